@@ -54,16 +54,43 @@
 
 #include "libbuild.hpp"
 
+#include "containers/klfixed.hpp"
 #include "containers/kllist.hpp"
 #include "containers/klmap.hpp"
+#include "containers/klnumber.hpp"
+#include "containers/klstaticlist.hpp"
+#include "containers/klstaticmap.hpp"
+#include "containers/klstaticstring.hpp"
 #include "containers/klstring.hpp"
+#include "containers/klstringbuilder.hpp"
+#include "containers/klstringview.hpp"
+#include "containers/klsymbol.hpp"
 #include "containers/kltree.hpp"
 
+#if !defined(F_CPU)
+#include "containers/klflattree.hpp"
+#include "containers/klmappedfile.hpp"
+#include "containers/klthreadpool.hpp"
+#endif
+
+#if defined(USING_CONCURRENT)
+#include "containers/klconcurrentmap.hpp"
+#endif
+
 #include "script/klbindings.hpp"
+#include "script/klcache.hpp"
+#include "script/klexpression.hpp"
+#include "script/kljit.hpp"
 #include "script/klparser.hpp"
+#include "script/klprogram.hpp"
+#include "script/klreactive.hpp"
 #include "script/klscript.hpp"
 #include "script/klvariables.hpp"
 
+#if !defined(F_CPU)
+#include "script/kltranslator.hpp"
+#endif
+
 #if defined(QT_VERSION)
 #include "qt/klhighlighter.hpp"
 #include "qt/klscripteditor.hpp"
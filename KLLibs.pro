@@ -28,21 +28,55 @@ DEFINES	+=	KLLIBS_LIBRARY
 SOURCES	+=	script/klscript.cpp \
 			script/klvariables.cpp \
 			script/klbindings.cpp \
+			script/klcache.cpp \
 			script/klparser.cpp \
+			script/klprogram.cpp \
+			script/kljit.cpp \
+			script/klexpression.cpp \
+			script/klreactive.cpp \
+			script/kltranslator.cpp \
 			containers/klmap.cpp \
+			containers/klfixed.cpp \
 			containers/kllist.cpp \
+			containers/klnumber.cpp \
+			containers/klstaticlist.cpp \
+			containers/klstaticmap.cpp \
+			containers/klstaticstring.cpp \
 			containers/klstring.cpp \
-			containers/kltree.cpp
+			containers/klstringbuilder.cpp \
+			containers/klstringview.cpp \
+			containers/klsymbol.cpp \
+			containers/kltree.cpp \
+			containers/klflattree.cpp \
+			containers/klthreadpool.cpp \
+			containers/klmappedfile.cpp
 
 HEADERS	+=	KLLibs.hpp libbuild.hpp \
 			script/klscript.hpp \
 			script/klvariables.hpp \
 			script/klbindings.hpp \
+			script/klcache.hpp \
 			script/klparser.hpp \
+			script/klprogram.hpp \
+			script/kljit.hpp \
+			script/klexpression.hpp \
+			script/klreactive.hpp \
+			script/kltranslator.hpp \
 			containers/klmap.hpp \
+			containers/klfixed.hpp \
 			containers/kllist.hpp \
+			containers/klnumber.hpp \
+			containers/klstaticlist.hpp \
+			containers/klstaticmap.hpp \
+			containers/klstaticstring.hpp \
 			containers/klstring.hpp \
-			containers/kltree.hpp
+			containers/klstringbuilder.hpp \
+			containers/klstringview.hpp \
+			containers/klsymbol.hpp \
+			containers/kltree.hpp \
+			containers/klflattree.hpp \
+			containers/klthreadpool.hpp \
+			containers/klmappedfile.hpp
 
 QMAKE_CXXFLAGS	+=	-s -march=native -std=c++14
 
@@ -76,6 +110,34 @@ boost {
 
 }
 
+cow {
+
+	DEFINES	+=	USING_COW
+
+}
+
+static {
+
+	DEFINES	+=	USING_STATIC_CONTAINERS
+
+}
+
+fixed {
+
+	DEFINES	+=	USING_FIXED_POINT
+
+}
+
+concurrent {
+
+	DEFINES	+=	USING_CONCURRENT
+
+	SOURCES	+=	containers/klconcurrentmap.cpp
+
+	HEADERS	+=	containers/klconcurrentmap.hpp
+
+}
+
 unix {
 
 	target.path = /usr/lib
@@ -0,0 +1,453 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Concurrent Map interpretation for KLLibs                   *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLCONCURRENTMAP_CPP
+#define KLCONCURRENTMAP_CPP
+
+#include "klconcurrentmap.hpp"
+
+template<typename Key>
+unsigned KLConcurrentMapHash<Key>::operator() (const Key& ID) const
+{
+	return std::hash<Key>()(ID);
+}
+
+inline unsigned KLConcurrentMapHash<KLString>::operator() (const KLString& ID) const
+{
+	return unsigned(ID.Hash());
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapRecord::KLConcurrentMapRecord(const Data& _Value, const Key& _Index)
+: Value(_Value), Index(_Index) {}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapItem::KLConcurrentMapItem(const Data& Value, const Key& Index)
+: Next(nullptr), Discarded(nullptr), Record(Value, Index) {}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapShard::KLConcurrentMapShard(void)
+: Begin(nullptr), End(nullptr), Discarded(nullptr), Phase(0), Capacity(0)
+{
+	Readers[0] = Readers[1] = 0;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapReader::KLConcurrentMapReader(KLConcurrentMapShard& Segment)
+: Shard(Segment), Phase(Segment.Phase.load() & 1)
+{
+	Shard.Readers[Phase].fetch_add(1);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapReader::~KLConcurrentMapReader(void)
+{
+	Shard.Readers[Phase].fetch_sub(1);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator::KLConcurrentMapVarIterator(KLConcurrentMapShard* Begin, KLConcurrentMapShard* End)
+: Shard(Begin), Last(End), Current(nullptr)
+{
+	while (Shard != Last && !(Current = Shard->Begin.load())) ++Shard;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapRecord& KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator::operator* (void)
+{
+	return Current->Record;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator& KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator::operator++ (void)
+{
+	Current = Current->Next.load();
+
+	while (!Current && ++Shard != Last) Current = Shard->Begin.load();
+
+	return *this;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+bool KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator::operator!= (const KLConcurrentMapVarIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator::KLConcurrentMapConstIterator(const KLConcurrentMapShard* Begin, const KLConcurrentMapShard* End)
+: Shard(Begin), Last(End), Current(nullptr)
+{
+	while (Shard != Last && !(Current = Shard->Begin.load())) ++Shard;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+const typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapRecord& KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator::operator* (void) const
+{
+	return Current->Record;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator& KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator::operator++ (void)
+{
+	Current = Current->Next.load();
+
+	while (!Current && ++Shard != Last) Current = Shard->Begin.load();
+
+	return *this;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+bool KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator::operator!= (const KLConcurrentMapConstIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapShard& KLConcurrentMap<Data, Key, Shards, Hash>::Select(const Key& ID) const
+{
+	return Segments[Hash()(ID) % unsigned(Shards)];
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapItem* KLConcurrentMap<Data, Key, Shards, Hash>::Find(const KLConcurrentMapShard& Shard, const Key& ID)
+{
+	KLConcurrentMapItem* MapItem = Shard.Begin.load();
+
+	while (MapItem)
+	{
+		if (MapItem->Record.Index == ID)
+			return MapItem;
+		else
+			MapItem = MapItem->Next.load();
+	}
+
+	return nullptr;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+void KLConcurrentMap<Data, Key, Shards, Hash>::Synchronize(KLConcurrentMapShard& Shard)
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		const unsigned Phase = Shard.Phase.load() & 1;
+
+		Shard.Phase.store(Phase ^ 1);
+
+		while (Shard.Readers[Phase].load()) std::this_thread::yield();
+	}
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+void KLConcurrentMap<Data, Key, Shards, Hash>::Discard(KLConcurrentMapShard& Shard, KLConcurrentMapItem* MapItem)
+{
+	MapItem->Discarded = Shard.Discarded;
+	Shard.Discarded = MapItem;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+bool KLConcurrentMap<Data, Key, Shards, Hash>::Append(KLConcurrentMapItem* MapItem)
+{
+	KLConcurrentMapShard& Shard = Select(MapItem->Record.Index);
+
+	std::lock_guard<std::mutex> Lock(Shard.Lock);
+
+	if (Find(Shard, MapItem->Record.Index))
+	{
+		delete MapItem;
+
+		return false;
+	}
+
+	if (Shard.End) Shard.End->Next.store(MapItem);
+	else Shard.Begin.store(MapItem);
+
+	Shard.End = MapItem;
+	Shard.Capacity.fetch_add(1);
+
+	return true;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMap(const KLConcurrentMap<Data, Key, Shards, Hash>& Map)
+: KLConcurrentMap()
+{
+	for (const auto& Record: Map) Insert(Record.Value, Record.Index);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMap(KLConcurrentMap<Data, Key, Shards, Hash>&& Map)
+: KLConcurrentMap()
+{
+	for (int i = 0; i < Shards; ++i)
+	{
+		KLConcurrentMapShard& Shard = Map.Segments[i];
+
+		Segments[i].Begin.store(Shard.Begin.exchange(nullptr));
+		Segments[i].Capacity.store(Shard.Capacity.exchange(0));
+		Segments[i].End = Shard.End;
+		Segments[i].Discarded = Shard.Discarded;
+
+		Shard.End = nullptr;
+		Shard.Discarded = nullptr;
+	}
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMap(void) {}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>::~KLConcurrentMap(void)
+{
+	Clean(); Reclaim();
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+int KLConcurrentMap<Data, Key, Shards, Hash>::Insert(const Data& Item, const Key& ID)
+{
+	if (!Append(new KLConcurrentMapItem(Item, ID))) return -1;
+
+	return Size();
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+int KLConcurrentMap<Data, Key, Shards, Hash>::Delete(const Key& ID)
+{
+	KLConcurrentMapShard& Shard = Select(ID);
+
+	{
+		std::lock_guard<std::mutex> Lock(Shard.Lock);
+
+		KLConcurrentMapItem* MapItem = Shard.Begin.load();
+		KLConcurrentMapItem* PrevItem = nullptr;
+
+		while (MapItem && !(MapItem->Record.Index == ID))
+		{
+			PrevItem = MapItem;
+			MapItem = MapItem->Next.load();
+		}
+
+		if (!MapItem) return -1;
+
+		if (PrevItem) PrevItem->Next.store(MapItem->Next.load());
+		else Shard.Begin.store(MapItem->Next.load());
+
+		if (Shard.End == MapItem) Shard.End = PrevItem;
+
+		Shard.Capacity.fetch_sub(1);
+
+		Discard(Shard, MapItem);
+	}
+
+	return Size();
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+bool KLConcurrentMap<Data, Key, Shards, Hash>::Exists(const Key& ID) const
+{
+	KLConcurrentMapShard& Shard = Select(ID);
+	KLConcurrentMapReader Reader(Shard);
+
+	return Find(Shard, ID);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+bool KLConcurrentMap<Data, Key, Shards, Hash>::Update(const Key& OldID, const Key& NewID)
+{
+	if (OldID == NewID) return true;
+
+	KLConcurrentMapShard& Shard = Select(OldID);
+	KLConcurrentMapItem* MapItem = nullptr;
+
+	{
+		KLConcurrentMapReader Reader(Shard);
+
+		if (KLConcurrentMapItem* OldItem = Find(Shard, OldID))
+		{
+			MapItem = new KLConcurrentMapItem(OldItem->Record.Value, NewID);
+		}
+	}
+
+	if (!MapItem || !Append(MapItem)) return false;
+
+	return Delete(OldID) != -1;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+int KLConcurrentMap<Data, Key, Shards, Hash>::Size(void) const
+{
+	int Count = 0;
+
+	for (const auto& Shard: Segments) Count += Shard.Capacity.load();
+
+	return Count;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLList<Data> KLConcurrentMap<Data, Key, Shards, Hash>::Values(void) const
+{
+	KLList<Data> Buffer;
+
+	for (auto& Shard: Segments)
+	{
+		KLConcurrentMapReader Reader(Shard);
+
+		for (auto MapItem = Shard.Begin.load(); MapItem; MapItem = MapItem->Next.load())
+		{
+			Buffer.Insert(MapItem->Record.Value);
+		}
+	}
+
+	return Buffer;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLList<Key> KLConcurrentMap<Data, Key, Shards, Hash>::Keys(void) const
+{
+	KLList<Key> Buffer;
+
+	for (auto& Shard: Segments)
+	{
+		KLConcurrentMapReader Reader(Shard);
+
+		for (auto MapItem = Shard.Begin.load(); MapItem; MapItem = MapItem->Next.load())
+		{
+			Buffer.Insert(MapItem->Record.Index);
+		}
+	}
+
+	return Buffer;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+void KLConcurrentMap<Data, Key, Shards, Hash>::Clean(void)
+{
+	for (auto& Shard: Segments)
+	{
+		std::lock_guard<std::mutex> Lock(Shard.Lock);
+
+		KLConcurrentMapItem* MapItem = Shard.Begin.exchange(nullptr);
+
+		Shard.End = nullptr;
+		Shard.Capacity.store(0);
+
+		for (; MapItem; MapItem = MapItem->Next.load()) Discard(Shard, MapItem);
+	}
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+void KLConcurrentMap<Data, Key, Shards, Hash>::Reclaim(void)
+{
+	for (auto& Shard: Segments)
+	{
+		std::lock_guard<std::mutex> Lock(Shard.Lock);
+
+		KLConcurrentMapItem* MapItem = Shard.Discarded;
+
+		Shard.Discarded = nullptr;
+
+		if (MapItem) Synchronize(Shard);
+
+		while (MapItem)
+		{
+			KLConcurrentMapItem* NextItem = MapItem->Discarded;
+
+			delete MapItem;
+
+			MapItem = NextItem;
+		}
+	}
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+template<typename Functor>
+bool KLConcurrentMap<Data, Key, Shards, Hash>::Read(const Key& ID, Functor Function) const
+{
+	KLConcurrentMapShard& Shard = Select(ID);
+	KLConcurrentMapReader Reader(Shard);
+
+	if (const KLConcurrentMapItem* MapItem = Find(Shard, ID))
+	{
+		Function(static_cast<const Data&>(MapItem->Record.Value)); return true;
+	}
+	else return false;
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator KLConcurrentMap<Data, Key, Shards, Hash>::begin(void)
+{
+	return KLConcurrentMapVarIterator(Segments, Segments + Shards);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapVarIterator KLConcurrentMap<Data, Key, Shards, Hash>::end(void)
+{
+	return KLConcurrentMapVarIterator(Segments + Shards, Segments + Shards);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator KLConcurrentMap<Data, Key, Shards, Hash>::begin(void) const
+{
+	return KLConcurrentMapConstIterator(Segments, Segments + Shards);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+typename KLConcurrentMap<Data, Key, Shards, Hash>::KLConcurrentMapConstIterator KLConcurrentMap<Data, Key, Shards, Hash>::end(void) const
+{
+	return KLConcurrentMapConstIterator(Segments + Shards, Segments + Shards);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+Data& KLConcurrentMap<Data, Key, Shards, Hash>::operator[] (const Key& ID)
+{
+	KLConcurrentMapShard& Shard = Select(ID);
+	KLConcurrentMapReader Reader(Shard);
+
+	if (KLConcurrentMapItem* MapItem = Find(Shard, ID))
+		return MapItem->Record.Value;
+	else
+		return *((Data*) nullptr);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+const Data& KLConcurrentMap<Data, Key, Shards, Hash>::operator[] (const Key& ID) const
+{
+	KLConcurrentMapShard& Shard = Select(ID);
+	KLConcurrentMapReader Reader(Shard);
+
+	if (KLConcurrentMapItem* MapItem = Find(Shard, ID))
+		return MapItem->Record.Value;
+	else
+		return *((Data*) nullptr);
+}
+
+template<typename Data, typename Key, int Shards, typename Hash>
+KLConcurrentMap<Data, Key, Shards, Hash>& KLConcurrentMap<Data, Key, Shards, Hash>::operator= (const KLConcurrentMap<Data, Key, Shards, Hash>& Map)
+{
+	if (this == &Map) return *this;
+
+	Clean();
+
+	for (const auto& Record: Map) Insert(Record.Value, Record.Index);
+
+	return *this;
+}
+
+#endif // KLCONCURRENTMAP_CPP
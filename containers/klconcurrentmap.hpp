@@ -0,0 +1,425 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Concurrent Map interpretation for KLLibs                   *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLCONCURRENTMAP_HPP
+#define KLCONCURRENTMAP_HPP
+
+#include "../libbuild.hpp"
+
+#include "kllist.hpp"
+#include "klstring.hpp"
+
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+/*! \file		klconcurrentmap.hpp
+ *  \brief	Deklaracje dla klasy KLConcurrentMap i jej składników.
+ *
+ */
+
+/*! \file		klconcurrentmap.cpp
+ *  \brief	Implementacja klasy KLConcurrentMap i jej składników.
+ *
+ */
+
+/*! \brief	Funkcja skrótu dla kluczy mapy.
+ *  \tparam	Key Typ używanego klucza.
+ *
+ * Domyślnie korzysta z `std::hash`. Dla `KLString` zdefiniowano specjalizację korzystającą z zapamiętanego skrótu `KLString::Hash`, który jest obliczany przed dodaniem klucza do mapy.
+ *
+ */
+template<typename Key>
+struct KLConcurrentMapHash
+{
+	unsigned operator() (const Key& ID) const;
+};
+
+template<>
+struct KLConcurrentMapHash<KLString>
+{
+	unsigned operator() (const KLString& ID) const;
+};
+
+/*! \brief	Współbieżna interpretacja mapy.
+ *  \tparam	Data		Typ przechowywanych danych.
+ *  \tparam	Key		Typ używanego klucza.
+ *  \tparam	Shards	Liczba niezależnych segmentów mapy.
+ *  \tparam	Hash		Funkcja skrótu wybierająca segment dla klucza.
+ *  \note		Do użycia wymagany jest konstruktor kopiujący dla klucza i danych.
+ *  \warning	Referencje zwrócone przez `operator[]` oraz iteratory pozostają ważne także po usunięciu elementu - do najbliższego wywołania `Reclaim()`.
+ *
+ * Mapa o interfejsie zgodnym z `KLMap` przeznaczona do współdzielenia pomiędzy wątkami. Elementy są rozdzielane pomiędzy segmenty na podstawie skrótu klucza, a każdy segment posiada własną blokadę dla operacji modyfikujących.
+ *
+ * Operacje odczytu (`Exists`, `operator[]`, `Read`, `Values`, `Keys`) nie zakładają blokad. Segment jest listą, w której wskaźniki są publikowane atomowo. Usunięte elementy (`Delete`, `Update`, `Clean`) są jedynie odłączane od segmentu i trafiają na listę elementów do zwolnienia. Pamięć odzyskuje dopiero metoda `Reclaim()`, wywoływana przez użytkownika w punkcie spoczynku (gdy żaden wątek nie przechowuje referencji ani iteratorów), po upływie okresu łaski (RCU) dla trwających sekcji odczytu. Metoda `Read()` wywołuje podany obiekt funkcyjny w sekcji odczytu, więc udostępniona wartość jest bezpieczna nawet podczas równoczesnego wywołania `Reclaim()`.
+ *
+ */
+template<typename Data, typename Key, int Shards = 16, typename Hash = KLConcurrentMapHash<Key>>
+class KLConcurrentMap
+{
+
+	static_assert(Shards > 0, "KLConcurrentMap requires at least one shard");
+
+	/*! \brief		Struktura reprezentująca parę klucz-dane.
+	 *
+	 * Struktura przechowująca informacje o obiekcie przechowywanym w mapie.
+	 *
+	 */
+	public: struct KLConcurrentMapRecord
+	{
+
+		Data	Value;	//!< Dane obiektu.
+		Key	Index;		//!< Klucz obiektu.
+
+		/*! \brief		Konstruktor rekordu.
+		 *  \param [in]	_Value	Dane rekordu.
+		 *  \param [in]	_Index	Klucz rekordu.
+		 *
+		 * Tworzy nowy rekord na podstawie podanych obiektów klucza i danych. Kopiuje wszystkie obiekty.
+		 *
+		 */
+		KLConcurrentMapRecord(const Data& _Value, const Key& _Index);
+
+	};
+
+	/*! \brief		Struktura elementu mapy.
+	 *
+	 * Przechowuje rekord wraz z atomowym wskaźnikiem na kolejny element segmentu.
+	 *
+	 */
+	protected: struct KLConcurrentMapItem
+	{
+
+		std::atomic<KLConcurrentMapItem*> Next;	//!< Wskaźnik na kolejny element.
+		KLConcurrentMapItem* Discarded;			//!< Kolejny element do zwolnienia (po odłączeniu od segmentu).
+		KLConcurrentMapRecord Record;				//!< Dane elementu.
+
+		/*! \brief		Konstruktor elementu.
+		 *  \param [in]	Value	Dane elementu.
+		 *  \param [in]	Index	Klucz elementu.
+		 *
+		 * Inicjuje wszystkie pola obiektu.
+		 *
+		 */
+		KLConcurrentMapItem(const Data& Value, const Key& Index);
+
+	};
+
+	/*! \brief		Struktura segmentu mapy.
+	 *
+	 * Przechowuje listę elementów segmentu, listę elementów do zwolnienia, blokadę pisarzy i liczniki czytelników w dwóch fazach.
+	 *
+	 */
+	protected: struct KLConcurrentMapShard
+	{
+
+		std::atomic<KLConcurrentMapItem*> Begin;	//!< Wskaźnik na początek segmentu.
+		KLConcurrentMapItem* End;				//!< Wskaźnik na koniec segmentu (chroniony blokadą).
+		KLConcurrentMapItem* Discarded;			//!< Odłączone elementy oczekujące na zwolnienie (chronione blokadą).
+
+		std::atomic<unsigned> Readers[2];			//!< Liczniki aktywnych czytelników w obu fazach.
+		std::atomic<unsigned> Phase;				//!< Bieżąca faza czytelników.
+
+		std::atomic<int> Capacity;				//!< Liczba elementów segmentu.
+
+		std::mutex Lock;						//!< Blokada operacji modyfikujących.
+
+		/*! \brief		Domyślny konstruktor.
+		 *
+		 * Inicjuje wszystkie pola obiektu.
+		 *
+		 */
+		KLConcurrentMapShard(void);
+
+	};
+
+	/*! \brief		Sekcja odczytu segmentu.
+	 *
+	 * Rejestruje czytelnika w bieżącej fazie segmentu na czas swojego istnienia.
+	 *
+	 */
+	protected: class KLConcurrentMapReader
+	{
+
+		protected:
+
+			KLConcurrentMapShard& Shard;	//!< Czytany segment.
+
+			const unsigned Phase;		//!< Faza w której zarejestrowano czytelnika.
+
+		public:
+
+			explicit KLConcurrentMapReader(KLConcurrentMapShard& Segment);
+
+			~KLConcurrentMapReader(void);
+
+	};
+
+	public: class KLConcurrentMapVarIterator
+	{
+
+		protected:
+
+			KLConcurrentMapShard* Shard;
+			KLConcurrentMapShard* Last;
+
+			KLConcurrentMapItem* Current;
+
+		public:
+
+			KLConcurrentMapVarIterator(KLConcurrentMapShard* Begin, KLConcurrentMapShard* End);
+
+			KLConcurrentMapRecord& operator* (void);
+			KLConcurrentMapVarIterator& operator++ (void);
+			bool operator!= (const KLConcurrentMapVarIterator& Iterator) const;
+
+	};
+
+	public: class KLConcurrentMapConstIterator
+	{
+
+		protected:
+
+			const KLConcurrentMapShard* Shard;
+			const KLConcurrentMapShard* Last;
+
+			const KLConcurrentMapItem* Current;
+
+		public:
+
+			KLConcurrentMapConstIterator(const KLConcurrentMapShard* Begin, const KLConcurrentMapShard* End);
+
+			const KLConcurrentMapRecord& operator* (void) const;
+			KLConcurrentMapConstIterator& operator++ (void);
+			bool operator!= (const KLConcurrentMapConstIterator& Iterator) const;
+
+	};
+
+	protected:
+
+		mutable KLConcurrentMapShard Segments[Shards];	//!< Segmenty mapy.
+
+		/*! \brief		Wybór segmentu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Segment odpowiedzialny za podany klucz.
+		 *
+		 * Wybiera segment na podstawie skrótu klucza.
+		 *
+		 */
+		KLConcurrentMapShard& Select(const Key& ID) const;
+
+		/*! \brief		Wyszukanie elementu.
+		 *  \param [in]	Shard	Przeszukiwany segment.
+		 *  \param [in]	ID		Klucz elementu.
+		 *  \return		Wskaźnik na element lub `nullptr`.
+		 *
+		 * Przegląda segment w poszukiwaniu podanego klucza. Wymaga aktywnej sekcji odczytu lub blokady segmentu.
+		 *
+		 */
+		static KLConcurrentMapItem* Find(const KLConcurrentMapShard& Shard, const Key& ID);
+
+		/*! \brief		Oczekiwanie na okres łaski.
+		 *  \param [in]	Shard Segment do synchronizacji.
+		 *
+		 * Dwukrotnie przełącza fazę segmentu i czeka aż wszyscy czytelnicy poprzednich faz zakończą odczyt. Po powrocie odłączone elementy mogą zostać bezpiecznie zwolnione. Wymaga blokady segmentu.
+		 *
+		 */
+		static void Synchronize(KLConcurrentMapShard& Shard);
+
+		/*! \brief		Odłożenie elementu do zwolnienia.
+		 *  \param [in]	Shard	Segment elementu.
+		 *  \param [in]	MapItem	Odłączony element.
+		 *
+		 * Dopisuje element do listy elementów zwalnianych przez `Reclaim()`. Pole `Next` elementu pozostaje bez zmian, dzięki czemu czytelnik stojący na elemencie może kontynuować przeglądanie segmentu. Wymaga blokady segmentu.
+		 *
+		 */
+		static void Discard(KLConcurrentMapShard& Shard, KLConcurrentMapItem* MapItem);
+
+		/*! \brief		Dołączenie elementu.
+		 *  \param [in]	MapItem Nowy element.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Dołącza gotowy element na koniec odpowiedniego segmentu. Gdy klucz jest zajęty element jest zwalniany.
+		 *
+		 */
+		bool Append(KLConcurrentMapItem* MapItem);
+
+	public:
+
+		/*! \brief		Konstruktor kopiujący.
+		 *  \param [in]	Map Mapa do sklonowania.
+		 *
+		 * Klonuje wybraną instancje mapy.
+		 *
+		 */
+		KLConcurrentMap(const KLConcurrentMap<Data, Key, Shards, Hash>& Map);
+
+		/*! \brief		Konstruktor przenoszący.
+		 *  \param [in]	Map Mapa do przeniesienia.
+		 *  \warning		Przenoszona mapa nie może być w tym czasie używana przez inne wątki.
+		 *
+		 * Przenosi wybraną instancje mapy.
+		 *
+		 */
+		KLConcurrentMap(KLConcurrentMap<Data, Key, Shards, Hash>&& Map);
+
+		/*! \brief		Domyślny konstruktor.
+		 *
+		 * Inicjuje wszystkie pola obiektu.
+		 *
+		 */
+		KLConcurrentMap(void);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Zwalnia wszystkie użyte zasoby.
+		 *
+		 */
+		~KLConcurrentMap(void);
+
+		/*! \brief		Wstawianie elementu.
+		 *  \param [in]	Item	Element dodawany do mapy.
+		 *  \param [in]	ID	Identyfikator obiektu.
+		 *  \return		Aktualna liczba elementów lub -1 gdy klucz jest zajęty.
+		 *
+		 * Dodaje do mapy kopie podanego elementu i zwraca nową ilość elementów.
+		 *
+		 */
+		int Insert(const Data& Item, const Key& ID);
+
+		/*! \brief		Usunięcie elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Aktualna liczba elementów lub -1 w przypadku błędu.
+		 *
+		 * Usuwa wybrany element i zwraca aktualną ilość elementów. Pamięć elementu zwalniana jest dopiero przez `Reclaim()`.
+		 *
+		 */
+		int Delete(const Key& ID);
+
+		/*! \brief		Test klucza.
+		 *  \param [in]	ID Klucz do sprawdzenia.
+		 *  \return		`true` jeśli element o podanym kluczu istnieje, lub `false` gdy nie iestnieje.
+		 *
+		 * Sprawdza bez blokowania czy obiekt o podanym kluczu istnieje i zwraca odpowiednią wartość.
+		 *
+		 */
+		bool Exists(const Key& ID) const;
+
+		/*! \brief		Zmiana klucza obiektu.
+		 *  \param [in]	OldID	Klucz do zamiany.
+		 *  \param [in]	NewID	Nowy klucz.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zamienia podany klucz na nowy. Element zostaje skopiowany pod nowym kluczem, więc wcześniejsze referencje do niego tracą ważność.
+		 *
+		 */
+		bool Update(const Key& OldID, const Key& NewID);
+
+		/*! \brief		Sprawdzenie ilości elementów.
+		 *  \return		Aktualna liczba elementów.
+		 *
+		 * Zwraca aktualną liczbę elementów.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Lista wartości.
+		 *  \return		Aktualna lista elementów.
+		 *
+		 * Zwraca kopie aktualnej listy wartości.
+		 *
+		 */
+		KLList<Data> Values(void) const;
+
+		/*! \brief		Lista kluczy.
+		 *  \return		Aktualna lista kluczy.
+		 *
+		 * Zwraca kopie aktualnej listy kluczy.
+		 *
+		 */
+		KLList<Key> Keys(void) const;
+
+		/*! \brief		Czyszczenie mapy.
+		 *
+		 * Usuwa wszystkie elementy mapy. Pamięć elementów zwalniana jest dopiero przez `Reclaim()`.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Odzyskanie pamięci.
+		 *  \warning		Wywołujący gwarantuje, że żaden wątek nie przechowuje referencji zwróconych przez `operator[]` ani iteratorów mapy.
+		 *
+		 * Czeka na zakończenie trwających sekcji odczytu (`Exists`, `Read`, `Values`, `Keys`) i zwalnia elementy usunięte od poprzedniego wywołania.
+		 *
+		 */
+		void Reclaim(void);
+
+		/*! \brief		Odczyt elementu w sekcji odczytu.
+		 *  \tparam		Functor	Typ obiektu funkcyjnego.
+		 *  \param [in]	ID		Klucz elementu.
+		 *  \param [in]	Function	Obiekt funkcyjny wywoływany ze stałą referencją do elementu.
+		 *  \return		`true` jeśli element istnieje.
+		 *
+		 * Wywołuje obiekt funkcyjny w sekcji odczytu segmentu, więc element nie zostanie zwolniony (także przez `Reclaim()`) przed jego zakończeniem.
+		 *
+		 */
+		template<typename Functor> bool Read(const Key& ID, Functor Function) const;
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Referencja do wybranego elementu.
+		 *  \warning		Gdy element o podanym kluczu nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
+		 *
+		 * Wybiera bez blokowania element o podanym kluczu z mapy. Referencja pozostaje ważna także po usunięciu elementu, do najbliższego wywołania `Reclaim()`.
+		 *
+		 */
+		Data& operator[] (const Key& ID);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Stała referencja do wybranego elementu.
+		 *  \warning		Gdy element o podanym kluczu nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
+		 *
+		 * Wybiera bez blokowania element o podanym kluczu z mapy. Referencja pozostaje ważna także po usunięciu elementu, do najbliższego wywołania `Reclaim()`.
+		 *
+		 */
+		const Data& operator[] (const Key& ID) const;
+
+		/*! \brief		Operator przypisania.
+		 *  \param [in]	Map Obiekt do sklonowania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Zwalnia dotychczasowe zasoby i klonuje wybrany obiekt.
+		 *
+		 */
+		KLConcurrentMap<Data, Key, Shards, Hash>& operator= (const KLConcurrentMap<Data, Key, Shards, Hash>& Map);
+
+		KLConcurrentMapVarIterator begin(void);
+		KLConcurrentMapVarIterator end(void);
+
+		KLConcurrentMapConstIterator begin(void) const;
+		KLConcurrentMapConstIterator end(void) const;
+
+};
+
+#include "klconcurrentmap.cpp"
+
+#endif // KLCONCURRENTMAP_HPP
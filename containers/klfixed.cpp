@@ -0,0 +1,638 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Fixed Point interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLFIXED_CPP
+#define KLFIXED_CPP
+
+#include "klfixed.hpp"
+
+#if defined(F_CPU)
+#include <avr/pgmspace.h>
+#define KLFIXED_TABLE				PROGMEM								//!< Umieszczenie tablic w pamięci programu.
+#define KLFIXED_READ(Table, Index)	int32_t(pgm_read_dword(&(Table)[Index]))	//!< Odczyt elementu tablicy.
+#else
+#define KLFIXED_TABLE													//!< Umieszczenie tablic w pamięci programu.
+#define KLFIXED_READ(Table, Index)	(Table)[Index]						//!< Odczyt elementu tablicy.
+#endif
+
+#define KLFIXED_LOG2E	1.4426950408889634	//!< Wartość `log2(e)`.
+#define KLFIXED_LN2		0.6931471805599453	//!< Wartość `ln(2)`.
+#define KLFIXED_LG2		0.3010299956639812	//!< Wartość `log10(2)`.
+#define KLFIXED_2PI		6.2831853071795865	//!< Wartość `2pi`.
+
+template<typename Raw, typename Wide, int Fraction>
+constexpr Raw KLFixedPoint<Raw, Wide, Fraction>::ONE;
+
+template<typename Raw, typename Wide, int Fraction>
+constexpr Raw KLFixedPoint<Raw, Wide, Fraction>::MAX;
+
+template<typename Raw, typename Wide, int Fraction>
+constexpr Raw KLFixedPoint<Raw, Wide, Fraction>::MIN;
+
+template<typename Raw, typename Wide, int Fraction>
+const int32_t KLFixedPoint<Raw, Wide, Fraction>::SinTable[257] KLFIXED_TABLE =
+{
+	0, 6588356, 13176464, 19764076, 26350943, 32936819, 39521455, 46104602,
+	52686014, 59265442, 65842639, 72417357, 78989349, 85558366, 92124163, 98686491,
+	105245103, 111799753, 118350194, 124896179, 131437462, 137973796, 144504935, 151030634,
+	157550647, 164064728, 170572633, 177074115, 183568930, 190056834, 196537583, 203010932,
+	209476638, 215934457, 222384147, 228825464, 235258165, 241682010, 248096755, 254502159,
+	260897982, 267283981, 273659918, 280025552, 286380643, 292724951, 299058239, 305380268,
+	311690799, 317989595, 324276419, 330551034, 336813204, 343062693, 349299266, 355522689,
+	361732726, 367929144, 374111709, 380280190, 386434353, 392573967, 398698801, 404808624,
+	410903207, 416982319, 423045732, 429093217, 435124548, 441139496, 447137835, 453119340,
+	459083786, 465030947, 470960600, 476872522, 482766489, 488642281, 494499676, 500338453,
+	506158392, 511959275, 517740883, 523502998, 529245404, 534967884, 540670223, 546352205,
+	552013618, 557654248, 563273883, 568872310, 574449320, 580004702, 585538248, 591049748,
+	596538995, 602005783, 607449906, 612871159, 618269338, 623644239, 628995660, 634323400,
+	639627258, 644907034, 650162530, 655393548, 660599890, 665781362, 670937767, 676068911,
+	681174602, 686254647, 691308855, 696337036, 701339000, 706314559, 711263525, 716185713,
+	721080937, 725949013, 730789757, 735602987, 740388522, 745146182, 749875788, 754577161,
+	759250125, 763894504, 768510122, 773096806, 777654384, 782182683, 786681534, 791150767,
+	795590213, 799999706, 804379079, 808728167, 813046808, 817334838, 821592095, 825818421,
+	830013654, 834177638, 838310216, 842411232, 846480531, 850517961, 854523370, 858496606,
+	862437520, 866345964, 870221790, 874064853, 877875009, 881652112, 885396022, 889106597,
+	892783698, 896427186, 900036924, 903612776, 907154608, 910662286, 914135678, 917574653,
+	920979082, 924348837, 927683790, 930983817, 934248793, 937478595, 940673101, 943832191,
+	946955747, 950043650, 953095785, 956112036, 959092290, 962036435, 964944360, 967815955,
+	970651112, 973449725, 976211688, 978936898, 981625251, 984276646, 986890984, 989468165,
+	992008094, 994510675, 996975812, 999403415, 1001793390, 1004145648, 1006460100, 1008736660,
+	1010975242, 1013175761, 1015338134, 1017462281, 1019548121, 1021595575, 1023604567, 1025575020,
+	1027506862, 1029400018, 1031254418, 1033069992, 1034846671, 1036584389, 1038283080, 1039942680,
+	1041563127, 1043144360, 1044686319, 1046188946, 1047652185, 1049075980, 1050460278, 1051805027,
+	1053110176, 1054375676, 1055601479, 1056787540, 1057933813, 1059040255, 1060106826, 1061133483,
+	1062120190, 1063066909, 1063973603, 1064840240, 1065666786, 1066453210, 1067199483, 1067905576,
+	1068571464, 1069197120, 1069782521, 1070327646, 1070832474, 1071296985, 1071721163, 1072104991,
+	1072448455, 1072751542, 1073014240, 1073236540, 1073418433, 1073559913, 1073660973, 1073721611,
+	1073741824
+};
+
+template<typename Raw, typename Wide, int Fraction>
+const int32_t KLFixedPoint<Raw, Wide, Fraction>::LogTable[129] KLFIXED_TABLE =
+{
+	0, 12055174, 24017256, 35887675, 47667823, 59359063, 70962728, 82480119,
+	93912511, 105261148, 116527248, 127712004, 138816582, 149842124, 160789745, 171660541,
+	182455581, 193175914, 203822568, 214396548, 224898839, 235330407, 245692198, 255985140,
+	266210141, 276368092, 286459867, 296486323, 306448299, 316346620, 326182095, 335955515,
+	345667660, 355319292, 364911162, 374444004, 383918542, 393335482, 402695523, 411999347,
+	421247625, 430441017, 439580170, 448665721, 457698295, 466678506, 475606957, 484484242,
+	493310944, 502087636, 510814882, 519493235, 528123241, 536705435, 545240343, 553728485,
+	562170370, 570566499, 578917365, 587223455, 595485245, 603703206, 611877800, 620009483,
+	628098702, 636145900, 644151509, 652115959, 660039669, 667923055, 675766525, 683570481,
+	691335320, 699061430, 706749198, 714399001, 722011213, 729586201, 737124328, 744625951,
+	752091421, 759521085, 766915285, 774274358, 781598637, 788888448, 796144114, 803365955,
+	810554283, 817709409, 824831638, 831921271, 838978604, 846003931, 852997541, 859959719,
+	866890747, 873790901, 880660455, 887499680, 894308843, 901088206, 907838029, 914558569,
+	921250079, 927912807, 934547002, 941152905, 947730758, 954280797, 960803257, 967298370,
+	973766362, 980207461, 986621888, 993009864, 999371606, 1005707329, 1012017244, 1018301561,
+	1024560487, 1030794226, 1037002979, 1043186948, 1049346328, 1055481314, 1061592099, 1067678873,
+	1073741824
+};
+
+template<typename Raw, typename Wide, int Fraction>
+const int32_t KLFixedPoint<Raw, Wide, Fraction>::ExpTable[129] KLFIXED_TABLE =
+{
+	0, 5830312, 11692282, 17586082, 23511884, 29469863, 35460194, 41483051,
+	47538612, 53627054, 59748555, 65903296, 72091456, 78313218, 84568763, 90858275,
+	97181938, 103539938, 109932462, 116359696, 122821830, 129319052, 135851554, 142419526,
+	149023162, 155662655, 162338200, 169049992, 175798228, 182583107, 189404828, 196263589,
+	203159593, 210093041, 217064138, 224073086, 231120093, 238205364, 245329108, 252491532,
+	259692848, 266933267, 274213000, 281532261, 288891266, 296290228, 303729367, 311208899,
+	318729045, 326290024, 333892058, 341535371, 349220186, 356946729, 364715227, 372525906,
+	380378997, 388274729, 396213335, 404195046, 412220097, 420288723, 428401161, 436557649,
+	444758426, 453003732, 461293810, 469628901, 478009252, 486435107, 494906713, 503424319,
+	511988176, 520598533, 529255643, 537959761, 546711141, 555510041, 564356717, 573251430,
+	582194441, 591186011, 600226404, 609315886, 618454723, 627643183, 636881535, 646170051,
+	655509003, 664898664, 674339309, 683831217, 693374665, 702969933, 712617302, 722317055,
+	732069477, 741874854, 751733473, 761645624, 771611596, 781631683, 791706177, 801835375,
+	812019574, 822259072, 832554169, 842905168, 853312372, 863776085, 874296616, 884874272,
+	895509364, 906202203, 916953103, 927762380, 938630350, 949557332, 960543646, 971589615,
+	982695563, 993861814, 1005088698, 1016376542, 1027725678, 1039136438, 1050609158, 1062144174,
+	1073741824
+};
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Saturate(Wide Number)
+{
+	if (Number > Wide(MAX)) return FromRaw(MAX);
+	else if (Number < Wide(MIN)) return FromRaw(MIN);
+	else return FromRaw(Raw(Number));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+int32_t KLFixedPoint<Raw, Wide, Fraction>::Interpolate(const int32_t* Table, uint32_t Position, int Bits)
+{
+	const int Shift = 30 - Bits;
+	const uint32_t Index = Position >> Shift;
+	const uint32_t Rest = Position & ((uint32_t(1) << Shift) - 1);
+
+	const int32_t Left = KLFIXED_READ(Table, Index);
+
+	if (!Rest) return Left;
+
+	const int64_t Delta = int64_t(KLFIXED_READ(Table, Index + 1)) - Left;
+
+	return Left + int32_t((Delta * Rest + (int64_t(1) << (Shift - 1))) >> Shift);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+Wide KLFixedPoint<Raw, Wide, Fraction>::FromQ30(Wide Number)
+{
+	const int Down = Fraction < 30 ? 30 - Fraction : 0;
+	const int Up = Fraction > 30 ? Fraction - 30 : 0;
+
+	return (Number * (Wide(1) << Up) + ((Wide(1) << Down) >> 1)) >> Down;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+uint32_t KLFixedPoint<Raw, Wide, Fraction>::Phase(Raw Angle)
+{
+	const int Shift = int(sizeof(Wide) - sizeof(Raw)) * 8 - 32 + Fraction;
+	const Wide Factor = Wide(double(Wide(1) << (32 - Fraction + Shift)) / KLFIXED_2PI + 0.5);
+
+	return uint32_t((Wide(Angle) * Factor) >> Shift);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+Wide KLFixedPoint<Raw, Wide, Fraction>::Scale(Raw Number, double Factor)
+{
+	return (Wide(Number) * Wide(Factor * double(int32_t(1) << 30) + 0.5) + (Wide(1) << 29)) >> 30;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::SinPhase(uint32_t Phase)
+{
+	const uint32_t Quadrant = Phase >> 30;
+
+	uint32_t Position = Phase & 0x3FFFFFFFu;
+
+	if (Quadrant & 1) Position = 0x40000000u - Position;
+
+	const Wide Result = FromQ30(Interpolate(SinTable, Position, 8));
+
+	return FromRaw(Raw((Quadrant & 2) ? -Result : Result));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>::KLFixedPoint(int Number)
+: Value(Saturate(Wide(Number) * ONE).Value) {}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>::KLFixedPoint(double Number)
+{
+	const double Scaled = Number * double(ONE);
+
+	if (Scaled != Scaled) Value = 0;
+	else if (Scaled >= double(MAX)) Value = MAX;
+	else if (Scaled <= double(MIN)) Value = MIN;
+	else Value = Raw(Scaled < 0.0 ? Scaled - 0.5 : Scaled + 0.5);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::FromRaw(Raw Number)
+{
+	KLFixedPoint Result;
+
+	Result.Value = Number;
+
+	return Result;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+const char* KLFixedPoint<Raw, Wide, Fraction>::Parse(const char* Begin, const char* End, KLFixedPoint& Value)
+{
+	const char* Current = Begin;
+	const bool Negative = Current < End && *Current == '-';
+
+	if (Current < End && (*Current == '-' || *Current == '+')) ++Current;
+
+	const char* Digits = Current;
+
+	Wide Integer = 0;
+	uint32_t Numerator = 0, Denominator = 1;
+
+	while (Current < End && *Current >= '0' && *Current <= '9')
+	{
+		if (Integer <= Wide(MAX)) Integer = Integer * 10 + (*Current - '0');
+
+		++Current;
+	}
+
+	if (Current < End && *Current == '.')
+	{
+		++Current;
+
+		while (Current < End && *Current >= '0' && *Current <= '9')
+		{
+			if (Denominator < 1000000000u)
+			{
+				Numerator = Numerator * 10 + (*Current - '0');
+				Denominator *= 10;
+			}
+
+			++Current;
+		}
+	}
+
+	if (Current == Digits || (Current == Digits + 1 && *Digits == '.')) return Begin;
+
+	const Wide Part = (Wide(Numerator) * ONE + Denominator / 2) / Denominator;
+	const Wide Result = Integer > Wide(MAX) ? Wide(MAX) + 1 : Integer * ONE + Part;
+
+	Value = Saturate(Negative ? -Result : Result);
+
+	return Current;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+Raw KLFixedPoint<Raw, Wide, Fraction>::ToRaw(void) const
+{
+	return Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+int KLFixedPoint<Raw, Wide, Fraction>::ToInt(void) const
+{
+	return int(Value / ONE);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+double KLFixedPoint<Raw, Wide, Fraction>::ToNumber(void) const
+{
+	return double(Value) / double(ONE);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Round(int Digits) const
+{
+	const Wide Magnitude = Value < 0 ? -Wide(Value) : Wide(Value);
+
+	Wide Scale = 1, Result = 0;
+
+	if (Digits >= 0)
+	{
+		while (Digits-- && Scale < ONE) Scale *= 10;
+
+		if (Scale >= ONE) return *this;
+
+		const Wide Units = (Magnitude * Scale + ONE / 2) / ONE;
+
+		Result = (Units * ONE + Scale / 2) / Scale;
+	}
+	else
+	{
+		while (Digits++ && Scale <= Wide(MAX)) Scale *= 10;
+
+		if (Scale > Wide(MAX) / ONE) return FromRaw(0);
+
+		const Wide Unit = Scale * ONE;
+
+		Result = (Magnitude + Unit / 2) / Unit * Unit;
+	}
+
+	return Saturate(Value < 0 ? -Result : Result);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Abs(void) const
+{
+	return Value < 0 ? -*this : *this;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Sqrt(void) const
+{
+	if (Value <= 0) return FromRaw(0);
+
+	Wide Number = Wide(Value) * ONE;
+	Wide Root = 0;
+	Wide Bit = Wide(1) << (sizeof(Wide) * 8 - 2);
+
+	while (Bit > Number) Bit >>= 2;
+
+	while (Bit)
+	{
+		if (Number >= Root + Bit)
+		{
+			Number -= Root + Bit;
+			Root = (Root >> 1) + Bit;
+		}
+		else Root >>= 1;
+
+		Bit >>= 2;
+	}
+
+	if (Number > Root) ++Root;
+
+	return Saturate(Root);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Sin(void) const
+{
+	return SinPhase(Phase(Value));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Cos(void) const
+{
+	return SinPhase(Phase(Value) + 0x40000000u);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Tan(void) const
+{
+	return Sin() / Cos();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Exp2(void) const
+{
+	const Wide Integer = Wide(Value) >> Fraction;
+	const Wide Part = Wide(Value) - Integer * ONE;
+
+	const int Down = Fraction > 30 ? Fraction - 30 : 0;
+	const int Up = Fraction < 30 ? 30 - Fraction : 0;
+
+	const uint32_t Position = uint32_t((Part * (Wide(1) << Up)) >> Down);
+	const Wide Mantissa = FromQ30(Wide(Interpolate(ExpTable, Position, 7)) + (Wide(1) << 30));
+
+	if (Integer >= Wide(sizeof(Raw) * 8 - 1)) return FromRaw(MAX);
+	else if (Integer >= 0) return Saturate(Mantissa << Integer);
+	else if (Integer < -Wide(sizeof(Raw) * 8)) return FromRaw(0);
+	else return Saturate((Mantissa + ((Wide(1) << -Integer) >> 1)) >> -Integer);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Exp(void) const
+{
+	return Saturate(Scale(Value, KLFIXED_LOG2E)).Exp2();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Log2(void) const
+{
+	if (Value <= 0) return FromRaw(MIN);
+
+	int Top = sizeof(Raw) * 8 - 2;
+
+	while (!(Wide(Value) >> Top)) --Top;
+
+	const Wide Normalized = Top >= 30 ? Wide(Value) >> (Top - 30) : Wide(Value) << (30 - Top);
+	const uint32_t Position = uint32_t(Normalized - (Wide(1) << 30));
+
+	return Saturate(Wide(Top - Fraction) * ONE + FromQ30(Interpolate(LogTable, Position, 7)));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Log10(void) const
+{
+	if (Value <= 0) return FromRaw(MIN);
+
+	return Saturate(Scale(Log2().Value, KLFIXED_LG2));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Ln(void) const
+{
+	if (Value <= 0) return FromRaw(MIN);
+
+	return Saturate(Scale(Log2().Value, KLFIXED_LN2));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::Pow(const KLFixedPoint& Exponent) const
+{
+	if (Exponent.Value % ONE == 0)
+	{
+		Wide Count = Exponent.Value / ONE;
+
+		const bool Inverse = Count < 0;
+
+		KLFixedPoint Base = *this, Result = 1;
+
+		if (Inverse) Count = -Count;
+
+		while (Count)
+		{
+			if (Count & 1) Result *= Base;
+
+			if (Count >>= 1) Base *= Base;
+		}
+
+		return Inverse ? KLFixedPoint(1) / Result : Result;
+	}
+	else if (Value <= 0) return FromRaw(0);
+	else return (Exponent * Log2()).Exp2();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>::operator bool (void) const
+{
+	return Value != 0;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>::operator int (void) const
+{
+	return ToInt();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>::operator double (void) const
+{
+	return ToNumber();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::operator- (void) const
+{
+	return Saturate(-Wide(Value));
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::operator+ (const KLFixedPoint& Number) const
+{
+	return Saturate(Wide(Value) + Number.Value);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::operator- (const KLFixedPoint& Number) const
+{
+	return Saturate(Wide(Value) - Number.Value);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::operator* (const KLFixedPoint& Number) const
+{
+	return Saturate((Wide(Value) * Number.Value + (ONE >> 1)) >> Fraction);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> KLFixedPoint<Raw, Wide, Fraction>::operator/ (const KLFixedPoint& Number) const
+{
+	if (!Number.Value) return FromRaw(Value > 0 ? MAX : Value < 0 ? MIN : 0);
+
+	const Wide Dividend = Wide(Value) * ONE;
+	const Wide Rest = Dividend % Number.Value;
+
+	Wide Result = Dividend / Number.Value;
+
+	if (2 * (Rest < 0 ? -Rest : Rest) >= (Number.Value < 0 ? -Wide(Number.Value) : Wide(Number.Value)))
+	{
+		Result += ((Value < 0) != (Number.Value < 0)) ? -1 : 1;
+	}
+
+	return Saturate(Result);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>& KLFixedPoint<Raw, Wide, Fraction>::operator+= (const KLFixedPoint& Number)
+{
+	return *this = *this + Number;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>& KLFixedPoint<Raw, Wide, Fraction>::operator-= (const KLFixedPoint& Number)
+{
+	return *this = *this - Number;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>& KLFixedPoint<Raw, Wide, Fraction>::operator*= (const KLFixedPoint& Number)
+{
+	return *this = *this * Number;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction>& KLFixedPoint<Raw, Wide, Fraction>::operator/= (const KLFixedPoint& Number)
+{
+	return *this = *this / Number;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+bool KLFixedPoint<Raw, Wide, Fraction>::operator== (const KLFixedPoint& Number) const
+{
+	return Value == Number.Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+bool KLFixedPoint<Raw, Wide, Fraction>::operator!= (const KLFixedPoint& Number) const
+{
+	return Value != Number.Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+bool KLFixedPoint<Raw, Wide, Fraction>::operator< (const KLFixedPoint& Number) const
+{
+	return Value < Number.Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+bool KLFixedPoint<Raw, Wide, Fraction>::operator> (const KLFixedPoint& Number) const
+{
+	return Value > Number.Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+bool KLFixedPoint<Raw, Wide, Fraction>::operator<= (const KLFixedPoint& Number) const
+{
+	return Value <= Number.Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+bool KLFixedPoint<Raw, Wide, Fraction>::operator>= (const KLFixedPoint& Number) const
+{
+	return Value >= Number.Value;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> fabs(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Abs();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> sqrt(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Sqrt();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> sin(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Sin();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> cos(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Cos();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> tan(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Tan();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> exp(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Exp();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> log(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Ln();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> log10(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Log10();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> round(const KLFixedPoint<Raw, Wide, Fraction>& Number)
+{
+	return Number.Round();
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> pow(const KLFixedPoint<Raw, Wide, Fraction>& Base, const KLFixedPoint<Raw, Wide, Fraction>& Exponent)
+{
+	return Base.Pow(Exponent);
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> fmin(const KLFixedPoint<Raw, Wide, Fraction>& A, const KLFixedPoint<Raw, Wide, Fraction>& B)
+{
+	return B < A ? B : A;
+}
+
+template<typename Raw, typename Wide, int Fraction>
+KLFixedPoint<Raw, Wide, Fraction> fmax(const KLFixedPoint<Raw, Wide, Fraction>& A, const KLFixedPoint<Raw, Wide, Fraction>& B)
+{
+	return A < B ? B : A;
+}
+
+#endif // KLFIXED_CPP
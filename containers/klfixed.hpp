@@ -0,0 +1,283 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Fixed Point interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLFIXED_HPP
+#define KLFIXED_HPP
+
+#include "../libbuild.hpp"
+
+#include <stdint.h>
+
+/*! \file		klfixed.hpp
+ *  \brief	Deklaracje dla klasy KLFixedPoint i jej składników.
+ *
+ */
+
+/*! \file		klfixed.cpp
+ *  \brief	Implementacja klasy KLFixedPoint i jej składników.
+ *
+ */
+
+/*! \brief	Liczba stałoprzecinkowa.
+ *  \tparam	Raw		Typ całkowity przechowujący liczbę.
+ *  \tparam	Wide		Typ całkowity o co najmniej dwukrotnie większej szerokości, używany w obliczeniach pośrednich.
+ *  \tparam	Fraction	Liczba bitów części ułamkowej.
+ *
+ * Zastępuje typ `double` na platformach bez jednostki zmiennoprzecinkowej (AVR, mniejsze rdzenie ARM). Wszystkie działania wykonywane są na liczbach całkowitych, a ich wynik jest nasycany do zakresu typu zamiast się przepełniać. Funkcje trygonometryczne, wykładnicze i logarytmiczne korzystają z tablic z interpolacją liniową, a pierwiastek obliczany jest metodą bitową.
+ *
+ * Tablice zajmują około 2 kB; na platformie AVR umieszczane są w pamięci programu.
+ *
+ * Dodawanie, mnożenie, dzielenie i pierwiastek są dokładne z zaokrągleniem do `2^-Fraction`. Dokładność funkcji tablicowych nie zależy od formatu: błąd sinusa, kosinusa i logarytmów nie przekracza `1.5 * 2^-16`, a funkcji `exp` i `pow` (dla wyników większych od 1 względnie) odpowiednio `1.5 * 2^-16` i `4.5 * 2^-16`. Ograniczenia te sprawdza program `tools/klfixedbench`.
+ *
+ * Liczba stałoprzecinkowa nie posiada wartości `nan` ani `inf`: działania niezdefiniowane (np. pierwiastek z liczby ujemnej) zwracają `0`, a dzielenie przez zero i logarytm z zera zwracają skrajną wartość zakresu.
+ *
+ * Do funkcji z nagłówka `math.h` dołączone są przeciążenia dla tego typu, dzięki czemu kod napisany dla typu `double` może działać także na liczbach stałoprzecinkowych.
+ *
+ */
+template<typename Raw, typename Wide, int Fraction>
+class KLFixedPoint
+{
+
+	static_assert(Fraction > 0 && Fraction < int(sizeof(Raw) * 8) - 1, "KLFixedPoint requires integer bits");
+	static_assert(sizeof(Wide) >= 2 * sizeof(Raw), "KLFixedPoint requires twice wider intermediate type");
+
+	protected:
+
+		static const int32_t SinTable[257];	//!< Ćwiartka sinusa w formacie Q30.
+		static const int32_t LogTable[129];	//!< Wartości `log2(1 + x)` w formacie Q30.
+		static const int32_t ExpTable[129];	//!< Wartości `2^x - 1` w formacie Q30.
+
+		Raw Value;	//!< Wartość przemnożona przez `2^Fraction`.
+
+		/*! \brief		Nasycenie wyniku.
+		 *  \param [in]	Number Wynik w formacie wewnętrznym.
+		 *  \return		Liczba ograniczona do zakresu typu.
+		 *
+		 * Ogranicza wynik obliczeń pośrednich do zakresu typu `Raw`.
+		 *
+		 */
+		static KLFixedPoint Saturate(Wide Number);
+
+		/*! \brief		Odczyt tablicy.
+		 *  \param [in]	Table	Tablica wartości w formacie Q30.
+		 *  \param [in]	Position	Położenie w zakresie `[0, 1]` w formacie Q30.
+		 *  \param [in]	Bits		Logarytm liczby przedziałów tablicy.
+		 *  \return		Wartość interpolowana liniowo w formacie Q30.
+		 *
+		 * Odczytuje wartość tablicy interpolując pomiędzy sąsiednimi punktami.
+		 *
+		 */
+		static int32_t Interpolate(const int32_t* Table, uint32_t Position, int Bits);
+
+		/*! \brief		Konwersja z formatu Q30.
+		 *  \param [in]	Number Liczba w formacie Q30.
+		 *  \return		Liczba w formacie wewnętrznym (bez nasycenia).
+		 *
+		 * Przelicza liczbę z formatu tablic na format `Fraction` z zaokrągleniem.
+		 *
+		 */
+		static Wide FromQ30(Wide Number);
+
+		/*! \brief		Faza kąta.
+		 *  \param [in]	Angle Kąt w radianach (wartość wewnętrzna).
+		 *  \return		Faza jako część pełnego obrotu (`2^32` odpowiada `2pi`).
+		 *
+		 * Mnoży kąt przez `1 / 2pi` z dodatkową precyzją; redukcja do jednego obrotu wynika z przepełnienia 32-bitowej fazy.
+		 *
+		 */
+		static uint32_t Phase(Raw Angle);
+
+		/*! \brief		Mnożenie przez stałą.
+		 *  \param [in]	Number Wartość wewnętrzna.
+		 *  \param [in]	Factor Stała (zamieniana na format Q30 podczas kompilacji).
+		 *  \return		Iloczyn w formacie wewnętrznym (bez nasycenia).
+		 *
+		 * Mnoży liczbę przez stałą z większą precyzją niż zapewnia format `Fraction`.
+		 *
+		 */
+		static Wide Scale(Raw Number, double Factor);
+
+		/*! \brief		Sinus fazy.
+		 *  \param [in]	Phase Faza jako część pełnego obrotu (`2^32` odpowiada `2pi`).
+		 *  \return		Sinus kąta.
+		 *
+		 * Oblicza sinus na podstawie ćwiartki zapisanej w tablicy.
+		 *
+		 */
+		static KLFixedPoint SinPhase(uint32_t Phase);
+
+	public:
+
+		static constexpr Raw ONE = Raw(1) << Fraction;					//!< Wartość wewnętrzna liczby `1`.
+		static constexpr Raw MAX = Raw(~0ull >> (65 - sizeof(Raw) * 8));	//!< Największa wartość wewnętrzna.
+		static constexpr Raw MIN = -MAX - 1;							//!< Najmniejsza wartość wewnętrzna.
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Nie inicjuje wartości, dzięki czemu typ może być składnikiem unii.
+		 *
+		 */
+		KLFixedPoint(void) = default;
+
+		/*! \brief		Konstruktor konwertujący z `int`.
+		 *  \param [in]	Number Liczba całkowita.
+		 *
+		 * Tworzy liczbę stałoprzecinkową o podanej wartości (z nasyceniem).
+		 *
+		 */
+		KLFixedPoint(int Number);
+
+		/*! \brief		Konstruktor konwertujący z `double`.
+		 *  \param [in]	Number Liczba zmiennoprzecinkowa.
+		 *
+		 * Tworzy najbliższą liczbę stałoprzecinkową (z nasyceniem). Wartość `nan` zamieniana jest na `0`.
+		 *
+		 */
+		KLFixedPoint(double Number);
+
+		/*! \brief		Utworzenie z wartości wewnętrznej.
+		 *  \param [in]	Number Wartość przemnożona przez `2^Fraction`.
+		 *  \return		Liczba stałoprzecinkowa.
+		 *
+		 * Tworzy liczbę bezpośrednio z jej reprezentacji.
+		 *
+		 */
+		static KLFixedPoint FromRaw(Raw Number);
+
+		/*! \brief		Odczyt liczby.
+		 *  \param [in]	Begin	Początek tekstu.
+		 *  \param [in]	End		Koniec tekstu.
+		 *  \param [out]	Value	Odczytana liczba.
+		 *  \return		Wskaźnik za ostatnim odczytanym znakiem lub `Begin` gdy tekst nie zaczyna się od liczby.
+		 *
+		 * Odczytuje liczbę dziesiętną (z opcjonalnym znakiem i częścią ułamkową) bez użycia arytmetyki zmiennoprzecinkowej. Uwzględniane jest do 9 cyfr części ułamkowej.
+		 *
+		 */
+		static const char* Parse(const char* Begin, const char* End, KLFixedPoint& Value);
+
+		/*! \brief		Wartość wewnętrzna.
+		 *  \return		Wartość przemnożona przez `2^Fraction`.
+		 *
+		 * Zwraca reprezentację liczby.
+		 *
+		 */
+		Raw ToRaw(void) const;
+
+		/*! \brief		Konwersja na liczbę całkowitą.
+		 *  \return		Część całkowita liczby (zaokrąglenie w stronę zera).
+		 *
+		 * Odpowiada konwersji `int(double)`.
+		 *
+		 */
+		int ToInt(void) const;
+
+		/*! \brief		Konwersja na liczbę zmiennoprzecinkową.
+		 *  \return		Wartość liczby.
+		 *
+		 * Zwraca wartość jako `double`.
+		 *
+		 */
+		double ToNumber(void) const;
+
+		/*! \brief		Zaokrąglenie.
+		 *  \param [in]	Digits Liczba cyfr po przecinku (ujemna zaokrągla do dziesiątek, setek itd.).
+		 *  \return		Zaokrąglona liczba.
+		 *
+		 * Zaokrągla liczbę do podanej pozycji dziesiętnej (połówki od zera) bez użycia funkcji `pow`.
+		 *
+		 */
+		KLFixedPoint Round(int Digits = 0) const;
+
+		KLFixedPoint Abs(void) const;		//!< Wartość bezwzględna.
+		KLFixedPoint Sqrt(void) const;		//!< Pierwiastek kwadratowy.
+		KLFixedPoint Sin(void) const;		//!< Sinus.
+		KLFixedPoint Cos(void) const;		//!< Cosinus.
+		KLFixedPoint Tan(void) const;		//!< Tangens.
+		KLFixedPoint Exp2(void) const;		//!< Liczba `2` do potęgi.
+		KLFixedPoint Exp(void) const;		//!< Liczba `e` do potęgi.
+		KLFixedPoint Log2(void) const;		//!< Logarytm dwójkowy.
+		KLFixedPoint Log10(void) const;		//!< Logarytm dziesiętny.
+		KLFixedPoint Ln(void) const;		//!< Logarytm naturalny.
+
+		/*! \brief		Potęgowanie.
+		 *  \param [in]	Exponent Wykładnik.
+		 *  \return		Liczba podniesiona do potęgi.
+		 *
+		 * Wykładniki całkowite obliczane są przez wielokrotne mnożenie, pozostałe jako `2^(Exponent * log2(x))`.
+		 *
+		 */
+		KLFixedPoint Pow(const KLFixedPoint& Exponent) const;
+
+		explicit operator bool (void) const;
+		explicit operator int (void) const;
+		explicit operator double (void) const;
+
+		KLFixedPoint operator- (void) const;
+
+		KLFixedPoint operator+ (const KLFixedPoint& Number) const;
+		KLFixedPoint operator- (const KLFixedPoint& Number) const;
+		KLFixedPoint operator* (const KLFixedPoint& Number) const;
+		KLFixedPoint operator/ (const KLFixedPoint& Number) const;
+
+		KLFixedPoint& operator+= (const KLFixedPoint& Number);
+		KLFixedPoint& operator-= (const KLFixedPoint& Number);
+		KLFixedPoint& operator*= (const KLFixedPoint& Number);
+		KLFixedPoint& operator/= (const KLFixedPoint& Number);
+
+		bool operator== (const KLFixedPoint& Number) const;
+		bool operator!= (const KLFixedPoint& Number) const;
+		bool operator< (const KLFixedPoint& Number) const;
+		bool operator> (const KLFixedPoint& Number) const;
+		bool operator<= (const KLFixedPoint& Number) const;
+		bool operator>= (const KLFixedPoint& Number) const;
+
+};
+
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> fabs(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> sqrt(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> sin(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> cos(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> tan(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> exp(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> log(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> log10(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> round(const KLFixedPoint<Raw, Wide, Fraction>& Number);
+
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> pow(const KLFixedPoint<Raw, Wide, Fraction>& Base, const KLFixedPoint<Raw, Wide, Fraction>& Exponent);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> fmin(const KLFixedPoint<Raw, Wide, Fraction>& A, const KLFixedPoint<Raw, Wide, Fraction>& B);
+template<typename Raw, typename Wide, int Fraction> KLFixedPoint<Raw, Wide, Fraction> fmax(const KLFixedPoint<Raw, Wide, Fraction>& A, const KLFixedPoint<Raw, Wide, Fraction>& B);
+
+#if defined(KLFIXED_WIDE)
+
+#if !defined(__SIZEOF_INT128__)
+#error "KLFIXED_WIDE requires 128-bit integer support"
+#endif
+
+using KLFixed = KLFixedPoint<int64_t, __int128, 32>;	//!< Liczba w formacie Q32.32.
+
+#else
+
+using KLFixed = KLFixedPoint<int32_t, int64_t, 16>;	//!< Liczba w formacie Q16.16.
+
+#endif
+
+#include "klfixed.cpp"
+
+#endif // KLFIXED_HPP
@@ -0,0 +1,531 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Flat Tree interpretation for KLLibs                        *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLFLATTREE_CPP
+#define KLFLATTREE_CPP
+
+#include "klflattree.hpp"
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTreeStorage::KLFlatTreeStorage(void)
+: Nodes(nullptr), Blocks(nullptr), Capacity(0), Used(0), Free(NONE) {}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTreeStorage::~KLFlatTreeStorage(void)
+{
+	for (uint32_t i = 0; i < Capacity / BLOCK; ++i) ::operator delete(Blocks[i]);
+
+	delete [] Blocks;
+	delete [] Nodes;
+}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTreeVarIterator::KLFlatTreeVarIterator(KLFlatTreeStorage* Tree, uint32_t Begin)
+: Storage(Tree), Current(Begin) {}
+
+template<typename Data>
+Data& KLFlatTree<Data>::KLFlatTreeVarIterator::operator* (void)
+{
+	return *Record(Storage, Current);
+}
+
+template<typename Data>
+typename KLFlatTree<Data>::KLFlatTreeVarIterator& KLFlatTree<Data>::KLFlatTreeVarIterator::operator++ (void)
+{
+	Current = Storage->Nodes[Current].NextSibling;
+
+	return *this;
+}
+
+template<typename Data>
+bool KLFlatTree<Data>::KLFlatTreeVarIterator::operator!= (const KLFlatTreeVarIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTreeConstIterator::KLFlatTreeConstIterator(const KLFlatTreeStorage* Tree, uint32_t Begin)
+: Storage(Tree), Current(Begin) {}
+
+template<typename Data>
+const Data& KLFlatTree<Data>::KLFlatTreeConstIterator::operator* (void) const
+{
+	return *Record(Storage, Current);
+}
+
+template<typename Data>
+typename KLFlatTree<Data>::KLFlatTreeConstIterator& KLFlatTree<Data>::KLFlatTreeConstIterator::operator++ (void)
+{
+	Current = Storage->Nodes[Current].NextSibling;
+
+	return *this;
+}
+
+template<typename Data>
+bool KLFlatTree<Data>::KLFlatTreeConstIterator::operator!= (const KLFlatTreeConstIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTree(KLFlatTreeStorage* Tree, uint32_t Branch)
+: Storage(Tree), Root(Branch), Current(Branch), Owner(false) {}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTree(const KLFlatTree<Data>& Tree)
+: KLFlatTree()
+{
+	Insert(Tree);
+}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTree(KLFlatTree<Data>&& Tree)
+: Storage(Tree.Storage), Root(Tree.Root), Current(Tree.Current), Owner(Tree.Owner)
+{
+	Tree.Storage = nullptr;
+	Tree.Owner = false;
+}
+
+template<typename Data>
+KLFlatTree<Data>::KLFlatTree(void)
+: Storage(new KLFlatTreeStorage), Root(0), Current(0), Owner(true)
+{
+	Reserve(0);
+
+	Storage->Nodes[0] = { NONE, NONE, NONE, NONE, 0 };
+	Storage->Used = 1;
+}
+
+template<typename Data>
+KLFlatTree<Data>::~KLFlatTree(void)
+{
+	if (Owner)
+	{
+		Clean();
+
+		delete Storage;
+	}
+}
+
+template<typename Data>
+Data* KLFlatTree<Data>::Record(const KLFlatTreeStorage* Tree, uint32_t Node)
+{
+	return Tree->Blocks[Node / BLOCK] + Node % BLOCK;
+}
+
+template<typename Data>
+uint32_t KLFlatTree<Data>::Allocate(const Data& Item, uint32_t Branch)
+{
+	uint32_t Node;
+
+	if (Storage->Free != NONE)
+	{
+		Node = Storage->Free;
+		Storage->Free = Storage->Nodes[Node].NextSibling;
+	}
+	else
+	{
+		if (Storage->Used == Storage->Capacity) Reserve(Storage->Capacity * 2);
+
+		Node = Storage->Used++;
+	}
+
+	new (Record(Storage, Node)) Data(Item);
+
+	KLFlatTreeNode* Nodes = Storage->Nodes;
+
+	Nodes[Node] = { Branch, NONE, NONE, NONE, 0 };
+
+	if (Nodes[Branch].LastChild == NONE)
+		Nodes[Branch].FirstChild = Node;
+	else
+		Nodes[Nodes[Branch].LastChild].NextSibling = Node;
+
+	Nodes[Branch].LastChild = Node;
+	Nodes[Branch].Count += 1;
+
+	return Node;
+}
+
+template<typename Data>
+void KLFlatTree<Data>::Delete(uint32_t Branch)
+{
+	KLFlatTreeNode* Nodes = Storage->Nodes;
+
+	uint32_t Node = Branch;
+
+	while (true)
+	{
+		if (Nodes[Node].FirstChild != NONE)
+		{
+			Node = Nodes[Node].FirstChild;
+		}
+		else if (Node == Branch)
+		{
+			break;
+		}
+		else
+		{
+			const uint32_t Parent = Nodes[Node].Parent;
+
+			Nodes[Parent].FirstChild = Nodes[Node].NextSibling;
+
+			Release(Node);
+
+			Node = Parent;
+		}
+	}
+
+	Nodes[Branch].LastChild = NONE;
+	Nodes[Branch].Count = 0;
+}
+
+template<typename Data>
+void KLFlatTree<Data>::Release(uint32_t Node)
+{
+	Record(Storage, Node)->~Data();
+
+	Storage->Nodes[Node].Parent = NONE;
+	Storage->Nodes[Node].NextSibling = Storage->Free;
+
+	Storage->Free = Node;
+}
+
+template<typename Data>
+uint32_t KLFlatTree<Data>::Child(int ID) const
+{
+	if (ID < 0) return NONE;
+
+	uint32_t Node = Storage->Nodes[Current].FirstChild;
+
+	for (int i = 0; i < ID; i++)
+	{
+		if (Node != NONE)
+			Node = Storage->Nodes[Node].NextSibling;
+		else
+			return NONE;
+	}
+
+	return Node;
+}
+
+template<typename Data>
+int KLFlatTree<Data>::Insert(const Data& Item)
+{
+	Allocate(Item, Current);
+
+	return Storage->Nodes[Current].Count;
+}
+
+template<typename Data>
+int KLFlatTree<Data>::Insert(const KLFlatTree<Data>& Tree)
+{
+	if (Tree.Storage == Storage) return Insert(KLFlatTree<Data>(Tree));
+
+	const KLFlatTreeStorage* Source = Tree.Storage;
+
+	uint32_t From = Source->Nodes[Tree.Root].FirstChild;
+	uint32_t To = Current;
+
+	while (From != NONE)
+	{
+		const uint32_t Node = Allocate(*Record(Source, From), To);
+
+		if (Source->Nodes[From].FirstChild != NONE)
+		{
+			From = Source->Nodes[From].FirstChild;
+			To = Node;
+		}
+		else
+		{
+			while (Source->Nodes[From].NextSibling == NONE)
+			{
+				From = Source->Nodes[From].Parent;
+
+				if (From == Tree.Root) return Size();
+
+				To = Storage->Nodes[To].Parent;
+			}
+
+			From = Source->Nodes[From].NextSibling;
+		}
+	}
+
+	return Size();
+}
+
+template<typename Data>
+bool KLFlatTree<Data>::Delete(int ID)
+{
+	if (ID < 0) return false;
+
+	KLFlatTreeNode* Nodes = Storage->Nodes;
+
+	uint32_t Node = Nodes[Current].FirstChild;
+	uint32_t Prev = NONE;
+
+	for (int i = 0; i < ID; i++)
+	{
+		if (Node != NONE)
+		{
+			Prev = Node;
+			Node = Nodes[Node].NextSibling;
+		}
+		else
+			return false;
+	}
+
+	if (Node == NONE) return false;
+
+	if (Prev == NONE)
+		Nodes[Current].FirstChild = Nodes[Node].NextSibling;
+	else
+		Nodes[Prev].NextSibling = Nodes[Node].NextSibling;
+
+	if (Nodes[Current].LastChild == Node) Nodes[Current].LastChild = Prev;
+
+	Nodes[Current].Count -= 1;
+
+	Delete(Node);
+	Release(Node);
+
+	return true;
+}
+
+template<typename Data>
+bool KLFlatTree<Data>::Select(int ID)
+{
+	switch (ID)
+	{
+		case ROOT:
+				Current = Root;
+		break;
+		case PREV:
+			if (Current != Root)
+				Current = Storage->Nodes[Current].Parent;
+			else
+				return false;
+		break;
+		default:
+			const uint32_t Node = Child(ID);
+
+			if (Node != NONE)
+				Current = Node;
+			else
+				return false;
+	}
+
+	return true;
+}
+
+template<typename Data>
+int KLFlatTree<Data>::Size(void) const
+{
+	return Storage->Nodes[Current].Count;
+}
+
+template<typename Data>
+int KLFlatTree<Data>::Deep(void) const
+{
+	uint32_t Node = Current;
+
+	int Count = 0;
+
+	while (Node != Root)
+	{
+		Node = Storage->Nodes[Node].Parent;
+
+		Count++;
+	}
+
+	return Count;
+}
+
+template<typename Data>
+void KLFlatTree<Data>::Reserve(int Count)
+{
+	const uint32_t Blocks = (uint32_t(Count) + BLOCK) / BLOCK;
+	const uint32_t Last = Storage->Capacity / BLOCK;
+
+	if (Blocks <= Last) return;
+
+	KLFlatTreeNode* Nodes = new KLFlatTreeNode[Blocks * BLOCK];
+	Data** Records = new Data*[Blocks];
+
+	if (Storage->Used) memcpy(Nodes, Storage->Nodes, Storage->Used * sizeof(KLFlatTreeNode));
+	if (Last) memcpy(Records, Storage->Blocks, Last * sizeof(Data*));
+
+	for (uint32_t i = Last; i < Blocks; ++i)
+	{
+		Records[i] = static_cast<Data*>(::operator new(BLOCK * sizeof(Data)));
+	}
+
+	delete [] Storage->Nodes;
+	delete [] Storage->Blocks;
+
+	Storage->Nodes = Nodes;
+	Storage->Blocks = Records;
+	Storage->Capacity = Blocks * BLOCK;
+}
+
+template<typename Data>
+KLFlatTree<Data> KLFlatTree<Data>::Branch(int ID)
+{
+	switch (ID)
+	{
+		case ROOT:
+			return KLFlatTree(Storage, Root);
+		break;
+		case PREV:
+			if (Current != Root) return KLFlatTree(Storage, Storage->Nodes[Current].Parent);
+		break;
+		case CURRENT:
+			return KLFlatTree(Storage, Current);
+		default:
+			const uint32_t Node = Child(ID);
+
+			if (Node != NONE) return KLFlatTree(Storage, Node);
+	}
+
+	return KLFlatTree();
+}
+
+template<typename Data>
+const KLFlatTree<Data> KLFlatTree<Data>::Branch(int ID) const
+{
+	switch (ID)
+	{
+		case ROOT:
+			return KLFlatTree(Storage, Root);
+		break;
+		case PREV:
+			if (Current != Root) return KLFlatTree(Storage, Storage->Nodes[Current].Parent);
+		break;
+		case CURRENT:
+			return KLFlatTree(Storage, Current);
+		default:
+			const uint32_t Node = Child(ID);
+
+			if (Node != NONE) return KLFlatTree(Storage, Node);
+	}
+
+	return KLFlatTree();
+}
+
+template<typename Data>
+void KLFlatTree<Data>::Clean(void)
+{
+	Delete(Root);
+
+	Current = Root;
+}
+
+template<typename Data>
+typename KLFlatTree<Data>::KLFlatTreeVarIterator KLFlatTree<Data>::begin(void)
+{
+	return KLFlatTreeVarIterator(Storage, Storage->Nodes[Current].FirstChild);
+}
+
+template<typename Data>
+typename KLFlatTree<Data>::KLFlatTreeVarIterator KLFlatTree<Data>::end(void)
+{
+	return KLFlatTreeVarIterator(Storage, NONE);
+}
+
+template<typename Data>
+typename KLFlatTree<Data>::KLFlatTreeConstIterator KLFlatTree<Data>::begin(void) const
+{
+	return KLFlatTreeConstIterator(Storage, Storage->Nodes[Current].FirstChild);
+}
+
+template<typename Data>
+typename KLFlatTree<Data>::KLFlatTreeConstIterator KLFlatTree<Data>::end(void) const
+{
+	return KLFlatTreeConstIterator(Storage, NONE);
+}
+
+template<typename Data>
+Data& KLFlatTree<Data>::operator[] (int ID)
+{
+	const uint32_t Node = Child(ID);
+
+	if (Node != NONE)
+		return *Record(Storage, Node);
+	else
+		return *((Data*) nullptr);
+}
+
+template<typename Data>
+const Data& KLFlatTree<Data>::operator[] (int ID) const
+{
+	const uint32_t Node = Child(ID);
+
+	if (Node != NONE)
+		return *Record(Storage, Node);
+	else
+		return *((Data*) nullptr);
+}
+
+template<typename Data>
+KLFlatTree<Data>& KLFlatTree<Data>::operator= (const KLFlatTree<Data>& Tree)
+{
+	if (this == &Tree) return *this;
+
+	if (Tree.Storage == Storage) return *this = KLFlatTree<Data>(Tree);
+
+	Clean();
+
+	Insert(Tree);
+
+	return *this;
+}
+
+template<typename Data>
+KLFlatTree<Data>& KLFlatTree<Data>::operator= (KLFlatTree<Data>&& Tree)
+{
+	if (this == &Tree) return *this;
+
+	if (!Owner || !Tree.Owner) return *this = static_cast<const KLFlatTree<Data>&>(Tree);
+
+	Clean();
+
+	delete Storage;
+
+	Storage = Tree.Storage;
+	Root = Tree.Root;
+	Current = Tree.Current;
+	Owner = Tree.Owner;
+
+	Tree.Storage = nullptr;
+	Tree.Owner = false;
+
+	return *this;
+}
+
+template<typename Data>
+template<typename ...Steps>
+void KLFlatTree<Data>::Select(int ID, Steps... IDS)
+{
+	Select(ID);
+
+	Select(IDS...);
+}
+
+#endif // KLFLATTREE_CPP
@@ -0,0 +1,379 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Flat Tree interpretation for KLLibs                        *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLFLATTREE_HPP
+#define KLFLATTREE_HPP
+
+#include "../libbuild.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include <new>
+
+/*! \file		klflattree.hpp
+ *  \brief	Deklaracje dla klasy KLFlatTree i jej składników.
+ *
+ */
+
+/*! \file		klflattree.cpp
+ *  \brief	Implementacja klasy KLFlatTree i jej składników.
+ *
+ */
+
+/*! \brief	Spłaszczona interpretacja drzewa.
+ *  \tparam	Data Typ przechowywanych danych.
+ *  \note		Do użycia wymagany jest konstruktor kopiujący dla danych.
+ *
+ * Drzewo o interfejsie zgodnym z `KLTree`, w którym struktura przechowywana jest w ciągłej tablicy węzłów. Węzły odwołują się do siebie 32-bitowymi indeksami (rodzic, pierwsze i ostatnie dziecko, kolejne rodzeństwo) i pamiętają liczbę swoich dzieci, więc `Insert` i `Size` działają w czasie stałym.
+ *
+ * Dane przechowywane są w blokach o stałej wielkości, dzięki czemu referencje do elementów pozostają ważne po dodaniu kolejnych węzłów. Zwolnione węzły trafiają na listę wolnych pozycji i są używane ponownie.
+ *
+ */
+template<typename Data>
+class KLFlatTree
+{
+
+	/*! \brief		Struktura węzła drzewa.
+	 *
+	 * Przechowuje indeksy powiązanych węzłów i liczbę dzieci.
+	 *
+	 */
+	protected: struct KLFlatTreeNode
+	{
+
+		uint32_t Parent;		//!< Indeks rodzica.
+		uint32_t FirstChild;	//!< Indeks pierwszego dziecka.
+		uint32_t LastChild;		//!< Indeks ostatniego dziecka.
+		uint32_t NextSibling;	//!< Indeks kolejnego rodzeństwa lub kolejnej wolnej pozycji.
+		uint32_t Count;		//!< Liczba dzieci.
+
+	};
+
+	/*! \brief		Struktura pamięci drzewa.
+	 *
+	 * Wspólna dla drzewa i wszystkich utworzonych z niego gałęzi.
+	 *
+	 */
+	protected: struct KLFlatTreeStorage
+	{
+
+		KLFlatTreeNode* Nodes;	//!< Tablica węzłów.
+		Data** Blocks;			//!< Tablica bloków danych.
+
+		uint32_t Capacity;		//!< Liczba przydzielonych węzłów.
+		uint32_t Used;			//!< Liczba użytych pozycji tablicy węzłów.
+		uint32_t Free;			//!< Początek listy wolnych węzłów.
+
+		KLFlatTreeStorage(void);
+
+		~KLFlatTreeStorage(void);
+
+	};
+
+	/*! \brief		Wyliczenie specjalnych węzłów.
+	 *
+	 * Jednoznacznie określa specjalne indeksy dla wybranych węzłów.
+	 *
+	 */
+	public: enum NOODES : int
+	{
+		ROOT = -1,	//!< Węzeł główny.
+		PREV = -2,	//!< Poprzedni węzeł.
+		CURRENT = -3	//!< Obecny węzeł.
+	};
+
+	protected: enum : uint32_t
+	{
+		NONE = 0xFFFFFFFF,	//!< Brak węzła.
+		BLOCK = 64		//!< Liczba rekordów w bloku danych.
+	};
+
+	public: class KLFlatTreeVarIterator
+	{
+
+		protected:
+
+			KLFlatTreeStorage* Storage;
+
+			uint32_t Current;
+
+		public:
+
+			KLFlatTreeVarIterator(KLFlatTreeStorage* Tree, uint32_t Begin);
+
+			Data& operator* (void);
+			KLFlatTreeVarIterator& operator++ (void);
+			bool operator!= (const KLFlatTreeVarIterator& Iterator) const;
+
+	};
+
+	public: class KLFlatTreeConstIterator
+	{
+
+		protected:
+
+			const KLFlatTreeStorage* Storage;
+
+			uint32_t Current;
+
+		public:
+
+			KLFlatTreeConstIterator(const KLFlatTreeStorage* Tree, uint32_t Begin);
+
+			const Data& operator* (void) const;
+			KLFlatTreeConstIterator& operator++ (void);
+			bool operator!= (const KLFlatTreeConstIterator& Iterator) const;
+
+	};
+
+	protected:
+
+		KLFlatTreeStorage* Storage;	//!< Wskaźnik na pamięć drzewa.
+
+		uint32_t Root;		//!< Indeks głównego węzła.
+
+		uint32_t Current;	//!< Indeks obecnego węzła.
+
+		bool Owner;		//!< Określa czy obiekt jest właścicielem pamięci.
+
+		/*! \brief		Specjalny konstruktor.
+		 *  \param [in]	Tree		Pamięć drzewa bazowego.
+		 *  \param [in]	Branch	Gałąź główna.
+		 *
+		 * Tworzy tymczasowy obiekt będący ograniczeniem bazowego obiektu.
+		 *
+		 */
+		KLFlatTree(KLFlatTreeStorage* Tree, uint32_t Branch);
+
+		/*! \brief		Rekord węzła.
+		 *  \param [in]	Tree	Pamięć drzewa.
+		 *  \param [in]	Node	Indeks węzła.
+		 *  \return		Wskaźnik na miejsce rekordu w bloku danych.
+		 *
+		 * Zwraca adres rekordu przypisanego do węzła.
+		 *
+		 */
+		static Data* Record(const KLFlatTreeStorage* Tree, uint32_t Node);
+
+		/*! \brief		Przydział węzła.
+		 *  \param [in]	Item	Dane węzła.
+		 *  \param [in]	Branch	Indeks rodzica.
+		 *  \return		Indeks nowego węzła.
+		 *
+		 * Pobiera węzeł z listy wolnych pozycji lub powiększa tablicę węzłów i dołącza go na koniec dzieci rodzica.
+		 *
+		 */
+		uint32_t Allocate(const Data& Item, uint32_t Branch);
+
+		/*! \brief		Usuwa gałąź.
+		 *  \param [in]	Branch Indeks gałęzi do usunięcia.
+		 *
+		 * Iteracyjnie usuwa wszystkie dzieci podanego węzła i zwalnia ich pozycje.
+		 *
+		 */
+		void Delete(uint32_t Branch);
+
+		/*! \brief		Zwolnienie węzła.
+		 *  \param [in]	Node Indeks węzła.
+		 *
+		 * Niszczy rekord węzła i dodaje jego pozycję do listy wolnych węzłów.
+		 *
+		 */
+		void Release(uint32_t Node);
+
+		/*! \brief		Wyszukanie dziecka.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Indeks węzła lub `NONE`.
+		 *
+		 * Wyszukuje dziecko bieżącej gałęzi o podanym numerze.
+		 *
+		 */
+		uint32_t Child(int ID) const;
+
+	public:
+
+		/*! \brief		Konstruktor kopiujący.
+		 *  \param [in]	Tree Drzewo do skopiowania.
+		 *
+		 * Kopiuje całą strukturę drzewa.
+		 *
+		 */
+		KLFlatTree(const KLFlatTree<Data>& Tree);
+
+		/*! \brief		Konstruktor przenoszący.
+		 *  \param [in]	Tree Drzewo do przeniesienia.
+		 *
+		 * Przenosi tymczasowy obiekt do bierzącego.
+		 *
+		 */
+		KLFlatTree(KLFlatTree<Data>&& Tree);
+
+		/*! \brief		Domyślny konstruktor.
+		 *
+		 * Inicjuje wszystkie pola obiektu.
+		 *
+		 */
+		KLFlatTree(void);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Automatycznie usuwa przechowywane dane. Nie niszczy obiektu jeśli jest on gałęzią innego.
+		 *
+		 */
+		~KLFlatTree(void);
+
+		/*! \brief		Wstawianie elementu.
+		 *  \param [in]	Item Element dodawany do drzewa.
+		 *  \return		Aktualna liczba elementów.
+		 *
+		 * Dodaje do drzewa kopie podanego elementu i zwraca nową ilość elementów w bieżącym zakresie.
+		 *
+		 */
+		int Insert(const Data& Item);
+
+		/*! \brief		Wstawianie elementu.
+		 *  \param [in]	Tree Drzewo dodawane do drzewa.
+		 *  \return		Aktualna liczba elementów.
+		 *
+		 * Dodaje do drzewa kopie podanego drzewa i zwraca nową ilość elementów w bieżącym zakresie.
+		 *
+		 */
+		int Insert(const KLFlatTree<Data>& Tree);
+
+		/*! \brief		Usunięcie elementu.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Usuwa wybrany element i zwraca stan operacji.
+		 *
+		 */
+		bool Delete(int ID);
+
+		/*! \brief		Wybór gałęzi.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Powodzenie operacji.
+		 *  \see			KLFlatTree::NOODES.
+		 *
+		 * Wybiera podaną gałąź jako roboczą.
+		 *
+		 */
+		bool Select(int ID);
+
+		/*! \brief		Sprawdzenie ilości elementów.
+		 *  \return		Aktualna liczba elementów.
+		 *
+		 * Zwraca zapamiętaną liczbę elementów w bierzącej gałęzi.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Sprawdzenie głębokości.
+		 *  \return		Aktualna głębokość.
+		 *
+		 * Zwraca aktualną głębokość na jakiej znajduję się bierząca gałąź.
+		 *
+		 */
+		int Deep(void) const;
+
+		/*! \brief		Rezerwacja pamięci.
+		 *  \param [in]	Count Oczekiwana liczba węzłów.
+		 *
+		 * Przydziela pamięć dla podanej liczby węzłów, aby uniknąć wielokrotnego powiększania tablicy przy budowie dużych drzew.
+		 *
+		 */
+		void Reserve(int Count);
+
+		/*! \brief		Wybór gałęzi.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Obiekt tymczasowy reprezentujący gałąź.
+		 *  \see			KLFlatTree::NOODES.
+		 *
+		 * Zwraca tymczasowy obiekt będący referencją do wybranej gałęzi.
+		 *
+		 */
+		KLFlatTree<Data> Branch(int ID);
+
+		/*! \brief		Wybór gałęzi.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Obiekt tymczasowy reprezentujący gałąź.
+		 *  \see			KLFlatTree::NOODES.
+		 *
+		 * Zwraca tymczasowy obiekt będący referencją do wybranej gałęzi.
+		 *
+		 */
+		const KLFlatTree<Data> Branch(int ID) const;
+
+		/*! \brief		Czyszczenie drzewa.
+		 *
+		 * Usuwa wszystkie elementy drzewa.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Indeks elementu.
+		 *  \return		Referencja do wybranego elementu.
+		 *  \warning		Gdy element o podanym indeksie nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
+		 *
+		 * Wybiera element o podanym indeksie z drzewa.
+		 *
+		 */
+		Data& operator[] (int ID);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Indeks elementu.
+		 *  \return		Stała referencja do wybranego elementu.
+		 *  \warning		Gdy element o podanym indeksie nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
+		 *
+		 * Wybiera element o podanym indeksie z drzewa.
+		 *
+		 */
+		const Data& operator[] (int ID) const;
+
+		/*! \brief		Operator przypisania.
+		 *  \param [in]	Tree Obiekt do sklonowania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Zwalnia dotychczasowe zasoby i klonuje wybrany obiekt.
+		 *
+		 */
+		KLFlatTree<Data>& operator= (const KLFlatTree<Data>& Tree);
+
+		/*! \brief		Operator przeniesienia.
+		 *  \param [in]	Tree Obiekt do przeniesienia.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Zwalnia dotychczasowe zasoby i przenosi wybrany obiekt.
+		 *
+		 */
+		KLFlatTree<Data>& operator= (KLFlatTree<Data>&& Tree);
+
+		template<typename ...Steps> void Select(int ID, Steps... IDS);
+
+		KLFlatTreeVarIterator begin(void);
+		KLFlatTreeVarIterator end(void);
+
+		KLFlatTreeConstIterator begin(void) const;
+		KLFlatTreeConstIterator end(void) const;
+};
+
+#include "klflattree.cpp"
+
+#endif // KLFLATTREE_HPP
@@ -0,0 +1,183 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Mapped File interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klmappedfile.hpp"
+
+#include <limits.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static const char* Load(const char* Path, int Size)
+{
+	FILE* File = fopen(Path, "rb");
+
+	if (!File) return nullptr;
+
+	char* Buffer = (char*) malloc(Size + 1);
+
+	if (Buffer && fread(Buffer, 1, Size, File) == size_t(Size)) Buffer[Size] = 0;
+	else
+	{
+		free(Buffer);
+
+		Buffer = nullptr;
+	}
+
+	fclose(File);
+
+	return Buffer;
+}
+
+KLMappedFile::KLMappedFile(void)
+: Mapping(nullptr), Length(0), Mapped(false) {}
+
+KLMappedFile::KLMappedFile(const char* Path)
+: KLMappedFile()
+{
+	Open(Path);
+}
+
+KLMappedFile::KLMappedFile(KLMappedFile&& File)
+: Mapping(File.Mapping), Length(File.Length), Mapped(File.Mapped)
+{
+	File.Mapping	= nullptr;
+	File.Length	= 0;
+	File.Mapped	= false;
+}
+
+KLMappedFile::~KLMappedFile(void)
+{
+	Close();
+}
+
+bool KLMappedFile::Open(const char* Path)
+{
+	Close();
+
+	if (!Path) return false;
+
+	long long Bytes = -1;
+
+#if defined(_WIN32)
+	HANDLE File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (File == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER Info;
+	SYSTEM_INFO System;
+
+	GetSystemInfo(&System);
+
+	if (GetFileSizeEx(File, &Info)) Bytes = Info.QuadPart;
+
+	if (Bytes > 0 && Bytes < INT_MAX && Bytes % System.dwPageSize)
+	{
+		HANDLE View = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (View)
+		{
+			Mapping = (const char*) MapViewOfFile(View, FILE_MAP_READ, 0, 0, 0);
+
+			CloseHandle(View);
+		}
+	}
+
+	CloseHandle(File);
+#else
+	const int File = open(Path, O_RDONLY);
+
+	if (File == -1) return false;
+
+	struct stat Info;
+
+	if (!fstat(File, &Info) && S_ISREG(Info.st_mode)) Bytes = Info.st_size;
+
+	if (Bytes > 0 && Bytes < INT_MAX && Bytes % sysconf(_SC_PAGESIZE))
+	{
+		void* View = mmap(nullptr, Bytes, PROT_READ, MAP_PRIVATE, File, 0);
+
+		if (View != MAP_FAILED)
+		{
+#if defined(MADV_SEQUENTIAL)
+			madvise(View, Bytes, MADV_SEQUENTIAL);
+#endif
+			Mapping = (const char*) View;
+		}
+	}
+
+	close(File);
+#endif
+
+	if (Bytes < 0 || Bytes >= INT_MAX) return false;
+
+	Length = int(Bytes);
+
+	if (Mapping) Mapped = true;
+	else if (Length) Mapping = Load(Path, Length);
+	else Mapping = "";
+
+	if (!Mapping) Length = 0;
+
+	return Mapping;
+}
+
+void KLMappedFile::Close(void)
+{
+	if (Mapped)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(Mapping);
+#else
+		munmap((void*) Mapping, Length);
+#endif
+	}
+	else if (Length) free((void*) Mapping);
+
+	Mapping	= nullptr;
+	Length	= 0;
+	Mapped	= false;
+}
+
+bool KLMappedFile::IsOpen(void) const
+{
+	return Mapping;
+}
+
+const char* KLMappedFile::Data(void) const
+{
+	return Mapping;
+}
+
+int KLMappedFile::Size(void) const
+{
+	return Length;
+}
+
+KLString KLMappedFile::String(void) const
+{
+	return KLString::Borrow(Mapping, Length);
+}
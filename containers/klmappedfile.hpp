@@ -0,0 +1,143 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Mapped File interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLMAPPEDFILE_HPP
+#define KLMAPPEDFILE_HPP
+
+#include "../libbuild.hpp"
+
+#include "klstring.hpp"
+
+/*! \file		klmappedfile.hpp
+ *  \brief	Deklaracje dla klasy KLMappedFile i jej składników.
+ *
+ */
+
+/*! \file		klmappedfile.cpp
+ *  \brief	Implementacja klasy KLMappedFile i jej składników.
+ *
+ */
+
+/*! \brief	Plik odwzorowany w pamięci.
+ *
+ * Udostępnia zawartość pliku tylko do odczytu bez kopiowania jej do pamięci programu. Strony pliku są wczytywane przez system dopiero przy pierwszym dostępie, więc koszt otwarcia nawet bardzo dużego pliku nie zależy od jego rozmiaru.
+ *
+ * Dane są zawsze zakończone zerem i mogą być przekazane bezpośrednio do klasy `KLString` (`String()`). Gdy odwzorowanie nie jest możliwe (np. rozmiar pliku jest wielokrotnością rozmiaru strony, a więc brakuje miejsca na kończące zero) plik jest wczytywany do bufora.
+ *
+ * Dostępne jedynie na platformach posiadających system plików (poza platformą AVR).
+ *
+ */
+class KLLIBS_EXPORT KLMappedFile
+{
+
+	protected:
+
+		const char* Mapping;	//!< Wskaźnik na dane pliku.
+
+		int Length;			//!< Rozmiar pliku.
+
+		bool Mapped;			//!< Informacja czy dane są odwzorowane (`true`), czy wczytane do bufora (`false`).
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy obiekt bez otwartego pliku.
+		 *
+		 */
+		KLMappedFile(void);
+
+		/*! \brief		Konstruktor otwierający.
+		 *  \param [in]	Path Ścieżka do pliku.
+		 *
+		 * Tworzy obiekt i otwiera wybrany plik (`Open()`).
+		 *
+		 */
+		KLMappedFile(const char* Path);
+
+		/*! \brief		Konstruktor przenoszący.
+		 *  \param [in]	File Obiekt do przeniesienia.
+		 *
+		 * Przejmuje odwzorowanie podanego obiektu.
+		 *
+		 */
+		KLMappedFile(KLMappedFile&& File);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Zamyka plik (`Close()`).
+		 *
+		 */
+		~KLMappedFile(void);
+
+		KLMappedFile(const KLMappedFile&) = delete;
+		KLMappedFile& operator= (const KLMappedFile&) = delete;
+
+		/*! \brief		Otwarcie pliku.
+		 *  \param [in]	Path Ścieżka do pliku.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zamyka poprzedni plik i odwzorowuje wybrany plik w pamięci. Pusty plik jest otwierany poprawnie i ma zerowy rozmiar.
+		 *
+		 */
+		bool Open(const char* Path);
+
+		/*! \brief		Zamknięcie pliku.
+		 *
+		 * Usuwa odwzorowanie i zwalnia wszystkie użyte zasoby. Łańcuchy uzyskane metodą `String()` przestają być ważne.
+		 *
+		 */
+		void Close(void);
+
+		/*! \brief		Sprawdzenie stanu pliku.
+		 *  \return		`true` jeśli plik jest otwarty.
+		 *
+		 * Sprawdza czy ostatnie otwarcie pliku się powiodło.
+		 *
+		 */
+		bool IsOpen(void) const;
+
+		/*! \brief		Dane pliku.
+		 *  \return		Wskaźnik na zawartość pliku zakończoną zerem.
+		 *
+		 * Zwraca wskaźnik na zawartość pliku lub `nullptr` gdy plik nie jest otwarty.
+		 *
+		 */
+		const char* Data(void) const;
+
+		/*! \brief		Rozmiar pliku.
+		 *  \return		Liczba bajtów w pliku.
+		 *
+		 * Zwraca rozmiar otwartego pliku.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Zawartość pliku jako łańcuch.
+		 *  \return		Łańcuch wskazujący bezpośrednio na dane pliku.
+		 *
+		 * Zwraca łańcuch utworzony metodą `KLString::Borrow()`. Łańcuch nie może być używany po zamknięciu pliku.
+		 *
+		 */
+		KLString String(void) const;
+
+};
+
+#endif // KLMAPPEDFILE_HPP
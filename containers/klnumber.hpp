@@ -0,0 +1,104 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Number Conversion interpretation for KLLibs                *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLNUMBER_HPP
+#define KLNUMBER_HPP
+
+#include "../libbuild.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*! \file		klnumber.hpp
+ *  \brief	Deklaracje dla klasy KLNumber i jej składników.
+ *
+ */
+
+/*! \file		klnumber.cpp
+ *  \brief	Implementacja klasy KLNumber i jej składników.
+ *
+ */
+
+/*! \brief	Konwersje liczb na tekst i tekstu na liczby.
+ *
+ * Zbiór statycznych metod zapisujących i odczytujących liczby bez alokacji pamięci i niezależnie od ustawień regionalnych. Liczby zmiennoprzecinkowe zapisywane są w najkrótszej postaci, która po odczytaniu daje dokładnie tą samą wartość (algorytm Ryu).
+ *
+ * Na platformie AVR używane są funkcje `dtostrf` i `itoa` oraz uproszczony odczyt liczb.
+ *
+ */
+class KLLIBS_EXPORT KLNumber
+{
+
+	public:
+
+		/*! \brief		Rozmiar bufora.
+		 *
+		 * Liczba znaków (wraz z kończącym zerem) wystarczająca do zapisu dowolnej liczby.
+		 *
+		 */
+		static const int BUFFER = 32;
+
+		/*! \brief		Zapis liczby zmiennoprzecinkowej.
+		 *  \param [in]	Value	Liczba do zapisania.
+		 *  \param [out]	Buffer	Bufor o rozmiarze co najmniej `BUFFER`.
+		 *  \return		Liczba zapisanych znaków (bez kończącego zera).
+		 *
+		 * Zapisuje najkrótszą reprezentację liczby. Dla wykładników dziesiętnych z zakresu od -6 do 20 używany jest zapis stałoprzecinkowy, w pozostałych przypadkach zapis naukowy (np. `1e+21`).
+		 *
+		 */
+		static int Format(double Value, char* Buffer);
+
+		/*! \brief		Zapis liczby całkowitej.
+		 *  \param [in]	Value	Liczba do zapisania.
+		 *  \param [out]	Buffer	Bufor o rozmiarze co najmniej `BUFFER`.
+		 *  \return		Liczba zapisanych znaków (bez kończącego zera).
+		 *
+		 * Zapisuje liczbę w systemie dziesiętnym.
+		 *
+		 */
+		static int Format(int Value, char* Buffer);
+
+		/*! \brief		Odczyt liczby zmiennoprzecinkowej.
+		 *  \param [in]	Begin	Początek tekstu.
+		 *  \param [in]	End		Koniec tekstu.
+		 *  \param [out]	Value	Odczytana liczba.
+		 *  \return		Wskaźnik za ostatnim odczytanym znakiem lub `Begin` gdy tekst nie zaczyna się od liczby.
+		 *
+		 * Odczytuje liczbę w zapisie dziesiętnym (z opcjonalnym znakiem, częścią ułamkową i wykładnikiem) oraz wartości `inf` i `nan`. Wynik jest poprawnie zaokrąglony. Nie pomija białych znaków i nie wymaga kończącego zera.
+		 *
+		 */
+		static const char* Parse(const char* Begin, const char* End, double& Value);
+
+		/*! \brief		Odczyt liczby całkowitej.
+		 *  \param [in]	Begin	Początek tekstu.
+		 *  \param [in]	End		Koniec tekstu.
+		 *  \param [out]	Value	Odczytana liczba.
+		 *  \return		Wskaźnik za ostatnim odczytanym znakiem lub `Begin` gdy tekst nie zaczyna się od liczby.
+		 *
+		 * Odczytuje liczbę całkowitą z opcjonalnym znakiem. Wartości spoza zakresu typu `int` są ograniczane do jego granic.
+		 *
+		 */
+		static const char* Parse(const char* Begin, const char* End, int& Value);
+
+};
+
+#endif // KLNUMBER_HPP
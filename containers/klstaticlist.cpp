@@ -0,0 +1,288 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Static List interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTATICLIST_CPP
+#define KLSTATICLIST_CPP
+
+#include "klstaticlist.hpp"
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>::KLStaticListVarIterator::KLStaticListVarIterator(KLStaticList* Owner, int Index)
+: List(Owner), Current(Index) {}
+
+template<typename Data, int Limit>
+Data& KLStaticList<Data, Limit>::KLStaticListVarIterator::operator* (void)
+{
+	return *List->At(Current);
+}
+
+template<typename Data, int Limit>
+typename KLStaticList<Data, Limit>::KLStaticListVarIterator& KLStaticList<Data, Limit>::KLStaticListVarIterator::operator++ (void)
+{
+	++Current;
+
+	return *this;
+}
+
+template<typename Data, int Limit>
+bool KLStaticList<Data, Limit>::KLStaticListVarIterator::operator!= (const KLStaticListVarIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>::KLStaticListConstIterator::KLStaticListConstIterator(const KLStaticList* Owner, int Index)
+: List(Owner), Current(Index) {}
+
+template<typename Data, int Limit>
+const Data& KLStaticList<Data, Limit>::KLStaticListConstIterator::operator* (void) const
+{
+	return *List->At(Current);
+}
+
+template<typename Data, int Limit>
+typename KLStaticList<Data, Limit>::KLStaticListConstIterator& KLStaticList<Data, Limit>::KLStaticListConstIterator::operator++ (void)
+{
+	++Current;
+
+	return *this;
+}
+
+template<typename Data, int Limit>
+bool KLStaticList<Data, Limit>::KLStaticListConstIterator::operator!= (const KLStaticListConstIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data, int Limit>
+Data* KLStaticList<Data, Limit>::At(int ID)
+{
+	return ((Data*) Storage) + (Begin + ID) % Limit;
+}
+
+template<typename Data, int Limit>
+const Data* KLStaticList<Data, Limit>::At(int ID) const
+{
+	return ((const Data*) Storage) + (Begin + ID) % Limit;
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>::KLStaticList(const KLStaticList<Data, Limit>& List)
+: KLStaticList()
+{
+	for (const auto& Item: List) Insert(Item);
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>::KLStaticList(KLStaticList<Data, Limit>&& List)
+: KLStaticList()
+{
+	for (int i = 0; i < List.Capacity; ++i) new (At(i)) Data(static_cast<Data&&>(*List.At(i)));
+
+	Capacity = List.Capacity;
+
+	List.Clean();
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>::KLStaticList(void)
+: Begin(0), Capacity(0) {}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>::~KLStaticList(void)
+{
+	Clean();
+}
+
+template<typename Data, int Limit>
+int KLStaticList<Data, Limit>::Insert(const Data& Item)
+{
+	if (Capacity == Limit) return -1;
+
+	new (At(Capacity)) Data(Item);
+
+	return ++Capacity;
+}
+
+template<typename Data, int Limit>
+int KLStaticList<Data, Limit>::Delete(int ID)
+{
+	if (ID < 0 || ID >= Capacity) return -1;
+
+	if (ID == 0)
+	{
+		At(0)->~Data();
+
+		Begin = (Begin + 1) % Limit;
+	}
+	else
+	{
+		for (int i = ID; i < Capacity; ++i)
+		{
+			At(i)->~Data();
+
+			if (i < Capacity - 1) new (At(i)) Data(static_cast<Data&&>(*At(i + 1)));
+		}
+	}
+
+	return --Capacity;
+}
+
+template<typename Data, int Limit>
+Data KLStaticList<Data, Limit>::Dequeue(void)
+{
+	if (!Capacity) return Data();
+
+	Data Buffer(static_cast<Data&&>(*At(0)));
+
+	Delete(0);
+
+	return Buffer;
+}
+
+template<typename Data, int Limit>
+Data KLStaticList<Data, Limit>::Pop(void)
+{
+	if (!Capacity) return Data();
+
+	Data Buffer(static_cast<Data&&>(*At(Capacity - 1)));
+
+	Delete(Capacity - 1);
+
+	return Buffer;
+}
+
+template<typename Data, int Limit>
+Data& KLStaticList<Data, Limit>::First(void)
+{
+	return *At(0);
+}
+
+template<typename Data, int Limit>
+const Data& KLStaticList<Data, Limit>::First(void) const
+{
+	return *At(0);
+}
+
+template<typename Data, int Limit>
+Data& KLStaticList<Data, Limit>::Last(void)
+{
+	return *At(Capacity - 1);
+}
+
+template<typename Data, int Limit>
+const Data& KLStaticList<Data, Limit>::Last(void) const
+{
+	return *At(Capacity - 1);
+}
+
+template<typename Data, int Limit>
+int KLStaticList<Data, Limit>::Size(void) const
+{
+	return Capacity;
+}
+
+template<typename Data, int Limit>
+bool KLStaticList<Data, Limit>::IsFull(void) const
+{
+	return Capacity == Limit;
+}
+
+template<typename Data, int Limit>
+void KLStaticList<Data, Limit>::Clean(void)
+{
+	for (int i = 0; i < Capacity; ++i) At(i)->~Data();
+
+	Begin = Capacity = 0;
+}
+
+template<typename Data, int Limit>
+Data& KLStaticList<Data, Limit>::operator[] (int ID)
+{
+	return *At(ID == LAST ? Capacity - 1 : ID);
+}
+
+template<typename Data, int Limit>
+const Data& KLStaticList<Data, Limit>::operator[] (int ID) const
+{
+	return *At(ID == LAST ? Capacity - 1 : ID);
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>& KLStaticList<Data, Limit>::operator<< (const Data& Item)
+{
+	Insert(Item);
+
+	return *this;
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>& KLStaticList<Data, Limit>::operator= (const KLStaticList<Data, Limit>& List)
+{
+	if (this == &List) return *this;
+
+	Clean();
+
+	for (const auto& Item: List) Insert(Item);
+
+	return *this;
+}
+
+template<typename Data, int Limit>
+KLStaticList<Data, Limit>& KLStaticList<Data, Limit>::operator= (KLStaticList<Data, Limit>&& List)
+{
+	if (this == &List) return *this;
+
+	Clean();
+
+	for (int i = 0; i < List.Capacity; ++i) new (At(i)) Data(static_cast<Data&&>(*List.At(i)));
+
+	Capacity = List.Capacity;
+
+	List.Clean();
+
+	return *this;
+}
+
+template<typename Data, int Limit>
+typename KLStaticList<Data, Limit>::KLStaticListVarIterator KLStaticList<Data, Limit>::begin(void)
+{
+	return KLStaticListVarIterator(this, 0);
+}
+
+template<typename Data, int Limit>
+typename KLStaticList<Data, Limit>::KLStaticListVarIterator KLStaticList<Data, Limit>::end(void)
+{
+	return KLStaticListVarIterator(this, Capacity);
+}
+
+template<typename Data, int Limit>
+typename KLStaticList<Data, Limit>::KLStaticListConstIterator KLStaticList<Data, Limit>::begin(void) const
+{
+	return KLStaticListConstIterator(this, 0);
+}
+
+template<typename Data, int Limit>
+typename KLStaticList<Data, Limit>::KLStaticListConstIterator KLStaticList<Data, Limit>::end(void) const
+{
+	return KLStaticListConstIterator(this, Capacity);
+}
+
+#endif // KLSTATICLIST_CPP
@@ -0,0 +1,304 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Static List interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTATICLIST_HPP
+#define KLSTATICLIST_HPP
+
+#include "../libbuild.hpp"
+
+#include <new>
+
+/*! \file		klstaticlist.hpp
+ *  \brief	Deklaracje dla klasy KLStaticList i jej składników.
+ *
+ */
+
+/*! \file		klstaticlist.cpp
+ *  \brief	Implementacja klasy KLStaticList i jej składników.
+ *
+ */
+
+/*! \brief	Lista o stałej pojemności.
+ *  \tparam	Data Typ przechowywanych danych.
+ *  \tparam	Limit Maksymalna liczba elementów.
+ *
+ * Odpowiednik klasy `KLList` przechowujący elementy w tablicy wewnątrz obiektu (bufor cykliczny), dzięki czemu nie korzysta ze sterty. Przeznaczona przede wszystkim dla platformy AVR, gdzie wielokrotne przydzielanie małych bloków pamięci powoduje jej fragmentację.
+ *
+ * Udostępnia ten sam interfejs co `KLList`. Dodanie elementu do pełnej listy kończy się niepowodzeniem (metoda `Insert` zwraca -1).
+ *
+ */
+template<typename Data, int Limit>
+class KLStaticList
+{
+
+	static_assert(Limit > 0, "KLStaticList requires positive capacity");
+
+	/*! \brief		Wyliczenie indeksu listy.
+	 *
+	 * Umożliwia indeksowanie listy z użyciem pierwszego i ostatniego elementu.
+	 *
+	 */
+	public: enum INDEX : int
+	{
+		FIRST = 0,	//!< Pierwszy element.
+		LAST = -1		//!< Ostatni element.
+	};
+
+	public: class KLStaticListVarIterator
+	{
+
+		protected:
+
+			KLStaticList* List;
+			int Current;
+
+		public:
+
+			KLStaticListVarIterator(KLStaticList* Owner, int Index);
+
+			Data& operator* (void);
+			KLStaticListVarIterator& operator++ (void);
+			bool operator!= (const KLStaticListVarIterator& Iterator) const;
+
+	};
+
+	public: class KLStaticListConstIterator
+	{
+
+		protected:
+
+			const KLStaticList* List;
+			int Current;
+
+		public:
+
+			KLStaticListConstIterator(const KLStaticList* Owner, int Index);
+
+			const Data& operator* (void) const;
+			KLStaticListConstIterator& operator++ (void);
+			bool operator!= (const KLStaticListConstIterator& Iterator) const;
+
+	};
+
+	protected:
+
+		alignas(Data) unsigned char Storage[Limit * sizeof(Data)];	//!< Pamięć na elementy.
+
+		int Begin;		//!< Położenie pierwszego elementu w buforze.
+
+		int Capacity;		//!< Liczba elementów listy.
+
+		/*! \brief		Adres elementu.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Wskaźnik na element w buforze.
+		 *
+		 * Przelicza indeks elementu na jego położenie w buforze cyklicznym.
+		 *
+		 */
+		Data* At(int ID);
+
+		/*! \brief		Adres elementu.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Wskaźnik na element w buforze.
+		 *
+		 * Przelicza indeks elementu na jego położenie w buforze cyklicznym.
+		 *
+		 */
+		const Data* At(int ID) const;
+
+	public:
+
+		/*! \brief		Konstruktor kopiujący.
+		 *  \param [in]	List Obiekt do skopiowania.
+		 *
+		 * Tworzy nową listę na podstawie podanej listy, kopiując wszystkie elementy.
+		 *
+		 */
+		KLStaticList(const KLStaticList<Data, Limit>& List);
+
+		/*! \brief		Konstruktor przenoszący.
+		 *  \param [in]	List Obiekt do przeniesienia.
+		 *
+		 * Przenosi wszystkie elementy podanej listy. Ze względu na przechowywanie danych wewnątrz obiektu operacja wymaga przeniesienia każdego elementu.
+		 *
+		 */
+		KLStaticList(KLStaticList<Data, Limit>&& List);
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Inicjuje wszystkie pola obiektu.
+		 *
+		 */
+		KLStaticList(void);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Usuwa wszystkie elementy.
+		 *
+		 */
+		~KLStaticList(void);
+
+		/*! \brief		Wstawianie elementu.
+		 *  \param [in]	Item Element dodawany do listy.
+		 *  \return		Aktualna liczba elementów lub -1 gdy lista jest pełna.
+		 *
+		 * Dodaje do listy kopie podanego elementu i zwraca nową ilość elementów.
+		 *
+		 */
+		int Insert(const Data& Item);
+
+		/*! \brief		Usunięcie elementu.
+		 *  \param [in]	ID Indeks elementu numerowany od zera.
+		 *  \return		Aktualna liczba elementów lub -1 w przypadku błędu.
+		 *
+		 * Usuwa wybrany element i zwraca aktualną ilość elementów. Gdy nie istnieje element o wybranym indeksie medoda zwróci -1.
+		 *
+		 */
+		int Delete(int ID);
+
+		/*! \brief		Pobranie elementu.
+		 *  \return		Kolejny element.
+		 *
+		 * Pobiera element w trybie kolejki i usuwa go z listy.
+		 *
+		 */
+		Data Dequeue(void);
+
+		/*! \brief		Pobranie elementu.
+		 *  \return		Kolejny element.
+		 *
+		 * Pobiera element w trybie stosu i usuwa go z listy.
+		 *
+		 */
+		Data Pop(void);
+
+		/*! \brief		Pierwszy element.
+		 *  \return		Referencja do pierwszego elementu.
+		 *
+		 * Zwraca pierwszy element listy.
+		 *
+		 */
+		Data& First(void);
+
+		/*! \brief		Pierwszy element.
+		 *  \return		Stała referencja do pierwszego elementu.
+		 *
+		 * Zwraca pierwszy element listy.
+		 *
+		 */
+		const Data& First(void) const;
+
+		/*! \brief		Ostatni element.
+		 *  \return		Referencja do ostatniego elementu.
+		 *
+		 * Zwraca ostatni element listy.
+		 *
+		 */
+		Data& Last(void);
+
+		/*! \brief		Ostatni element.
+		 *  \return		Stała referencja do ostatniego elementu.
+		 *
+		 * Zwraca ostatni element listy.
+		 *
+		 */
+		const Data& Last(void) const;
+
+		/*! \brief		Sprawdzenie ilości elementów.
+		 *  \return		Liczba elementów.
+		 *
+		 * Zwraca liczbę elementów w liście.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Sprawdzenie zapełnienia.
+		 *  \return		`true` jeśli nie można dodać kolejnego elementu.
+		 *
+		 * Sprawdza czy lista osiągnęła swoją pojemność.
+		 *
+		 */
+		bool IsFull(void) const;
+
+		/*! \brief		Czyszczenie listy.
+		 *
+		 * Usuwa wszystkie elementy z listy.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Indeks elementu.
+		 *  \return		Referencja do wybranego elementu.
+		 *  \warning		Indeks nie jest sprawdzany.
+		 *
+		 * Wybiera element o podanym indeksie z listy.
+		 *
+		 */
+		Data& operator[] (int ID);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Indeks elementu.
+		 *  \return		Stała referencja do wybranego elementu.
+		 *  \warning		Indeks nie jest sprawdzany.
+		 *
+		 * Wybiera element o podanym indeksie z listy.
+		 *
+		 */
+		const Data& operator[] (int ID) const;
+
+		/*! \brief		Operator dodania elementu.
+		 *  \param [in]	Item Element dodawany do listy.
+		 *  \return		Referencja do bieżącego obiektu.
+		 *
+		 * Dodaje element do listy (`Insert`).
+		 *
+		 */
+		KLStaticList<Data, Limit>& operator<< (const Data& Item);
+
+		/*! \brief		Operator przypisania.
+		 *  \param [in]	List Lista do skopiowania.
+		 *  \return		Referencja do bieżącego obiektu.
+		 *
+		 * Usuwa wszystkie elementy i kopiuje elementy podanej listy.
+		 *
+		 */
+		KLStaticList<Data, Limit>& operator= (const KLStaticList<Data, Limit>& List);
+
+		/*! \brief		Operator przeniesienia.
+		 *  \param [in]	List Lista do przeniesienia.
+		 *  \return		Referencja do bieżącego obiektu.
+		 *
+		 * Usuwa wszystkie elementy i przenosi elementy podanej listy.
+		 *
+		 */
+		KLStaticList<Data, Limit>& operator= (KLStaticList<Data, Limit>&& List);
+
+		KLStaticListVarIterator begin(void);
+		KLStaticListVarIterator end(void);
+
+		KLStaticListConstIterator begin(void) const;
+		KLStaticListConstIterator end(void) const;
+
+};
+
+#include "klstaticlist.cpp"
+
+#endif // KLSTATICLIST_HPP
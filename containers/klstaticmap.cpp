@@ -0,0 +1,158 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Static Map interpretation for KLLibs                       *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTATICMAP_CPP
+#define KLSTATICMAP_CPP
+
+#include "klstaticmap.hpp"
+
+template<typename Data, typename Key, int Limit>
+KLStaticMap<Data, Key, Limit>::KLStaticMapRecord::KLStaticMapRecord(const Data& _Value, const Key& _Index)
+: Value(_Value), Index(_Index) {}
+
+template<typename Data, typename Key, int Limit>
+int KLStaticMap<Data, Key, Limit>::Search(const Key& ID) const
+{
+	for (int i = 0; i < Records.Size(); ++i) if (Records[i].Index == ID) return i;
+
+	return -1;
+}
+
+template<typename Data, typename Key, int Limit>
+int KLStaticMap<Data, Key, Limit>::Insert(const Data& Item, const Key& ID)
+{
+	if (Exists(ID)) return -1;
+
+	return Records.Insert(KLStaticMapRecord(Item, ID));
+}
+
+template<typename Data, typename Key, int Limit>
+int KLStaticMap<Data, Key, Limit>::Delete(const Key& ID)
+{
+	const int Index = Search(ID);
+
+	if (Index == -1) return -1;
+
+	return Records.Delete(Index);
+}
+
+template<typename Data, typename Key, int Limit>
+bool KLStaticMap<Data, Key, Limit>::Exists(const Key& ID) const
+{
+	return Search(ID) != -1;
+}
+
+template<typename Data, typename Key, int Limit>
+bool KLStaticMap<Data, Key, Limit>::Update(const Key& OldID, const Key& NewID)
+{
+	if (OldID == NewID) return true;
+
+	const int Index = Search(OldID);
+
+	if (Index == -1) return false;
+
+	Records[Index].Index = NewID;
+
+	return true;
+}
+
+template<typename Data, typename Key, int Limit>
+int KLStaticMap<Data, Key, Limit>::Size(void) const
+{
+	return Records.Size();
+}
+
+template<typename Data, typename Key, int Limit>
+bool KLStaticMap<Data, Key, Limit>::IsFull(void) const
+{
+	return Records.IsFull();
+}
+
+template<typename Data, typename Key, int Limit>
+KLStaticList<Data, Limit> KLStaticMap<Data, Key, Limit>::Values(void) const
+{
+	KLStaticList<Data, Limit> Buffer;
+
+	for (const auto& Record: Records) Buffer.Insert(Record.Value);
+
+	return Buffer;
+}
+
+template<typename Data, typename Key, int Limit>
+KLStaticList<Key, Limit> KLStaticMap<Data, Key, Limit>::Keys(void) const
+{
+	KLStaticList<Key, Limit> Buffer;
+
+	for (const auto& Record: Records) Buffer.Insert(Record.Index);
+
+	return Buffer;
+}
+
+template<typename Data, typename Key, int Limit>
+void KLStaticMap<Data, Key, Limit>::Clean(void)
+{
+	Records.Clean();
+}
+
+template<typename Data, typename Key, int Limit>
+Data& KLStaticMap<Data, Key, Limit>::operator[] (const Key& ID)
+{
+	const int Index = Search(ID);
+
+	if (Index == -1) return *((Data*) nullptr);
+
+	return Records[Index].Value;
+}
+
+template<typename Data, typename Key, int Limit>
+const Data& KLStaticMap<Data, Key, Limit>::operator[] (const Key& ID) const
+{
+	const int Index = Search(ID);
+
+	if (Index == -1) return *((Data*) nullptr);
+
+	return Records[Index].Value;
+}
+
+template<typename Data, typename Key, int Limit>
+typename KLStaticMap<Data, Key, Limit>::KLStaticMapVarIterator KLStaticMap<Data, Key, Limit>::begin(void)
+{
+	return Records.begin();
+}
+
+template<typename Data, typename Key, int Limit>
+typename KLStaticMap<Data, Key, Limit>::KLStaticMapVarIterator KLStaticMap<Data, Key, Limit>::end(void)
+{
+	return Records.end();
+}
+
+template<typename Data, typename Key, int Limit>
+typename KLStaticMap<Data, Key, Limit>::KLStaticMapConstIterator KLStaticMap<Data, Key, Limit>::begin(void) const
+{
+	return Records.begin();
+}
+
+template<typename Data, typename Key, int Limit>
+typename KLStaticMap<Data, Key, Limit>::KLStaticMapConstIterator KLStaticMap<Data, Key, Limit>::end(void) const
+{
+	return Records.end();
+}
+
+#endif // KLSTATICMAP_CPP
@@ -0,0 +1,200 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Static Map interpretation for KLLibs                       *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTATICMAP_HPP
+#define KLSTATICMAP_HPP
+
+#include "../libbuild.hpp"
+
+#include "klstaticlist.hpp"
+
+/*! \file		klstaticmap.hpp
+ *  \brief	Deklaracje dla klasy KLStaticMap i jej składników.
+ *
+ */
+
+/*! \file		klstaticmap.cpp
+ *  \brief	Implementacja klasy KLStaticMap i jej składników.
+ *
+ */
+
+/*! \brief	Mapa o stałej pojemności.
+ *  \tparam	Data	Typ przechowywanych danych.
+ *  \tparam	Key	Typ używanego klucza.
+ *  \tparam	Limit	Maksymalna liczba elementów.
+ *  \note		Do użycia wymagany jest konstruktor kopiujący dla klucza i danych.
+ *
+ * Odpowiednik klasy `KLMap` przechowujący pary klucz-dane w tablicy wewnątrz obiektu (`KLStaticList`), dzięki czemu nie korzysta ze sterty. Usunięcie elementu przesuwa elementy następujące po nim, więc referencje do nich tracą ważność.
+ *
+ * Udostępnia ten sam interfejs co `KLMap`. Dodanie elementu do pełnej mapy kończy się niepowodzeniem (metoda `Insert` zwraca -1).
+ *
+ */
+template<typename Data, typename Key, int Limit>
+class KLStaticMap
+{
+
+	/*! \brief		Struktura reprezentująca parę klucz-dane.
+	 *
+	 * Struktura przechowująca informacje o obiekcie przechowywanym w mapie.
+	 *
+	 */
+	public: struct KLStaticMapRecord
+	{
+
+		Data	Value;	//!< Dane obiektu.
+		Key	Index;		//!< Klucz obiektu.
+
+		/*! \brief		Konstruktor rekordu.
+		 *  \param [in]	_Value	Dane rekordu.
+		 *  \param [in]	_Index	Klucz rekordu.
+		 *
+		 * Tworzy nowy rekord na podstawie podanych obiektów klucza i danych. Kopiuje wszystkie obiekty.
+		 *
+		 */
+		KLStaticMapRecord(const Data& _Value, const Key& _Index);
+
+	};
+
+	public: using KLStaticMapVarIterator = typename KLStaticList<KLStaticMapRecord, Limit>::KLStaticListVarIterator;
+	public: using KLStaticMapConstIterator = typename KLStaticList<KLStaticMapRecord, Limit>::KLStaticListConstIterator;
+
+	protected:
+
+		KLStaticList<KLStaticMapRecord, Limit> Records;	//!< Rekordy mapy.
+
+		/*! \brief		Wyszukanie klucza.
+		 *  \param [in]	ID Szukany klucz.
+		 *  \return		Indeks rekordu lub -1 gdy klucz nie istnieje.
+		 *
+		 * Przeszukuje kolejne rekordy mapy.
+		 *
+		 */
+		int Search(const Key& ID) const;
+
+	public:
+
+		/*! \brief		Wstawianie elementu.
+		 *  \param [in]	Item	Dodawany element.
+		 *  \param [in]	ID	Klucz elementu.
+		 *  \return		Aktualna liczba elementów lub -1 w przypadku błędu.
+		 *
+		 * Dodaje do mapy kopie podanego elementu i zwraca nową ilość elementów. Gdy klucz już istnieje lub mapa jest pełna metoda zwróci -1.
+		 *
+		 */
+		int Insert(const Data& Item, const Key& ID);
+
+		/*! \brief		Usunięcie elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Aktualna liczba elementów lub -1 w przypadku błędu.
+		 *
+		 * Usuwa wybrany element i zwraca aktualną ilość elementów. Gdy nie istnieje element o wybranym kluczu medoda zwróci -1.
+		 *
+		 */
+		int Delete(const Key& ID);
+
+		/*! \brief		Sprawdzenie istnienia elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Sprawdza czy istnieje element o podanym kluczu.
+		 *
+		 */
+		bool Exists(const Key& ID) const;
+
+		/*! \brief		Zmiana klucza.
+		 *  \param [in]	OldID Klucz elementu.
+		 *  \param [in]	NewID Nowy klucz elementu.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zmienia klucz wybranego elementu.
+		 *
+		 */
+		bool Update(const Key& OldID, const Key& NewID);
+
+		/*! \brief		Sprawdzenie ilości elementów.
+		 *  \return		Liczba elementów.
+		 *
+		 * Zwraca liczbę elementów w mapie.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Sprawdzenie zapełnienia.
+		 *  \return		`true` jeśli nie można dodać kolejnego elementu.
+		 *
+		 * Sprawdza czy mapa osiągnęła swoją pojemność.
+		 *
+		 */
+		bool IsFull(void) const;
+
+		/*! \brief		Pobranie wartości.
+		 *  \return		Lista wartości.
+		 *
+		 * Zwraca listę wszystkich wartości przechowywanych w mapie.
+		 *
+		 */
+		KLStaticList<Data, Limit> Values(void) const;
+
+		/*! \brief		Pobranie kluczy.
+		 *  \return		Lista kluczy.
+		 *
+		 * Zwraca listę wszystkich kluczy używanych w mapie.
+		 *
+		 */
+		KLStaticList<Key, Limit> Keys(void) const;
+
+		/*! \brief		Czyszczenie mapy.
+		 *
+		 * Usuwa wszystkie elementy z mapy.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Referencja do wybranego elementu.
+		 *  \warning		Gdy element o podanym kluczu nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
+		 *
+		 * Wybiera element o podanym kluczu z mapy.
+		 *
+		 */
+		Data& operator[] (const Key& ID);
+
+		/*! \brief		Wybór elementu.
+		 *  \param [in]	ID Klucz elementu.
+		 *  \return		Stała referencja do wybranego elementu.
+		 *  \warning		Gdy element o podanym kluczu nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
+		 *
+		 * Wybiera element o podanym kluczu z mapy.
+		 *
+		 */
+		const Data& operator[] (const Key& ID) const;
+
+		KLStaticMapVarIterator begin(void);
+		KLStaticMapVarIterator end(void);
+
+		KLStaticMapConstIterator begin(void) const;
+		KLStaticMapConstIterator end(void) const;
+
+};
+
+#include "klstaticmap.cpp"
+
+#endif // KLSTATICMAP_HPP
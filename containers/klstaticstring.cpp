@@ -0,0 +1,270 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Static String interpretation for KLLibs                    *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTATICSTRING_CPP
+#define KLSTATICSTRING_CPP
+
+#include "klstaticstring.hpp"
+
+template<int Limit>
+KLStaticString<Limit>::KLStaticString(void)
+: Capacity(0)
+{
+	Data[0] = 0;
+}
+
+template<int Limit>
+KLStaticString<Limit>::KLStaticString(const char* String)
+: KLStaticString()
+{
+	if (String) Insert(String);
+}
+
+template<int Limit>
+KLStaticString<Limit>::KLStaticString(const KLStringView& String)
+: KLStaticString()
+{
+	if (String.Size()) Insert(String.Data(), -1, String.Size());
+}
+
+template<int Limit>
+int KLStaticString<Limit>::Insert(const char* String, int Position, int Length)
+{
+	if (!String || Position > Capacity) return -1;
+
+	const int Strlen = (Length > 0) ? Length : strlen(String);
+
+	if (Strlen > Limit - Capacity) return -1;
+
+	if (String >= Data && String <= Data + Limit)
+	{
+		const KLStaticString<Limit> Buffer(KLStringView(String, Strlen));
+
+		return Insert(Buffer.Data, Position, Strlen);
+	}
+
+	if (Position < 0) Position = Capacity;
+
+	memmove(Data + Position + Strlen, Data + Position, Capacity - Position + 1);
+	memcpy(Data + Position, String, Strlen);
+
+	return Capacity += Strlen;
+}
+
+template<int Limit>
+int KLStaticString<Limit>::Insert(char Char, int Position)
+{
+	if (!Char) return -1;
+
+	return Insert(&Char, Position, 1);
+}
+
+template<int Limit>
+int KLStaticString<Limit>::Delete(int Start, int Stop)
+{
+	if (Stop > Capacity) Stop = Capacity;
+
+	if (Stop <= Start) return 0;
+
+	const int Last = Stop < Capacity ? Stop + 1 : Capacity;
+
+	memmove(Data + Start, Data + Last, Capacity - Last + 1);
+
+	Capacity -= Last - Start;
+
+	return Last - Start;
+}
+
+template<int Limit>
+int KLStaticString<Limit>::Find(const KLStringView& String, int Start, int Stop) const
+{
+	Stop = (Stop && Stop < Capacity) ? Stop : Capacity;
+
+	if (Start < 0) Start = 0;
+	if (Start >= Stop) return -1;
+
+	const int Found = KLString::Search(Data + Start, Stop - Start, String.Data(), String.Size());
+
+	return Found == -1 ? -1 : Found + Start;
+}
+
+template<int Limit>
+int KLStaticString<Limit>::Find(char Char, int Start, int Stop) const
+{
+	Stop = (Stop && Stop < Capacity) ? Stop : Capacity;
+
+	if (Start < 0) Start = 0;
+	if (Start >= Stop) return -1;
+
+	const char* Found = (const char*) memchr(Data + Start, Char, Stop - Start);
+
+	return Found ? Found - Data : -1;
+}
+
+template<int Limit>
+KLStaticString<Limit> KLStaticString<Limit>::Part(int Start, int Stop) const
+{
+	if (Start >= Stop || Start > Capacity || Stop > Capacity) return KLStaticString<Limit>();
+
+	return KLStaticString<Limit>(KLStringView(Data + Start, Stop - Start));
+}
+
+template<int Limit>
+int KLStaticString<Limit>::Size(void) const
+{
+	return Capacity;
+}
+
+template<int Limit>
+void KLStaticString<Limit>::Clean(void)
+{
+	Data[Capacity = 0] = 0;
+}
+
+template<int Limit>
+bool KLStaticString<Limit>::ToBool(void) const
+{
+	return ToInt() || !strcmp(Data, "true") || !strcmp(Data, "TRUE");
+}
+
+template<int Limit>
+int KLStaticString<Limit>::ToInt(void) const
+{
+	return KLStringView(Data, Capacity).ToInt();
+}
+
+template<int Limit>
+double KLStaticString<Limit>::ToNumber(void) const
+{
+	return KLStringView(Data, Capacity).ToNumber();
+}
+
+template<int Limit>
+KLStaticString<Limit>::operator const char* (void) const
+{
+	return Data;
+}
+
+template<int Limit>
+char& KLStaticString<Limit>::operator[] (int ID)
+{
+	return Data[ID];
+}
+
+template<int Limit>
+char KLStaticString<Limit>::operator[] (int ID) const
+{
+	if (Capacity > ID)
+		return Data[ID];
+	else
+		return 0;
+}
+
+template<int Limit>
+bool KLStaticString<Limit>::operator== (const KLStringView& String) const
+{
+	return KLStringView(Data, Capacity) == String;
+}
+
+template<int Limit>
+bool KLStaticString<Limit>::operator!= (const KLStringView& String) const
+{
+	return !(*this == String);
+}
+
+template<int Limit>
+bool KLStaticString<Limit>::operator== (const char* String) const
+{
+	return !strcmp(Data, String ? String : "");
+}
+
+template<int Limit>
+bool KLStaticString<Limit>::operator!= (const char* String) const
+{
+	return !(*this == String);
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator= (const char* String)
+{
+	return *this = KLStringView(String);
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator= (const KLStringView& String)
+{
+	if (String.Size() > Limit) return *this;
+
+	memmove(Data, String.Data(), String.Size());
+
+	Data[Capacity = String.Size()] = 0;
+
+	return *this;
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator+= (const KLStringView& String)
+{
+	if (String.Size()) Insert(String.Data(), -1, String.Size());
+
+	return *this;
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator<< (const KLStringView& Input)
+{
+	return *this += Input;
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator<< (const char* Input)
+{
+	return *this += KLStringView(Input);
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator<< (char Input)
+{
+	Insert(Input);
+
+	return *this;
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator<< (double Input)
+{
+	char Buffer[KLNumber::BUFFER];
+
+	Insert(Buffer, -1, KLNumber::Format(Input, Buffer));
+
+	return *this;
+}
+
+template<int Limit>
+KLStaticString<Limit>& KLStaticString<Limit>::operator<< (int Input)
+{
+	char Buffer[KLNumber::BUFFER];
+
+	Insert(Buffer, -1, KLNumber::Format(Input, Buffer));
+
+	return *this;
+}
+
+#endif // KLSTATICSTRING_CPP
@@ -0,0 +1,217 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Static String interpretation for KLLibs                    *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTATICSTRING_HPP
+#define KLSTATICSTRING_HPP
+
+#include "../libbuild.hpp"
+
+#include "klstring.hpp"
+
+/*! \file		klstaticstring.hpp
+ *  \brief	Deklaracje dla klasy KLStaticString i jej składników.
+ *
+ */
+
+/*! \file		klstaticstring.cpp
+ *  \brief	Implementacja klasy KLStaticString i jej składników.
+ *
+ */
+
+/*! \brief	Łańcuch znaków o stałej pojemności.
+ *  \tparam	Limit Maksymalna liczba znaków (bez kończącego zera).
+ *
+ * Odpowiednik klasy `KLString` przechowujący znaki w tablicy wewnątrz obiektu, dzięki czemu nie korzysta ze sterty. Udostępnia podstawowe operacje klasy `KLString` o tych samych nazwach i znaczeniu parametrów. Operacja, która przekroczyłaby pojemność łańcucha, nie jest wykonywana i zwraca -1.
+ *
+ * Łańcuch jest zawsze zakończony zerem i może być przekazywany tam, gdzie oczekiwany jest `const char*` lub `KLStringView`.
+ *
+ */
+template<int Limit>
+class KLStaticString
+{
+
+	static_assert(Limit > 0, "KLStaticString requires positive capacity");
+
+	protected:
+
+		char Data[Limit + 1];	//!< Przechowywane znaki.
+
+		int Capacity;		//!< Liczba znaków.
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy pusty łańcuch.
+		 *
+		 */
+		KLStaticString(void);
+
+		/*! \brief		Konstruktor z tekstu.
+		 *  \param [in]	String Tekst zakończony zerem.
+		 *
+		 * Tworzy łańcuch z kopią podanego tekstu. Tekst dłuższy niż pojemność łańcucha jest pomijany.
+		 *
+		 */
+		KLStaticString(const char* String);
+
+		/*! \brief		Konstruktor z fragmentu.
+		 *  \param [in]	String Fragment łańcucha.
+		 *
+		 * Tworzy łańcuch z kopią podanego fragmentu. Fragment dłuższy niż pojemność łańcucha jest pomijany.
+		 *
+		 */
+		KLStaticString(const KLStringView& String);
+
+		/*! \brief		Wstawianie tekstu.
+		 *  \param [in]	String	Tekst do wstawienia.
+		 *  \param [in]	Position	Miejsce wstawienia (-1 dla końca łańcucha).
+		 *  \param [in]	Length	Długość tekstu (-1 gdy tekst jest zakończony zerem).
+		 *  \return		Aktualna długość łańcucha lub -1 w przypadku błędu.
+		 *
+		 * Wstawia tekst w wybranym miejscu. Gdy tekst nie mieści się w łańcuchu metoda zwróci -1 i nie zmieni łańcucha.
+		 *
+		 */
+		int Insert(const char* String, int Position = -1, int Length = -1);
+
+		/*! \brief		Wstawianie znaku.
+		 *  \param [in]	Char		Znak do wstawienia.
+		 *  \param [in]	Position	Miejsce wstawienia (-1 dla końca łańcucha).
+		 *  \return		Aktualna długość łańcucha lub -1 w przypadku błędu.
+		 *
+		 * Wstawia znak w wybranym miejscu.
+		 *
+		 */
+		int Insert(char Char, int Position = -1);
+
+		/*! \brief		Usuwanie części łańcucha.
+		 *  \param [in]	Start	Punkt początkowy.
+		 *  \param [in]	Stop		Punkt końcowy.
+		 *  \return		Ilość usunięć.
+		 *
+		 * Usuwa z łańcucha wybrany fragment (tak samo jak `KLString::Delete`).
+		 *
+		 */
+		int Delete(int Start, int Stop);
+
+		/*! \brief		Wyszukiwanie frazy.
+		 *  \param [in]	String	Fraza do wyszukania.
+		 *  \param [in]	Start	Początek wyszukiwania.
+		 *  \param [in]	Stop		Koniec wyszukiwania.
+		 *  \return		Miejsce wystąpienia numerowane od zera lub -1 gdy nic nie znaleziono.
+		 *
+		 * Szuka w łańcuchu wybranej frazy i zwraca miejsce pierwszego wystąpienia.
+		 *
+		 */
+		int Find(const KLStringView& String, int Start = 0, int Stop = 0) const;
+
+		/*! \brief		Wyszukiwanie znaku.
+		 *  \param [in]	Char		Znak do wyszukania.
+		 *  \param [in]	Start	Początek wyszukiwania.
+		 *  \param [in]	Stop		Koniec wyszukiwania.
+		 *  \return		Miejsce wystąpienia numerowane od zera lub -1 gdy nic nie znaleziono.
+		 *
+		 * Szuka w łańcuchu wybranego znaku i zwraca miejsce pierwszego wystąpienia.
+		 *
+		 */
+		int Find(char Char, int Start = 0, int Stop = 0) const;
+
+		/*! \brief		Kopia części łańcucha.
+		 *  \param [in]	Start	Początek ciągu.
+		 *  \param [in]	Stop		Koniec ciągu.
+		 *  \return		Łańcuch złożony z części obejmującej podany zakres.
+		 *
+		 * Kopiuje znaki od wybranego znaku początkowego do końcowego i zwraca nowy łańcuch.
+		 *
+		 */
+		KLStaticString<Limit> Part(int Start, int Stop) const;
+
+		/*! \brief		Sprawdzenie długości.
+		 *  \return		Liczba znaków.
+		 *
+		 * Zwraca liczbę znaków w łańcuchu.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Czyszczenie łańcucha.
+		 *
+		 * Usuwa wszystkie znaki.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Konwersja na `bool`.
+		 *  \return		Wartość logiczna łańcucha.
+		 *
+		 * Zwraca `true` dla niezerowej liczby lub tekstu `true`.
+		 *
+		 */
+		bool ToBool(void) const;
+
+		/*! \brief		Konwersja na liczbę całkowitą.
+		 *  \return		Wartość liczbowa łańcucha.
+		 *
+		 * Odczytuje liczbę z początku łańcucha (`KLNumber::Parse`).
+		 *
+		 */
+		int ToInt(void) const;
+
+		/*! \brief		Konwersja na liczbę zmiennoprzecinkową.
+		 *  \return		Wartość liczbowa łańcucha.
+		 *
+		 * Odczytuje liczbę z początku łańcucha (`KLNumber::Parse`).
+		 *
+		 */
+		double ToNumber(void) const;
+
+		/*! \brief		Operator konwersji na `const char*`.
+		 *  \return		Wskaźnik na znaki zakończone zerem.
+		 *
+		 * Umożliwia przekazanie łańcucha do funkcji biblioteki `string.h`.
+		 *
+		 */
+		operator const char* (void) const;
+
+		char& operator[] (int ID);
+		char operator[] (int ID) const;
+
+		bool operator== (const KLStringView& String) const;
+		bool operator!= (const KLStringView& String) const;
+
+		bool operator== (const char* String) const;
+		bool operator!= (const char* String) const;
+
+		KLStaticString<Limit>& operator= (const char* String);
+		KLStaticString<Limit>& operator= (const KLStringView& String);
+
+		KLStaticString<Limit>& operator+= (const KLStringView& String);
+
+		KLStaticString<Limit>& operator<< (const KLStringView& Input);
+		KLStaticString<Limit>& operator<< (const char* Input);
+		KLStaticString<Limit>& operator<< (char Input);
+		KLStaticString<Limit>& operator<< (double Input);
+		KLStaticString<Limit>& operator<< (int Input);
+
+};
+
+#include "klstaticstring.cpp"
+
+#endif // KLSTATICSTRING_HPP
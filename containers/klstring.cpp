@@ -20,49 +20,228 @@
 
 #include "klstring.hpp"
 
-KLString::KLString(double Value)
-: KLString()
+#if defined(USING_COW) && !defined(F_CPU)
+#define KLSTRING_COW
+#include <atomic>
+#include <new>
+
+struct KLStringHeader
 {
-	char Buffer[32];
+	std::atomic<int> References;	//!< Liczba łańcuchów korzystających z bufora.
+};
+
+static inline KLStringHeader* Header(char* Buffer)
+{
+	return ((KLStringHeader*) Buffer) - 1;
+}
+#endif
+
+#if !defined(F_CPU) && defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define KLSTRING_SIMD_SEARCH
+#include <immintrin.h>
+#endif
 
 #ifndef F_CPU
-	snprintf(Buffer, 32, "%f", Value);
-#else
-	dtostrf(Value, 0, 5, Buffer);
+
+static int MaximalSuffix(const unsigned char* Pattern, int Length, int& Period, bool Reversed)
+{
+	int Suffix = -1, j = 0, k = 1;
+
+	Period = 1;
+
+	while (j + k < Length)
+	{
+		const unsigned char A = Pattern[j + k];
+		const unsigned char B = Pattern[Suffix + k];
+
+		if (A == B)
+		{
+			if (k == Period) { j += Period; k = 1; }
+			else ++k;
+		}
+		else if ((A < B) != Reversed)
+		{
+			j += k; k = 1;
+			Period = j - Suffix;
+		}
+		else
+		{
+			Suffix = j++;
+			k = Period = 1;
+		}
+	}
+
+	return Suffix;
+}
+
+static int TwoWaySearch(const char* Text, int Size, const char* Pattern, int Length)
+{
+	const unsigned char* T = (const unsigned char*) Text;
+	const unsigned char* P = (const unsigned char*) Pattern;
+
+	int Period, Reversed;
+
+	int Split = MaximalSuffix(P, Length, Period, false);
+	const int Other = MaximalSuffix(P, Length, Reversed, true);
+
+	if (Other > Split) { Split = Other; Period = Reversed; }
+
+	if (!memcmp(P, P + Period, Split + 1))
+	{
+		int Memory = -1;
+
+		for (int j = 0; j <= Size - Length;)
+		{
+			int i = (Split > Memory ? Split : Memory) + 1;
+
+			while (i < Length && P[i] == T[i + j]) ++i;
+
+			if (i >= Length)
+			{
+				i = Split;
+
+				while (i > Memory && P[i] == T[i + j]) --i;
+
+				if (i <= Memory) return j;
+
+				j += Period;
+				Memory = Length - Period - 1;
+			}
+			else
+			{
+				j += i - Split;
+				Memory = -1;
+			}
+		}
+	}
+	else
+	{
+		const int Left = Split + 1, Right = Length - Split - 1;
+
+		Period = (Left > Right ? Left : Right) + 1;
+
+		for (int j = 0; j <= Size - Length;)
+		{
+			int i = Split + 1;
+
+			while (i < Length && P[i] == T[i + j]) ++i;
+
+			if (i >= Length)
+			{
+				i = Split;
+
+				while (i >= 0 && P[i] == T[i + j]) --i;
+
+				if (i < 0) return j;
+
+				j += Period;
+			}
+			else j += i - Split;
+		}
+	}
+
+	return -1;
+}
+
 #endif
 
-	Capacity	= strlen(Buffer);
-	Data		= (char*) malloc(Capacity + 1);
+#ifdef KLSTRING_SIMD_SEARCH
 
-	memcpy(Data, Buffer, Capacity + 1);
+static int SearchSSE2(const char* Text, int Size, const char* Pattern, int Length)
+{
+	const __m128i First = _mm_set1_epi8(Pattern[0]);
+	const __m128i Last = _mm_set1_epi8(Pattern[Length - 1]);
+
+	int Misses = 0, i = 0;
+
+	for (; i + Length + 15 <= Size; i += 16)
+	{
+		const __m128i A = _mm_loadu_si128((const __m128i*) (Text + i));
+		const __m128i B = _mm_loadu_si128((const __m128i*) (Text + i + Length - 1));
+
+		unsigned Mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(First, A), _mm_cmpeq_epi8(Last, B)));
+
+		while (Mask)
+		{
+			const int Bit = __builtin_ctz(Mask);
+
+			if (!memcmp(Text + i + Bit + 1, Pattern + 1, Length - 2)) return i + Bit;
+
+			if (++Misses > 64 + i / 8)
+			{
+				const int Found = TwoWaySearch(Text + i, Size - i, Pattern, Length);
+
+				return Found == -1 ? -1 : i + Found;
+			}
+
+			Mask &= Mask - 1;
+		}
+	}
+
+	const int Found = TwoWaySearch(Text + i, Size - i, Pattern, Length);
+
+	return Found == -1 ? -1 : i + Found;
 }
 
-KLString::KLString(int Value)
-: KLString()
+__attribute__((target("avx2")))
+static int SearchAVX2(const char* Text, int Size, const char* Pattern, int Length)
 {
-	char Buffer[32];
+	const __m256i First = _mm256_set1_epi8(Pattern[0]);
+	const __m256i Last = _mm256_set1_epi8(Pattern[Length - 1]);
+
+	int Misses = 0, i = 0;
+
+	for (; i + Length + 31 <= Size; i += 32)
+	{
+		const __m256i A = _mm256_loadu_si256((const __m256i*) (Text + i));
+		const __m256i B = _mm256_loadu_si256((const __m256i*) (Text + i + Length - 1));
+
+		unsigned Mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(First, A), _mm256_cmpeq_epi8(Last, B)));
+
+		while (Mask)
+		{
+			const int Bit = __builtin_ctz(Mask);
+
+			if (!memcmp(Text + i + Bit + 1, Pattern + 1, Length - 2)) return i + Bit;
+
+			if (++Misses > 64 + i / 8)
+			{
+				const int Found = TwoWaySearch(Text + i, Size - i, Pattern, Length);
+
+				return Found == -1 ? -1 : i + Found;
+			}
+
+			Mask &= Mask - 1;
+		}
+	}
+
+	const int Found = SearchSSE2(Text + i, Size - i, Pattern, Length);
+
+	return Found == -1 ? -1 : i + Found;
+}
 
-#ifndef F_CPU
-	snprintf(Buffer, 32, "%i", Value);
-#else
-	itoa(Value, Buffer, 10);
 #endif
 
-	Capacity	= strlen(Buffer);
-	Data		= (char*) malloc(Capacity + 1);
+KLString::KLString(double Value)
+: KLString()
+{
+	char Buffer[KLNumber::BUFFER];
 
-	memcpy(Data, Buffer, Capacity + 1);
+	Insert(Buffer, -1, KLNumber::Format(Value, Buffer));
 }
 
-KLString::KLString(bool Bool)
+KLString::KLString(int Value)
 : KLString()
 {
-	static const char* Buffer[] = {"true", "false"};
+	char Buffer[KLNumber::BUFFER];
 
-	Capacity	= Bool ? 4 : 5;
-	Data		= (char*) malloc(Capacity + 1);
+	Insert(Buffer, -1, KLNumber::Format(Value, Buffer));
+}
 
-	memcpy(Data, Buffer, Capacity + 1);
+KLString::KLString(bool Bool)
+: KLString()
+{
+	Insert(Bool ? "true" : "false");
 }
 
 KLString::KLString(const void* Value)
@@ -76,66 +255,199 @@ KLString::KLString(const void* Value)
 	utoa((unsigned) Value, Buffer, 17);
 #endif
 
-	Capacity	= strlen(Buffer);
-	Data		= (char*) malloc(Capacity + 1);
-
-	memcpy(Data, Buffer, Capacity + 1);
+	Insert(Buffer);
 }
 
 KLString::KLString(char Char)
 : KLString()
 {
-	Data		= (char*) malloc(2);
-
-	Data[0]	= Char;
-	Data[1]	= 0;
-
-	Capacity	= 1;
+	Insert(Char);
 }
 
 KLString::KLString(const char* String)
 : KLString()
 {
-	if (String)
-	{
-		Capacity	= strlen(String);
-		Data		= (char*) malloc(Capacity + 1);
-
-		memcpy(Data, String, Capacity + 1);
-	}
+	Insert(String);
 }
 
 KLString::KLString(const KLString& String)
-: Data(nullptr), Capacity(String.Capacity), Reserved(0)
+: Data(nullptr), Capacity(String.Capacity), Reserved(0), Allocated(0), Hashed(String.Reserved ? 0 : String.Hashed)
 {
+#ifdef KLSTRING_COW
+	if (Capacity && !String.Reserved && String.Allocated)
+	{
+		Header(Data = String.Data)->References.fetch_add(1, std::memory_order_relaxed);
+
+		Allocated = String.Allocated;
+	}
+	else
+#endif
 	if (Capacity)
 	{
-		Data = (char*) malloc(Capacity + 1);
+		Data = Reallocate(nullptr, Allocated = Capacity + 1);
+
+		memcpy(Data, String.Data, Capacity);
 
-		memcpy(Data, String.Data, Capacity + 1);
+		Data[Capacity] = 0;
 	}
 }
 
 KLString::KLString(KLString&& String)
-: Data(String.Data), Capacity(String.Capacity), Reserved(String.Reserved)
+: Data(String.Data), Capacity(String.Capacity), Reserved(String.Reserved), Allocated(String.Allocated), Hashed(String.Hashed)
 {
 	String.Data		= nullptr;
 	String.Capacity	= 0;
 	String.Reserved	= 0;
+	String.Allocated	= 0;
+	String.Hashed		= 0;
 }
 
 KLString::KLString(void)
-: Data(nullptr), Capacity(0), Reserved(0) {}
+: Data(nullptr), Capacity(0), Reserved(0), Allocated(0), Hashed(0) {}
 
 KLString::~KLString(void)
 {
-	if (Data) free(Data);
+	if (Allocated) Deallocate(Data);
+}
+
+KLString KLString::Borrow(const char* String, int Length)
+{
+	KLString Buffer;
+
+	if (String && Length > 0)
+	{
+		Buffer.Data = (char*) String;
+		Buffer.Capacity = Length;
+	}
+
+	return Buffer;
+}
+
+void KLString::Expand(size_t Size)
+{
+	Detach();
+
+	if (Size < Allocated) return;
+
+#ifndef F_CPU
+	const size_t Grown = Allocated + Allocated / 2;
+
+	Allocated = Grown > Size ? Grown : Size + 1;
+#else
+	Allocated = Size + 1;
+#endif
+
+	Data = Reallocate(Data, Allocated);
+}
+
+int KLString::Compare(const char* First, int FirstSize, const char* Second, int SecondSize)
+{
+	const int Size = FirstSize < SecondSize ? FirstSize : SecondSize;
+	const int Result = Size ? memcmp(First, Second, Size) : 0;
+
+	if (Result) return Result;
+	else return (FirstSize > SecondSize) - (FirstSize < SecondSize);
+}
+
+int KLString::Length(void) const
+{
+	if (Reserved) return strlen(Data);
+	else return Capacity;
+}
+
+void KLString::Detach(void)
+{
+	if (Data && !Allocated)
+	{
+		char* Buffer = Reallocate(nullptr, Allocated = Capacity + 1);
+
+		memcpy(Buffer, Data, Capacity);
+		Buffer[Capacity] = 0;
+
+		Data = Buffer;
+
+		return;
+	}
+
+#ifdef KLSTRING_COW
+	if (Data && Header(Data)->References.load(std::memory_order_acquire) > 1)
+	{
+		char* Buffer = Reallocate(nullptr, Allocated = Capacity + 1);
+
+		memcpy(Buffer, Data, Capacity + 1);
+
+		Deallocate(Data);
+
+		Data = Buffer;
+	}
+#endif
+}
+
+char* KLString::Reallocate(char* Buffer, size_t Size)
+{
+#ifdef KLSTRING_COW
+	if (!Buffer)
+	{
+		KLStringHeader* Block = (KLStringHeader*) malloc(sizeof(KLStringHeader) + Size);
+
+		new (&Block->References) std::atomic<int>(1);
+
+		return (char*) (Block + 1);
+	}
+
+	return (char*) (((KLStringHeader*) realloc(Header(Buffer), sizeof(KLStringHeader) + Size)) + 1);
+#else
+	return (char*) realloc(Buffer, Size);
+#endif
+}
+
+void KLString::Deallocate(char* Buffer)
+{
+	if (!Buffer) return;
+
+#ifdef KLSTRING_COW
+	if (Header(Buffer)->References.fetch_sub(1, std::memory_order_acq_rel) == 1) free(Header(Buffer));
+#else
+	free(Buffer);
+#endif
+}
+
+int KLString::Search(const char* Text, int Size, const char* Pattern, int Length)
+{
+	if (Length <= 0) return 0;
+	if (Length > Size) return -1;
+
+	if (Length == 1)
+	{
+		const char* Found = (const char*) memchr(Text, *Pattern, Size);
+
+		return Found ? Found - Text : -1;
+	}
+
+#if defined(F_CPU)
+	for (int i = 0; i <= Size - Length; ++i) if (!memcmp(Text + i, Pattern, Length)) return i;
+
+	return -1;
+#elif defined(KLSTRING_SIMD_SEARCH)
+	using SEARCH = int (*)(const char*, int, const char*, int);
+
+	static const SEARCH Method = __builtin_cpu_supports("avx2") ? SearchAVX2 : SearchSSE2;
+
+	return Method(Text, Size, Pattern, Length);
+#else
+	return TwoWaySearch(Text, Size, Pattern, Length);
+#endif
 }
 
 void KLString::Reserve(size_t Size)
 {
+	Detach();
+
 	Reserved = Size + 1;
-	Data = (char*) realloc(Data, Reserved);
+	Data = Reallocate(Data, Allocated = Reserved);
+
+	Capacity = 0;
+	Hashed = 0;
 
 	Erase();
 }
@@ -143,11 +455,15 @@ void KLString::Reserve(size_t Size)
 void KLString::Refresh(void)
 {
 	if (Reserved) Capacity = strlen(Data);
+
+	Hashed = 0;
 }
 
 void KLString::Erase(void)
 {
 	if (Reserved) memset(Data, 0, Reserved);
+
+	Hashed = 0;
 }
 
 void KLString::Finalize(void)
@@ -155,9 +471,10 @@ void KLString::Finalize(void)
 	if (Reserved)
 	{
 		Capacity = strlen(Data);
-		Data = (char*) realloc(Data ,Capacity + 1);
+		Data = Reallocate(Data, Allocated = Capacity + 1);
 
 		Reserved = 0;
+		Hashed = 0;
 	}
 }
 
@@ -172,138 +489,131 @@ int KLString::Insert(const char* String, int Position, int Length)
 
 	const int Strlen = (Length > 0) ? Length : strlen(String);
 
-	if (!Data)
+	if (Data && String >= Data && String < Data + Allocated)
 	{
-		Data = (char*) malloc(Capacity + Strlen + 1);
+		const KLString Buffer(String);
 
-		memcpy(Data, String, Strlen + 1);
+		return Insert(Buffer.Data, Position, Strlen);
 	}
-	else if (Position < 0 || Position == Capacity)
-	{
-		Data = (char*) realloc(Data, Capacity + Strlen + 1);
 
-		memcpy(Data + Capacity, String, Strlen + 1);
-	}
-	else
-	{
-		char* Buffer = (char*) malloc(Capacity + Strlen + 1);
+	if (Position < 0) Position = Capacity;
 
-		memcpy(Buffer, Data, Position);
-		memcpy(Buffer + Position, String, Strlen);
-		memcpy(Buffer + Position + Strlen, Data + Position, Capacity - Position + 1);
+	Expand(Capacity + Strlen);
 
-		free(Data);
+	memmove(Data + Position + Strlen, Data + Position, Capacity - Position);
+	memcpy(Data + Position, String, Strlen);
 
-		Data = Buffer;
-	}
+	Capacity += Strlen;
+	Hashed = 0;
 
-	return Capacity += Strlen;
+	Data[Capacity] = 0;
+
+	return Capacity;
 }
 
 int KLString::Insert(char Char, int Position)
 {
 	if (!Char || Position > Capacity) return -1;
 
-	if (!Data)
-	{
-		Data = (char*) malloc(2);
+	if (Position < 0) Position = Capacity;
 
-		Data[0] = Char;
-		Data[1] = 0;
-	}
-	else if (Position < 0 || Position == Capacity)
-	{
-		Data = (char*) realloc(Data, Capacity + 2);
+	Expand(Capacity + 1);
 
-		Data[Capacity] = Char;
-		Data[Capacity + 1] = 0;
-	}
-	else
-	{
-		Data = (char*) realloc(Data, Capacity + 2);
+	memmove(Data + Position + 1, Data + Position, Capacity - Position);
 
-		memcpy(Data + Position + 1, Data + Position, Capacity - Position + 1);
+	Data[Position] = Char;
+	Data[++Capacity] = 0;
 
-		Data[Position] = Char;
-	}
+	Hashed = 0;
 
-	return ++Capacity;
+	return Capacity;
 }
 
 int KLString::Delete(const KLString& String, bool All)
 {
-	if (Capacity < String.Capacity) return 0;
+	return Replace(String, KLString(), All);
+}
 
-	int Counter	= 0;
-	int Found		= -1;
+int KLString::Delete(int Start, int Stop)
+{
+	if (Stop > Capacity) Stop = Capacity;
 
-	while ((Found = Find(String)) != -1)
-	{
-		memcpy(Data + Found, Data + String.Capacity, Capacity - Found + 1);
+	if (Stop <= Start) return 0;
 
-		Capacity -= String.Capacity;
+	const int Last = Stop < Capacity ? Stop + 1 : Capacity;
 
-		Counter++;
+	Detach();
 
-		if (!All) break;
-	}
+	memmove(Data + Start, Data + Last, Capacity - Last + 1);
 
-	Data = (char*) realloc(Data, Capacity + 1);
+	Capacity -= Last - Start;
+	Hashed = 0;
 
-	return Counter;
+	return Last - Start;
 }
 
-int KLString::Delete(int Start, int Stop)
+int KLString::Replace(const KLString& Old, const KLString& New, bool All, bool Words)
 {
-	if (Stop > Capacity) Stop = Capacity;
+	if (Capacity < Old.Capacity || !Old.Capacity) return 0;
 
-	if (Stop <= Start) return 0;
+	int Found = Find(Old, 0, 0, Words);
 
-	int NewCap	= Capacity - Stop + Start - 1;
-	int OldCap	= Capacity;
+	if (Found == -1) return 0;
 
-	char* Buffer = (char*) malloc(NewCap + 1);
+	if (!All)
+	{
+		Expand(Capacity - Old.Capacity + New.Capacity);
 
-	memcpy(Buffer, Data, Start);
-	memcpy(Buffer + Start, Data + Stop + 1, OldCap - Stop - 1);
+		memmove(Data + Found + New.Capacity, Data + Found + Old.Capacity, Capacity - Found - Old.Capacity + 1);
+		if (New.Capacity) memcpy(Data + Found, New.Data, New.Capacity);
 
-	Buffer[NewCap] = 0;
+		Capacity -= Old.Capacity - New.Capacity;
+		Hashed = 0;
 
-	free(Data);
+		return 1;
+	}
 
-	Data = Buffer;
+	const int Delta = New.Capacity - Old.Capacity;
 
-	Capacity = NewCap;
+	size_t Size = Capacity + 1 + (Delta > 0 ? Delta : 0);
 
-	return OldCap - NewCap;
-}
+	if (Size < Reserved) Size = Reserved;
 
-int KLString::Replace(const KLString& Old, const KLString& New, bool All, bool Words)
-{
-	if (Capacity < Old.Capacity) return 0;
+	char* Buffer = Reallocate(nullptr, Size);
 
-	int Counter	= 0;
-	int Found		= -1;
+	int Counter = 0, Length = 0, Last = 0;
 
-	while ((Found = Find(Old, 0, 0, Words)) != -1)
+	do
 	{
-		char* Buffer = (char*) malloc(Capacity - Old.Capacity + New.Capacity + 1);
+		const size_t Required = Length + Capacity - Last + (Delta > 0 ? Delta : 0) + 1;
 
-		memcpy(Buffer, Data, Found);
-		memcpy(Buffer + Found, New.Data, New.Capacity);
-		memcpy(Buffer + Found + New.Capacity, Data + Found + Old.Capacity, Capacity - Found - Old.Capacity);
+		if (Required > Size)
+		{
+			Size = Size * 2 > Required ? Size * 2 : Required;
+			Buffer = Reallocate(Buffer, Size);
+		}
 
-		free(Data);
+		memcpy(Buffer + Length, Data + Last, Found - Last);
+		Length += Found - Last;
 
-		Capacity -= Old.Capacity - New.Capacity;
+		if (New.Capacity) memcpy(Buffer + Length, New.Data, New.Capacity);
+		Length += New.Capacity;
 
-		Data = Buffer;
-		Data[Capacity] = 0;
+		Last = Found + Old.Capacity;
 
-		Counter++;
-
-		if (!All) break;
+		++Counter;
 	}
+	while ((Found = Find(Old, Last, 0, Words)) != -1);
+
+	memcpy(Buffer + Length, Data + Last, Capacity - Last + 1);
+	Length += Capacity - Last;
+
+	if (Allocated) Deallocate(Data);
+
+	Data = Buffer;
+	Capacity = Length;
+	Allocated = Size;
+	Hashed = 0;
 
 	return Counter;
 }
@@ -324,28 +634,43 @@ int KLString::Count(const KLString& String, int Start, int Stop, bool Words) con
 
 int KLString::Find(const KLString& String, int Start, int Stop, bool Words) const
 {
-	Stop = ((Stop && Stop < Capacity) ? Stop : Capacity) - String.Capacity + 1;
+	Stop = (Stop && Stop < Capacity) ? Stop : Capacity;
+
+	if (Start < 0) Start = 0;
 
-	for (int i = Start; i < Stop; i++)
+	while (Start + String.Capacity <= Stop)
 	{
-		if (!strncmp(Data + i, String.Data, String.Capacity))
-		{
-			if (Words)
-			{
-				bool Found = true;
+		const int Found = Search(Data + Start, Stop - Start, String.Data, String.Capacity);
 
-				if (i) Found = Found && !isalnum(Data[i - 1]);
-				if (i + String.Capacity < Capacity) Found = Found && !isalnum(Data[i + String.Capacity]);
+		if (Found == -1) return -1;
 
-				if (Found) return i;
-			}
-			else return i;
-		}
+		const int i = Start + Found;
+
+		if (!Words) return i;
+
+		const bool Before = !i || !isalnum((unsigned char) Data[i - 1]);
+		const bool After = i + String.Capacity >= Capacity || !isalnum((unsigned char) Data[i + String.Capacity]);
+
+		if (Before && After) return i;
+
+		Start = i + 1;
 	}
 
 	return -1;
 }
 
+int KLString::Find(char Char, int Start, int Stop) const
+{
+	Stop = (Stop && Stop < Capacity) ? Stop : Capacity;
+
+	if (Start < 0) Start = 0;
+	if (Start >= Stop) return -1;
+
+	const char* Found = (const char*) memchr(Data + Start, Char, Stop - Start);
+
+	return Found ? Found - Data : -1;
+}
+
 KLString KLString::Part(int Start, int Stop) const
 {
 	if (Start >= Stop || Start > Capacity || Stop > Capacity) return KLString();
@@ -353,7 +678,7 @@ KLString KLString::Part(int Start, int Stop) const
 	KLString Buffer;
 
 	Buffer.Capacity = Stop - Start;
-	Buffer.Data = (char*) malloc(Buffer.Capacity + 1);
+	Buffer.Data = Reallocate(nullptr, Buffer.Allocated = Buffer.Capacity + 1);
 
 	memcpy(Buffer.Data, Data + Start, Buffer.Capacity);
 
@@ -362,8 +687,27 @@ KLString KLString::Part(int Start, int Stop) const
 	return Buffer;
 }
 
+KLStringSplit KLString::Split(char Delimiter) const
+{
+	return KLStringSplit(*this, Delimiter);
+}
+
+KLStringSplit KLString::Split(const char* Delimiter) const
+{
+	return KLStringSplit(*this, Delimiter, KLStringSplit::STRING);
+}
+
+KLStringSplit KLString::Tokenize(const char* Delimiters) const
+{
+	return KLStringSplit(*this, Delimiters, KLStringSplit::CLASS);
+}
+
 char& KLString::First(void)
 {
+	Detach();
+
+	Hashed = 0;
+
 	return Data[0];
 }
 
@@ -375,6 +719,10 @@ char KLString::First(void) const
 
 char& KLString::Last(void)
 {
+	Detach();
+
+	Hashed = 0;
+
 	return Data[Capacity - 1];
 }
 
@@ -389,38 +737,92 @@ int KLString::Size(void) const
 	return Capacity;
 }
 
+size_t KLString::Hash(void) const
+{
+	if (Hashed && !Reserved) return Hashed;
+
+	const size_t Result = Hash(Data, Reserved ? strlen(Data) : Capacity);
+
+	if (!Reserved) Hashed = Result;
+
+	return Result;
+}
+
+size_t KLString::Hash(const char* String, int Length)
+{
+#if SIZE_MAX > 0xFFFFFFFFu
+	size_t Result = 14695981039346656037u;
+
+	for (int i = 0; i < Length; ++i) Result = (Result ^ (unsigned char) String[i]) * 1099511628211u;
+#else
+	size_t Result = 2166136261u;
+
+	for (int i = 0; i < Length; ++i) Result = (Result ^ (unsigned char) String[i]) * 16777619u;
+#endif
+
+	return Result ? Result : 1;
+}
+
 void KLString::Clean(void)
 {
 	if (Data)
 	{
-		free(Data);
+		if (Allocated) Deallocate(Data);
 
 		Capacity	= 0;
 		Data		= nullptr;
 	}
+
+	Reserved = Allocated = Hashed = 0;
 }
 
 bool KLString::ToBool(void) const
 {
-	if (Data) return atoi(Data) || !strcmp(Data, "true") || !strcmp(Data, "TRUE");
+	if (Data) return ToInt() || *this == "true" || *this == "TRUE";
 	else return false;
 }
 
 int KLString::ToInt(void) const
 {
-	if (Data) return atoi(Data);
-	else return 0;
+	int Value = 0;
+
+	if (Data)
+	{
+		const char* Begin = Data;
+		const char* End = Data + Capacity;
+
+		while (Begin < End && isspace((unsigned char) *Begin)) ++Begin;
+
+		KLNumber::Parse(Begin, End, Value);
+	}
+
+	return Value;
 }
 
 double KLString::ToNumber(void) const
 {
-	if (Data) return atof(Data);
-	else return 0.0;
+	double Value = 0.0;
+
+	if (Data)
+	{
+		const char* Begin = Data;
+		const char* End = Data + Capacity;
+
+		while (Begin < End && isspace((unsigned char) *Begin)) ++Begin;
+
+		KLNumber::Parse(Begin, End, Value);
+	}
+
+	return Value;
 }
 
 
 char& KLString::operator[] (int ID)
 {
+	Detach();
+
+	Hashed = 0;
+
 	return Data[ID];
 }
 
@@ -436,16 +838,21 @@ bool KLString::operator== (const KLString& String) const
 {
 	if (this == &String)
 		return true;
+	else if (Reserved || String.Reserved)
+		return !Compare(Data, Length(), String.Data, String.Length());
+	else if (Capacity != String.Capacity)
+		return false;
+	else if (!Capacity)
+		return true;
+	else if (Hash() != String.Hash())
+		return false;
 	else
-		return !strcmp(Data ? Data : "", String.Data ? String.Data : "");
+		return !memcmp(Data, String.Data, Capacity);
 }
 
 bool KLString::operator!= (const KLString& String) const
 {
-	if (this == &String)
-		return false;
-	else
-		return strcmp(Data ? Data : "", String.Data ? String.Data : "");
+	return !(*this == String);
 }
 
 bool KLString::operator== (const char* String) const
@@ -453,40 +860,48 @@ bool KLString::operator== (const char* String) const
 	if (Data == String)
 		return true;
 	else
-		return !strcmp(Data ? Data : "", String);
+		return !Compare(Data, Length(), String, String ? strlen(String) : 0);
 }
 
 bool KLString::operator!= (const char* String) const
 {
-	return strcmp(Data ? Data : "", String);
+	return !(*this == String);
 }
 
 bool KLString::operator> (const KLString& String) const
 {
-	return strcmp(Data ? Data : "", String.Data ? String.Data : "") < 0;
+	return Compare(Data, Length(), String.Data, String.Length()) < 0;
 }
 
 bool KLString::operator< (const KLString& String) const
 {
-	return strcmp(Data ? Data : "", String.Data ? String.Data : "") > 0;
+	return Compare(Data, Length(), String.Data, String.Length()) > 0;
 }
 
 KLString KLString::operator+ (const KLString& String) const
 {
+	const int Strlen = String.Length();
+
 	KLString Buffer;
 
-	Buffer.Insert(Data);
-	Buffer.Insert(String.Data);
+	Buffer.Expand(Capacity + Strlen);
+
+	if (Capacity) Buffer.Insert(Data, -1, Capacity);
+	if (Strlen) Buffer.Insert(String.Data, -1, Strlen);
 
 	return Buffer;
 }
 
 KLString KLString::operator+ (const char* String) const
 {
+	const int Strlen = String ? strlen(String) : 0;
+
 	KLString Buffer;
 
-	Buffer.Insert(Data);
-	Buffer.Insert(String);
+	Buffer.Expand(Capacity + Strlen);
+
+	if (Capacity) Buffer.Insert(Data, -1, Capacity);
+	if (Strlen) Buffer.Insert(String, -1, Strlen);
 
 	return Buffer;
 }
@@ -495,7 +910,10 @@ KLString KLString::operator+ (char Char) const
 {
 	KLString Buffer;
 
-	Buffer.Insert(Data);
+	Buffer.Expand(Capacity + 1);
+
+	if (Capacity) Buffer.Insert(Data, -1, Capacity);
+
 	Buffer.Insert(Char);
 
 	return Buffer;
@@ -505,29 +923,62 @@ KLString& KLString::operator= (const KLString& String)
 {
 	if (this == &String) return *this;
 
-	Clean();
+#ifdef KLSTRING_COW
+	if (String.Capacity && !String.Reserved && String.Allocated)
+	{
+		Header(String.Data)->References.fetch_add(1, std::memory_order_relaxed);
+
+		if (Allocated) Deallocate(Data);
+
+		Data = String.Data;
+		Capacity = String.Capacity;
+		Allocated = String.Allocated;
+		Reserved = 0;
+		Hashed = String.Hashed;
 
-	Insert(String.Data);
+		return *this;
+	}
+#endif
+
+	Detach();
+
+	Capacity = Reserved = 0;
+
+	if (Data) Data[0] = 0;
+
+	if (String.Capacity) Insert(String.Data, -1, String.Capacity);
+
+	Hashed = String.Reserved ? 0 : String.Hashed;
 
 	return *this;
 }
 
 KLString& KLString::operator= (KLString&& String)
 {
+	if (this == &String) return *this;
+
 	Clean();
 
 	Data = String.Data;
 
 	Capacity = String.Capacity;
+	Reserved = String.Reserved;
+	Allocated = String.Allocated;
+	Hashed = String.Hashed;
 
 	String.Data = nullptr;
 
+	String.Capacity = 0;
+	String.Reserved = 0;
+	String.Allocated = 0;
+	String.Hashed = 0;
+
 	return *this;
 }
 
 KLString& KLString::operator+= (const KLString& String)
 {
-	Insert(String.Data);
+	if (String.Capacity) Insert(String.Data, -1, String.Capacity);
 
 	return *this;
 }
@@ -23,6 +23,8 @@
 
 #include "../libbuild.hpp"
 
+#include "klnumber.hpp"
+
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -38,10 +40,16 @@
  *
  */
 
+class KLStringSplit;
+
 /*! \brief	Lekka interpretacja łańcucha znaków.
  *
  * Prosta i lekka interpretacja łańcucha znaków. Wymaga jedynie kilku podstawowych funkcji biblioteki `string.h`.
  *
+ * Łańcuch może też wskazywać na cudzy bufor tylko do odczytu (`Borrow()`), co pozwala przetwarzać duże teksty bez ich kopiowania.
+ *
+ * Po zdefiniowaniu `USING_COW` (poza platformą AVR) kopie łańcucha współdzielą bufor z licznikiem referencji, więc kopiowanie ma stały koszt. Pierwsza operacja modyfikująca kopię (w tym wywołanie niestałego `operator[]`, `First()` i `Last()`) tworzy jej własny bufor. Łańcuchy w trybie rezerwacji (`Reserve()`) są zawsze kopiowane.
+ *
  */
 class KLLIBS_EXPORT KLString
 {
@@ -54,12 +62,85 @@ class KLLIBS_EXPORT KLString
 
 		size_t Reserved;	//!< Ilość zarezerwowanych danych.
 
+		size_t Allocated;	//!< Ilość przydzielonej pamięci.
+
+		mutable size_t Hashed;	//!< Zapamiętany skrót łańcucha lub `0` gdy nie został obliczony.
+
+		/*! \brief		Zapewnienie miejsca na dane.
+		 *  \param [in]	Size Wymagana liczba znaków.
+		 *
+		 * Powiększa bufor tak, aby zmieścił podaną liczbę znaków i kończące zero. Na platformach innych niż AVR bufor rośnie geometrycznie, dzięki czemu seria dopisań wymaga jedynie logarytmicznej liczby realokacji.
+		 *
+		 */
+		void Expand(size_t Size);
+
+		/*! \brief		Uzyskanie wyłącznego bufora.
+		 *
+		 * Jeśli bufor jest współdzielony z innymi łańcuchami (tryb `USING_COW`), tworzy jego prywatną kopię. W pozostałych przypadkach nie robi nic.
+		 *
+		 */
+		void Detach(void);
+
+		/*! \brief		Przydział pamięci bufora.
+		 *  \param [in]	Buffer	Dotychczasowy bufor lub `nullptr`.
+		 *  \param [in]	Size		Wymagany rozmiar w bajtach.
+		 *  \return		Wskaźnik na bufor o podanym rozmiarze.
+		 *
+		 * Odpowiednik `realloc` uwzględniający licznik referencji w trybie `USING_COW`. Bufor nie może być współdzielony.
+		 *
+		 */
+		static char* Reallocate(char* Buffer, size_t Size);
+
+		/*! \brief		Zwolnienie bufora.
+		 *  \param [in]	Buffer Bufor do zwolnienia lub `nullptr`.
+		 *
+		 * Odpowiednik `free`. W trybie `USING_COW` zmniejsza licznik referencji i zwalnia pamięć dopiero po odłączeniu ostatniego łańcucha.
+		 *
+		 */
+		static void Deallocate(char* Buffer);
+
+		/*! \brief		Wyszukiwanie wzorca.
+		 *  \param [in]	Text		Przeszukiwany tekst.
+		 *  \param [in]	Size		Długość tekstu.
+		 *  \param [in]	Pattern	Wyszukiwany wzorzec.
+		 *  \param [in]	Length	Długość wzorca.
+		 *  \return		Miejsce pierwszego wystąpienia lub -1 gdy nic nie znaleziono.
+		 *
+		 * Na procesorach x86 kandydaci wybierani są porównaniem pierwszego i ostatniego znaku wzorca w blokach SSE2 lub AVX2 (wybór następuje podczas działania programu). Gdy filtr zwraca zbyt wiele fałszywych trafień wyszukiwanie kończy algorytm Two-Way o liniowym czasie działania. Na platformie AVR używane jest proste porównanie.
+		 *
+		 */
+		static int Search(const char* Text, int Size, const char* Pattern, int Length);
+
+		/*! \brief		Porównanie danych.
+		 *  \param [in]	First	Pierwszy ciąg znaków.
+		 *  \param [in]	FirstSize	Długość pierwszego ciągu.
+		 *  \param [in]	Second	Drugi ciąg znaków.
+		 *  \param [in]	SecondSize	Długość drugiego ciągu.
+		 *  \return		Wynik porównania zgodny z `strcmp`.
+		 *
+		 * Porównuje ciągi o znanej długości, więc nie wymaga kończącego zera (np. dla łańcuchów utworzonych metodą `Borrow()`).
+		 *
+		 */
+		static int Compare(const char* First, int FirstSize, const char* Second, int SecondSize);
+
+		/*! \brief		Długość danych.
+		 *  \return		Liczba znaków łańcucha.
+		 *
+		 * Dla łańcucha w trybie rezerwacji (`Reserve()`) długość liczona jest do kończącego zera.
+		 *
+		 */
+		int Length(void) const;
+
+		friend class KLStringBuilder;
+		friend class KLStringSplit;
+		template<int> friend class KLStaticString;
+
 	public:
 
 		/*! \brief		Konstruktor konwertujący z typu `double`.
 		 *  \param [in]	Value Wybrana liczba.
 		 *
-		 * Tworzy obiekt konwertując liczbę do postaci łańcucha znaków.
+		 * Tworzy obiekt konwertując liczbę do najkrótszej postaci łańcucha znaków, która pozwala odtworzyć dokładnie tą samą wartość (`KLNumber::Format`).
 		 *
 		 */
 		KLString(double Value);
@@ -134,13 +215,23 @@ class KLLIBS_EXPORT KLString
 		 */
 		~KLString(void);
 
+		/*! \brief		Łańcuch korzystający z zewnętrznego bufora.
+		 *  \param [in]	String	Tekst zakończony zerem.
+		 *  \param [in]	Length	Długość tekstu (bez kończącego zera).
+		 *  \return		Łańcuch wskazujący bezpośrednio na podany tekst.
+		 *
+		 * Tworzy łańcuch bez kopiowania danych i bez przejmowania bufora na własność (np. dla pliku odwzorowanego w pamięci). Bufor musi pozostać niezmieniony do końca życia łańcucha, a znak `String[Length]` musi być zerem. Kopie łańcucha oraz pierwsza operacja modyfikująca tworzą własny bufor.
+		 *
+		 */
+		static KLString Borrow(const char* String, int Length);
+
 		/*! \brief		Rezerwacja miejsca na dane.
 		 *  \param [in]	Size Liczba bajtów do zarezerwowania.
 		 *  \warning		Przed rozpoczęciem stałych operacji na łańcuchu użyj metody `Refresh()`.
 		 *  \warning		Przed rozpoczęciem operacji modyfikujących łańcuch użyj metody `Finalize()`.
 		 *  \see			Finalize(), Refresh().
 		 *
-		 * Czyści łańcuch i rezerwuje wybraną ilość bajtów na znaki. Znaki można wprowadzać za pomocą operatora wyłuskania. Po zarezerwowaniu wszystkie znaki mają wartość `0`.
+		 * Czyści łańcuch i rezerwuje wybraną ilość bajtów na znaki. Znaki można wprowadzać za pomocą operatora wyłuskania. Po zarezerwowaniu wszystkie znaki mają wartość `0`. Do zwykłego dopisywania danych nie jest wymagana, ponieważ bufor łańcucha rośnie automatycznie.
 		 *
 		 */
 		void Reserve(size_t Size);
@@ -209,7 +300,7 @@ class KLLIBS_EXPORT KLString
 		 *  \param [in]	All		Usuń wszystkie wystąpienia.
 		 *  \return		Ilość usunięć.
 		 *
-		 * Usuwa z łańcucha wybrany łańcuch.
+		 * Usuwa z łańcucha wybrany łańcuch. Usunięcie wszystkich wystąpień odbywa się w jednym przebiegu.
 		 *
 		 */
 		int Delete(const KLString& String, bool All = false);
@@ -231,7 +322,7 @@ class KLLIBS_EXPORT KLString
 		 *  \param [in]	Words	Wyszukuje dopasowań pełnych słów.
 		 *  \return		Ilość zmienionych fraz.
 		 *
-		 * Usuwa z łańcucha wybrany łańcuch i wstawia na jego miejsce nowy.
+		 * Usuwa z łańcucha wybrany łańcuch i wstawia na jego miejsce nowy. Zamiana wszystkich wystąpień odbywa się w jednym przebiegu do nowego bufora, a wstawione fragmenty nie są ponownie przeszukiwane.
 		 *
 		 */
 		int Replace(const KLString& Old, const KLString& New, bool All = false, bool Words = false);
@@ -260,6 +351,17 @@ class KLLIBS_EXPORT KLString
 		 */
 		int Find(const KLString& String, int Start = 0, int Stop = 0, bool Words = false) const;
 
+		/*! \brief		Wyszukiwanie znaku.
+		 *  \param [in]	Char		Znak do wyszukania.
+		 *  \param [in]	Start	Początek wyszukiwania.
+		 *  \param [in]	Stop		Koniec wyszukiwania.
+		 *  \return		Miejsce wystąpienia numerowane od zera lub -1 gdy nic nie znaleziono.
+		 *
+		 * Szuka w łańcuchu wybranego znaku przy pomocy `memchr` i zwraca miejsce pierwszego wystąpienia.
+		 *
+		 */
+		int Find(char Char, int Start = 0, int Stop = 0) const;
+
 		/*! \brief		Kopia części łańcucha.
 		 *  \param [in]	Start	Początek ciągu.
 		 *  \param [in]	Stop		Koniec ciągu.
@@ -270,6 +372,33 @@ class KLLIBS_EXPORT KLString
 		 */
 		KLString Part(int Start, int Stop) const;
 
+		/*! \brief		Podział łańcucha na znaku.
+		 *  \param [in]	Delimiter Znak rozdzielający.
+		 *  \return		Zakres kolejnych pól.
+		 *
+		 * Zwraca leniwy zakres pól (`KLStringView`) rozdzielonych podanym znakiem. Puste pola są zwracane, więc `n` znaków rozdzielających daje `n + 1` pól. Podział nie przydziela pamięci, a zwracane pola są ważne do czasu modyfikacji łańcucha.
+		 *
+		 */
+		KLStringSplit Split(char Delimiter) const;
+
+		/*! \brief		Podział łańcucha na ciągu znaków.
+		 *  \param [in]	Delimiter Ciąg rozdzielający.
+		 *  \return		Zakres kolejnych pól.
+		 *
+		 * Zwraca leniwy zakres pól (`KLStringView`) rozdzielonych podanym ciągiem. Puste pola są zwracane. Ciąg rozdzielający musi pozostać ważny w trakcie iteracji.
+		 *
+		 */
+		KLStringSplit Split(const char* Delimiter) const;
+
+		/*! \brief		Podział łańcucha na słowa.
+		 *  \param [in]	Delimiters Zbiór znaków rozdzielających.
+		 *  \return		Zakres kolejnych słów.
+		 *
+		 * Zwraca leniwy zakres niepustych pól (`KLStringView`) rozdzielonych dowolnymi znakami z podanego zbioru (np. `" \t\n"`). Kolejne znaki rozdzielające traktowane są jak jeden.
+		 *
+		 */
+		KLStringSplit Tokenize(const char* Delimiters) const;
+
 		/*! \brief		Wybór pierwszego elementu.
 		 *  \return		Referencja do pierwszego elementu.
 		 *  \warning		Gdy element o podanym indeksie nie istnieje to zwrócona zostanie niepoprawna referencja do `nullptr` co zapewne spowoduje krytyczny wyjątek.
@@ -312,6 +441,26 @@ class KLLIBS_EXPORT KLString
 		 */
 		int Size(void) const;
 
+		/*! \brief		Skrót łańcucha.
+		 *  \return		Skrót FNV-1a zawartości łańcucha (zawsze różny od zera).
+		 *
+		 * Oblicza skrót przy pierwszym wywołaniu i zapamiętuje go do czasu modyfikacji łańcucha. Każda metoda modyfikująca łańcuch (także wywołanie niestałego `operator[]`, `First()` i `Last()`) unieważnia zapamiętany skrót.
+		 *
+		 * Obiekty współdzielone przez kilka wątków powinny mieć skrót obliczony przed udostępnieniem.
+		 *
+		 */
+		size_t Hash(void) const;
+
+		/*! \brief		Skrót fragmentu tekstu.
+		 *  \param [in]	String Początek tekstu.
+		 *  \param [in]	Length Długość tekstu.
+		 *  \return		Skrót FNV-1a tekstu (zawsze różny od zera).
+		 *
+		 * Oblicza skrót zgodny z metodą `Hash()` bez tworzenia obiektu `KLString`.
+		 *
+		 */
+		static size_t Hash(const char* String, int Length);
+
 		/*! \brief		Czyszczenie łańcucha.
 		 *
 		 * Usuwa wszystkie znaki z łańcucha.
@@ -330,7 +479,7 @@ class KLLIBS_EXPORT KLString
 		/*! \brief		Operator konwersji na `int`.
 		 *  \return		Interpretacja łańcucha jako liczba całkowita.
 		 *
-		 * Zwraca wynik funkcji `atoi` użytej na łańcuchu.
+		 * Pomija początkowe białe znaki i odczytuje liczbę przy pomocy `KLNumber::Parse`. Zwraca `0` gdy łańcuch nie zaczyna się od liczby.
 		 *
 		 */
 		int ToInt(void) const;
@@ -338,7 +487,7 @@ class KLLIBS_EXPORT KLString
 		/*! \brief		Operator konwersji na `double`.
 		 *  \return		Interpretacja łańcucha jako liczba zmiennoprzecinkowa.
 		 *
-		 * Zwraca wynik funkcji `atof` użytej na łańcuchu.
+		 * Pomija początkowe białe znaki i odczytuje liczbę przy pomocy `KLNumber::Parse` niezależnie od ustawień regionalnych. Zwraca `0` gdy łańcuch nie zaczyna się od liczby.
 		 *
 		 */
 		double ToNumber(void) const;
@@ -367,7 +516,7 @@ class KLLIBS_EXPORT KLString
 		 *  \param [in]	String Łańcuch do porównania.
 		 *  \return		`true` jeśli łańcuchy są jednakowe, lub `false` gdy są różne.
 		 *
-		 * Dokonuje porównania łańcuchów i zwraca rezultat operacji.
+		 * Dokonuje porównania łańcuchów i zwraca rezultat operacji. Najpierw porównywane są długości, a następnie zapamiętane skróty łańcuchów, więc różne łańcuchy są zwykle odrzucane bez porównywania znaków.
 		 *
 		 */
 		bool operator== (const KLString& String) const;
@@ -494,4 +643,6 @@ class KLLIBS_EXPORT KLString
 
 };
 
+#include "klstringview.hpp"
+
 #endif // KLSTRING_HPP
@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight String Builder interpretation for KLLibs                   *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klstringbuilder.hpp"
+
+KLStringBuilder::KLStringBuilder(size_t Size)
+: Data(nullptr), Capacity(0), Allocated(0)
+{
+	if (Size) Reserve(Size);
+}
+
+KLStringBuilder::~KLStringBuilder(void)
+{
+	KLString::Deallocate(Data);
+}
+
+char* KLStringBuilder::Expand(size_t Size)
+{
+	const size_t Required = Capacity + Size + 1;
+
+	if (Required > Allocated)
+	{
+#ifndef F_CPU
+		const size_t Grown = Allocated * 2;
+
+		Allocated = Grown > Required ? Grown : Required;
+#else
+		Allocated = Required;
+#endif
+
+		Data = KLString::Reallocate(Data, Allocated);
+	}
+
+	return Data + Capacity;
+}
+
+void KLStringBuilder::Reserve(size_t Size)
+{
+	if (Size + 1 > Allocated) Data = KLString::Reallocate(Data, Allocated = Size + 1);
+}
+
+KLStringBuilder& KLStringBuilder::Append(const char* String, int Length)
+{
+	if (!String) return *this;
+
+	const int Strlen = (Length >= 0) ? Length : strlen(String);
+
+	memcpy(Expand(Strlen), String, Strlen);
+
+	Capacity += Strlen;
+
+	return *this;
+}
+
+KLStringBuilder& KLStringBuilder::Append(const KLString& String)
+{
+	return Append(String.Data, String.Capacity);
+}
+
+KLStringBuilder& KLStringBuilder::Append(char Char)
+{
+	*Expand(1) = Char;
+
+	Capacity += 1;
+
+	return *this;
+}
+
+KLStringBuilder& KLStringBuilder::Append(int Value)
+{
+	Capacity += KLNumber::Format(Value, Expand(KLNumber::BUFFER));
+
+	return *this;
+}
+
+KLStringBuilder& KLStringBuilder::Append(double Value)
+{
+	Capacity += KLNumber::Format(Value, Expand(KLNumber::BUFFER));
+
+	return *this;
+}
+
+KLStringBuilder& KLStringBuilder::Append(bool Bool)
+{
+	return Bool ? Append("true", 4) : Append("false", 5);
+}
+
+int KLStringBuilder::Size(void) const
+{
+	return Capacity;
+}
+
+void KLStringBuilder::Clean(void)
+{
+	Capacity = 0;
+}
+
+KLString KLStringBuilder::Release(void)
+{
+	KLString Buffer;
+
+	if (Capacity)
+	{
+		Data[Capacity] = 0;
+
+		Buffer.Data = Data;
+		Buffer.Capacity = Capacity;
+		Buffer.Allocated = Allocated;
+	}
+	else KLString::Deallocate(Data);
+
+	Data = nullptr;
+	Capacity = 0;
+	Allocated = 0;
+
+	return Buffer;
+}
+
+KLStringBuilder& KLStringBuilder::operator << (const KLString& Input)
+{
+	return Append(Input);
+}
+
+KLStringBuilder& KLStringBuilder::operator << (const char* Input)
+{
+	return Append(Input);
+}
+
+KLStringBuilder& KLStringBuilder::operator << (char Input)
+{
+	return Append(Input);
+}
+
+KLStringBuilder& KLStringBuilder::operator << (int Input)
+{
+	return Append(Input);
+}
+
+KLStringBuilder& KLStringBuilder::operator << (double Input)
+{
+	return Append(Input);
+}
+
+KLStringBuilder& KLStringBuilder::operator << (bool Input)
+{
+	return Append(Input);
+}
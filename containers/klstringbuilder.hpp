@@ -0,0 +1,178 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight String Builder interpretation for KLLibs                   *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTRINGBUILDER_HPP
+#define KLSTRINGBUILDER_HPP
+
+#include "../libbuild.hpp"
+
+#include "klstring.hpp"
+
+/*! \file		klstringbuilder.hpp
+ *  \brief	Deklaracje dla klasy KLStringBuilder i jej składników.
+ *
+ */
+
+/*! \file		klstringbuilder.cpp
+ *  \brief	Implementacja klasy KLStringBuilder i jej składników.
+ *
+ */
+
+/*! \brief	Budowniczy łańcuchów znaków.
+ *
+ * Gromadzi fragmenty tekstu i liczby w jednym geometrycznie rosnącym buforze. Gotowy bufor jest przekazywany do `KLString` bez kopiowania, więc zbudowanie łańcucha z wielu fragmentów wymaga jedynie logarytmicznej liczby alokacji.
+ *
+ */
+class KLLIBS_EXPORT KLStringBuilder
+{
+
+	protected:
+
+		char* Data;		//!< Wskaźnik na bufor.
+
+		int Capacity;		//!< Ilość zapisanych znaków.
+
+		size_t Allocated;	//!< Ilość przydzielonej pamięci.
+
+		/*! \brief		Zapewnienie miejsca na dane.
+		 *  \param [in]	Size Liczba dopisywanych znaków.
+		 *  \return		Wskaźnik na miejsce dopisania znaków.
+		 *
+		 * Powiększa bufor tak, aby zmieścił podaną liczbę dodatkowych znaków i kończące zero.
+		 *
+		 */
+		char* Expand(size_t Size);
+
+	public:
+
+		/*! \brief		Domyślny konstruktor.
+		 *  \param [in]	Size Wstępnie rezerwowana liczba znaków.
+		 *
+		 * Inicjuje wszystkie pola obiektu i opcjonalnie rezerwuje pamięć.
+		 *
+		 */
+		explicit KLStringBuilder(size_t Size = 0);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Zwalnia wszystkie użyte zasoby.
+		 *
+		 */
+		~KLStringBuilder(void);
+
+		KLStringBuilder(const KLStringBuilder&) = delete;
+		KLStringBuilder& operator= (const KLStringBuilder&) = delete;
+
+		/*! \brief		Rezerwacja miejsca na dane.
+		 *  \param [in]	Size Liczba znaków.
+		 *
+		 * Rezerwuje pamięć dla podanej łącznej liczby znaków.
+		 *
+		 */
+		void Reserve(size_t Size);
+
+		/*! \brief		Dopisanie łańcucha.
+		 *  \param [in]	String	Łańcuch do dopisania.
+		 *  \param [in]	Length	Długość łańcucha lub `-1` dla obliczenia jej automatycznie.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Dopisuje podany łańcuch na koniec bufora.
+		 *
+		 */
+		KLStringBuilder& Append(const char* String, int Length = -1);
+
+		/*! \brief		Dopisanie łańcucha.
+		 *  \param [in]	String Łańcuch do dopisania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Dopisuje podany łańcuch na koniec bufora.
+		 *
+		 */
+		KLStringBuilder& Append(const KLString& String);
+
+		/*! \brief		Dopisanie znaku.
+		 *  \param [in]	Char Znak do dopisania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Dopisuje podany znak na koniec bufora.
+		 *
+		 */
+		KLStringBuilder& Append(char Char);
+
+		/*! \brief		Dopisanie liczby.
+		 *  \param [in]	Value Liczba do dopisania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Dopisuje tekstową reprezentację liczby bez tworzenia tymczasowego łańcucha.
+		 *
+		 */
+		KLStringBuilder& Append(int Value);
+
+		/*! \brief		Dopisanie liczby.
+		 *  \param [in]	Value Liczba do dopisania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Dopisuje tekstową reprezentację liczby bez tworzenia tymczasowego łańcucha.
+		 *
+		 */
+		KLStringBuilder& Append(double Value);
+
+		/*! \brief		Dopisanie wartości logicznej.
+		 *  \param [in]	Bool Wartość do dopisania.
+		 *  \return		Referencja do bierzącego obiektu.
+		 *
+		 * Dopisuje `true` lub `false`.
+		 *
+		 */
+		KLStringBuilder& Append(bool Bool);
+
+		/*! \brief		Sprawdzenie ilości znaków.
+		 *  \return		Aktualna liczba znaków.
+		 *
+		 * Zwraca liczbę zgromadzonych znaków.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Czyszczenie bufora.
+		 *
+		 * Usuwa zgromadzone znaki pozostawiając przydzieloną pamięć.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Utworzenie łańcucha.
+		 *  \return		Łańcuch zawierający zgromadzone znaki.
+		 *
+		 * Przekazuje bufor do nowego obiektu `KLString` bez kopiowania danych. Po wywołaniu budowniczy jest pusty.
+		 *
+		 */
+		KLString Release(void);
+
+		KLStringBuilder& operator << (const KLString& Input);
+		KLStringBuilder& operator << (const char* Input);
+		KLStringBuilder& operator << (char Input);
+		KLStringBuilder& operator << (int Input);
+		KLStringBuilder& operator << (double Input);
+		KLStringBuilder& operator << (bool Input);
+
+};
+
+#endif // KLSTRINGBUILDER_HPP
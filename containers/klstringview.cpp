@@ -0,0 +1,305 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight String View interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klstringview.hpp"
+
+#if !defined(F_CPU) && defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define KLSTRINGVIEW_SIMD_SCAN
+#include <immintrin.h>
+#endif
+
+KLStringView::KLStringView(void)
+: Begin(""), Length(0) {}
+
+KLStringView::KLStringView(const char* String, int Size)
+: Begin(String ? String : ""), Length(String && Size > 0 ? Size : 0) {}
+
+KLStringView::KLStringView(const char* String)
+: KLStringView(String, String ? strlen(String) : 0) {}
+
+KLStringView::KLStringView(const KLString& String)
+: KLStringView((const char*) String, String.Size()) {}
+
+const char* KLStringView::Data(void) const
+{
+	return Begin;
+}
+
+int KLStringView::Size(void) const
+{
+	return Length;
+}
+
+KLStringView KLStringView::Part(int Start, int Stop) const
+{
+	if (Start < 0) Start = 0;
+	if (Stop > Length) Stop = Length;
+
+	if (Start >= Stop) return KLStringView();
+
+	return KLStringView(Begin + Start, Stop - Start);
+}
+
+KLStringView KLStringView::Trimmed(void) const
+{
+	int Start = 0, Stop = Length;
+
+	while (Start < Stop && isspace((unsigned char) Begin[Start])) ++Start;
+	while (Stop > Start && isspace((unsigned char) Begin[Stop - 1])) --Stop;
+
+	return KLStringView(Begin + Start, Stop - Start);
+}
+
+KLStringSplit KLStringView::Split(char Delimiter) const
+{
+	return KLStringSplit(*this, Delimiter);
+}
+
+KLStringSplit KLStringView::Split(const char* Delimiter) const
+{
+	return KLStringSplit(*this, Delimiter, KLStringSplit::STRING);
+}
+
+KLStringSplit KLStringView::Tokenize(const char* Delimiters) const
+{
+	return KLStringSplit(*this, Delimiters, KLStringSplit::CLASS);
+}
+
+KLString KLStringView::ToString(void) const
+{
+	KLString Buffer;
+
+	if (Length) Buffer.Insert(Begin, -1, Length);
+
+	return Buffer;
+}
+
+size_t KLStringView::Hash(void) const
+{
+	return KLString::Hash(Begin, Length);
+}
+
+int KLStringView::ToInt(void) const
+{
+	const KLStringView Text = Trimmed();
+
+	int Value = 0;
+
+	KLNumber::Parse(Text.Begin, Text.Begin + Text.Length, Value);
+
+	return Value;
+}
+
+double KLStringView::ToNumber(void) const
+{
+	const KLStringView Text = Trimmed();
+
+	double Value = 0.0;
+
+	KLNumber::Parse(Text.Begin, Text.Begin + Text.Length, Value);
+
+	return Value;
+}
+
+char KLStringView::operator[] (int ID) const
+{
+	if (ID >= 0 && ID < Length)
+		return Begin[ID];
+	else
+		return 0;
+}
+
+bool KLStringView::operator== (const KLStringView& String) const
+{
+	return Length == String.Length && !memcmp(Begin, String.Begin, Length);
+}
+
+bool KLStringView::operator!= (const KLStringView& String) const
+{
+	return !(*this == String);
+}
+
+KLStringSplit::KLStringSplitIterator::KLStringSplitIterator(const KLStringSplit* Split, const char* Begin)
+: Owner(Split), Next(Begin)
+{
+	Advance();
+}
+
+void KLStringSplit::KLStringSplitIterator::Advance(void)
+{
+	if (!Next)
+	{
+		Owner = nullptr;
+		Field = KLStringView();
+
+		return;
+	}
+
+	const char* End = Owner->Text.Data() + Owner->Text.Size();
+	const char* Stop = End;
+
+	switch (Owner->Mode)
+	{
+		case CHAR:
+		{
+			const char* Found = (const char*) memchr(Next, Owner->Set[0], End - Next);
+
+			if (Found) Stop = Found;
+		}
+		break;
+
+		case STRING:
+		{
+			const int Found = KLString::Search(Next, End - Next, Owner->Delimiter, Owner->Length);
+
+			if (Owner->Length && Found != -1) Stop = Next + Found;
+		}
+		break;
+
+		case CLASS:
+		{
+			Next = Owner->Scan(Next, End, false);
+
+			if (Next == End)
+			{
+				Owner = nullptr;
+				Next = nullptr;
+				Field = KLStringView();
+
+				return;
+			}
+
+			Stop = Owner->Scan(Next, End, true);
+		}
+		break;
+	}
+
+	Field = KLStringView(Next, Stop - Next);
+
+	if (Owner->Mode == CLASS) Next = Stop;
+	else if (Stop == End) Next = nullptr;
+	else Next = Stop + (Owner->Mode == CHAR ? 1 : Owner->Length);
+}
+
+const KLStringView& KLStringSplit::KLStringSplitIterator::operator* (void) const
+{
+	return Field;
+}
+
+KLStringSplit::KLStringSplitIterator& KLStringSplit::KLStringSplitIterator::operator++ (void)
+{
+	Advance();
+
+	return *this;
+}
+
+bool KLStringSplit::KLStringSplitIterator::operator!= (const KLStringSplitIterator& Iterator) const
+{
+	return Owner != Iterator.Owner || Next != Iterator.Next || Field.Data() != Iterator.Field.Data();
+}
+
+KLStringSplit::KLStringSplit(const KLStringView& String, char Char)
+: Text(String), Delimiter(nullptr), Length(0), Count(1), Mode(CHAR)
+{
+	memset(Table, 0, sizeof(Table));
+
+	Set[0] = Char;
+}
+
+KLStringSplit::KLStringSplit(const KLStringView& String, const char* Delimiters, MODE Type)
+: Text(String), Delimiter(Delimiters ? Delimiters : ""), Length(strlen(Delimiter)), Count(0), Mode(Type)
+{
+	memset(Table, 0, sizeof(Table));
+
+	if (Mode != CLASS) return;
+
+	for (int i = 0; i < Length; ++i)
+	{
+		const unsigned char Char = Delimiter[i];
+
+		if (Table[Char >> 3] & (1 << (Char & 7))) continue;
+
+		Table[Char >> 3] |= 1 << (Char & 7);
+
+		if (Count < 16) Set[Count] = Char;
+
+		++Count;
+	}
+
+	if (Count > 16) Count = 17;
+
+	Delimiter = nullptr;
+	Length = 0;
+}
+
+const char* KLStringSplit::Scan(const char* Begin, const char* End, bool Member) const
+{
+#ifdef KLSTRINGVIEW_SIMD_SCAN
+	if (Count && Count <= 16)
+	{
+		const int Flip = Member ? 0 : 0xFFFF;
+
+		while (End - Begin >= 16)
+		{
+			const __m128i Block = _mm_loadu_si128((const __m128i*) Begin);
+
+			__m128i Hits = _mm_cmpeq_epi8(Block, _mm_set1_epi8(Set[0]));
+
+			for (int i = 1; i < Count; ++i) Hits = _mm_or_si128(Hits, _mm_cmpeq_epi8(Block, _mm_set1_epi8(Set[i])));
+
+			const int Mask = _mm_movemask_epi8(Hits) ^ Flip;
+
+			if (Mask) return Begin + __builtin_ctz(Mask);
+
+			Begin += 16;
+		}
+	}
+#endif
+
+	while (Begin < End)
+	{
+		const unsigned char Char = *Begin;
+
+		if (bool(Table[Char >> 3] & (1 << (Char & 7))) == Member) return Begin;
+
+		++Begin;
+	}
+
+	return End;
+}
+
+int KLStringSplit::Size(void) const
+{
+	int Fields = 0;
+
+	for (auto i = begin(); i != end(); ++i) ++Fields;
+
+	return Fields;
+}
+
+KLStringSplit::KLStringSplitIterator KLStringSplit::begin(void) const
+{
+	return KLStringSplitIterator(this, Text.Data());
+}
+
+KLStringSplit::KLStringSplitIterator KLStringSplit::end(void) const
+{
+	return KLStringSplitIterator(this, nullptr);
+}
@@ -0,0 +1,289 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight String View interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSTRINGVIEW_HPP
+#define KLSTRINGVIEW_HPP
+
+#include "../libbuild.hpp"
+
+#include "klstring.hpp"
+
+/*! \file		klstringview.hpp
+ *  \brief	Deklaracje dla klas KLStringView i KLStringSplit oraz ich składników.
+ *
+ */
+
+/*! \file		klstringview.cpp
+ *  \brief	Implementacja klas KLStringView i KLStringSplit oraz ich składników.
+ *
+ */
+
+class KLStringSplit;
+
+/*! \brief	Fragment łańcucha znaków.
+ *
+ * Wskaźnik na początek fragmentu i jego długość. Obiekt nie przechowuje danych i nie przydziela pamięci, dlatego nie może być używany po zmianie lub usunięciu łańcucha, na który wskazuje. Fragment nie musi być zakończony zerem.
+ *
+ */
+class KLLIBS_EXPORT KLStringView
+{
+
+	protected:
+
+		const char* Begin;	//!< Wskaźnik na początek fragmentu.
+
+		int Length;		//!< Długość fragmentu.
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy pusty fragment.
+		 *
+		 */
+		KLStringView(void);
+
+		/*! \brief		Konstruktor z zakresu.
+		 *  \param [in]	String	Początek fragmentu.
+		 *  \param [in]	Size		Długość fragmentu.
+		 *
+		 * Tworzy fragment obejmujący podany zakres.
+		 *
+		 */
+		KLStringView(const char* String, int Size);
+
+		/*! \brief		Konstruktor z tekstu.
+		 *  \param [in]	String Tekst zakończony zerem.
+		 *
+		 * Tworzy fragment obejmujący cały tekst.
+		 *
+		 */
+		KLStringView(const char* String);
+
+		/*! \brief		Konstruktor z łańcucha.
+		 *  \param [in]	String Wybrany łańcuch.
+		 *
+		 * Tworzy fragment obejmujący cały łańcuch.
+		 *
+		 */
+		KLStringView(const KLString& String);
+
+		/*! \brief		Początek fragmentu.
+		 *  \return		Wskaźnik na pierwszy znak.
+		 *
+		 * Zwraca wskaźnik na pierwszy znak fragmentu. Dane nie muszą być zakończone zerem.
+		 *
+		 */
+		const char* Data(void) const;
+
+		/*! \brief		Długość fragmentu.
+		 *  \return		Liczba znaków.
+		 *
+		 * Zwraca liczbę znaków fragmentu.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Fragment fragmentu.
+		 *  \param [in]	Start	Początek ciągu.
+		 *  \param [in]	Stop		Koniec ciągu.
+		 *  \return		Fragment obejmujący podany zakres.
+		 *
+		 * Zwraca fragment od wybranego znaku początkowego do końcowego bez kopiowania danych.
+		 *
+		 */
+		KLStringView Part(int Start, int Stop) const;
+
+		/*! \brief		Usunięcie białych znaków.
+		 *  \return		Fragment bez białych znaków na początku i końcu.
+		 *
+		 * Zwraca fragment pomniejszony o białe znaki z obu stron.
+		 *
+		 */
+		KLStringView Trimmed(void) const;
+
+		/*! \brief		Podział fragmentu.
+		 *  \param [in]	Delimiter Znak rozdzielający.
+		 *  \return		Zakres kolejnych pól.
+		 *
+		 * \see KLString::Split(char).
+		 *
+		 */
+		KLStringSplit Split(char Delimiter) const;
+
+		/*! \brief		Podział fragmentu.
+		 *  \param [in]	Delimiter Ciąg rozdzielający.
+		 *  \return		Zakres kolejnych pól.
+		 *
+		 * \see KLString::Split(const char*).
+		 *
+		 */
+		KLStringSplit Split(const char* Delimiter) const;
+
+		/*! \brief		Podział fragmentu na słowa.
+		 *  \param [in]	Delimiters Zbiór znaków rozdzielających.
+		 *  \return		Zakres kolejnych słów.
+		 *
+		 * \see KLString::Tokenize(const char*).
+		 *
+		 */
+		KLStringSplit Tokenize(const char* Delimiters) const;
+
+		/*! \brief		Kopia fragmentu.
+		 *  \return		Łańcuch z kopią fragmentu.
+		 *
+		 * Tworzy nowy łańcuch zawierający znaki fragmentu.
+		 *
+		 */
+		KLString ToString(void) const;
+
+		/*! \brief		Skrót fragmentu.
+		 *  \return		Skrót FNV-1a zgodny z metodą `KLString::Hash()`.
+		 *
+		 * Oblicza skrót znaków fragmentu.
+		 *
+		 */
+		size_t Hash(void) const;
+
+		/*! \brief		Konwersja na liczbę całkowitą.
+		 *  \return		Wartość liczbowa fragmentu.
+		 *
+		 * Odczytuje liczbę z początku fragmentu (`KLNumber::Parse`) pomijając początkowe białe znaki.
+		 *
+		 */
+		int ToInt(void) const;
+
+		/*! \brief		Konwersja na liczbę zmiennoprzecinkową.
+		 *  \return		Wartość liczbowa fragmentu.
+		 *
+		 * Odczytuje liczbę z początku fragmentu (`KLNumber::Parse`) pomijając początkowe białe znaki.
+		 *
+		 */
+		double ToNumber(void) const;
+
+		char operator[] (int ID) const;
+
+		bool operator== (const KLStringView& String) const;
+		bool operator!= (const KLStringView& String) const;
+
+};
+
+/*! \brief	Leniwy podział łańcucha.
+ *
+ * Zakres zwracany przez metody `Split` i `Tokenize`, po którym można iterować pętlą `for`. Kolejne pola wyszukiwane są dopiero podczas iteracji i zwracane jako obiekty `KLStringView`, więc podział nie przydziela żadnej pamięci.
+ *
+ * Pojedynczy znak wyszukiwany jest funkcją `memchr`, ciąg znaków algorytmem `KLString::Search`, a zbiór znaków (do 16 znaków) porównaniem bloków SSE2 na procesorach x86. Większe zbiory sprawdzane są przy pomocy tablicy bitowej.
+ *
+ */
+class KLLIBS_EXPORT KLStringSplit
+{
+
+	public: enum MODE
+	{
+		CHAR,		//!< Pojedynczy znak rozdzielający, puste pola są zwracane.
+		STRING,	//!< Ciąg rozdzielający, puste pola są zwracane.
+		CLASS		//!< Zbiór znaków rozdzielających, puste pola są pomijane.
+	};
+
+	public: class KLStringSplitIterator
+	{
+
+		protected:
+
+			const KLStringSplit* Owner;	//!< Dzielony zakres.
+
+			KLStringView Field;		//!< Bieżące pole.
+
+			const char* Next;		//!< Początek kolejnego pola lub `nullptr` gdy bieżące pole jest ostatnie.
+
+			void Advance(void);
+
+		public:
+
+			KLStringSplitIterator(const KLStringSplit* Split, const char* Begin);
+
+			const KLStringView& operator* (void) const;
+			KLStringSplitIterator& operator++ (void);
+			bool operator!= (const KLStringSplitIterator& Iterator) const;
+
+	};
+
+	protected:
+
+		KLStringView Text;		//!< Dzielony tekst.
+
+		const char* Delimiter;	//!< Ciąg rozdzielający (tryb `STRING`).
+
+		int Length;			//!< Długość ciągu rozdzielającego (tryb `STRING`).
+
+		unsigned char Set[16];	//!< Znaki rozdzielające (tryby `CHAR` i `CLASS`).
+
+		int Count;			//!< Liczba znaków rozdzielających (`17` gdy używana jest tablica bitowa).
+
+		unsigned char Table[32];	//!< Tablica bitowa znaków rozdzielających (tryb `CLASS`).
+
+		MODE Mode;			//!< Tryb podziału.
+
+		/*! \brief		Wyszukanie znaku ze zbioru.
+		 *  \param [in]	Begin	Początek przeszukiwanego tekstu.
+		 *  \param [in]	End		Koniec przeszukiwanego tekstu.
+		 *  \param [in]	Member	`true` aby szukać znaku rozdzielającego, `false` aby szukać innego znaku.
+		 *  \return		Wskaźnik na znaleziony znak lub `End`.
+		 *
+		 * Przeszukuje tekst w blokach SSE2 (poza platformą AVR) gdy zbiór zawiera nie więcej niż 16 znaków.
+		 *
+		 */
+		const char* Scan(const char* Begin, const char* End, bool Member) const;
+
+	public:
+
+		/*! \brief		Konstruktor podziału na znaku.
+		 *  \param [in]	String	Dzielony tekst.
+		 *  \param [in]	Char		Znak rozdzielający.
+		 *
+		 * Tworzy zakres dzielący tekst na każdym wystąpieniu znaku.
+		 *
+		 */
+		KLStringSplit(const KLStringView& String, char Char);
+
+		/*! \brief		Konstruktor podziału.
+		 *  \param [in]	String	Dzielony tekst.
+		 *  \param [in]	Delimiters	Ciąg lub zbiór znaków rozdzielających.
+		 *  \param [in]	Type		Tryb podziału (`STRING` lub `CLASS`).
+		 *
+		 * Tworzy zakres dzielący tekst na wystąpieniach ciągu (tryb `STRING`) lub dowolnego znaku ze zbioru (tryb `CLASS`). W trybie `STRING` ciąg musi pozostać ważny w trakcie iteracji, zbiór znaków jest kopiowany.
+		 *
+		 */
+		KLStringSplit(const KLStringView& String, const char* Delimiters, MODE Type);
+
+		/*! \brief		Zliczenie pól.
+		 *  \return		Liczba pól.
+		 *
+		 * Przechodzi cały zakres i zwraca liczbę pól.
+		 *
+		 */
+		int Size(void) const;
+
+		KLStringSplitIterator begin(void) const;
+		KLStringSplitIterator end(void) const;
+
+};
+
+#endif // KLSTRINGVIEW_HPP
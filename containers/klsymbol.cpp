@@ -0,0 +1,224 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Symbol interpretation for KLLibs                           *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klsymbol.hpp"
+
+#if !defined(F_CPU)
+#include <mutex>
+#endif
+
+#if !defined(F_CPU)
+#define KLSYMBOL_BLOCK 256
+#else
+#define KLSYMBOL_BLOCK 16
+#endif
+
+struct KLSymbolTable
+{
+	KLString** Blocks;	//!< Bloki nazw o stałym położeniu w pamięci.
+	int* Slots;		//!< Tablica mieszająca numerów symboli.
+
+	int Names;		//!< Liczba nazw (wraz z pustą nazwą o numerze 0).
+	int Mask;			//!< Rozmiar tablicy mieszającej pomniejszony o 1.
+
+#if !defined(F_CPU)
+	std::mutex Lock;
+#endif
+
+	KLSymbolTable(void)
+	: Blocks((KLString**) malloc(sizeof(KLString*))), Slots(nullptr), Names(1), Mask(-1)
+	{
+		Blocks[0] = new KLString[KLSYMBOL_BLOCK];
+	}
+
+	KLString& At(int ID)
+	{
+		return Blocks[ID / KLSYMBOL_BLOCK][ID % KLSYMBOL_BLOCK];
+	}
+
+	int Search(const KLStringView& Name, size_t Hash, size_t& Slot)
+	{
+		if (Mask < 0) return 0;
+
+		for (Slot = Hash & Mask; Slots[Slot]; Slot = (Slot + 1) & Mask)
+		{
+			const KLString& Stored = At(Slots[Slot]);
+
+			if (Stored.Hash() == Hash && KLStringView(Stored) == Name) return Slots[Slot];
+		}
+
+		return 0;
+	}
+
+	void Rehash(void)
+	{
+		const int Size = Mask < 0 ? 16 : (Mask + 1) * 2;
+
+		free(Slots);
+
+		Slots = (int*) calloc(Size, sizeof(int));
+		Mask = Size - 1;
+
+		for (int ID = 1; ID < Names; ++ID)
+		{
+			size_t Slot = At(ID).Hash() & Mask;
+
+			while (Slots[Slot]) Slot = (Slot + 1) & Mask;
+
+			Slots[Slot] = ID;
+		}
+	}
+
+	int Insert(const KLStringView& Name, size_t Hash)
+	{
+		size_t Slot = 0;
+
+		if (const int ID = Search(Name, Hash, Slot)) return ID;
+
+		if (Names * 2 > Mask)
+		{
+			Rehash(); Search(Name, Hash, Slot);
+		}
+
+		if (Names % KLSYMBOL_BLOCK == 0)
+		{
+			Blocks = (KLString**) realloc(Blocks, (Names / KLSYMBOL_BLOCK + 1) * sizeof(KLString*));
+			Blocks[Names / KLSYMBOL_BLOCK] = new KLString[KLSYMBOL_BLOCK];
+		}
+
+		At(Names) = Name.ToString();
+		At(Names).Hash();
+
+		Slots[Slot] = Names;
+
+		return Names++;
+	}
+};
+
+static KLSymbolTable& Table(void)
+{
+	static KLSymbolTable* Instance = new KLSymbolTable();
+
+	return *Instance;
+}
+
+KLSymbol::KLSymbol(int Index)
+: ID(Index) {}
+
+KLSymbol::KLSymbol(void)
+: ID(0) {}
+
+KLSymbol::KLSymbol(const KLString& Name)
+: KLSymbol(KLStringView(Name)) {}
+
+KLSymbol::KLSymbol(const char* Name)
+: KLSymbol(KLStringView(Name)) {}
+
+KLSymbol::KLSymbol(const KLStringView& Name)
+: ID(0)
+{
+	if (!Name.Size()) return;
+
+	const size_t Hash = Name.Hash();
+
+	KLSymbolTable& Symbols = Table();
+
+#if !defined(F_CPU)
+	std::lock_guard<std::mutex> Guard(Symbols.Lock);
+#endif
+
+	ID = Symbols.Insert(Name, Hash);
+}
+
+KLSymbol KLSymbol::Find(const KLStringView& Name)
+{
+	if (!Name.Size()) return KLSymbol();
+
+	const size_t Hash = Name.Hash();
+
+	KLSymbolTable& Symbols = Table();
+
+#if !defined(F_CPU)
+	std::lock_guard<std::mutex> Guard(Symbols.Lock);
+#endif
+
+	size_t Slot;
+
+	const int ID = Symbols.Search(Name, Hash, Slot);
+
+	return KLSymbol(ID ? ID : -1);
+}
+
+int KLSymbol::Count(void)
+{
+	KLSymbolTable& Symbols = Table();
+
+#if !defined(F_CPU)
+	std::lock_guard<std::mutex> Guard(Symbols.Lock);
+#endif
+
+	return Symbols.Names - 1;
+}
+
+const KLString& KLSymbol::Name(void) const
+{
+	KLSymbolTable& Symbols = Table();
+
+#if !defined(F_CPU)
+	std::lock_guard<std::mutex> Guard(Symbols.Lock);
+#endif
+
+	return Symbols.At(ID > 0 ? ID : 0);
+}
+
+int KLSymbol::ToInt(void) const
+{
+	return ID;
+}
+
+bool KLSymbol::IsValid(void) const
+{
+	return ID > 0;
+}
+
+KLSymbol::operator const KLString& (void) const
+{
+	return Name();
+}
+
+KLSymbol::operator bool (void) const
+{
+	return ID > 0;
+}
+
+bool KLSymbol::operator== (const KLSymbol& Symbol) const
+{
+	return ID == Symbol.ID;
+}
+
+bool KLSymbol::operator!= (const KLSymbol& Symbol) const
+{
+	return ID != Symbol.ID;
+}
+
+bool KLSymbol::operator< (const KLSymbol& Symbol) const
+{
+	return ID < Symbol.ID;
+}
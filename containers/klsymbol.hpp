@@ -0,0 +1,180 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Symbol interpretation for KLLibs                           *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLSYMBOL_HPP
+#define KLSYMBOL_HPP
+
+#include "../libbuild.hpp"
+
+#include "klstring.hpp"
+
+#if !defined(F_CPU)
+#include <functional>
+#endif
+
+/*! \file		klsymbol.hpp
+ *  \brief	Deklaracje dla klasy KLSymbol i jej składników.
+ *
+ */
+
+/*! \file		klsymbol.cpp
+ *  \brief	Implementacja klasy KLSymbol i jej składników.
+ *
+ */
+
+/*! \brief	Internowany identyfikator.
+ *
+ * Każda unikalna nazwa jest zapisywana jeden raz w globalnej tablicy symboli i otrzymuje stały numer. Obiekt przechowuje jedynie ten numer, więc kopiowanie i porównywanie symboli sprowadza się do operacji na liczbie całkowitej, a powtarzające się nazwy nie zajmują dodatkowej pamięci.
+ *
+ * Tablica jest współdzielona przez wszystkie wątki i zabezpieczona blokadą (poza platformą AVR). Zapisane nazwy nie są zwalniane do końca działania programu.
+ *
+ */
+class KLLIBS_EXPORT KLSymbol
+{
+
+	protected:
+
+		int ID;	//!< Numer symbolu w tablicy (`0` dla pustej nazwy, `-1` dla nieznanej).
+
+		/*! \brief		Konstruktor z numeru.
+		 *  \param [in]	Index Numer symbolu.
+		 *
+		 * Tworzy symbol o podanym numerze bez odwoływania się do tablicy.
+		 *
+		 */
+		explicit KLSymbol(int Index);
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy symbol pustej nazwy.
+		 *
+		 */
+		KLSymbol(void);
+
+		/*! \brief		Konstruktor internujący.
+		 *  \param [in]	Name Nazwa symbolu.
+		 *
+		 * Wyszukuje nazwę w tablicy symboli i dodaje ją, jeśli nie była jeszcze używana.
+		 *
+		 */
+		KLSymbol(const KLString& Name);
+
+		/*! \brief		Konstruktor internujący.
+		 *  \param [in]	Name Nazwa symbolu.
+		 *
+		 * Wyszukuje nazwę w tablicy symboli i dodaje ją, jeśli nie była jeszcze używana.
+		 *
+		 */
+		KLSymbol(const char* Name);
+
+		/*! \brief		Konstruktor internujący.
+		 *  \param [in]	Name Fragment tekstu z nazwą symbolu.
+		 *
+		 * Wyszukuje nazwę w tablicy symboli bez tworzenia tymczasowego łańcucha. Nowy łańcuch jest tworzony jedynie gdy nazwa nie była jeszcze używana.
+		 *
+		 */
+		KLSymbol(const KLStringView& Name);
+
+		/*! \brief		Wyszukanie symbolu.
+		 *  \param [in]	Name Nazwa symbolu.
+		 *  \return		Symbol o podanej nazwie lub nieprawidłowy symbol gdy nazwa nie była używana.
+		 *
+		 * Wyszukuje nazwę w tablicy symboli bez dodawania nowych wpisów i bez przydzielania pamięci.
+		 *
+		 */
+		static KLSymbol Find(const KLStringView& Name);
+
+		/*! \brief		Sprawdzenie ilości symboli.
+		 *  \return		Liczba zapisanych nazw.
+		 *
+		 * Zwraca liczbę unikalnych nazw zapisanych w tablicy symboli.
+		 *
+		 */
+		static int Count(void);
+
+		/*! \brief		Nazwa symbolu.
+		 *  \return		Referencja do nazwy zapisanej w tablicy symboli.
+		 *
+		 * Zwraca nazwę symbolu. Referencja pozostaje ważna do końca działania programu.
+		 *
+		 */
+		const KLString& Name(void) const;
+
+		/*! \brief		Numer symbolu.
+		 *  \return		Numer symbolu w tablicy.
+		 *
+		 * Zwraca stały numer przypisany do nazwy.
+		 *
+		 */
+		int ToInt(void) const;
+
+		/*! \brief		Sprawdzenie poprawności.
+		 *  \return		`true` jeśli symbol ma niepustą, zapisaną w tablicy nazwę.
+		 *
+		 * Sprawdza czy symbol odpowiada niepustej nazwie.
+		 *
+		 */
+		bool IsValid(void) const;
+
+		/*! \brief		Operator konwersji na `KLString`.
+		 *  \return		Referencja do nazwy symbolu.
+		 *
+		 * Umożliwia używanie symbolu wszędzie tam gdzie oczekiwany jest łańcuch znaków.
+		 *
+		 */
+		operator const KLString& (void) const;
+
+		/*! \brief		Operator konwersji na `bool`.
+		 *  \return		Wynik metody `IsValid()`.
+		 *
+		 * Umożliwia sprawdzenie symbolu w instrukcjach warunkowych.
+		 *
+		 */
+		explicit operator bool (void) const;
+
+		bool operator== (const KLSymbol& Symbol) const;
+		bool operator!= (const KLSymbol& Symbol) const;
+		bool operator< (const KLSymbol& Symbol) const;
+
+};
+
+#if !defined(F_CPU)
+
+/*! \brief	Funkcja skrótu dla symboli.
+ *
+ * Umożliwia użycie `KLSymbol` jako klucza w kontenerach korzystających z `std::hash`, np. `KLConcurrentMap`.
+ *
+ */
+namespace std
+{
+	template<> struct hash<KLSymbol>
+	{
+		size_t operator() (const KLSymbol& Symbol) const
+		{
+			return size_t(Symbol.ToInt());
+		}
+	};
+}
+
+#endif
+
+#endif // KLSYMBOL_HPP
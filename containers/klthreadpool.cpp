@@ -0,0 +1,131 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Thread Pool interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klthreadpool.hpp"
+
+KLThreadPool::KLThreadPool(int Threads)
+: Workers(nullptr), Count(Threads), Waiting(0), Active(0), Running(true)
+{
+	if (Count <= 0) Count = std::thread::hardware_concurrency();
+	if (Count <= 0) Count = 1;
+
+	Workers = new std::thread[Count];
+
+	for (int i = 0; i < Count; ++i) Workers[i] = std::thread(&KLThreadPool::Work, this);
+}
+
+KLThreadPool::~KLThreadPool(void)
+{
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		Running = false;
+	}
+
+	Signal.notify_all();
+
+	for (int i = 0; i < Count; ++i) Workers[i].join();
+
+	delete [] Workers;
+}
+
+void KLThreadPool::Work(void)
+{
+	while (true)
+	{
+		KLTASK Task;
+
+		{
+			std::unique_lock<std::mutex> Guard(Lock);
+
+			++Waiting;
+
+			Signal.wait(Guard, [this] () { return !Running || Tasks.Size(); });
+
+			--Waiting;
+
+			if (!Tasks.Size()) return;
+
+			Task = Tasks.Dequeue();
+
+			++Active;
+		}
+
+		Execute(Task);
+	}
+}
+
+void KLThreadPool::Execute(const KLTASK& Task)
+{
+	Task();
+
+	std::lock_guard<std::mutex> Guard(Lock);
+
+	if (!--Active && !Tasks.Size()) Finished.notify_all();
+}
+
+void KLThreadPool::Insert(const KLTASK& Task)
+{
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		Tasks.Insert(Task);
+	}
+
+	Signal.notify_one();
+}
+
+bool KLThreadPool::Process(void)
+{
+	KLTASK Task;
+
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		if (!Tasks.Size()) return false;
+
+		Task = Tasks.Dequeue();
+
+		++Active;
+	}
+
+	Execute(Task);
+
+	return true;
+}
+
+void KLThreadPool::Wait(void)
+{
+	while (Process());
+
+	std::unique_lock<std::mutex> Guard(Lock);
+
+	Finished.wait(Guard, [this] () { return !Active && !Tasks.Size(); });
+}
+
+int KLThreadPool::Size(void) const
+{
+	return Count;
+}
+
+int KLThreadPool::Idle(void) const
+{
+	return Waiting.load();
+}
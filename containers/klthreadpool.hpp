@@ -0,0 +1,150 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Thread Pool interpretation for KLLibs                      *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLTHREADPOOL_HPP
+#define KLTHREADPOOL_HPP
+
+#include "../libbuild.hpp"
+
+#include "kllist.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+/*! \file		klthreadpool.hpp
+ *  \brief	Deklaracje dla klasy KLThreadPool i jej składników.
+ *
+ */
+
+/*! \file		klthreadpool.cpp
+ *  \brief	Implementacja klasy KLThreadPool i jej składników.
+ *
+ */
+
+/*! \brief	Lekka interpretacja puli wątków.
+ *
+ * Stała grupa wątków roboczych wykonujących zadania z jednej wspólnej kolejki. Wątek oczekujący na wyniki może sam pobierać zadania przy pomocy `Process`, dzięki czemu zadania mogą bezpiecznie tworzyć i oczekiwać na kolejne zadania.
+ *
+ * Dostępne jedynie na platformach obsługujących `std::thread`.
+ *
+ */
+class KLLIBS_EXPORT KLThreadPool
+{
+
+	public: using KLTASK = std::function<void (void)>;
+
+	protected:
+
+		KLList<KLTASK> Tasks;			//!< Kolejka oczekujących zadań.
+
+		std::thread* Workers;			//!< Tablica wątków roboczych.
+
+		int Count;					//!< Liczba wątków roboczych.
+
+		std::atomic<int> Waiting;		//!< Liczba bezczynnych wątków.
+		std::atomic<int> Active;			//!< Liczba wykonywanych zadań.
+
+		bool Running;					//!< Stan pracy puli.
+
+		std::mutex Lock;				//!< Blokada kolejki zadań.
+
+		std::condition_variable Signal;	//!< Powiadomienie o nowych zadaniach.
+		std::condition_variable Finished;	//!< Powiadomienie o wykonaniu wszystkich zadań.
+
+		/*! \brief		Pętla wątku roboczego.
+		 *
+		 * Pobiera i wykonuje zadania do czasu zatrzymania puli.
+		 *
+		 */
+		void Work(void);
+
+		/*! \brief		Wykonanie zadania.
+		 *  \param [in]	Task Zadanie pobrane z kolejki.
+		 *
+		 * Wykonuje zadanie i powiadamia oczekujących gdy kolejka została opróżniona.
+		 *
+		 */
+		void Execute(const KLTASK& Task);
+
+	public:
+
+		/*! \brief		Domyślny konstruktor.
+		 *  \param [in]	Threads Liczba wątków roboczych lub `0` dla liczby rdzeni procesora.
+		 *
+		 * Uruchamia wątki robocze.
+		 *
+		 */
+		explicit KLThreadPool(int Threads = 0);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Wykonuje pozostałe zadania i zatrzymuje wątki robocze.
+		 *
+		 */
+		~KLThreadPool(void);
+
+		KLThreadPool(const KLThreadPool&) = delete;
+		KLThreadPool& operator= (const KLThreadPool&) = delete;
+
+		/*! \brief		Dodanie zadania.
+		 *  \param [in]	Task Zadanie do wykonania.
+		 *
+		 * Dodaje zadanie do kolejki i budzi jeden z bezczynnych wątków.
+		 *
+		 */
+		void Insert(const KLTASK& Task);
+
+		/*! \brief		Wykonanie zadania w bieżącym wątku.
+		 *  \return		`true` jeśli wykonano zadanie, lub `false` gdy kolejka była pusta.
+		 *
+		 * Pobiera jedno zadanie z kolejki i wykonuje je w wątku wywołującym.
+		 *
+		 */
+		bool Process(void);
+
+		/*! \brief		Oczekiwanie na zadania.
+		 *
+		 * Pomaga w wykonywaniu zadań i czeka aż kolejka zostanie opróżniona, a wszystkie zadania zakończone.
+		 *
+		 */
+		void Wait(void);
+
+		/*! \brief		Sprawdzenie ilości wątków.
+		 *  \return		Liczba wątków roboczych.
+		 *
+		 * Zwraca liczbę wątków roboczych puli.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Sprawdzenie ilości bezczynnych wątków.
+		 *  \return		Liczba wątków oczekujących na zadania.
+		 *
+		 * Zwraca przybliżoną liczbę wątków, które nie mają zadań do wykonania.
+		 *
+		 */
+		int Idle(void) const;
+
+};
+
+#endif // KLTHREADPOOL_HPP
@@ -84,29 +84,207 @@ bool KLTree<Data>::KLTreeConstIterator::operator!= (const KLTreeConstIterator& I
 }
 
 template<typename Data>
-KLTree<Data>::KLTree(KLTreeItem* Branch)
-: Root(Branch), Current(Branch)
+KLTree<Data>::KLTreeOrderVarIterator::KLTreeOrderVarIterator(KLTreeItem* Scope, ORDER Mode)
+: Current(Scope ? Scope->Branch : nullptr), Top(Scope), Order(Mode)
+{
+	if (Order == POSTORDER && Current) while (Current->Branch) Current = Current->Branch;
+}
+
+template<typename Data>
+Data& KLTree<Data>::KLTreeOrderVarIterator::operator* (void)
+{
+	return *Current->Record;
+}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeOrderVarIterator& KLTree<Data>::KLTreeOrderVarIterator::operator++ (void)
+{
+	switch (Order)
+	{
+		case PREORDER:
+			if (Current->Branch)
+			{
+				Current = Current->Branch;
+			}
+			else
+			{
+				while (Current != Top && !Current->Next) Current = Current->Root;
+
+				Current = Current != Top ? Current->Next : nullptr;
+			}
+		break;
+		case POSTORDER:
+			if (Current->Next)
+			{
+				Current = Current->Next;
+
+				while (Current->Branch) Current = Current->Branch;
+			}
+			else
+			{
+				Current = Current->Root != Top ? Current->Root : nullptr;
+			}
+		break;
+		case LEVELORDER:
+			if (Current->Branch) Queue.Insert(Current->Branch);
+
+			if (Current->Next)
+				Current = Current->Next;
+			else
+				Current = Queue.Size() ? Queue.Dequeue() : nullptr;
+		break;
+	}
+
+#if defined(__GNUC__)
+	if (Current)
+	{
+		__builtin_prefetch(Current->Next);
+		__builtin_prefetch(Current->Branch);
+	}
+#endif
+
+	return *this;
+}
+
+template<typename Data>
+bool KLTree<Data>::KLTreeOrderVarIterator::operator!= (const KLTreeOrderVarIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data>
+KLTree<Data>::KLTreeOrderConstIterator::KLTreeOrderConstIterator(const KLTreeItem* Scope, ORDER Mode)
+: Current(Scope ? Scope->Branch : nullptr), Top(Scope), Order(Mode)
+{
+	if (Order == POSTORDER && Current) while (Current->Branch) Current = Current->Branch;
+}
+
+template<typename Data>
+const Data& KLTree<Data>::KLTreeOrderConstIterator::operator* (void) const
+{
+	return *Current->Record;
+}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeOrderConstIterator& KLTree<Data>::KLTreeOrderConstIterator::operator++ (void)
+{
+	switch (Order)
+	{
+		case PREORDER:
+			if (Current->Branch)
+			{
+				Current = Current->Branch;
+			}
+			else
+			{
+				while (Current != Top && !Current->Next) Current = Current->Root;
+
+				Current = Current != Top ? Current->Next : nullptr;
+			}
+		break;
+		case POSTORDER:
+			if (Current->Next)
+			{
+				Current = Current->Next;
+
+				while (Current->Branch) Current = Current->Branch;
+			}
+			else
+			{
+				Current = Current->Root != Top ? Current->Root : nullptr;
+			}
+		break;
+		case LEVELORDER:
+			if (Current->Branch) Queue.Insert(Current->Branch);
+
+			if (Current->Next)
+				Current = Current->Next;
+			else
+				Current = Queue.Size() ? Queue.Dequeue() : nullptr;
+		break;
+	}
+
+#if defined(__GNUC__)
+	if (Current)
+	{
+		__builtin_prefetch(Current->Next);
+		__builtin_prefetch(Current->Branch);
+	}
+#endif
+
+	return *this;
+}
+
+template<typename Data>
+bool KLTree<Data>::KLTreeOrderConstIterator::operator!= (const KLTreeOrderConstIterator& Iterator) const
+{
+	return Current != Iterator.Current;
+}
+
+template<typename Data>
+KLTree<Data>::KLTreeVarRange::KLTreeVarRange(KLTreeItem* Branch, ORDER Mode)
+: Scope(Branch), Order(Mode) {}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeOrderVarIterator KLTree<Data>::KLTreeVarRange::begin(void) const
+{
+	return KLTreeOrderVarIterator(Scope, Order);
+}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeOrderVarIterator KLTree<Data>::KLTreeVarRange::end(void) const
 {
-	Root->Root = Branch;
+	return KLTreeOrderVarIterator(nullptr, Order);
 }
 
+template<typename Data>
+KLTree<Data>::KLTreeConstRange::KLTreeConstRange(const KLTreeItem* Branch, ORDER Mode)
+: Scope(Branch), Order(Mode) {}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeOrderConstIterator KLTree<Data>::KLTreeConstRange::begin(void) const
+{
+	return KLTreeOrderConstIterator(Scope, Order);
+}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeOrderConstIterator KLTree<Data>::KLTreeConstRange::end(void) const
+{
+	return KLTreeOrderConstIterator(nullptr, Order);
+}
+
+#if !defined(F_CPU)
+
+template<typename Data>
+template<typename Result, typename Map, typename Reduce>
+KLTree<Data>::KLTreeReduceContext<Result, Map, Reduce>::KLTreeReduceContext(KLThreadPool& Threads, Map& Mapping, Reduce& Reducing, const Result& Neutral, int Size)
+: Pool(Threads), Mapper(Mapping), Reducer(Reducing), Initial(Neutral), Grain(Size), Total(Neutral), Pending(1) {}
+
+#endif
+
+template<typename Data>
+KLTree<Data>::KLTree(KLTreeItem* Branch)
+: Root(Branch), Current(Branch), Owner(false) {}
+
 template<typename Data>
 KLTree<Data>::KLTree(const KLTree<Data>& Tree)
 : KLTree()
 {
-	Insert(Tree.Root);
+	Insert(Tree.Root->Branch);
 }
 
 template<typename Data>
 KLTree<Data>::KLTree(KLTree<Data>&& Tree)
-: Root(Tree.Root), Current(Tree.Current)
+: Root(Tree.Root), Current(Tree.Current), Owner(Tree.Owner)
 {
 	Tree.Root = nullptr;
 	Tree.Current = nullptr;
+	Tree.Owner = false;
 }
 
 template<typename Data>
 KLTree<Data>::KLTree(void)
+: Owner(true)
 {
 	Root = Current = new KLTreeItem;
 }
@@ -114,7 +292,7 @@ KLTree<Data>::KLTree(void)
 template<typename Data>
 KLTree<Data>::~KLTree(void)
 {
-	if (!Root->Root)
+	if (Owner)
 	{
 		Clean();
 
@@ -126,19 +304,36 @@ template<typename Data>
 int KLTree<Data>::Delete(KLTreeItem* Branch)
 {
 	KLTreeItem* TreeItem = nullptr;
+	KLTreeItem* LastItem = Branch;
 
+	while (LastItem && LastItem->Next) LastItem = LastItem->Next;
+
+	const KLTreeItem* BaseItem = LastItem;
+
+	bool Base = true;
 	int Count = 0;
 
 	while (Branch)
 	{
-		if (Branch->Branch) Delete(Branch->Branch);
+		if (Branch->Branch)
+		{
+			LastItem->Next = Branch->Branch;
+			Branch->Branch = nullptr;
+
+			while (LastItem->Next) LastItem = LastItem->Next;
+		}
 
 		TreeItem = Branch;
 		Branch = Branch->Next;
 
-		delete TreeItem;
+		if (Base)
+		{
+			Base = TreeItem != BaseItem;
 
-		Count++;
+			Count++;
+		}
+
+		delete TreeItem;
 	}
 
 	return Count;
@@ -147,29 +342,118 @@ int KLTree<Data>::Delete(KLTreeItem* Branch)
 template<typename Data>
 int KLTree<Data>::Insert(KLTreeItem* Branch)
 {
+	if (!Branch) return 0;
+
+	const KLTreeItem* Top = Branch->Root;
+	const KLTreeItem* Source = Branch;
+
+	KLTreeItem* Parent = Current;
+	KLTreeItem* LastItem = Current->Branch;
+
+	while (LastItem && LastItem->Next) LastItem = LastItem->Next;
+
 	int Count = 0;
 
-	while (Branch)
+	while (Source)
 	{
-		Insert(Branch->Record);
+		KLTreeItem* TreeItem = new KLTreeItem;
 
-		if (Branch->Branch)
-		{
-			Select(Count);
+		TreeItem->Record = new Data(*Source->Record);
+		TreeItem->Root = Parent;
 
-			Insert(Branch->Branch);
+		if (LastItem)
+			LastItem->Next = TreeItem;
+		else
+			Parent->Branch = TreeItem;
 
-			Select(PREV);
+		LastItem = TreeItem;
+
+		if (Parent == Current) Count++;
+
+		if (Source->Branch)
+		{
+			Source = Source->Branch;
+
+			Parent = TreeItem;
+			LastItem = nullptr;
 		}
+		else
+		{
+			while (Source && !Source->Next)
+			{
+				Source = Source->Root != Top ? Source->Root : nullptr;
 
-		Branch = Branch->Next;
+				LastItem = Parent;
+				Parent = Parent->Root;
+			}
 
-		Count++;
+			if (Source) Source = Source->Next;
+		}
 	}
 
 	return Count;
 }
 
+template<typename Data>
+bool KLTree<Data>::Contains(const KLTreeItem* Branch) const
+{
+	for (const KLTreeItem* TreeItem = Current; TreeItem; TreeItem = TreeItem->Root)
+	{
+		if (TreeItem == Branch) return true;
+	}
+
+	return false;
+}
+
+#if !defined(F_CPU)
+
+template<typename Data>
+template<typename Result, typename Map, typename Reduce>
+void KLTree<Data>::Process(KLTreeReduceContext<Result, Map, Reduce>* Context, KLList<const KLTreeItem*> Queue)
+{
+	Result Local = Context->Initial;
+
+	int Count = 0;
+
+	while (Queue.Size())
+	{
+		const KLTreeItem* TreeItem = Queue.Dequeue();
+
+		while (TreeItem)
+		{
+			Local = Context->Reducer(Local, Context->Mapper(*TreeItem->Record));
+
+			if (TreeItem->Branch) Queue.Insert(TreeItem->Branch);
+
+			TreeItem = TreeItem->Next;
+
+			++Count;
+		}
+
+		if (Count >= Context->Grain && Queue.Size() > 1 && Context->Pool.Idle())
+		{
+			KLList<const KLTreeItem*> Part;
+
+			for (int i = Queue.Size() / 2; i > 0; --i) Part.Insert(Queue.Dequeue());
+
+			Context->Pending.fetch_add(1);
+			Context->Pool.Insert([Context, Part] () { Process(Context, Part); });
+
+			Count = 0;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> Guard(Context->Lock);
+
+		Context->Total = Context->Reducer(Context->Total, Local);
+	}
+
+	Context->Pending.fetch_sub(1);
+}
+
+#endif
+
 template<typename Data>
 int KLTree<Data>::Insert(const Data& Item)
 {
@@ -204,14 +488,9 @@ int KLTree<Data>::Insert(const Data& Item)
 template<typename Data>
 int KLTree<Data>::Insert(const KLTree<Data>& Tree)
 {
-	KLTreeItem* TreeItem = Tree.Root;
-	KLTreeItem* LastCurrent = Current;
+	if (Contains(Tree.Root)) return Insert(KLTree<Data>(Tree));
 
-	int Count = Insert(Tree.Root);
-
-	Current = LastCurrent;
-
-	return Count;
+	return Insert(Tree.Root->Branch);
 }
 
 template<typename Data>
@@ -231,6 +510,8 @@ bool KLTree<Data>::Delete(int ID)
 			return false;
 	}
 
+	if (!TreeItem) return false;
+
 	if (!PrevItem)
 	{
 		if (Root->Branch == Current->Branch)
@@ -299,7 +580,7 @@ int KLTree<Data>::Size(void) const
 template<typename Data>
 int KLTree<Data>::Deep(void) const
 {
-	KLTreeItem* TreeItem = Current->Branch;
+	KLTreeItem* TreeItem = Current;
 
 	int Count = 0;
 
@@ -373,6 +654,42 @@ const KLTree<Data> KLTree<Data>::Branch(int ID) const
 	return KLTree();
 }
 
+template<typename Data>
+typename KLTree<Data>::KLTreeVarRange KLTree<Data>::Traverse(ORDER Order)
+{
+	return KLTreeVarRange(Current, Order);
+}
+
+template<typename Data>
+typename KLTree<Data>::KLTreeConstRange KLTree<Data>::Traverse(ORDER Order) const
+{
+	return KLTreeConstRange(Current, Order);
+}
+
+#if !defined(F_CPU)
+
+template<typename Data>
+template<typename Result, typename Map, typename Reduce>
+Result KLTree<Data>::MapReduce(KLThreadPool& Pool, const Result& Initial, Map Mapper, Reduce Reducer, int Grain) const
+{
+	KLTreeReduceContext<Result, Map, Reduce> Context(Pool, Mapper, Reducer, Initial, Grain);
+
+	KLList<const KLTreeItem*> Queue;
+
+	if (Current->Branch) Queue.Insert(Current->Branch);
+
+	Process(&Context, Queue);
+
+	while (Context.Pending.load())
+	{
+		if (!Pool.Process()) std::this_thread::yield();
+	}
+
+	return Context.Total;
+}
+
+#endif
+
 template<typename Data>
 void KLTree<Data>::Clean(void)
 {
@@ -380,8 +697,10 @@ void KLTree<Data>::Clean(void)
 	{
 		Delete(Root->Branch);
 
-		Current = Root;
+		Root->Branch = nullptr;
 	}
+
+	Current = Root;
 }
 
 template<typename Data>
@@ -446,9 +765,22 @@ KLTree<Data>& KLTree<Data>::operator= (const KLTree<Data>& Tree)
 {
 	if (this == &Tree) return *this;
 
-	Clean();
+	Current = Root;
+
+	if (Contains(Tree.Root) || Tree.Contains(Root))
+	{
+		const KLTree<Data> Copy(Tree);
 
-	Insert(Tree.Root);
+		Clean();
+
+		Insert(Copy.Root->Branch);
+	}
+	else
+	{
+		Clean();
+
+		Insert(Tree.Root->Branch);
+	}
 
 	return *this;
 }
@@ -458,13 +790,19 @@ KLTree<Data>& KLTree<Data>::operator= (KLTree<Data>&& Tree)
 {
 	if (this == &Tree) return *this;
 
+	if (!Owner || !Tree.Owner) return *this = static_cast<const KLTree<Data>&>(Tree);
+
 	Clean();
 
+	delete Root;
+
 	Root = Tree.Root;
 	Current = Tree.Current;
+	Owner = Tree.Owner;
 
 	Tree.Root = nullptr;
 	Tree.Current = nullptr;
+	Tree.Owner = false;
 
 	return *this;
 }
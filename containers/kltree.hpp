@@ -23,6 +23,12 @@
 
 #include "../libbuild.hpp"
 
+#include "kllist.hpp"
+
+#if !defined(F_CPU)
+#include "klthreadpool.hpp"
+#endif
+
 /*! \file		kltree.hpp
  *  \brief	Deklaracje dla klasy KLTree i jej składników.
  *
@@ -83,6 +89,18 @@ class KLTree
 		CURRENT = -3	//!< Obecny węzeł.
 	};
 
+	/*! \brief		Wyliczenie kolejności przeglądania.
+	 *
+	 * Określa kolejność odwiedzania węzłów przez `KLTree::Traverse`.
+	 *
+	 */
+	public: enum ORDER : int
+	{
+		PREORDER,		//!< Węzeł przed swoimi dziećmi (w głąb).
+		POSTORDER,	//!< Węzeł po swoich dzieciach (w głąb).
+		LEVELORDER	//!< Kolejne poziomy drzewa (wszerz).
+	};
+
 	public: class KLTreeVarIterator
 	{
 
@@ -117,12 +135,134 @@ class KLTree
 
 	};
 
+	/*! \brief		Iterator przeglądający całe poddrzewo.
+	 *
+	 * Odwiedza wszystkie węzły poniżej wybranej gałęzi w zadanej kolejności. Przeglądanie w głąb korzysta jedynie ze wskaźników na rodzica, przeglądanie wszerz przechowuje kolejkę początków list dzieci.
+	 *
+	 */
+	public: class KLTreeOrderVarIterator
+	{
+
+		protected:
+
+			KLTreeItem* Current;
+			KLTreeItem* Top;
+
+			ORDER Order;
+
+			KLList<KLTreeItem*> Queue;
+
+		public:
+
+			KLTreeOrderVarIterator(KLTreeItem* Scope, ORDER Mode);
+
+			Data& operator* (void);
+			KLTreeOrderVarIterator& operator++ (void);
+			bool operator!= (const KLTreeOrderVarIterator& Iterator) const;
+
+	};
+
+	public: class KLTreeOrderConstIterator
+	{
+
+		protected:
+
+			const KLTreeItem* Current;
+			const KLTreeItem* Top;
+
+			ORDER Order;
+
+			KLList<const KLTreeItem*> Queue;
+
+		public:
+
+			KLTreeOrderConstIterator(const KLTreeItem* Scope, ORDER Mode);
+
+			const Data& operator* (void) const;
+			KLTreeOrderConstIterator& operator++ (void);
+			bool operator!= (const KLTreeOrderConstIterator& Iterator) const;
+
+	};
+
+	/*! \brief		Zakres przeglądania poddrzewa.
+	 *
+	 * Obiekt tymczasowy umożliwiający iterację po zakresie po wszystkich węzłach gałęzi.
+	 *
+	 */
+	public: class KLTreeVarRange
+	{
+
+		protected:
+
+			KLTreeItem* Scope;
+
+			ORDER Order;
+
+		public:
+
+			KLTreeVarRange(KLTreeItem* Branch, ORDER Mode);
+
+			KLTreeOrderVarIterator begin(void) const;
+			KLTreeOrderVarIterator end(void) const;
+
+	};
+
+	public: class KLTreeConstRange
+	{
+
+		protected:
+
+			const KLTreeItem* Scope;
+
+			ORDER Order;
+
+		public:
+
+			KLTreeConstRange(const KLTreeItem* Branch, ORDER Mode);
+
+			KLTreeOrderConstIterator begin(void) const;
+			KLTreeOrderConstIterator end(void) const;
+
+	};
+
+#if !defined(F_CPU)
+
+	/*! \brief		Stan równoległego przeglądania.
+	 *
+	 * Wspólny dla wszystkich zadań jednego wywołania `KLTree::MapReduce`.
+	 *
+	 */
+	protected: template<typename Result, typename Map, typename Reduce> struct KLTreeReduceContext
+	{
+
+		KLThreadPool& Pool;			//!< Pula wykonująca zadania.
+
+		Map& Mapper;				//!< Funkcja odwzorowująca dane węzła.
+		Reduce& Reducer;			//!< Funkcja łącząca wyniki.
+
+		const Result& Initial;		//!< Element neutralny redukcji.
+		const int Grain;			//!< Minimalna liczba węzłów przetwarzanych przed podziałem.
+
+		Result Total;				//!< Wynik końcowy.
+
+		std::mutex Lock;			//!< Blokada wyniku końcowego.
+
+		std::atomic<int> Pending;	//!< Liczba niezakończonych zadań.
+
+		KLTreeReduceContext(KLThreadPool& Threads, Map& Mapping, Reduce& Reducing, const Result& Neutral, int Size);
+
+	};
+
+#endif
+
 	protected:
 
 		KLTreeItem* Root;		//!< Wskaźnik na główny węzeł.
 
 		KLTreeItem* Current;	//!< Wskaźnik na obecny węzeł.
 
+		bool Owner;			//!< Określa czy obiekt jest właścicielem węzłów.
+
 		/*! \brief		Specjalny konstruktor.
 		 *  \param [in]	Branch Gałąź główna.
 		 *
@@ -135,7 +275,7 @@ class KLTree
 		 *  \param [in]	Branch Gałąź do usunięcia.
 		 *  \return		Ilość usuniętych pozycji w bazowym zakresie.
 		 *
-		 * Rekurencyjnie usuwa gałąź i jej składniki.
+		 * Usuwa gałąź i jej składniki bez rekurencji. Listy dzieci kolejnych węzłów są dołączane na koniec usuwanej listy, dzięki czemu każdy węzeł jest odwiedzany tylko raz.
 		 *
 		 */
 		int Delete(KLTreeItem* Branch);
@@ -144,17 +284,40 @@ class KLTree
 		 *  \param [in]	Branch Gałąź do wstawienia.
 		 *  \return		Ilość dodanych pozycji w bazowym zakresie.
 		 *
-		 * Rekurencyjnie dodaje gałąź i jej składniki.
+		 * Kopiuje gałąź i jej składniki w jednym przebiegu bez rekurencji, przechodząc po źródle przy pomocy wskaźników na rodzica i pamiętając ostatni element każdego poziomu kopii.
 		 *
 		 */
 		int Insert(KLTreeItem* Branch);
 
+		/*! \brief		Test zawierania.
+		 *  \param [in]	Branch Sprawdzana gałąź.
+		 *  \return		`true` jeśli bieżąca gałąź znajduje się w podanej gałęzi.
+		 *
+		 * Sprawdza czy bieżąca gałąź jest podaną gałęzią lub jej potomkiem.
+		 *
+		 */
+		bool Contains(const KLTreeItem* Branch) const;
+
+#if !defined(F_CPU)
+
+		/*! \brief		Zadanie równoległego przeglądania.
+		 *  \param [in]	Context	Stan przeglądania.
+		 *  \param [in]	Queue	Gałęzie do przetworzenia.
+		 *
+		 * Przetwarza podane gałęzie i dołącza wynik częściowy do wyniku końcowego.
+		 *
+		 */
+		template<typename Result, typename Map, typename Reduce>
+		static void Process(KLTreeReduceContext<Result, Map, Reduce>* Context, KLList<const KLTreeItem*> Queue);
+
+#endif
+
 	public:
 
 		/*! \brief		Konstruktor kopiujący.
 		 *  \param [in]	Tree Drzewo do skopiowania.
 		 *
-		 * Rekurencyjnie kopiuje całą strukturę drzewa.
+		 * Kopiuje całą strukturę drzewa w jednym przebiegu.
 		 *
 		 */
 		KLTree(const KLTree<Data>& Tree);
@@ -254,6 +417,48 @@ class KLTree
 		 */
 		const KLTree<Data> Branch(int ID) const;
 
+#if !defined(F_CPU)
+
+		/*! \brief		Równoległe przeglądanie poddrzewa.
+		 *  \tparam		Result	Typ wyniku.
+		 *  \tparam		Map		Typ funkcji odwzorowującej `Result (const Data&)`.
+		 *  \tparam		Reduce	Typ funkcji łączącej `Result (const Result&, const Result&)`.
+		 *  \param [in]	Pool		Pula wątków wykonująca zadania.
+		 *  \param [in]	Initial	Element neutralny redukcji.
+		 *  \param [in]	Mapper	Funkcja odwzorowująca dane węzła.
+		 *  \param [in]	Reducer	Funkcja łącząca wyniki.
+		 *  \param [in]	Grain	Liczba węzłów przetwarzanych w jednym zadaniu przed oddaniem części pracy.
+		 *  \return		Wynik redukcji wszystkich węzłów poniżej bieżącej gałęzi.
+		 *  \warning		Funkcja łącząca musi być łączna i przemienna, a obie funkcje mogą być wywoływane jednocześnie z wielu wątków. Drzewo nie może być modyfikowane w trakcie przeglądania.
+		 *
+		 * Odwzorowuje każdy węzeł poddrzewa i łączy wyniki. Każde zadanie przegląda swoją część drzewa przy pomocy lokalnej kolejki list rodzeństwa, a po przetworzeniu `Grain` węzłów oddaje połowę oczekujących list do bezczynnych wątków puli. Wątek wywołujący również wykonuje zadania do czasu zakończenia obliczeń.
+		 *
+		 */
+		template<typename Result, typename Map, typename Reduce>
+		Result MapReduce(KLThreadPool& Pool, const Result& Initial, Map Mapper, Reduce Reducer, int Grain = 1024) const;
+
+#endif
+
+		/*! \brief		Przeglądanie poddrzewa.
+		 *  \param [in]	Order Kolejność przeglądania.
+		 *  \return		Zakres obejmujący wszystkie węzły poniżej bieżącej gałęzi.
+		 *  \see			KLTree::ORDER.
+		 *
+		 * Zwraca zakres umożliwiający odwiedzenie całego poddrzewa w jednym przebiegu, bez rekurencji i bez tworzenia tymczasowych gałęzi.
+		 *
+		 */
+		KLTreeVarRange Traverse(ORDER Order = PREORDER);
+
+		/*! \brief		Przeglądanie poddrzewa.
+		 *  \param [in]	Order Kolejność przeglądania.
+		 *  \return		Zakres obejmujący wszystkie węzły poniżej bieżącej gałęzi.
+		 *  \see			KLTree::ORDER.
+		 *
+		 * Zwraca zakres umożliwiający odwiedzenie całego poddrzewa w jednym przebiegu, bez rekurencji i bez tworzenia tymczasowych gałęzi.
+		 *
+		 */
+		KLTreeConstRange Traverse(ORDER Order = PREORDER) const;
+
 		/*! \brief		Czyszczenie drzewa.
 		 *
 		 * Usuwa wszystkie elementy drzewa.
@@ -27,7 +27,9 @@ KLParserbinding::~KLParserbinding(void) {}
 
 bool KLParserbinding::Evaluate(const QString& Code, const KLVariables* Scoope)
 {
-	const bool OK = KLParser::Evaluate(Code.toStdString().c_str(), Scoope);
+	const QByteArray Buffer = Code.toUtf8();
+
+	const bool OK = KLParser::Evaluate(KLStringView(Buffer.constData(), Buffer.size()), Scoope);
 
 	if (OK) emit onEvaluate(LastValue);
 
@@ -59,6 +61,7 @@ QString KLParserbinding::Errorcode(KLParser::ERROR Code)
 		case NOT_ENOUGH_PARAMETERS:	return tr("Expected paramters");
 		case TOO_MANY_PARAMETERS:	return tr("Expected operator");
 		case BRACKETS_NOT_EQUAL:		return tr("Encountered single bracket");
+		case OUT_OF_CAPACITY:		return tr("Expression is too long");
 
 		default: return tr("Script is valid");
 	}
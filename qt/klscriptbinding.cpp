@@ -40,18 +40,24 @@ QString KLScriptbinding::GetCode(void) const
 
 bool KLScriptbinding::Evaluate(void)
 {
-	const bool OK = KLScript::Evaluate(LastCode.toStdString().c_str());
+	const QByteArray Code = LastCode.toUtf8();
+	const KLString Script = KLString::Borrow(Code.constData(), Code.size());
 
-	LastLine = KLScript::GetLine(LastCode.toStdString().c_str());
+	const bool OK = KLScript::Evaluate(Script);
+
+	LastLine = KLScript::GetLine(Script);
 
 	emit onEvaluate(LastReturn, LastError); return OK;
 }
 
 bool KLScriptbinding::Validate(const QString& Script)
 {
-	const bool OK = KLScript::Validate(Script.toStdString().c_str());
+	const QByteArray Code = Script.toUtf8();
+	const KLString Borrowed = KLString::Borrow(Code.constData(), Code.size());
+
+	const bool OK = KLScript::Validate(Borrowed);
 
-	LastLine = KLScript::GetLine(Script.toStdString().c_str());
+	LastLine = KLScript::GetLine(Borrowed);
 
 	return OK;
 }
@@ -107,6 +113,7 @@ QString KLScriptbinding::Errorcode(KLScript::ERROR Code, KLParser::ERROR Parser)
 		case WRONG_PARAMETERS:		return tr("Encountered invalid expresion parameters");
 		case VARIABLE_READONLY:		return tr("Selected variable is readonly");
 		case SCRIPT_TERMINATED:		return tr("Script terminated before end");
+		case OUT_OF_CAPACITY:		return tr("Script exceeds container capacity");
 
 		case WRONG_EVALUATION:		return KLParserbinding::Errorcode(Parser);
 
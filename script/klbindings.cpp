@@ -21,34 +21,44 @@
 #include "klbindings.hpp"
 
 KLBindings::KLBinding::KLBinding(const KLBinding& Binding)
-: Pointer(Binding.Pointer) {}
+: Pointer(Binding.Pointer), Pure(Binding.Pure) {}
 
-KLBindings::KLBinding::KLBinding(KLSENTRY Entry)
-: Pointer(Entry) {}
+KLBindings::KLBinding::KLBinding(KLSENTRY Entry, bool Function)
+: Pointer(Entry), Pure(Function) {}
 
 void KLBindings::KLBinding::Update(KLSENTRY Entry)
 {
 	Pointer = Entry;
 }
 
-double KLBindings::KLBinding::operator() (KLList<double>& Variables)
+void KLBindings::KLBinding::SetPure(bool Active)
+{
+	Pure = Active;
+}
+
+bool KLBindings::KLBinding::IsPure(void) const
+{
+	return Pure;
+}
+
+double KLBindings::KLBinding::operator() (KLSSTACK& Variables)
 {
 	return Pointer(Variables);
 }
 
-bool KLBindings::Add(const KLString& Name, KLSENTRY Entry)
+bool KLBindings::Add(const KLSymbol& Name, KLSENTRY Entry, bool Pure)
 {
 	if (!Entry) return false;
 
-	return Bindings.Insert(Entry, Name);
+	return Bindings.Insert(KLBinding(Entry, Pure), Name) != -1;
 }
 
-bool KLBindings::Delete(const KLString& Name)
+bool KLBindings::Delete(const KLSymbol& Name)
 {
 	return Bindings.Delete(Name) != -1;
 }
 
-bool KLBindings::Exists(const KLString& Name) const
+bool KLBindings::Exists(const KLSymbol& Name) const
 {
 	return Bindings.Exists(Name);
 }
@@ -58,32 +68,32 @@ int KLBindings::Size(void) const
 	return Bindings.Size();
 }
 
-KLBindings::KLBinding& KLBindings::operator[] (const KLString& Name)
+KLBindings::KLBinding& KLBindings::operator[] (const KLSymbol& Name)
 {
 	return Bindings[Name];
 }
 
-const KLBindings::KLBinding& KLBindings::operator[] (const KLString& Name) const
+const KLBindings::KLBinding& KLBindings::operator[] (const KLSymbol& Name) const
 {
 	return Bindings[Name];
 }
 
-KLMap<KLBindings::KLBinding, KLString>::KLMapVarIterator KLBindings::begin(void)
+KLBindings::KLSVARITERATOR KLBindings::begin(void)
 {
 	return Bindings.begin();
 }
 
-KLMap<KLBindings::KLBinding, KLString>::KLMapVarIterator KLBindings::end(void)
+KLBindings::KLSVARITERATOR KLBindings::end(void)
 {
 	return Bindings.end();
 }
 
-KLMap<KLBindings::KLBinding, KLString>::KLMapConstIterator KLBindings::begin(void) const
+KLBindings::KLSCONSTITERATOR KLBindings::begin(void) const
 {
 	return Bindings.begin();
 }
 
-KLMap<KLBindings::KLBinding, KLString>::KLMapConstIterator KLBindings::end(void) const
+KLBindings::KLSCONSTITERATOR KLBindings::end(void) const
 {
 	return Bindings.end();
 }
@@ -26,9 +26,23 @@
 #include "../containers/kllist.hpp"
 #include "../containers/klmap.hpp"
 #include "../containers/klstring.hpp"
+#include "../containers/klsymbol.hpp"
 
 #include "klvariables.hpp"
 
+#if defined(USING_STATIC_CONTAINERS)
+#include "../containers/klstaticlist.hpp"
+#include "../containers/klstaticmap.hpp"
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLBINDINGS_SIZE)
+#define KLBINDINGS_SIZE 8	//!< Maksymalna liczba przypisanych funkcji (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLBINDINGS_STACK)
+#define KLBINDINGS_STACK 8	//!< Maksymalna liczba parametrów wywołania funkcji (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
 #if defined(USING_BOOST)
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
@@ -52,10 +66,16 @@
 class KLLIBS_EXPORT KLBindings
 {
 
+#if defined(USING_STATIC_CONTAINERS)
+	public: using KLSSTACK = KLStaticList<double, KLBINDINGS_STACK>;
+#else
+	public: using KLSSTACK = KLList<double>;
+#endif
+
 #if defined(USING_BOOST)
-	public: using KLSENTRY = boost::function<double (KLList<double>&)>;
+	public: using KLSENTRY = boost::function<double (KLSSTACK&)>;
 #else
-	public: using KLSENTRY = double (*)(KLList<double>&);
+	public: using KLSENTRY = double (*)(KLSSTACK&);
 #endif
 
 	/*! \brief		Reprezentacja pojedynczego bindu.
@@ -70,6 +90,8 @@ class KLLIBS_EXPORT KLBindings
 
 			KLSENTRY Pointer;	//!< Adres zbindowanej funkcji.
 
+			bool Pure;		//!< Modyfikator funkcji czystej.
+
 		public:
 
 			/*! \brief		Konstruktor kopiujący.
@@ -81,12 +103,13 @@ class KLLIBS_EXPORT KLBindings
 			KLBinding(const KLBinding& Binding);
 
 			/*! \brief		Operator konwersji z `KLSENTRY`.
-			 *  \param [in]	Entry Adres funkcji do przypisania.
+			 *  \param [in]	Entry	Adres funkcji do przypisania.
+			 *  \param [in]	Function	Modyfikator funkcji czystej.
 			 *
 			 * Przypisuje podany adres do funkcji.
 			 *
 			 */
-			KLBinding(KLSENTRY Entry);
+			KLBinding(KLSENTRY Entry, bool Function = false);
 
 			/*! \brief		Aktualizacja przypisania.
 			 *  \param [in]	Entry Adres funkcji do przypisania.
@@ -96,6 +119,22 @@ class KLLIBS_EXPORT KLBindings
 			 */
 			void Update(KLSENTRY Entry);
 
+			/*! \brief		Ustalenie czystości funkcji.
+			 *  \param [in]	Active Modyfikator funkcji czystej.
+			 *
+			 * Oznacza funkcję jako czystą, czyli taką, której wynik zależy wyłącznie od parametrów i która nie modyfikuje zmiennych (także zbindowanych). Wywołania takich funkcji nie blokują optymalizacji `KLScript::Optimize()`.
+			 *
+			 */
+			void SetPure(bool Active);
+
+			/*! \brief		Sprawdzenie czystości funkcji.
+			 *  \return		Modyfikator funkcji czystej.
+			 *
+			 * Sprawdza czy funkcja została oznaczona jako czysta.
+			 *
+			 */
+			bool IsPure(void) const;
+
 			/*! \brief		Wywołanie funkcji.
 			 *  \param [in]	Variables System zmiennych.
 			 *  \return		Zwrócona wartość.
@@ -103,25 +142,36 @@ class KLLIBS_EXPORT KLBindings
 			 * Wywołuje funkcję z podanymi parametrami.
 			 *
 			 */
-			double operator() (KLList<double>& Variables);
+			double operator() (KLSSTACK& Variables);
 
 	};
 
+#if defined(USING_STATIC_CONTAINERS)
+	public: using KLSCONTAINER = KLStaticMap<KLBinding, KLSymbol, KLBINDINGS_SIZE>;
+	public: using KLSVARITERATOR = KLSCONTAINER::KLStaticMapVarIterator;
+	public: using KLSCONSTITERATOR = KLSCONTAINER::KLStaticMapConstIterator;
+#else
+	public: using KLSCONTAINER = KLMap<KLBinding, KLSymbol>;
+	public: using KLSVARITERATOR = KLSCONTAINER::KLMapVarIterator;
+	public: using KLSCONSTITERATOR = KLSCONTAINER::KLMapConstIterator;
+#endif
+
 	protected:
 
-		KLMap<KLBinding, KLString> Bindings;	//!< Kontener na przypisania.
+		KLSCONTAINER Bindings;	//!< Kontener na przypisania.
 
 	public:
 
 		/*! \brief		Dodawanie przypisania.
 		 *  \param [in]	Name		Nazwa przypisania.
 		 *  \param [in]	Entry	Adres funkcji do przypisania.
+		 *  \param [in]	Pure		Modyfikator funkcji czystej.
 		 *  \return		Powodzenie operacji.
 		 *
 		 * Dodaje do systemu nową funkcję o podanym adresie.
 		 *
 		 */
-		bool Add(const KLString& Name, KLSENTRY Entry);
+		bool Add(const KLSymbol& Name, KLSENTRY Entry, bool Pure = false);
 
 		/*! \brief		Usuwanie przypisania.
 		 *  \param [in]	Name		Nazwa przypisania.
@@ -130,7 +180,7 @@ class KLLIBS_EXPORT KLBindings
 		 * Usuwa przypisanie z systemu.
 		 *
 		 */
-		bool Delete(const KLString& Name);
+		bool Delete(const KLSymbol& Name);
 
 		/*! \brief		Test obecności przypisania.
 		 *  \param [in]	Name Nazwa przypisania.
@@ -139,7 +189,7 @@ class KLLIBS_EXPORT KLBindings
 		 * Sprawdza czy przypisanie o podanej nazwie jest obecne w systemie.
 		 *
 		 */
-		bool Exists(const KLString& Name) const;
+		bool Exists(const KLSymbol& Name) const;
 
 		/*! \brief		Pobranie ilości przypisań.
 		 *  \return		Ilośc przypisań.
@@ -157,7 +207,7 @@ class KLLIBS_EXPORT KLBindings
 		 * Wybiera z systemu przypisanie o podanej nazwie.
 		 *
 		 */
-		KLBinding& operator[] (const KLString& Name);
+		KLBinding& operator[] (const KLSymbol& Name);
 
 		/*! \brief		Operator wyboru.
 		 *  \param [in]	Name Nazwa przypisania.
@@ -167,13 +217,13 @@ class KLLIBS_EXPORT KLBindings
 		 * Wybiera z systemu przypisanie o podanej nazwie.
 		 *
 		 */
-		const KLBinding& operator[] (const KLString& Name) const;
+		const KLBinding& operator[] (const KLSymbol& Name) const;
 
-		KLMap<KLBinding, KLString>::KLMapVarIterator begin(void);
-		KLMap<KLBinding, KLString>::KLMapVarIterator end(void);
+		KLSVARITERATOR begin(void);
+		KLSVARITERATOR end(void);
 
-		KLMap<KLBinding, KLString>::KLMapConstIterator begin(void) const;
-		KLMap<KLBinding, KLString>::KLMapConstIterator end(void) const;
+		KLSCONSTITERATOR begin(void) const;
+		KLSCONSTITERATOR end(void) const;
 
 };
 
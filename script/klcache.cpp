@@ -0,0 +1,114 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Expression Result Cache for KLLibs                                     *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klcache.hpp"
+
+#include <string.h>
+
+bool KLCache::IsBinded(const KLStringView& Code, const KLVariables* Scoope) const
+{
+	KLList<KLSymbol> Names;
+
+	if (!Scoope) return false;
+
+	Parser.GetDependencies(Code, Names);
+
+	for (const auto& Name: Names)
+	{
+		if (Scoope->Exists(Name) && (*Scoope)[Name].IsBinded()) return true;
+	}
+
+	return false;
+}
+
+KLCache::KLCache(void)
+: Clock(0), LastValue(NAN), LastError(KLParser::NO_ERROR)
+{
+	Clean();
+}
+
+bool KLCache::Evaluate(const KLStringView& Code, const KLVariables* Scoope, const double Return)
+{
+	const size_t Hash = Code.Hash();
+	const uint64_t Version = Scoope ? Scoope->GetVersion() : 0;
+
+	ENTRY* Entry = nullptr;
+
+	for (auto& Item: Entries)
+	{
+		if (Item.Used && Item.Hash == Hash && KLStringView(Item.Expression) == Code)
+		{
+			Entry = &Item; break;
+		}
+	}
+
+	if (Entry && Entry->Scoope == Scoope && Entry->Version == Version)
+	{
+		if (!Entry->Binded && !memcmp(&Entry->Return, &Return, sizeof(double)))
+		{
+			Entry->Used = ++Clock;
+
+			LastValue = Entry->Value;
+			LastError = Entry->Error;
+
+			return LastError == KLParser::NO_ERROR;
+		}
+	}
+	else
+	{
+		if (!Entry)
+		{
+			Entry = Entries;
+
+			for (auto& Item: Entries) if (Item.Used < Entry->Used) Entry = &Item;
+
+			Entry->Expression = Code.ToString();
+			Entry->Hash = Hash;
+		}
+
+		Entry->Scoope = Scoope;
+		Entry->Version = Version;
+		Entry->Binded = IsBinded(Code, Scoope);
+	}
+
+	Parser.Evaluate(Code, Scoope, Return);
+
+	Entry->Used = ++Clock;
+	Entry->Return = Return;
+	Entry->Value = LastValue = Parser.GetValue();
+	Entry->Error = LastError = Parser.GetError();
+
+	return LastError == KLParser::NO_ERROR;
+}
+
+void KLCache::Clean(void)
+{
+	for (auto& Item: Entries) Item.Used = 0;
+}
+
+double KLCache::GetValue(void) const
+{
+	return LastValue;
+}
+
+KLParser::ERROR KLCache::GetError(void) const
+{
+	return LastError;
+}
@@ -0,0 +1,145 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Expression Result Cache for KLLibs                                     *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLCACHE_HPP
+#define KLCACHE_HPP
+
+#include "../libbuild.hpp"
+
+#include "../containers/klstring.hpp"
+#include "../containers/klstringview.hpp"
+
+#include "klparser.hpp"
+#include "klvariables.hpp"
+
+#include <stdint.h>
+
+#if !defined(KLCACHE_SIZE)
+#define KLCACHE_SIZE 32	//!< Liczba wyników przechowywanych w pamięci podręcznej.
+#endif
+
+/*! \file		klcache.hpp
+ *  \brief	Deklaracje dla klasy KLCache i jej składników.
+ *
+ */
+
+/*! \file		klcache.cpp
+ *  \brief	Implementacja klasy KLCache i jej składników.
+ *
+ */
+
+/*! \brief	Pamięć podręczna wyników wyrażeń.
+ *
+ * Pośredniczy w wywołaniach `KLParser::Evaluate()` i zapamiętuje wyniki (oraz błędy) ostatnio obliczanych wyrażeń. Wpis identyfikowany jest skrótem i kopią tekstu wyrażenia przechowywaną w samym wpisie (tekst nie trafia do globalnej tablicy symboli `KLSymbol`, więc pamięć zajmowana przez pamięć podręczną jest ograniczona), a jego wynik jest aktualny dopóki nie zmieni się zasięg zmiennych, wartość `$` ani znacznik zmiany zasięgu (`KLVariables::GetVersion()`), który zmienia się przy każdym przypisaniu zmiennej w zasięgu lub w zakresach nadrzędnych. Ponowne obliczenie niezmienionego wyrażenia nie wymaga wtedy parsowania tekstu.
+ *
+ * Pamięć podręczna mieści `KLCACHE_SIZE` wyników; gdy jest pełna, nowe wyrażenie zastępuje najdawniej używany wpis. Wyrażenia korzystające ze zbindowanych zmiennych (których wartość może zmienić się bez przypisania) są zawsze obliczane ponownie.
+ *
+ */
+class KLLIBS_EXPORT KLCache
+{
+
+	/*! \brief		Wpis pamięci podręcznej.
+	 *
+	 * Przechowuje wynik wyrażenia wraz z warunkami, przy których został obliczony.
+	 *
+	 */
+	protected: struct ENTRY
+	{
+		KLString Expression;		//!< Kopia tekstu wyrażenia.
+		size_t Hash;			//!< Skrót tekstu wyrażenia.
+
+		const KLVariables* Scoope;	//!< Zasięg zmiennych.
+		uint64_t Version;			//!< Znacznik zmiany zasięgu.
+
+		double Return;			//!< Wartość podstawiana za `$`.
+		double Value;			//!< Wartość wyrażenia.
+
+		KLParser::ERROR Error;		//!< Błąd obliczeń.
+
+		bool Binded;			//!< Wyrażenie korzysta ze zbindowanej zmiennej.
+
+		unsigned Used;			//!< Chwila ostatniego użycia (`0` dla wolnego wpisu).
+	};
+
+	protected:
+
+		/*! \brief		Sprawdzenie bindów.
+		 *  \param [in]	Code		Wyrażenie.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \return		`true` jeśli wyrażenie korzysta ze zbindowanej zmiennej.
+		 *
+		 */
+		bool IsBinded(const KLStringView& Code, const KLVariables* Scoope) const;
+
+		KLParser Parser;				//!< Parser obliczający wyrażenia.
+
+		ENTRY Entries[KLCACHE_SIZE];		//!< Wpisy pamięci podręcznej.
+
+		unsigned Clock;				//!< Licznik użyć wpisów.
+
+		double LastValue;				//!< Ostatnia obliczona wartość wyrażenia.
+
+		KLParser::ERROR LastError;		//!< Ostatni odnotowany błąd.
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy pustą pamięć podręczną.
+		 *
+		 */
+		KLCache(void);
+
+		/*! \brief		Wywołanie wyrażenia.
+		 *  \param [in]	Code		Wyrażenie do obliczenia.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return		Powodzenie operacji.
+		 *  \see			GetError(), GetValue().
+		 *
+		 * Zwraca zapamiętany wynik, jeśli od jego obliczenia nie zmienił się zasięg zmiennych. W przeciwnym razie oblicza wyrażenie metodą `KLParser::Evaluate()` i zapamiętuje wynik.
+		 *
+		 */
+		bool Evaluate(const KLStringView& Code, const KLVariables* Scoope = nullptr, const double Return = NAN);
+
+		/*! \brief		Czyszczenie obiektu.
+		 *
+		 * Usuwa wszystkie zapamiętane wyniki.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Pobranie wartości.
+		 *  \return		Ostatnia obliczona wartość.
+		 *  \see			Evaluate().
+		 *
+		 */
+		double GetValue(void) const;
+
+		/*! \brief		Pobranie błędu.
+		 *  \return		Ostatni napotkany błąd.
+		 *  \see			Evaluate().
+		 *
+		 */
+		KLParser::ERROR GetError(void) const;
+
+};
+
+#endif // KLCACHE_HPP
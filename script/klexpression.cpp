@@ -0,0 +1,657 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Compile-time Expression Parser for KLLibs                              *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLEXPRESSION_CPP
+#define KLEXPRESSION_CPP
+
+#include "klexpression.hpp"
+
+template<int Size>
+constexpr bool KLExpression<Size>::IsSpace(char Char)
+{
+	return Char == ' ' || (Char >= '\t' && Char <= '\r');
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::IsDigit(char Char)
+{
+	return Char >= '0' && Char <= '9';
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::IsAlpha(char Char)
+{
+	return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z');
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::IsAlnum(char Char)
+{
+	return IsAlpha(Char) || IsDigit(Char);
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::Equal(const char* Begin, int Length, const char* Token)
+{
+	for (int i = 0; i < Length; ++i) if (Token[i] != Begin[i]) return false;
+
+	return Token[Length] == 0;
+}
+
+template<int Size>
+constexpr int KLExpression<Size>::GetPriority(const KLExpressionToken& Token)
+{
+	if (Token.Class != CLASS::OPERATOR) return 100;
+
+	switch (OPERATOR(Token.Code))
+	{
+		case OPERATOR::ROUND:		return 31;
+		case OPERATOR::ADD:			return 32;
+		case OPERATOR::SUB:			return 32;
+		case OPERATOR::MUL:			return 33;
+		case OPERATOR::DIV:			return 33;
+		case OPERATOR::MOD:			return 33;
+		case OPERATOR::POW:			return 34;
+
+		case OPERATOR::EQ:			return 21;
+		case OPERATOR::NEQ:			return 21;
+		case OPERATOR::GT:			return 22;
+		case OPERATOR::LT:			return 22;
+		case OPERATOR::GE:			return 22;
+		case OPERATOR::LE:			return 22;
+
+		case OPERATOR::OR:			return 11;
+		case OPERATOR::FOR:			return 11;
+		case OPERATOR::AND:			return 12;
+		case OPERATOR::FAND:		return 12;
+
+		case OPERATOR::L_BRACKET:	return 1;
+		case OPERATOR::R_BRACKET:	return 1;
+
+		default: return 0;
+	}
+}
+
+template<int Size>
+constexpr typename KLExpression<Size>::OPERATOR KLExpression<Size>::GetOperator(const char* Begin, int Length)
+{
+	if (Equal(Begin, Length, "~")) return OPERATOR::ROUND;
+	if (Equal(Begin, Length, "+")) return OPERATOR::ADD;
+	if (Equal(Begin, Length, "-")) return OPERATOR::SUB;
+	if (Equal(Begin, Length, "*")) return OPERATOR::MUL;
+	if (Equal(Begin, Length, "/")) return OPERATOR::DIV;
+	if (Equal(Begin, Length, "%")) return OPERATOR::MOD;
+	if (Equal(Begin, Length, "^")) return OPERATOR::POW;
+
+	if (Equal(Begin, Length, "=")) return OPERATOR::EQ;
+	if (Equal(Begin, Length, "<>")) return OPERATOR::NEQ;
+	if (Equal(Begin, Length, ">")) return OPERATOR::GT;
+	if (Equal(Begin, Length, "<")) return OPERATOR::LT;
+	if (Equal(Begin, Length, ">=")) return OPERATOR::GE;
+	if (Equal(Begin, Length, "<=")) return OPERATOR::LE;
+
+	if (Equal(Begin, Length, "|")) return OPERATOR::OR;
+	if (Equal(Begin, Length, "?")) return OPERATOR::FOR;
+	if (Equal(Begin, Length, "&")) return OPERATOR::AND;
+	if (Equal(Begin, Length, "@")) return OPERATOR::FAND;
+
+	return OPERATOR::UNKNOWN;
+}
+
+template<int Size>
+constexpr typename KLExpression<Size>::FUNCTION KLExpression<Size>::GetFunction(const char* Begin, int Length)
+{
+	if (Equal(Begin, Length, "sin")) return FUNCTION::SIN;
+	if (Equal(Begin, Length, "cos")) return FUNCTION::COS;
+	if (Equal(Begin, Length, "tan")) return FUNCTION::TAN;
+
+	if (Equal(Begin, Length, "abs")) return FUNCTION::ABS;
+
+	if (Equal(Begin, Length, "exp")) return FUNCTION::EXP;
+	if (Equal(Begin, Length, "sqrt")) return FUNCTION::SQRT;
+	if (Equal(Begin, Length, "log")) return FUNCTION::LOG;
+	if (Equal(Begin, Length, "ln")) return FUNCTION::LN;
+
+	return FUNCTION::UNKNOWN;
+}
+
+template<int Size>
+constexpr int KLExpression<Size>::Bits(const KLExpressionNumber& Number)
+{
+	for (int i = KLExpressionNumber::WORDS - 1; i >= 0; --i) if (Number.Words[i])
+	{
+		int Count = i * 32;
+
+		for (uint32_t Word = Number.Words[i]; Word; Word >>= 1) ++Count;
+
+		return Count;
+	}
+
+	return 0;
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::Less(const KLExpressionNumber& ParamA, const KLExpressionNumber& ParamB)
+{
+	for (int i = KLExpressionNumber::WORDS - 1; i >= 0; --i) if (ParamA.Words[i] != ParamB.Words[i])
+	{
+		return ParamA.Words[i] < ParamB.Words[i];
+	}
+
+	return false;
+}
+
+template<int Size>
+constexpr void KLExpression<Size>::Subtract(KLExpressionNumber& ParamA, const KLExpressionNumber& ParamB)
+{
+	uint64_t Borrow = 0;
+
+	for (int i = 0; i < KLExpressionNumber::WORDS; ++i)
+	{
+		const uint64_t Result = uint64_t(ParamA.Words[i]) - ParamB.Words[i] - Borrow;
+
+		ParamA.Words[i] = uint32_t(Result);
+		Borrow = (Result >> 32) & 1;
+	}
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::Multiply(KLExpressionNumber& Number, uint32_t Factor, uint32_t Add)
+{
+	uint64_t Carry = Add;
+
+	for (int i = 0; i < KLExpressionNumber::WORDS; ++i)
+	{
+		const uint64_t Result = uint64_t(Number.Words[i]) * Factor + Carry;
+
+		Number.Words[i] = uint32_t(Result);
+		Carry = Result >> 32;
+	}
+
+	return !Carry;
+}
+
+template<int Size>
+constexpr bool KLExpression<Size>::Shift(KLExpressionNumber& Number, int Count)
+{
+	bool Lost = false;
+
+	if (Count >= 0)
+	{
+		const int Move = Count / 32, Bit = Count % 32;
+
+		for (int i = KLExpressionNumber::WORDS - 1; i >= 0; --i)
+		{
+			uint32_t Word = i - Move >= 0 ? uint32_t(Number.Words[i - Move] << Bit) : 0;
+
+			if (Bit && i - Move - 1 >= 0) Word |= Number.Words[i - Move - 1] >> (32 - Bit);
+
+			Number.Words[i] = Word;
+		}
+	}
+	else
+	{
+		const int Move = -Count / 32, Bit = -Count % 32;
+
+		for (int i = 0; i < Move && i < KLExpressionNumber::WORDS; ++i) Lost |= Number.Words[i] != 0;
+
+		if (Bit && Move < KLExpressionNumber::WORDS) Lost |= (Number.Words[Move] & ((uint32_t(1) << Bit) - 1)) != 0;
+
+		for (int i = 0; i < KLExpressionNumber::WORDS; ++i)
+		{
+			uint32_t Word = i + Move < KLExpressionNumber::WORDS ? Number.Words[i + Move] >> Bit : 0;
+
+			if (Bit && i + Move + 1 < KLExpressionNumber::WORDS) Word |= uint32_t(Number.Words[i + Move + 1] << (32 - Bit));
+
+			Number.Words[i] = Word;
+		}
+	}
+
+	return Lost;
+}
+
+template<int Size>
+constexpr typename KLExpression<Size>::KLSCONSTANT KLExpression<Size>::GetNumber(const char* Begin, const char* End)
+{
+	const char* Current = Begin;
+
+#if defined(USING_FIXED_POINT)
+	const KLSWIDE Max = KLSWIDE(KLParser::KLSNUMBER::MAX);
+	const KLSWIDE One = KLSWIDE(KLParser::KLSNUMBER::ONE);
+
+	KLSWIDE Integer = 0;
+	uint32_t Numerator = 0, Denominator = 1;
+
+	while (Current < End && IsDigit(*Current))
+	{
+		if (Integer <= Max) Integer = Integer * 10 + (*Current - '0');
+
+		++Current;
+	}
+
+	if (Current < End && *Current == '.')
+	{
+		++Current;
+
+		while (Current < End && IsDigit(*Current))
+		{
+			if (Denominator < 1000000000u)
+			{
+				Numerator = Numerator * 10 + (*Current - '0');
+				Denominator *= 10;
+			}
+
+			++Current;
+		}
+	}
+
+	const KLSWIDE Part = (KLSWIDE(Numerator) * One + Denominator / 2) / Denominator;
+	const KLSWIDE Result = Integer > Max ? Max + 1 : Integer * One + Part;
+
+	return KLSCONSTANT(Result > Max ? Max : Result);
+#else
+	KLExpressionNumber Number {}, Divisor {};
+	int Scale = 0;
+
+	for (; Current < End && IsDigit(*Current); ++Current)
+	{
+		Multiply(Number, 10, uint32_t(*Current - '0'));
+	}
+
+	if (Current < End && *Current == '.')
+	{
+		const char* Last = ++Current;
+
+		for (const char* Pos = Current; Pos < End && IsDigit(*Pos); ++Pos) if (*Pos != '0') Last = Pos + 1;
+
+		for (; Current < Last; ++Current, ++Scale)
+		{
+			Multiply(Number, 10, uint32_t(*Current - '0'));
+		}
+	}
+
+	if (!Bits(Number)) return 0.0;
+
+	Divisor.Words[0] = 1;
+
+	for (int i = 0; i < Scale; ++i) Multiply(Divisor, 10, 0);
+
+	const int Power = DBL_MANT_DIG + 3 - (Bits(Number) - Bits(Divisor));
+	const int Length = DBL_MANT_DIG + 3;
+
+	bool Sticky = Shift(Number, Power);
+	uint64_t Quotient = 0;
+
+	Shift(Divisor, Length);
+
+	for (int i = Length; i >= 0; --i)
+	{
+		if (!Less(Number, Divisor))
+		{
+			Subtract(Number, Divisor);
+			Quotient |= uint64_t(1) << i;
+		}
+
+		Shift(Divisor, -1);
+	}
+
+	Sticky |= Bits(Number) != 0;
+
+	int Drop = 0;
+
+	// liczby zdenormalizowane mają mniej bitów mantysy, a wynik poniżej ich zakresu zaokrąglany jest do zera
+	while (Drop < 62 && ((Quotient >> Drop) >> DBL_MANT_DIG || Drop - Power < DBL_MIN_EXP - DBL_MANT_DIG)) ++Drop;
+
+	uint64_t Mantissa = Quotient >> Drop;
+
+	const uint64_t Rest = Quotient & ((uint64_t(1) << Drop) - 1);
+	const uint64_t Half = uint64_t(1) << (Drop - 1);
+
+	if (Rest > Half || (Rest == Half && (Sticky || (Mantissa & 1)))) ++Mantissa;
+
+	if (Mantissa >> DBL_MANT_DIG)
+	{
+		Mantissa >>= 1; ++Drop;
+	}
+
+	double Value = double(Mantissa);
+
+	for (int Exponent = Drop - Power; Exponent > 0; --Exponent)
+	{
+		if (Value > DBL_MAX / 2.0) return INFINITY;
+
+		Value *= 2.0;
+	}
+
+	for (int Exponent = Drop - Power; Exponent < 0; ++Exponent) Value /= 2.0;
+
+	return Value;
+#endif
+}
+
+template<int Size>
+constexpr void KLExpression<Size>::Reject(KLParser::ERROR Error)
+{
+	switch (Error)
+	{
+		case KLParser::UNEXPECTED_OPERATOR:		UnexpectedOperator(); break;
+		case KLParser::UNKNOWN_OPERATOR:		UnknownOperator(); break;
+		case KLParser::UNKNOWN_EXPRESSION:		UnknownExpression(); break;
+		case KLParser::NOT_ENOUGH_PARAMETERS:	NotEnoughParameters(); break;
+		case KLParser::TOO_MANY_PARAMETERS:	TooManyParameters(); break;
+		case KLParser::BRACKETS_NOT_EQUAL:		BracketsNotEqual(); break;
+		case KLParser::OUT_OF_CAPACITY:		OutOfCapacity(); break;
+
+		default: break;
+	}
+}
+
+template<int Size> void KLExpression<Size>::UnexpectedOperator(void) {}
+template<int Size> void KLExpression<Size>::UnknownOperator(void) {}
+template<int Size> void KLExpression<Size>::UnknownExpression(void) {}
+template<int Size> void KLExpression<Size>::NotEnoughParameters(void) {}
+template<int Size> void KLExpression<Size>::TooManyParameters(void) {}
+template<int Size> void KLExpression<Size>::BracketsNotEqual(void) {}
+template<int Size> void KLExpression<Size>::OutOfCapacity(void) {}
+
+template<int Size>
+constexpr void KLExpression<Size>::Append(const KLExpressionToken& Token)
+{
+#if defined(USING_STATIC_CONTAINERS)
+	if (Count >= KLPARSER_TOKENS) LastError = KLParser::OUT_OF_CAPACITY;
+	else
+#endif
+	if (Count >= Size) LastError = KLParser::OUT_OF_CAPACITY;
+	else Tokens[Count++] = Token;
+}
+
+template<int Size>
+constexpr void KLExpression<Size>::Append(KLExpressionState& State, const KLExpressionToken& Token)
+{
+#if defined(USING_STATIC_CONTAINERS)
+	if (State.Top >= KLPARSER_TOKENS) LastError = KLParser::OUT_OF_CAPACITY;
+	else
+#endif
+	if (State.Top >= Size) LastError = KLParser::OUT_OF_CAPACITY;
+	else State.Operators[State.Top++] = Token;
+}
+
+template<int Size>
+constexpr void KLExpression<Size>::Emit(KLExpressionState& State, const KLExpressionToken& Token)
+{
+	const int Arity = Token.Class == CLASS::OPERATOR ? 2 : Token.Class == CLASS::FUNCTION ? 1 : 0;
+
+	if (State.Invalid == KLParser::NO_ERROR)
+	{
+		if (Token.Class == CLASS::OPERATOR && OPERATOR(Token.Code) == OPERATOR::L_BRACKET) State.Invalid = KLParser::BRACKETS_NOT_EQUAL;
+		else if (State.Depth < Arity) State.Invalid = KLParser::NOT_ENOUGH_PARAMETERS;
+		else if (Token.Class == CLASS::OPERATOR && OPERATOR(Token.Code) == OPERATOR::UNKNOWN) State.Invalid = KLParser::UNKNOWN_OPERATOR;
+	}
+
+	State.Depth += 1 - Arity;
+
+#if defined(USING_STATIC_CONTAINERS)
+	if (State.Invalid == KLParser::NO_ERROR && State.Depth > KLPARSER_STACK) State.Invalid = KLParser::OUT_OF_CAPACITY;
+#endif
+
+	Append(Token);
+}
+
+template<int Size>
+constexpr void KLExpression<Size>::Push(KLExpressionState& State, const KLExpressionToken& Token)
+{
+	while (State.Top && GetPriority(Token) <= GetPriority(State.Operators[State.Top - 1]))
+	{
+		Emit(State, State.Operators[--State.Top]);
+	}
+
+	Append(State, Token);
+
+	State.Last = true;
+}
+
+template<int Size>
+constexpr int KLExpression<Size>::Intern(int Offset, int Length)
+{
+	for (int i = 0; i < Variables; ++i) if (Names[i].Length == Length)
+	{
+		int Same = 0; while (Same < Length && Text[Offset + Same] == Text[Names[i].Offset + Same]) ++Same;
+
+		if (Same == Length) return i;
+	}
+
+	Names[Variables] = { Offset, Length };
+
+	return Variables++;
+}
+
+template<int Size>
+constexpr void KLExpression<Size>::Parse(void)
+{
+	KLExpressionState State {};
+
+	State.Last = true;
+
+	int Start = 0, Pos = 0;
+
+	while (Pos < Size - 1 && LastError == KLParser::NO_ERROR)
+	{
+		while (Pos < Size - 1 && IsSpace(Text[Pos])) ++Pos;
+
+		if (!Text[Pos]) break;
+		else Start = Pos;
+
+		if (IsDigit(Text[Pos]))
+		{
+			State.Last = false; while (IsDigit(Text[Pos]) || Text[Pos] == '.') ++Pos;
+
+			Emit(State, { CLASS::VALUE, 0, GetNumber(Text + Start, Text + Pos) });
+		}
+		else if (IsAlpha(Text[Pos]))
+		{
+			State.Last = true; while (IsAlnum(Text[Pos])) ++Pos;
+
+			const FUNCTION Function = GetFunction(Text + Start, Pos - Start);
+
+			if (Function == FUNCTION::UNKNOWN)
+			{
+				State.Last = false;
+
+				Emit(State, { CLASS::VARIABLE, Intern(Start, Pos - Start), 0 });
+			}
+			else Append(State, { CLASS::FUNCTION, int(Function), 0 });
+		}
+		else
+		{
+			switch (Text[Pos])
+			{
+				case ')':
+					while (true)
+					{
+						if (!State.Top)
+						{
+							LastError = KLParser::BRACKETS_NOT_EQUAL; return;
+						}
+
+						const KLExpressionToken Operator = State.Operators[--State.Top];
+
+						if (Operator.Class == CLASS::OPERATOR && OPERATOR(Operator.Code) == OPERATOR::L_BRACKET) break;
+						else Emit(State, Operator);
+					}
+				break;
+				case '(':
+					Append(State, { CLASS::OPERATOR, int(OPERATOR::L_BRACKET), 0 });
+				break;
+				case '~':
+				case '+':
+				case '*':
+				case '/':
+				case '%':
+				case '^':
+				case '=':
+				case '|':
+				case '&':
+				case '?':
+				case '@':
+					Push(State, { CLASS::OPERATOR, int(GetOperator(Text + Pos, 1)), 0 });
+				break;
+				case '-':
+					if (State.Last) Push(State, { CLASS::FUNCTION, int(FUNCTION::MINUS), 0 });
+					else Push(State, { CLASS::OPERATOR, int(OPERATOR::SUB), 0 });
+				break;
+				case '!':
+					Push(State, { CLASS::FUNCTION, int(FUNCTION::NOT), 0 });
+				break;
+				case '$':
+					Emit(State, { CLASS::RETURN, 0, 0 });
+				break;
+				default:
+				{
+					while (Text[Pos] &&
+						  !IsSpace(Text[Pos]) &&
+						  !IsDigit(Text[Pos]) &&
+						  !IsAlpha(Text[Pos]) &&
+						  Text[Pos] != '(' &&
+						  Text[Pos] != ')') ++Pos;
+
+					Push(State, { CLASS::OPERATOR, int(GetOperator(Text + Start, Pos - Start)), 0 }); --Pos;
+				}
+			}
+
+			++Pos;
+		}
+	}
+
+	while (State.Top && LastError == KLParser::NO_ERROR) Emit(State, State.Operators[--State.Top]);
+
+	if (LastError == KLParser::NO_ERROR && State.Depth != 1 && State.Invalid == KLParser::NO_ERROR) State.Invalid = KLParser::TOO_MANY_PARAMETERS;
+	if (LastError == KLParser::NO_ERROR) LastError = State.Invalid;
+}
+
+template<int Size>
+constexpr KLExpression<Size>::KLExpression(const char (&Code)[Size])
+: Text {}, Tokens {}, Names {}, Count(0), Variables(0), LastError(KLParser::NO_ERROR)
+{
+	for (int i = 0; i < Size - 1; ++i) Text[i] = Code[i];
+
+	Parse();
+
+	Reject(LastError);
+}
+
+template<int Size>
+constexpr int KLExpression<Size>::Find(const char* Name) const
+{
+	for (int i = 0; i < Variables; ++i)
+	{
+		if (Equal(Text + Names[i].Offset, Names[i].Length, Name)) return i;
+	}
+
+	return -1;
+}
+
+template<int Size>
+constexpr int KLExpression<Size>::GetVariables(void) const
+{
+	return Variables;
+}
+
+template<int Size>
+constexpr KLParser::ERROR KLExpression<Size>::GetError(void) const
+{
+	return LastError;
+}
+
+template<int Size>
+KLStringView KLExpression<Size>::GetName(int Index) const
+{
+	return KLStringView(Text + Names[Index].Offset, Names[Index].Length);
+}
+
+template<int Size>
+double KLExpression<Size>::Calculate(const double* Values, const double Return) const
+{
+	KLParser::KLSNUMBER Stack[Size];
+
+	int Top = 0;
+
+	if (LastError != KLParser::NO_ERROR) return NAN;
+
+	for (int i = 0; i < Count; ++i)
+	{
+		const KLExpressionToken& Token = Tokens[i];
+
+		switch (Token.Class)
+		{
+			case CLASS::VALUE:
+#if defined(USING_FIXED_POINT)
+				Stack[Top++] = KLParser::KLSNUMBER::FromRaw(Token.Value);
+#else
+				Stack[Top++] = Token.Value;
+#endif
+			break;
+			case CLASS::VARIABLE:
+				Stack[Top++] = KLParser::KLSNUMBER(Values[Token.Code]);
+			break;
+			case CLASS::RETURN:
+				Stack[Top++] = KLParser::KLSNUMBER(Return);
+			break;
+			case CLASS::OPERATOR:
+				--Top; Stack[Top - 1] = KLParser::KLParserToken::Calculate(OPERATOR(Token.Code), Stack[Top - 1], Stack[Top]);
+			break;
+			case CLASS::FUNCTION:
+				Stack[Top - 1] = KLParser::KLParserToken::Calculate(FUNCTION(Token.Code), Stack[Top - 1]);
+			break;
+			default: break;
+		}
+	}
+
+	return double(Stack[0]);
+}
+
+template<int Size>
+bool KLExpression<Size>::Evaluate(const KLVariables* Scoope, double& Value, const double Return) const
+{
+	double Values[Size];
+
+	Value = NAN;
+
+	if (LastError != KLParser::NO_ERROR) return false;
+
+	for (int i = 0; i < Variables; ++i)
+	{
+		const KLSymbol Symbol = Scoope ? KLSymbol::Find(GetName(i)) : KLSymbol();
+
+		if (Symbol.IsValid() && Scoope->Exists(Symbol)) Values[i] = (*Scoope)[Symbol].ToNumber();
+		else return false;
+	}
+
+	Value = Calculate(Values, Return);
+
+	return true;
+}
+
+template<int Size>
+constexpr KLExpression<Size> KLExpr(const char (&Code)[Size])
+{
+	return KLExpression<Size>(Code);
+}
+
+#endif // KLEXPRESSION_CPP
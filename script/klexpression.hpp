@@ -0,0 +1,335 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Compile-time Expression Parser for KLLibs                              *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLEXPRESSION_HPP
+#define KLEXPRESSION_HPP
+
+#include "../libbuild.hpp"
+
+#include "../containers/klstringview.hpp"
+#include "../containers/klsymbol.hpp"
+
+#include "klparser.hpp"
+#include "klvariables.hpp"
+
+#include <float.h>
+#include <stdint.h>
+
+/*! \file		klexpression.hpp
+ *  \brief	Deklaracje dla klasy KLExpression i jej składników.
+ *
+ */
+
+/*! \file		klexpression.cpp
+ *  \brief	Implementacja klasy KLExpression i jej składników.
+ *
+ */
+
+/*! \brief	Wyrażenie przetwarzane podczas kompilacji.
+ *  \tparam	Size Rozmiar tekstu wyrażenia (wraz z kończącym znakiem `0`).
+ *
+ * Przetwarza stały tekst wyrażenia do postaci RPN w konstruktorze `constexpr`, dzięki czemu wyrażenie zapisane w kodzie źródłowym jest sprawdzane i przetwarzane przez kompilator. Obiekt tworzy się funkcją `KLExpr()`:
+ *
+ * \code
+ * constexpr auto Area = KLExpr("a * b + c");
+ * \endcode
+ *
+ * Błąd składni w obiekcie `constexpr` przerywa kompilację, a komunikat kompilatora wskazuje funkcję nazwaną tak jak błąd (np. `BracketsNotEqual()`). Wyrażenie utworzone poza kontekstem `constexpr` zgłasza błąd przez metodę `GetError()`, tak samo jak `KLParser::Compile()`.
+ *
+ * Obliczenie wyrażenia sprowadza się do pobrania wartości zmiennych i wykonania działań na stałym stosie, bez przydziału pamięci i bez parsowania tekstu. Zmienne numerowane są w kolejności pierwszego wystąpienia w wyrażeniu (`Find()`), a wyniki i błędy składni są identyczne z wynikami klasy `KLParser`.
+ *
+ * Stałe liczbowe zamieniane są podczas kompilacji z poprawnym zaokrągleniem do typu `double` (na platformie AVR, gdzie `KLNumber::Parse()` nie zaokrągla dokładnie, wynik może różnić się na ostatnim bicie). Długość stałej nie jest ograniczona: stała większa od zakresu typu `double` daje `inf`, a mniejsza od najmniejszej liczby zdenormalizowanej `0`, tak samo jak w klasie `KLParser`.
+ *
+ */
+template<int Size>
+class KLExpression
+{
+
+#if defined(USING_FIXED_POINT)
+	protected: using KLSCONSTANT = int64_t;
+#else
+	protected: using KLSCONSTANT = double;
+#endif
+
+#if defined(USING_FIXED_POINT) && defined(KLFIXED_WIDE)
+	protected: using KLSWIDE = __int128;
+#elif defined(USING_FIXED_POINT)
+	protected: using KLSWIDE = int64_t;
+#endif
+
+	protected: using CLASS = KLParser::KLParserToken::CLASS;
+	protected: using OPERATOR = KLParser::KLParserToken::OPERATOR;
+	protected: using FUNCTION = KLParser::KLParserToken::FUNCTION;
+
+	/*! \brief		Token wyrażenia.
+	 *
+	 * Przechowuje wartość stałej, numer operatora, funkcji lub zmiennej.
+	 *
+	 */
+	protected: struct KLExpressionToken
+	{
+		CLASS Class;		//!< Klasa tokenu.
+
+		int Code;			//!< Numer operatora, funkcji lub zmiennej.
+
+		KLSCONSTANT Value;	//!< Wartość stałej (w trybie `USING_FIXED_POINT` wartość wewnętrzna).
+	};
+
+	/*! \brief		Nazwa zmiennej.
+	 *
+	 * Położenie nazwy zmiennej w tekście wyrażenia.
+	 *
+	 */
+	protected: struct KLExpressionName
+	{
+		int Offset;	//!< Początek nazwy.
+		int Length;	//!< Długość nazwy.
+	};
+
+	/*! \brief		Stan przetwarzania.
+	 *
+	 * Stos operatorów i głębokość stosu wartości używane podczas przetwarzania wyrażenia.
+	 *
+	 */
+	protected: struct KLExpressionState
+	{
+		KLExpressionToken Operators[Size];	//!< Stos operatorów.
+
+		int Top;						//!< Liczba operatorów na stosie.
+		int Depth;					//!< Głębokość stosu wartości.
+
+		bool Last;					//!< Ostatni token był operatorem.
+
+		KLParser::ERROR Invalid;		//!< Pierwszy błąd wykryty w tokenach.
+	};
+
+	/*! \brief		Duża liczba całkowita.
+	 *
+	 * Liczba używana do dokładnej zamiany stałych na typ `double`. Jej długość wystarcza na iloczyn `10^(Size - 1)` i mantysy, więc mieści każdą stałą wyrażenia.
+	 *
+	 */
+	protected: struct KLExpressionNumber
+	{
+		static constexpr int WORDS = (Size * 10 / 3 + DBL_MANT_DIG + 8) / 32 + 2;	//!< Liczba słów.
+
+		uint32_t Words[WORDS];	//!< Słowa liczby (od najmłodszego).
+	};
+
+	protected:
+
+		char Text[Size];					//!< Tekst wyrażenia.
+
+		KLExpressionToken Tokens[Size];	//!< Tokeny w notacji RPN.
+		KLExpressionName Names[Size];		//!< Nazwy zmiennych.
+
+		int Count;						//!< Liczba tokenów.
+		int Variables;					//!< Liczba zmiennych.
+
+		KLParser::ERROR LastError;			//!< Błąd przetwarzania.
+
+		static constexpr bool IsSpace(char Char);
+		static constexpr bool IsDigit(char Char);
+		static constexpr bool IsAlpha(char Char);
+		static constexpr bool IsAlnum(char Char);
+
+		/*! \brief		Porównanie fragmentu tekstu.
+		 *  \param [in]	Begin	Początek fragmentu.
+		 *  \param [in]	Length	Długość fragmentu.
+		 *  \param [in]	Token	Porównywany napis.
+		 *  \return		`true` jeśli fragment jest równy napisowi.
+		 *
+		 */
+		static constexpr bool Equal(const char* Begin, int Length, const char* Token);
+
+		/*! \brief		Pobranie priorytetu.
+		 *  \param [in]	Token Token wyrażenia.
+		 *  \return		Priorytet tokenu.
+		 *
+		 * Zwraca te same priorytety co `KLParser::KLParserToken::GetPriority()`.
+		 *
+		 */
+		static constexpr int GetPriority(const KLExpressionToken& Token);
+
+		/*! \brief		Wyszukanie operatora.
+		 *  \param [in]	Begin	Początek symbolu.
+		 *  \param [in]	Length	Długość symbolu.
+		 *  \return		Numer operatora (`OPERATOR::UNKNOWN` gdy brak).
+		 *
+		 */
+		static constexpr OPERATOR GetOperator(const char* Begin, int Length);
+
+		/*! \brief		Wyszukanie funkcji.
+		 *  \param [in]	Begin	Początek nazwy.
+		 *  \param [in]	Length	Długość nazwy.
+		 *  \return		Numer funkcji (`FUNCTION::UNKNOWN` gdy brak).
+		 *
+		 */
+		static constexpr FUNCTION GetFunction(const char* Begin, int Length);
+
+		static constexpr int Bits(const KLExpressionNumber& Number);
+		static constexpr bool Less(const KLExpressionNumber& ParamA, const KLExpressionNumber& ParamB);
+		static constexpr void Subtract(KLExpressionNumber& ParamA, const KLExpressionNumber& ParamB);
+		static constexpr bool Multiply(KLExpressionNumber& Number, uint32_t Factor, uint32_t Add);
+		static constexpr bool Shift(KLExpressionNumber& Number, int Count);
+
+		/*! \brief		Zamiana stałej.
+		 *  \param [in]	Begin	Początek stałej.
+		 *  \param [in]	End		Koniec stałej.
+		 *  \return		Wartość stałej.
+		 *
+		 * Odczytuje stałą tak samo jak `KLNumber::Parse()` lub `KLFixedPoint::Parse()`. W trybie zmiennoprzecinkowym stała jest dzielona dokładnie na dużych liczbach całkowitych i zaokrąglana do najbliższej wartości typu `double` (także zdenormalizowanej).
+		 *
+		 */
+		static constexpr KLSCONSTANT GetNumber(const char* Begin, const char* End);
+
+		/*! \brief		Zgłoszenie błędu.
+		 *  \param [in]	Error Błąd przetwarzania.
+		 *
+		 * Wywołuje funkcję, która nie jest `constexpr`, dzięki czemu błąd w wyrażeniu `constexpr` przerywa kompilację.
+		 *
+		 */
+		static constexpr void Reject(KLParser::ERROR Error);
+
+		static void UnexpectedOperator(void);	//!< Błąd `KLParser::UNEXPECTED_OPERATOR`.
+		static void UnknownOperator(void);		//!< Błąd `KLParser::UNKNOWN_OPERATOR`.
+		static void UnknownExpression(void);	//!< Błąd `KLParser::UNKNOWN_EXPRESSION`.
+		static void NotEnoughParameters(void);	//!< Błąd `KLParser::NOT_ENOUGH_PARAMETERS`.
+		static void TooManyParameters(void);	//!< Błąd `KLParser::TOO_MANY_PARAMETERS`.
+		static void BracketsNotEqual(void);	//!< Błąd `KLParser::BRACKETS_NOT_EQUAL`.
+		static void OutOfCapacity(void);		//!< Błąd `KLParser::OUT_OF_CAPACITY`.
+
+		/*! \brief		Dopisanie tokenu.
+		 *  \param [in]	Token Token wyrażenia.
+		 *
+		 */
+		constexpr void Append(const KLExpressionToken& Token);
+
+		/*! \brief		Dopisanie operatora.
+		 *  \param [in,out]	State	Stan przetwarzania.
+		 *  \param [in]		Token	Operator lub funkcja.
+		 *
+		 */
+		constexpr void Append(KLExpressionState& State, const KLExpressionToken& Token);
+
+		/*! \brief		Umieszczenie tokenu w wyniku.
+		 *  \param [in,out]	State	Stan przetwarzania.
+		 *  \param [in]		Token	Token wyrażenia.
+		 *
+		 * Śledzi głębokość stosu wartości i wykrywa błędy tak samo jak `KLParser::GetTokens()`.
+		 *
+		 */
+		constexpr void Emit(KLExpressionState& State, const KLExpressionToken& Token);
+
+		/*! \brief		Umieszczenie operatora na stosie.
+		 *  \param [in,out]	State	Stan przetwarzania.
+		 *  \param [in]		Token	Operator lub funkcja.
+		 *
+		 */
+		constexpr void Push(KLExpressionState& State, const KLExpressionToken& Token);
+
+		/*! \brief		Dodanie zmiennej.
+		 *  \param [in]	Offset	Początek nazwy.
+		 *  \param [in]	Length	Długość nazwy.
+		 *  \return		Numer zmiennej.
+		 *
+		 */
+		constexpr int Intern(int Offset, int Length);
+
+		/*! \brief		Przekształcenie wyrażenia do notacji RPN.
+		 *
+		 * Przenosi algorytm metody `KLParser::GetTokens()` (bez tokenów skoku, które nie zmieniają wyniku).
+		 *
+		 */
+		constexpr void Parse(void);
+
+	public:
+
+		/*! \brief		Konstruktor z tekstu.
+		 *  \param [in]	Code Wyrażenie do przetworzenia.
+		 *
+		 * Przetwarza wyrażenie. W kontekście `constexpr` błąd składni przerywa kompilację.
+		 *
+		 */
+		constexpr KLExpression(const char (&Code)[Size]);
+
+		/*! \brief		Wyszukanie zmiennej.
+		 *  \param [in]	Name Nazwa zmiennej.
+		 *  \return		Numer zmiennej lub `-1` gdy wyrażenie nie korzysta ze zmiennej.
+		 *
+		 * Zwraca indeks w tablicy wartości przekazywanej do metody `Calculate()`.
+		 *
+		 */
+		constexpr int Find(const char* Name) const;
+
+		/*! \brief		Liczba zmiennych.
+		 *  \return		Liczba różnych zmiennych wyrażenia.
+		 *
+		 */
+		constexpr int GetVariables(void) const;
+
+		/*! \brief		Pobranie błędu.
+		 *  \return		Błąd przetwarzania wyrażenia.
+		 *
+		 */
+		constexpr KLParser::ERROR GetError(void) const;
+
+		/*! \brief		Pobranie nazwy zmiennej.
+		 *  \param [in]	Index Numer zmiennej.
+		 *  \return		Nazwa zmiennej.
+		 *
+		 */
+		KLStringView GetName(int Index) const;
+
+		/*! \brief		Obliczenie wyrażenia.
+		 *  \param [in]	Values	Wartości zmiennych w kolejności zwracanej przez `Find()`.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return		Wartość wyrażenia lub `NAN` gdy wyrażenie zawiera błąd.
+		 *
+		 * Wykonuje wyłącznie działania na stałym stosie - nie przydziela pamięci i nie wyszukuje zmiennych.
+		 *
+		 */
+		double Calculate(const double* Values, const double Return = NAN) const;
+
+		/*! \brief		Obliczenie wyrażenia.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [out]	Value	Wartość wyrażenia.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Pobiera wartości zmiennych z zasięgu i oblicza wyrażenie. Gdy zmienna nie istnieje zwracany jest `false`, a wartość ustawiana jest na `NAN` (odpowiada błędowi `KLParser::UNKNOWN_EXPRESSION`).
+		 *
+		 */
+		bool Evaluate(const KLVariables* Scoope, double& Value, const double Return = NAN) const;
+
+};
+
+/*! \brief		Utworzenie wyrażenia.
+ *  \tparam		Size Rozmiar tekstu wyrażenia.
+ *  \param [in]	Code Wyrażenie do przetworzenia.
+ *  \return		Przetworzone wyrażenie.
+ *
+ * Pozwala pominąć rozmiar wyrażenia: `constexpr auto Expr = KLExpr("a + b");`.
+ *
+ */
+template<int Size> constexpr KLExpression<Size> KLExpr(const char (&Code)[Size]);
+
+#include "klexpression.cpp"
+
+#endif // KLEXPRESSION_HPP
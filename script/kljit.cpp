@@ -0,0 +1,487 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Expression JIT Compiler for KLLibs                         *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "kljit.hpp"
+
+#if !defined(F_CPU) && !defined(USING_FIXED_POINT) && (defined(__x86_64__) || defined(_M_X64))
+#define KLJIT_NATIVE
+#include <stdint.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#endif
+
+#if defined(KLJIT_NATIVE) && !defined(_WIN32) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define ReturnError(error) { LastError = error; return false; }
+
+#if defined(KLJIT_NATIVE)
+
+#define Emit(Bytes) Put(Out, Bytes, sizeof(Bytes) - 1)
+
+#if defined(_WIN32)
+static const int Shadow = 32;		// Obszar parametrów wymagany przez konwencję wywołań Windows x64.
+#else
+static const int Shadow = 0;
+#endif
+
+static const uint64_t One = 0x3FF0000000000000ull;
+static const uint64_t Sign = 0x8000000000000000ull;
+static const uint64_t Lowest = 0xFFF0000000000000ull;
+static const uint64_t Highest = 0x7FF0000000000000ull;
+
+static double Round(double A, double B) { return KLParser::Round(A, int(B)); }
+static double Mod(double A, double B) { return int(A) % int(B); }
+static double Pow(double A, double B) { return pow(A, B); }
+
+static double Sin(double A) { return sin(A); }
+static double Cos(double A) { return cos(A); }
+static double Tan(double A) { return tan(A); }
+static double Exp(double A) { return exp(A); }
+static double Log(double A) { return log10(A); }
+static double Ln(double A) { return log(A); }
+
+static void Put(unsigned char*& Out, const char* Bytes, int Count)
+{
+	memcpy(Out, Bytes, Count); Out += Count;
+}
+
+static void Put(unsigned char*& Out, uint32_t Value)
+{
+	memcpy(Out, &Value, sizeof(Value)); Out += sizeof(Value);
+}
+
+static void Put(unsigned char*& Out, uint64_t Value)
+{
+	memcpy(Out, &Value, sizeof(Value)); Out += sizeof(Value);
+}
+
+static void Constant(unsigned char*& Out, uint64_t Bits, bool Top)
+{
+	Emit("\x48\xB8"); Put(Out, Bits);						// mov rax, Bits
+
+	if (Top) Emit("\x66\x48\x0F\x6E\xC0");					// movq xmm0, rax
+	else Emit("\x66\x48\x0F\x6E\xD0");						// movq xmm2, rax
+}
+
+static void Slot(unsigned char*& Out, int Index, bool Store)
+{
+	if (Store) Emit("\xF2\x0F\x11\x84\x24");					// movsd [rsp + disp32], xmm0
+	else Emit("\xF2\x0F\x10\x84\x24");						// movsd xmm0, [rsp + disp32]
+
+	Put(Out, uint32_t(Shadow + Index * 8));
+}
+
+static void Call(unsigned char*& Out, double (*Function)(double))
+{
+	Emit("\x48\xB8"); Put(Out, uint64_t(uintptr_t(Function)));	// mov rax, Function
+	Emit("\xFF\xD0");									// call rax
+}
+
+static void Call(unsigned char*& Out, double (*Function)(double, double))
+{
+	Emit("\x48\xB8"); Put(Out, uint64_t(uintptr_t(Function)));	// mov rax, Function
+	Emit("\xFF\xD0");									// call rax
+}
+
+static void Boolean(unsigned char*& Out)
+{
+	Constant(Out, One, false);
+	Emit("\x66\x0F\x54\xC2");								// andpd xmm0, xmm2
+}
+
+#endif
+
+KLJit::KLJit(void)
+: Function(nullptr), Code(nullptr), Size(0), Data(nullptr), LastValue(NAN), LastError(KLParser::NO_ERROR) {}
+
+KLJit::~KLJit(void)
+{
+	Clean();
+}
+
+bool KLJit::Generate(void)
+{
+#if defined(KLJIT_NATIVE)
+	using OPERATOR = KLParser::KLParserToken::OPERATOR;
+	using FUNCTION = KLParser::KLParserToken::FUNCTION;
+	using CLASS = KLParser::KLParserToken::CLASS;
+
+	const KLProgram::EXPRESSION& Expression = Program.Expressions[0];
+	const KLParser::KLParserToken* Tokens = Program.Tokens + Expression.First;
+	const int Count = Expression.Count;
+
+	int* Depths = new int[Count + 1];
+	int* Labels = new int[Count + 1];
+	int* Links = new int[Count];
+
+	unsigned char* Buffer = new unsigned char[64 * (Count + 1)];
+	unsigned char* Out = Buffer;
+
+	int Depth = 0, Deepest = 0;
+	bool Valid = true;
+
+	for (int i = 0; i < Count && Valid; ++i)
+	{
+		const KLParser::KLParserToken& Token = Tokens[i];
+
+		Depths[i] = Depth;
+
+		switch (Token.Class)
+		{
+			case CLASS::VALUE:
+			case CLASS::VARIABLE:
+			case CLASS::RETURN:
+				if (++Depth > Deepest) Deepest = Depth;
+			break;
+
+			case CLASS::JUMP:
+				Valid = Token.Target == -1 || Depth > 0;
+			break;
+
+			default:
+				Valid = Depth >= Token.GetArity();
+				Depth -= Token.GetArity() - 1;
+		}
+	}
+
+	Depths[Count] = Depth;
+
+	if (Depth != 1) Valid = false;
+
+#if defined(USING_STATIC_CONTAINERS)
+	if (Deepest > KLPARSER_STACK) Valid = false;
+#endif
+
+	// Skok jest poprawny tylko gdy pominięty fragment nie sięga pod lewy argument i zostawia stos tej samej głębokości
+	for (int i = 0; i < Count && Valid; ++i) if (Tokens[i].Class == CLASS::JUMP && Tokens[i].Target != -1)
+	{
+		for (int j = i + 1; j <= Tokens[i].Target && Valid; ++j) Valid = Depths[j] >= Depths[i];
+
+		if (Depths[Tokens[i].Target] != Depths[i]) Valid = false;
+	}
+
+	const int Frame = (Shadow + Deepest * 8 + 15) & ~15;
+
+	Emit("\x53");											// push rbx
+#if defined(_WIN32)
+	Emit("\x48\x89\xCB");									// mov rbx, rcx
+#else
+	Emit("\x48\x89\xFB");									// mov rbx, rdi
+#endif
+	Emit("\x48\x81\xEC"); Put(Out, uint32_t(Frame));				// sub rsp, Frame
+
+	for (int i = 0; i < Count && Valid; ++i)
+	{
+		const KLParser::KLParserToken& Token = Tokens[i];
+
+		Labels[i] = int(Out - Buffer);
+		Links[i] = -1;
+
+		switch (Token.Class)
+		{
+			case CLASS::VALUE:
+			case CLASS::VARIABLE:
+			case CLASS::RETURN:
+				if (Depths[i]) Slot(Out, Depths[i] - 1, true);
+
+				if (Token.Class == CLASS::VALUE)
+				{
+					const double Value = Token.GetValue();
+					uint64_t Bits;
+
+					memcpy(&Bits, &Value, sizeof(Bits));
+					Constant(Out, Bits, true);
+				}
+				else
+				{
+					Emit("\xF2\x0F\x10\x83");						// movsd xmm0, [rbx + disp32]
+					Put(Out, uint32_t(Token.Class == CLASS::VARIABLE ? (Token.GetIndex() + 1) * 8 : 0));
+				}
+			break;
+
+			case CLASS::OPERATOR:
+				Emit("\x66\x0F\x28\xC8");							// movapd xmm1, xmm0
+				Slot(Out, Depths[i] - 2, false);
+
+				switch (Token.GetOperator())
+				{
+					case OPERATOR::ROUND:	Call(Out, Round); break;
+					case OPERATOR::ADD:		Emit("\xF2\x0F\x58\xC1"); break;	// addsd xmm0, xmm1
+					case OPERATOR::SUB:		Emit("\xF2\x0F\x5C\xC1"); break;	// subsd xmm0, xmm1
+					case OPERATOR::MUL:		Emit("\xF2\x0F\x59\xC1"); break;	// mulsd xmm0, xmm1
+					case OPERATOR::DIV:		Emit("\xF2\x0F\x5E\xC1"); break;	// divsd xmm0, xmm1
+					case OPERATOR::MOD:		Call(Out, Mod); break;
+					case OPERATOR::POW:		Call(Out, Pow); break;
+
+					case OPERATOR::EQ:		Emit("\xF2\x0F\xC2\xC1\x00"); Boolean(Out); break;	// cmpeqsd xmm0, xmm1
+					case OPERATOR::NEQ:		Emit("\xF2\x0F\xC2\xC1\x04"); Boolean(Out); break;	// cmpneqsd xmm0, xmm1
+					case OPERATOR::LT:		Emit("\xF2\x0F\xC2\xC1\x01"); Boolean(Out); break;	// cmpltsd xmm0, xmm1
+					case OPERATOR::LE:		Emit("\xF2\x0F\xC2\xC1\x02"); Boolean(Out); break;	// cmplesd xmm0, xmm1
+					case OPERATOR::GT:		Emit("\xF2\x0F\xC2\xC8\x01\x66\x0F\x28\xC1"); Boolean(Out); break;	// cmpltsd xmm1, xmm0; movapd xmm0, xmm1
+					case OPERATOR::GE:		Emit("\xF2\x0F\xC2\xC8\x02\x66\x0F\x28\xC1"); Boolean(Out); break;	// cmplesd xmm1, xmm0; movapd xmm0, xmm1
+
+					case OPERATOR::AND:
+					case OPERATOR::OR:
+						Emit("\x66\x0F\x57\xD2");						// xorpd xmm2, xmm2
+						Emit("\xF2\x0F\xC2\xC2\x04");					// cmpneqsd xmm0, xmm2
+						Emit("\xF2\x0F\xC2\xCA\x04");					// cmpneqsd xmm1, xmm2
+
+						if (Token.GetOperator() == OPERATOR::AND) Emit("\x66\x0F\x54\xC1");	// andpd xmm0, xmm1
+						else Emit("\x66\x0F\x56\xC1");								// orpd xmm0, xmm1
+
+						Boolean(Out);
+					break;
+
+					case OPERATOR::FAND:
+					case OPERATOR::FOR:
+						Emit("\x66\x0F\x2E\xC9\x7A\x04");				// ucomisd xmm1, xmm1; jp +4
+
+						if (Token.GetOperator() == OPERATOR::FAND) Emit("\xF2\x0F\x5D\xC1");	// minsd xmm0, xmm1
+						else Emit("\xF2\x0F\x5F\xC1");								// maxsd xmm0, xmm1
+					break;
+
+					default: Valid = false;
+				}
+			break;
+
+			case CLASS::FUNCTION:
+				switch (Token.GetFunction())
+				{
+					case FUNCTION::SIN:		Call(Out, Sin); break;
+					case FUNCTION::COS:		Call(Out, Cos); break;
+					case FUNCTION::TAN:		Call(Out, Tan); break;
+
+					case FUNCTION::ABS:		Constant(Out, ~Sign, false); Emit("\x66\x0F\x54\xC2"); break;	// andpd xmm0, xmm2
+
+					case FUNCTION::EXP:		Call(Out, Exp); break;
+					case FUNCTION::SQRT:	Emit("\xF2\x0F\x51\xC0"); break;	// sqrtsd xmm0, xmm0
+					case FUNCTION::LOG:		Call(Out, Log); break;
+					case FUNCTION::LN:		Call(Out, Ln); break;
+
+					case FUNCTION::NOT:
+						Emit("\x66\x0F\x57\xD2");						// xorpd xmm2, xmm2
+						Emit("\xF2\x0F\xC2\xC2\x00");					// cmpeqsd xmm0, xmm2
+						Boolean(Out);
+					break;
+
+					case FUNCTION::MINUS:	Constant(Out, Sign, false); Emit("\x66\x0F\x57\xC2"); break;	// xorpd xmm0, xmm2
+
+					default: Valid = false;
+				}
+			break;
+
+			case CLASS::JUMP:
+				if (Token.Target != -1) switch (Token.Data.Operator)
+				{
+					case OPERATOR::AND:
+						Emit("\x66\x0F\x57\xD2");						// xorpd xmm2, xmm2
+						Emit("\x66\x0F\x2E\xC2");						// ucomisd xmm0, xmm2
+						Emit("\x7A\x0B\x75\x09");						// jp +11; jne +9
+						Emit("\x66\x0F\x57\xC0");						// xorpd xmm0, xmm0
+					break;
+
+					case OPERATOR::OR:
+						Emit("\x66\x0F\x57\xD2");						// xorpd xmm2, xmm2
+						Emit("\x66\x0F\x2E\xC2");						// ucomisd xmm0, xmm2
+						Emit("\x7A\x02\x74\x14");						// jp +2; je +20
+						Constant(Out, One, true);
+					break;
+
+					case OPERATOR::FAND:
+					case OPERATOR::FOR:
+						Constant(Out, Token.Data.Operator == OPERATOR::FAND ? Lowest : Highest, false);
+						Emit("\x66\x0F\x2E\xC2");						// ucomisd xmm0, xmm2
+						Emit("\x7A\x07\x75\x05");						// jp +7; jne +5
+					break;
+
+					default: Valid = false;
+				}
+
+				if (Token.Target != -1)
+				{
+					Emit("\xE9");								// jmp rel32
+					Links[i] = int(Out - Buffer);
+					Put(Out, uint32_t(0));
+				}
+			break;
+		}
+	}
+
+	Labels[Count] = int(Out - Buffer);
+
+	Emit("\x48\x81\xC4"); Put(Out, uint32_t(Frame));				// add rsp, Frame
+	Emit("\x5B");											// pop rbx
+	Emit("\xC3");											// ret
+
+	for (int i = 0; i < Count && Valid; ++i) if (Links[i] != -1)
+	{
+		const uint32_t Offset = uint32_t(Labels[Tokens[i].Target] - (Links[i] + 4));
+
+		memcpy(Buffer + Links[i], &Offset, sizeof(Offset));
+	}
+
+	if (Valid)
+	{
+		const int Length = int(Out - Buffer);
+		void* Pages = nullptr;
+
+#if defined(_WIN32)
+		SYSTEM_INFO System;
+		DWORD Old;
+
+		GetSystemInfo(&System);
+
+		Size = (Length + System.dwPageSize - 1) / System.dwPageSize * System.dwPageSize;
+		Pages = VirtualAlloc(nullptr, Size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+		if (Pages)
+		{
+			memcpy(Pages, Buffer, Length);
+
+			if (!VirtualProtect(Pages, Size, PAGE_EXECUTE_READ, &Old))
+			{
+				VirtualFree(Pages, 0, MEM_RELEASE); Pages = nullptr;
+			}
+			else FlushInstructionCache(GetCurrentProcess(), Pages, Size);
+		}
+#else
+		const long Page = sysconf(_SC_PAGESIZE);
+
+		Size = int((Length + Page - 1) / Page * Page);
+		Pages = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (Pages == MAP_FAILED) Pages = nullptr;
+		else
+		{
+			memcpy(Pages, Buffer, Length);
+
+			if (mprotect(Pages, Size, PROT_READ | PROT_EXEC))
+			{
+				munmap(Pages, Size); Pages = nullptr;
+			}
+		}
+#endif
+
+		if (Pages)
+		{
+			Code = Pages;
+			Function = KLSFUNCTION(Pages);
+			Data = new double[Program.Header->Symbols.Count + 1];
+		}
+		else Size = 0;
+	}
+
+	delete [] Depths;
+	delete [] Labels;
+	delete [] Links;
+	delete [] Buffer;
+
+	return Function;
+#else
+	return false;
+#endif
+}
+
+bool KLJit::Compile(const KLStringView& Code)
+{
+	Clean();
+
+	LastError = KLParser::NO_ERROR;
+	LastValue = NAN;
+
+	if (!Parser.Compile(Code, Program)) ReturnError(Parser.GetError());
+
+	Generate();
+
+	return true;
+}
+
+bool KLJit::Evaluate(const KLVariables* Scoope, const double Return)
+{
+	LastError = KLParser::NO_ERROR;
+	LastValue = NAN;
+
+	if (!Function)
+	{
+		const bool OK = Parser.Evaluate(Program, Scoope, Return);
+
+		LastError = Parser.GetError();
+		LastValue = Parser.GetValue();
+
+		return OK;
+	}
+
+	const int Count = Program.Header->Symbols.Count;
+
+	Data[0] = Return;
+
+	for (int i = 0; i < Count; ++i)
+	{
+		if (!Scoope || !Scoope->Exists(Program.Symbols[i])) ReturnError(KLParser::UNKNOWN_EXPRESSION);
+
+		Data[i + 1] = (*Scoope)[Program.Symbols[i]].ToNumber();
+	}
+
+	LastValue = Function(Data);
+
+	return true;
+}
+
+void KLJit::Clean(void)
+{
+#if defined(KLJIT_NATIVE)
+#if defined(_WIN32)
+	if (Code) VirtualFree(Code, 0, MEM_RELEASE);
+#else
+	if (Code) munmap(Code, Size);
+#endif
+#endif
+
+	delete [] Data;
+
+	Program.Clean();
+
+	Function = nullptr;
+	Code = nullptr;
+	Data = nullptr;
+	Size = 0;
+}
+
+bool KLJit::IsNative(void) const
+{
+	return Function;
+}
+
+double KLJit::GetValue(void) const
+{
+	return LastValue;
+}
+
+KLParser::ERROR KLJit::GetError(void) const
+{
+	return LastError;
+}
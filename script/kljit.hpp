@@ -0,0 +1,161 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Expression JIT Compiler for KLLibs                         *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLJIT_HPP
+#define KLJIT_HPP
+
+#include "../libbuild.hpp"
+
+#include "../containers/klstringview.hpp"
+
+#include "klparser.hpp"
+#include "klprogram.hpp"
+#include "klvariables.hpp"
+
+/*! \file		kljit.hpp
+ *  \brief	Deklaracje dla klasy KLJit i jej składników.
+ *
+ */
+
+/*! \file		kljit.cpp
+ *  \brief	Implementacja klasy KLJit i jej składników.
+ *
+ */
+
+/*! \brief	Kompilacja wyrażeń do kodu maszynowego.
+ *
+ * Kompiluje wyrażenie (`KLParser::Compile()`) i zamienia jego tokeny RPN na funkcję w kodzie maszynowym x86-64 (SSE2) umieszczoną w wykonywalnych stronach pamięci. Szczyt stosu wartości przechowywany jest w rejestrze, operatory arytmetyczne, porównania, operatory logiczne oraz funkcje `abs`, `sqrt`, `!` i `-` wykonywane są bezpośrednio, a pozostałe funkcje i operatory wywołują te same funkcje biblioteki `math.h` co interpreter. Wyniki i błędy są identyczne (bit w bit) z wynikami metody `KLParser::Evaluate(const KLProgram&, const KLVariables*, const double)`.
+ *
+ * Wartości zmiennych pobierane są z zasięgu przed wykonaniem kodu, więc brak którejkolwiek zmiennej wyrażenia kończy się błędem `KLParser::UNKNOWN_EXPRESSION` tak samo jak w interpreterze.
+ *
+ * Na platformach innych niż x86-64 (Linux, BSD, macOS i Windows), w trybie `USING_FIXED_POINT` oraz gdy system nie pozwala utworzyć wykonywalnych stron pamięci, wyrażenie obliczane jest przez interpreter (`IsNative()` zwraca `false`).
+ *
+ */
+class KLLIBS_EXPORT KLJit
+{
+
+	/*! \brief		Typ wygenerowanej funkcji.
+	 *
+	 * Funkcja otrzymuje tablicę, w której pierwszy element to wartość `$`, a kolejne to wartości symboli programu.
+	 *
+	 */
+	protected: using KLSFUNCTION = double (*)(const double* Data);
+
+	protected:
+
+		/*! \brief		Generowanie kodu maszynowego.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Sprawdza głębokość stosu wartości w każdym miejscu wyrażenia i tworzy funkcję dla skompilowanego programu. Wyrażenie, którego nie da się bezpiecznie wykonać natywnie, pozostaje obliczane przez interpreter.
+		 *
+		 */
+		bool Generate(void);
+
+		KLProgram Program;		//!< Skompilowane wyrażenie.
+
+		KLParser Parser;		//!< Interpreter używany gdy kod maszynowy nie jest dostępny.
+
+		KLSFUNCTION Function;	//!< Wygenerowana funkcja (`nullptr` gdy brak).
+
+		void* Code;			//!< Wykonywalne strony pamięci.
+
+		int Size;				//!< Rozmiar wykonywalnych stron.
+
+		double* Data;			//!< Wartości przekazywane do funkcji.
+
+		double LastValue;		//!< Ostatnia poprawnie obliczona wartość wyrażenia.
+
+		KLParser::ERROR LastError;	//!< Ostatni odnotowany błąd.
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy obiekt bez wyrażenia.
+		 *
+		 */
+		KLJit(void);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Zwalnia wszystkie użyte zasoby (`Clean()`).
+		 *
+		 */
+		~KLJit(void);
+
+		KLJit(const KLJit&) = delete;
+		KLJit& operator= (const KLJit&) = delete;
+
+		/*! \brief		Kompilacja wyrażenia.
+		 *  \param [in]	Code Wyrażenie do przetworzenia.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Kompiluje wyrażenie i, gdy to możliwe, tworzy dla niego kod maszynowy. Błędy składni zgłaszane są tak samo jak w metodzie `KLParser::Compile()`.
+		 *
+		 */
+		bool Compile(const KLStringView& Code);
+
+		/*! \brief		Wywołanie wyrażenia.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return		Powodzenie operacji.
+		 *  \see			GetError(), GetValue().
+		 *
+		 * Oblicza skompilowane wyrażenie. Gdy nie skompilowano wyrażenia zgłaszany jest błąd `KLParser::UNKNOWN_EXPRESSION`.
+		 *
+		 */
+		bool Evaluate(const KLVariables* Scoope = nullptr, const double Return = NAN);
+
+		/*! \brief		Czyszczenie obiektu.
+		 *
+		 * Zwalnia wyrażenie i wygenerowany kod.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Sprawdzenie kodu maszynowego.
+		 *  \return		`true` jeśli wyrażenie wykonywane jest natywnie.
+		 *
+		 * Pozwala sprawdzić czy ostatnio skompilowane wyrażenie jest obliczane przez kod maszynowy, czy przez interpreter.
+		 *
+		 */
+		bool IsNative(void) const;
+
+		/*! \brief		Pobranie wartości.
+		 *  \return		Ostatnia poprawnie obliczona wartość.
+		 *  \see			Evaluate().
+		 *
+		 * Pobiera ostatnią obliczoną wartość.
+		 *
+		 */
+		double GetValue(void) const;
+
+		/*! \brief		Pobranie błędu.
+		 *  \return		Ostatni napotkany błąd.
+		 *  \see			Compile(), Evaluate().
+		 *
+		 * Pobiera ostatni błąd kompilacji lub obliczeń.
+		 *
+		 */
+		KLParser::ERROR GetError(void) const;
+
+};
+
+#endif // KLJIT_HPP
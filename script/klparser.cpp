@@ -19,6 +19,7 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "klparser.hpp"
+#include "klprogram.hpp"
 
 #define ReturnError(error) { LastError = error; return false; }
 
@@ -71,20 +72,32 @@ const KLParser::KLParserToken::KLParserFunctionData KLParser::KLParserToken::Fun
 	{ KLParser::KLParserToken::FUNCTION::MINUS,		"-"	}
 };
 
-KLParser::KLParserToken::KLParserToken(const char* Token, CLASS TokenClass)
-: Class(TokenClass)
+KLParser::KLParserToken::KLParserToken(void)
+: Class(CLASS::VALUE), Target(-1), Depth(0)
+{
+	Data.Value = 0.0;
+}
+
+KLParser::KLParserToken::KLParserToken(const KLStringView& Token, CLASS TokenClass)
+: Class(TokenClass), Target(-1), Depth(0)
 {
 	switch (Class)
 	{
 		case CLASS::VALUE:
-			Data.Value = atof(Token);
+			Data.Value = 0.0;
+
+#if defined(USING_FIXED_POINT)
+			KLSNUMBER::Parse(Token.Data(), Token.Data() + Token.Size(), Data.Value);
+#else
+			KLNumber::Parse(Token.Data(), Token.Data() + Token.Size(), Data.Value);
+#endif
 		break;
 		case CLASS::OPERATOR:
 			Data.Operator = OPERATOR::UNKNOWN;
 
 			for (const auto& Symbol: Operators)
 			{
-				if (!strcmp(Token, Symbol.Token))
+				if (Token == Symbol.Token)
 				{
 					Data.Operator = Symbol.Operator; break;
 				}
@@ -97,7 +110,7 @@ KLParser::KLParserToken::KLParserToken(const char* Token, CLASS TokenClass)
 
 			for (const auto& Symbol: Functions)
 			{
-				if (!strcmp(Token, Symbol.Token))
+				if (Token == Symbol.Token)
 				{
 					Data.Function = Symbol.Function; break;
 				}
@@ -105,27 +118,124 @@ KLParser::KLParserToken::KLParserToken(const char* Token, CLASS TokenClass)
 
 			if (Data.Function == FUNCTION::UNKNOWN) LastError = UNKNOWN_EXPRESSION;
 		break;
+		default: break;
 	}
 }
 
-KLParser::KLParserToken::KLParserToken(double Value)
-: Class(CLASS::VALUE)
+KLParser::KLParserToken::KLParserToken(KLSNUMBER Value)
+: Class(CLASS::VALUE), Target(-1), Depth(0)
 {
 	Data.Value = Value;
 }
 
 KLParser::KLParserToken::KLParserToken(OPERATOR Operator)
-: Class(CLASS::OPERATOR)
+: Class(CLASS::OPERATOR), Target(-1), Depth(0)
 {
 	Data.Operator = Operator;
 }
 
 KLParser::KLParserToken::KLParserToken(FUNCTION Function)
-: Class(CLASS::FUNCTION)
+: Class(CLASS::FUNCTION), Target(-1), Depth(0)
 {
 	Data.Function = Function;
 }
 
+KLParser::KLParserToken::KLParserToken(OPERATOR Condition, int Jump)
+: Class(CLASS::JUMP), Target(Jump), Depth(0)
+{
+	Data.Operator = Condition;
+}
+
+KLParser::KLParserToken::KLParserToken(CLASS TokenClass, int Symbol)
+: Class(TokenClass), Target(-1), Depth(0)
+{
+	Data.Index = Symbol;
+}
+
+bool KLParser::KLParserToken::IsValid(int Position, int Count, int Symbols) const
+{
+	switch (Class)
+	{
+		case CLASS::VALUE:
+		case CLASS::RETURN:
+			return true;
+
+		case CLASS::OPERATOR:
+			return Data.Operator > OPERATOR::UNKNOWN && Data.Operator < OPERATOR::L_BRACKET;
+
+		case CLASS::FUNCTION:
+			return Data.Function > FUNCTION::UNKNOWN && Data.Function <= FUNCTION::MINUS;
+
+		case CLASS::JUMP:
+			return Target == -1 || (Target > Position && Target <= Count);
+
+		case CLASS::VARIABLE:
+			return Data.Index >= 0 && Data.Index < Symbols;
+
+		default: return false;
+	}
+}
+
+bool KLParser::KLParserToken::IsLogical(void) const
+{
+	if (Class != CLASS::OPERATOR) return false;
+
+	switch (Data.Operator)
+	{
+		case OPERATOR::AND:
+		case OPERATOR::OR:
+		case OPERATOR::FAND:
+		case OPERATOR::FOR:
+			return true;
+
+		default: return false;
+	}
+}
+
+int KLParser::KLParserToken::GetArity(void) const
+{
+	switch (Class)
+	{
+		case CLASS::OPERATOR: return 2;
+		case CLASS::FUNCTION: return 1;
+
+		default: return 0;
+	}
+}
+
+bool KLParser::KLParserToken::Decides(KLSNUMBER& Value) const
+{
+#if defined(USING_FIXED_POINT)
+	static const KLSNUMBER Lowest = KLSNUMBER::FromRaw(KLSNUMBER::MIN);
+	static const KLSNUMBER Highest = KLSNUMBER::FromRaw(KLSNUMBER::MAX);
+#else
+	static const KLSNUMBER Lowest = -INFINITY;
+	static const KLSNUMBER Highest = INFINITY;
+#endif
+
+	switch (Data.Operator)
+	{
+		case OPERATOR::AND:
+			if (Value) return false;
+			else Value = 0;
+		break;
+		case OPERATOR::OR:
+			if (!Value) return false;
+			else Value = 1;
+		break;
+		case OPERATOR::FAND:
+			if (Value != Lowest) return false;
+		break;
+		case OPERATOR::FOR:
+			if (Value != Highest) return false;
+		break;
+
+		default: return false;
+	}
+
+	return true;
+}
+
 unsigned KLParser::KLParserToken::GetPriority(void) const
 {
 	switch (Class)
@@ -139,18 +249,9 @@ unsigned KLParser::KLParserToken::GetPriority(void) const
 	return 0;
 }
 
-double KLParser::KLParserToken::GetValue(KLList<double>* Values) const
+template<typename List>
+KLParser::KLSNUMBER KLParser::KLParserToken::Execute(List* Values) const
 {
-	static const auto roundto = [] (double Number, int To) -> double
-	{
-		if (!To) return round(Number);
-		else
-		{
-			double Pow = pow(10, To);
-			return round(Number * Pow) / Pow;
-		}
-	};
-
 	LastError = NO_ERROR;
 
 	switch (Class)
@@ -160,61 +261,21 @@ double KLParser::KLParserToken::GetValue(KLList<double>* Values) const
 			else if (Values->Size() < 2) LastError = NOT_ENOUGH_PARAMETERS;
 			else
 			{
-				double ParamB = Values->Pop();
-				double ParamA = Values->Pop();
+				KLSNUMBER ParamB = Values->Pop();
+				KLSNUMBER ParamA = Values->Pop();
 
-				switch (Data.Operator)
-				{
-					case OPERATOR::ROUND:	return roundto(ParamA, ParamB);
-					case OPERATOR::ADD:		return ParamA + ParamB;
-					case OPERATOR::SUB:		return ParamA - ParamB;
-					case OPERATOR::MUL:		return ParamA * ParamB;
-					case OPERATOR::DIV:		return ParamA / ParamB;
-					case OPERATOR::MOD:		return int(ParamA) % int(ParamB);
-					case OPERATOR::POW:		return pow(ParamA, ParamB);
-
-					case OPERATOR::EQ:		return ParamA == ParamB;
-					case OPERATOR::NEQ:		return ParamA != ParamB;
-					case OPERATOR::GT:		return ParamA > ParamB;
-					case OPERATOR::LT:		return ParamA < ParamB;
-					case OPERATOR::GE:		return ParamA >= ParamB;
-					case OPERATOR::LE:		return ParamA <= ParamB;
-
-					case OPERATOR::AND:		return ParamA && ParamB;
-					case OPERATOR::OR:		return ParamA || ParamB;
-
-					case OPERATOR::FAND:	return fmin(ParamA, ParamB);
-					case OPERATOR::FOR:		return fmax(ParamA, ParamB);
-
-					default: LastError = UNKNOWN_OPERATOR;
-				}
+				if (Data.Operator > OPERATOR::UNKNOWN && Data.Operator < OPERATOR::L_BRACKET) return Calculate(Data.Operator, ParamA, ParamB);
+				else LastError = UNKNOWN_OPERATOR;
 			}
 		break;
 		case CLASS::FUNCTION:
 			if (Values->Size() < 1) LastError = NOT_ENOUGH_PARAMETERS;
 			else
 			{
-				double ParamA = Values->Pop();
+				KLSNUMBER ParamA = Values->Pop();
 
-				switch (Data.Function)
-				{
-					case FUNCTION::SIN:		return sin(ParamA);
-					case FUNCTION::COS:		return cos(ParamA);
-					case FUNCTION::TAN:		return tan(ParamA);
-
-					case FUNCTION::ABS:		return fabs(ParamA);
-
-					case FUNCTION::EXP:		return exp(ParamA);
-					case FUNCTION::SQRT:	return sqrt(ParamA);
-					case FUNCTION::LOG:		return log10(ParamA);
-					case FUNCTION::LN:		return log(ParamA);
-
-					case FUNCTION::NOT:		return !ParamA;
-
-					case FUNCTION::MINUS:	return -ParamA;
-
-					default: LastError = UNKNOWN_EXPRESSION;
-				}
+				if (Data.Function > FUNCTION::UNKNOWN && Data.Function <= FUNCTION::MINUS) return Calculate(Data.Function, ParamA);
+				else LastError = UNKNOWN_EXPRESSION;
 			}
 		break;
 		default: return Data.Value;
@@ -223,6 +284,70 @@ double KLParser::KLParserToken::GetValue(KLList<double>* Values) const
 	return 0;
 }
 
+KLParser::KLSNUMBER KLParser::KLParserToken::GetValue(KLSVALUES* Values) const
+{
+	return Execute(Values);
+}
+
+#if !defined(USING_STATIC_CONTAINERS)
+KLParser::KLSNUMBER KLParser::KLParserToken::GetValue(KLSLOCALVALUES* Values) const
+{
+	return Execute(Values);
+}
+#endif
+
+KLParser::KLSNUMBER KLParser::KLParserToken::Calculate(OPERATOR Operator, KLSNUMBER ParamA, KLSNUMBER ParamB)
+{
+	switch (Operator)
+	{
+		case OPERATOR::ROUND:	return Round(ParamA, int(ParamB));
+		case OPERATOR::ADD:		return ParamA + ParamB;
+		case OPERATOR::SUB:		return ParamA - ParamB;
+		case OPERATOR::MUL:		return ParamA * ParamB;
+		case OPERATOR::DIV:		return ParamA / ParamB;
+		case OPERATOR::MOD:		return int(ParamA) % int(ParamB);
+		case OPERATOR::POW:		return pow(ParamA, ParamB);
+
+		case OPERATOR::EQ:		return ParamA == ParamB;
+		case OPERATOR::NEQ:		return ParamA != ParamB;
+		case OPERATOR::GT:		return ParamA > ParamB;
+		case OPERATOR::LT:		return ParamA < ParamB;
+		case OPERATOR::GE:		return ParamA >= ParamB;
+		case OPERATOR::LE:		return ParamA <= ParamB;
+
+		case OPERATOR::AND:		return ParamA && ParamB;
+		case OPERATOR::OR:		return ParamA || ParamB;
+
+		case OPERATOR::FAND:	return Minimum(ParamA, ParamB);
+		case OPERATOR::FOR:		return Maximum(ParamA, ParamB);
+
+		default: return 0;
+	}
+}
+
+KLParser::KLSNUMBER KLParser::KLParserToken::Calculate(FUNCTION Function, KLSNUMBER ParamA)
+{
+	switch (Function)
+	{
+		case FUNCTION::SIN:		return sin(ParamA);
+		case FUNCTION::COS:		return cos(ParamA);
+		case FUNCTION::TAN:		return tan(ParamA);
+
+		case FUNCTION::ABS:		return fabs(ParamA);
+
+		case FUNCTION::EXP:		return exp(ParamA);
+		case FUNCTION::SQRT:	return sqrt(ParamA);
+		case FUNCTION::LOG:		return log10(ParamA);
+		case FUNCTION::LN:		return log(ParamA);
+
+		case FUNCTION::NOT:		return !ParamA;
+
+		case FUNCTION::MINUS:	return -ParamA;
+
+		default: return 0;
+	}
+}
+
 KLParser::KLParserToken::OPERATOR KLParser::KLParserToken::GetOperator(void) const
 {
 	switch (Class)
@@ -243,17 +368,95 @@ KLParser::KLParserToken::FUNCTION KLParser::KLParserToken::GetFunction(void) con
 	}
 }
 
+int KLParser::KLParserToken::GetIndex(void) const
+{
+	switch (Class)
+	{
+		case CLASS::VARIABLE: return Data.Index;
+
+		default: return -1;
+	}
+}
+
 KLParser::ERROR KLParser::KLParserToken::GetError(void) const
 {
 	return LastError;
 }
 
-bool KLParser::GetTokens(KLList<KLParserToken*>& Tokens, const KLString& Code, const KLVariables* Scoope, const double Return)
+template<typename List>
+bool KLParser::GetTokens(List& Tokens, const KLStringView& Code, const KLVariables* Scoope, const double Return, KLList<KLSymbol>* Symbols)
 {
-	KLList<KLParserToken*> Operators;
-	KLParserToken* Operator = nullptr;
+	List Operators;
+
+	ERROR Invalid = NO_ERROR;
+	int Depth = 0, Jumps = 0;
+
+	const auto Append = [&] (List& Target, const KLParserToken& Token) -> void
+	{
+#if defined(USING_STATIC_CONTAINERS)
+		const int Used = &Target == &Tokens ? Target.Size() - Jumps : Target.Size();
+
+		if (Token.Class != KLParserToken::CLASS::JUMP && Used >= KLPARSER_TOKENS) LastError = OUT_OF_CAPACITY;
+		else
+#endif
+		if (Target.Insert(Token) == -1) LastError = OUT_OF_CAPACITY;
+	};
+
+	const auto Emit = [&] (const KLParserToken& Token) -> void
+	{
+		const int Arity = Token.GetArity();
+
+		if (Invalid == NO_ERROR)
+		{
+			if (Token.GetOperator() == KLParserToken::OPERATOR::L_BRACKET) Invalid = BRACKETS_NOT_EQUAL;
+			else if (Depth < Arity) Invalid = NOT_ENOUGH_PARAMETERS;
+			else if (Token.Class == KLParserToken::CLASS::OPERATOR &&
+					 Token.GetOperator() == KLParserToken::OPERATOR::UNKNOWN) Invalid = UNKNOWN_OPERATOR;
+		}
+
+		if (Token.Class != KLParserToken::CLASS::JUMP)
+		{
+			for (auto& Open: Operators) if (Open.Target != -1 && Depth - Arity < Open.Depth) Open.Target = -1;
+
+			if (Token.Target != -1 && Depth == Token.Depth + 1) Tokens[Token.Target].Target = Tokens.Size() + 1;
+
+			Depth += 1 - Arity;
+		}
+		else ++Jumps;
+
+#if defined(USING_STATIC_CONTAINERS)
+		if (Invalid == NO_ERROR && Depth > KLPARSER_STACK) Invalid = OUT_OF_CAPACITY;
+#endif
+
+		Append(Tokens, Token);
+	};
 
 	bool isLastTokenOperator = true;
+
+	const auto Push = [&] (KLParserToken Operator) -> void
+	{
+		while (Operators.Size() && (Operator.GetPriority() <= Operators.Last().GetPriority()))
+		{
+			Emit(Operators.Pop());
+		}
+
+#if defined(USING_STATIC_CONTAINERS)
+		if (Operator.IsLogical() && Depth > 0 && Invalid == NO_ERROR && Jumps < KLPARSER_JUMPS)
+#else
+		if (Operator.IsLogical() && Depth > 0 && Invalid == NO_ERROR)
+#endif
+		{
+			Operator.Target = Tokens.Size();
+			Operator.Depth = Depth;
+
+			Emit(KLParserToken(Operator.GetOperator(), -1));
+		}
+
+		Append(Operators, Operator);
+
+		isLastTokenOperator = true;
+	};
+
 	int Start = 0, Pos = 0;
 
 	while (Pos < Code.Size() && LastError == NO_ERROR)
@@ -267,90 +470,99 @@ bool KLParser::GetTokens(KLList<KLParserToken*>& Tokens, const KLString& Code, c
 		{
 			isLastTokenOperator = false; while (isdigit(Code[Pos]) || Code[Pos] == '.') ++Pos;
 
-			Tokens << new KLParserToken(Code.Part(Start, Pos), KLParserToken::CLASS::VALUE);
+			KLSNUMBER Value = 0;
+
+#if defined(USING_FIXED_POINT)
+			KLSNUMBER::Parse(Code.Data() + Start, Code.Data() + Pos, Value);
+#else
+			KLNumber::Parse(Code.Data() + Start, Code.Data() + Pos, Value);
+#endif
+
+			Emit(Value);
 		}
 		else if (isalpha(Code[Pos]))
 		{
 			isLastTokenOperator = true; while (isalnum(Code[Pos])) ++Pos;
 
-			const KLString Name = Code.Part(Start, Pos);
-			KLParserToken* Token = new KLParserToken(Name, KLParserToken::CLASS::FUNCTION);
+			const KLStringView Name = Code.Part(Start, Pos);
+			const KLParserToken Token(Name, KLParserToken::CLASS::FUNCTION);
 
-			if (Token->GetFunction() == KLParserToken::FUNCTION::UNKNOWN)
+			if (Token.GetFunction() == KLParserToken::FUNCTION::UNKNOWN)
 			{
-				delete Token; isLastTokenOperator = false;
+				isLastTokenOperator = false;
 
-				if (Scoope && Scoope->Exists(Name)) Tokens << new KLParserToken((*Scoope)[Name].ToNumber());
-				else ReturnError(UNKNOWN_EXPRESSION);
+				if (Symbols) Emit(KLParserToken(KLParserToken::CLASS::VARIABLE, KLProgram::Intern(*Symbols, Name)));
+				else
+				{
+					const KLSymbol Symbol = Scoope ? KLSymbol::Find(Name) : KLSymbol();
+
+					if (Symbol.IsValid() && Scoope->Exists(Symbol)) Emit(KLSNUMBER((*Scoope)[Symbol].ToNumber()));
+					else ReturnError(UNKNOWN_EXPRESSION);
+				}
 			}
-			else Operators << Token;
+			else Append(Operators, Token);
 		}
 		else
 		{
 			switch (Code[Pos])
 			{
 				case ')':
-					do
+					while (true)
 					{
-						if (Operators.Size()) Operator = Operators.Pop();
-						else ReturnError(BRACKETS_NOT_EQUAL);
+						if (!Operators.Size()) ReturnError(BRACKETS_NOT_EQUAL);
 
-						if (Operator->GetOperator() == KLParserToken::OPERATOR::L_BRACKET)
-						{
-							delete Operator; Operator = nullptr;
-						}
-						else
-						{
-							Tokens << Operator;
-						}
+						const KLParserToken Operator = Operators.Pop();
+
+						if (Operator.GetOperator() == KLParserToken::OPERATOR::L_BRACKET) break;
+						else Emit(Operator);
 					}
-					while (Operator);
 				break;
 				case '(':
-					Operators << new KLParserToken(KLParserToken::OPERATOR::L_BRACKET);
+					Append(Operators, KLParserToken::OPERATOR::L_BRACKET);
 				break;
 				case '~':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::ROUND);
+					Push(KLParserToken::OPERATOR::ROUND);
 				break;
 				case '+':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::ADD);
+					Push(KLParserToken::OPERATOR::ADD);
 				break;
 				case '-':
-					if (isLastTokenOperator) Operator = new KLParserToken(KLParserToken::FUNCTION::MINUS);
-					else Operator = new KLParserToken(KLParserToken::OPERATOR::SUB);
+					if (isLastTokenOperator) Push(KLParserToken::FUNCTION::MINUS);
+					else Push(KLParserToken::OPERATOR::SUB);
 				break;
 				case '*':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::MUL);
+					Push(KLParserToken::OPERATOR::MUL);
 				break;
 				case '/':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::DIV);
+					Push(KLParserToken::OPERATOR::DIV);
 				break;
 				case '%':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::MOD);
+					Push(KLParserToken::OPERATOR::MOD);
 				break;
 				case '^':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::POW);
+					Push(KLParserToken::OPERATOR::POW);
 				break;
 				case '=':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::EQ);
+					Push(KLParserToken::OPERATOR::EQ);
 				break;
 				case '|':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::OR);
+					Push(KLParserToken::OPERATOR::OR);
 				break;
 				case '&':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::AND);
+					Push(KLParserToken::OPERATOR::AND);
 				break;
 				case '?':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::FOR);
+					Push(KLParserToken::OPERATOR::FOR);
 				break;
 				case '@':
-					Operator = new KLParserToken(KLParserToken::OPERATOR::FAND);
+					Push(KLParserToken::OPERATOR::FAND);
 				break;
 				case '!':
-					Operator = new KLParserToken(KLParserToken::FUNCTION::NOT);
+					Push(KLParserToken::FUNCTION::NOT);
 				break;
 				case '$':
-					Tokens << new KLParserToken(Return);
+					if (Symbols) Emit(KLParserToken(KLParserToken::CLASS::RETURN, -1));
+					else Emit(KLSNUMBER(Return));
 				break;
 				default:
 				{
@@ -361,61 +573,439 @@ bool KLParser::GetTokens(KLList<KLParserToken*>& Tokens, const KLString& Code, c
 						  Code[Pos] != '(' &&
 						  Code[Pos] != ')') ++Pos;
 
-					Operator = new KLParserToken(Code.Part(Start, Pos--), KLParserToken::CLASS::OPERATOR);
+					Push(KLParserToken(Code.Part(Start, Pos--), KLParserToken::CLASS::OPERATOR));
 				}
 			}
 
-			if (Operator)
-			{
-				while (Operators.Size() && (Operator->GetPriority() <= Operators.Last()->GetPriority()))
-				{
-					Tokens << Operators.Pop();
-				}
-
-				Operators << Operator;
-
-				isLastTokenOperator = true;
-				Operator = nullptr;
-			}
-
 			++Pos;
 		}
 	}
 
-	while (Operators.Size()) Tokens << Operators.Pop();
+	while (Operators.Size() && LastError == NO_ERROR) Emit(Operators.Pop());
+
+	if (LastError == NO_ERROR && Depth != 1 && Invalid == NO_ERROR) Invalid = TOO_MANY_PARAMETERS;
+	if (LastError == NO_ERROR) LastError = Invalid;
 
 	return LastError == NO_ERROR;
 }
 
-bool KLParser::Evaluate(const KLString& Code, const KLVariables* Scoope, const double Return)
+template<typename TokenList, typename ValueList>
+bool KLParser::Execute(const KLStringView& Code, const KLVariables* Scoope, const double Return)
 {
-	KLList<KLParserToken*> Tokens;
-	KLList<double> Values;
+	TokenList Tokens;
+	ValueList Values;
 
 	LastError = NO_ERROR;
 	LastValue = NAN;
 
 	if (!GetTokens(Tokens, Code, Scoope, Return)) return false;
 
-	for (auto& Token: Tokens)
+	int Index = 0, Resume = 0;
+
+	for (const auto& Token: Tokens)
 	{
-		Values << Token->GetValue(&Values);
-		LastError = Token->GetError();
+		if (Index++ < Resume) continue;
+
+		if (Token.Class == KLParserToken::CLASS::JUMP)
+		{
+			if (Token.Target != -1 && Token.Decides(Values.Last())) Resume = Token.Target;
+
+			continue;
+		}
+
+		const KLSNUMBER Value = Token.GetValue(&Values);
+
+		if ((LastError = Token.GetError())) break;
 
-		if (LastError) break;
+		if (Values.Insert(Value) == -1)
+		{
+			LastError = OUT_OF_CAPACITY; break;
+		}
 	}
 
 	if (LastError == NO_ERROR)
 	{
-		if (Values.Size() == 1) LastValue = Values.Pop();
+		if (Values.Size() == 1) LastValue = double(Values.Pop());
 		else LastError = TOO_MANY_PARAMETERS;
 	}
 
-	for (auto Token: Tokens) delete Token;
+	return LastError == NO_ERROR;
+}
+
+bool KLParser::Evaluate(const KLStringView& Code, const KLVariables* Scoope, const double Return)
+{
+#if defined(USING_STATIC_CONTAINERS)
+	return Execute<KLSTOKENS, KLSVALUES>(Code, Scoope, Return);
+#else
+	if (Execute<KLSLOCALTOKENS, KLSLOCALVALUES>(Code, Scoope, Return)) return true;
+	else if (LastError != OUT_OF_CAPACITY) return false;
+	else return Execute<KLSTOKENS, KLSVALUES>(Code, Scoope, Return);
+#endif
+}
+
+bool KLParser::Assemble(const KLStringView& Code, KLList<KLParserToken>& Tokens, KLList<KLSymbol>& Symbols)
+{
+	KLSTOKENS Compiled;
+
+	LastError = NO_ERROR;
+	LastValue = NAN;
+
+	if (!GetTokens(Compiled, Code, nullptr, NAN, &Symbols)) return false;
+
+	for (const auto& Token: Compiled) Tokens.Insert(Token);
+
+	return true;
+}
+
+template<typename ValueList>
+bool KLParser::Execute(const KLProgram& Program, int Expression, const KLVariables* Scoope, const double Return)
+{
+	const KLProgram::EXPRESSION& Code = Program.Expressions[Expression];
+	const KLParserToken* Tokens = Program.Tokens + Code.First;
+
+	ValueList Values;
+
+	LastError = NO_ERROR;
+	LastValue = NAN;
+
+	const auto Exists = [&Program, Scoope] (const KLParserToken& Token) -> bool
+	{
+		return Scoope && Scoope->Exists(Program.Symbols[Token.GetIndex()]);
+	};
+
+	for (int Index = 0; Index < Code.Count; ++Index)
+	{
+		const KLParserToken& Token = Tokens[Index];
+		KLSNUMBER Value;
+
+		switch (Token.Class)
+		{
+			case KLParserToken::CLASS::JUMP:
+				if (Token.Target != -1 && Values.Size() && Token.Decides(Values.Last()))
+				{
+					while (++Index < Token.Target)
+					{
+						if (Tokens[Index].Class == KLParserToken::CLASS::VARIABLE && !Exists(Tokens[Index])) ReturnError(UNKNOWN_EXPRESSION);
+					}
+
+					--Index;
+				}
+			continue;
+
+			case KLParserToken::CLASS::VARIABLE:
+				if (!Exists(Token)) ReturnError(UNKNOWN_EXPRESSION);
+
+				Value = KLSNUMBER((*Scoope)[Program.Symbols[Token.GetIndex()]].ToNumber());
+			break;
+
+			case KLParserToken::CLASS::RETURN:
+				Value = KLSNUMBER(Return);
+			break;
+
+			default:
+				Value = Token.GetValue(&Values);
+
+				if ((LastError = Token.GetError())) return false;
+		}
+
+		if (Values.Insert(Value) == -1) ReturnError(OUT_OF_CAPACITY);
+	}
+
+	if (Values.Size() == 1) LastValue = double(Values.Pop());
+	else LastError = TOO_MANY_PARAMETERS;
 
 	return LastError == NO_ERROR;
 }
 
+bool KLParser::Calculate(const KLProgram& Program, int Expression, const KLVariables* Scoope, const double Return)
+{
+#if !defined(USING_STATIC_CONTAINERS)
+	if (Program.Expressions[Expression].Count <= KLPARSER_SCRATCH) return Execute<KLSLOCALVALUES>(Program, Expression, Scoope, Return);
+#endif
+
+	return Execute<KLSVALUES>(Program, Expression, Scoope, Return);
+}
+
+bool KLParser::Evaluate(const KLProgram& Program, const KLVariables* Scoope, const double Return)
+{
+	LastError = NO_ERROR;
+	LastValue = NAN;
+
+	if (!Program.IsValid() || Program.Header->Statements.Count || Program.Header->Expressions.Count != 1) ReturnError(UNKNOWN_EXPRESSION);
+
+	return Calculate(Program, 0, Scoope, Return);
+}
+
+bool KLParser::Compile(const KLStringView& Code, KLProgram& Program)
+{
+	KLProgram::BUILD Build;
+
+	Program.Clean();
+
+	if (!Assemble(Code, Build.Tokens, Build.Symbols)) return false;
+
+	Build.Expressions.Insert({ 0, Build.Tokens.Size() });
+
+	if (!Program.Create(Build, Code)) ReturnError(OUT_OF_CAPACITY);
+
+	return true;
+}
+
+bool KLParser::GetInvariants(const KLStringView& Code, const KLList<KLSymbol>& Variants, KLList<KLStringView>& Parts) const
+{
+	struct NODE
+	{
+		int Begin, End;
+		bool Invariant, Trivial;
+	};
+
+	struct ENTRY
+	{
+		KLParserToken Token;
+		int Begin, End, Depth;
+	};
+
+	KLList<NODE> Nodes, Found;
+	KLList<ENTRY> Operators;
+
+	bool isLastTokenOperator = true, Valid = true;
+
+	const auto Variant = [&Variants] (const KLSymbol& Name) -> bool
+	{
+		for (const auto& Symbol: Variants) if (Symbol == Name) return true;
+
+		return false;
+	};
+
+	const auto Emit = [&] (const ENTRY& Entry) -> void
+	{
+		const int Arity = Entry.Token.GetArity();
+
+		if (Entry.Token.GetOperator() == KLParserToken::OPERATOR::L_BRACKET || Nodes.Size() < Arity ||
+		    (Entry.Token.Class == KLParserToken::CLASS::OPERATOR && Entry.Token.GetOperator() == KLParserToken::OPERATOR::UNKNOWN))
+		{
+			Valid = false; return;
+		}
+
+		const NODE Right = Nodes.Pop();
+		const NODE Left = Arity == 2 ? Nodes.Pop() : Right;
+
+		if (Arity == 2 && (Entry.Begin < Left.End || Entry.End > Right.Begin)) Valid = false;
+		if (Arity == 1 && Entry.End > Right.Begin) Valid = false;
+
+		const NODE Node =
+		{
+			Arity == 2 ? Left.Begin : Entry.Begin, Right.End,
+			Left.Invariant && Right.Invariant, false
+		};
+
+		if (!Node.Invariant)
+		{
+			if (Arity == 2 && Left.Invariant && !Left.Trivial) Found.Insert(Left);
+			if (Right.Invariant && !Right.Trivial) Found.Insert(Right);
+		}
+
+		Nodes.Insert(Node);
+	};
+
+	const auto Push = [&] (const KLParserToken& Operator, int Begin, int End) -> void
+	{
+		while (Operators.Size() && (Operator.GetPriority() <= Operators.Last().Token.GetPriority()))
+		{
+			Emit(Operators.Pop());
+		}
+
+		Operators.Insert({ Operator, Begin, End, Nodes.Size() });
+
+		isLastTokenOperator = true;
+	};
+
+	int Start = 0, Pos = 0;
+
+	while (Pos < Code.Size() && Valid)
+	{
+		while (Pos < Code.Size() && isspace(Code[Pos])) ++Pos;
+
+		if (!Code[Pos]) break;
+		else Start = Pos;
+
+		if (isdigit(Code[Pos]))
+		{
+			isLastTokenOperator = false; while (isdigit(Code[Pos]) || Code[Pos] == '.') ++Pos;
+
+			Nodes.Insert({ Start, Pos, true, true });
+		}
+		else if (isalpha(Code[Pos]))
+		{
+			isLastTokenOperator = true; while (isalnum(Code[Pos])) ++Pos;
+
+			const KLStringView Name = Code.Part(Start, Pos);
+			const KLParserToken Token(Name, KLParserToken::CLASS::FUNCTION);
+
+			if (Token.GetFunction() == KLParserToken::FUNCTION::UNKNOWN)
+			{
+				isLastTokenOperator = false;
+
+				Nodes.Insert({ Start, Pos, !Variant(Name), true });
+			}
+			else Operators.Insert({ Token, Start, Pos, Nodes.Size() });
+		}
+		else
+		{
+			switch (Code[Pos])
+			{
+				case ')':
+					while (Valid)
+					{
+						if (!Operators.Size()) Valid = false;
+						else
+						{
+							const ENTRY Entry = Operators.Pop();
+
+							if (Entry.Token.GetOperator() != KLParserToken::OPERATOR::L_BRACKET) Emit(Entry);
+							else if (Nodes.Size() != Entry.Depth + 1 || Nodes.Last().Begin < Entry.End) Valid = false;
+							else
+							{
+								Nodes.Last().Begin = Entry.Begin;
+								Nodes.Last().End = Pos + 1;
+
+								break;
+							}
+						}
+					}
+				break;
+				case '(':
+					Operators.Insert({ KLParserToken::OPERATOR::L_BRACKET, Pos, Pos + 1, Nodes.Size() });
+				break;
+				case '~':
+					Push(KLParserToken::OPERATOR::ROUND, Pos, Pos + 1);
+				break;
+				case '+':
+					Push(KLParserToken::OPERATOR::ADD, Pos, Pos + 1);
+				break;
+				case '-':
+					if (isLastTokenOperator) Push(KLParserToken::FUNCTION::MINUS, Pos, Pos + 1);
+					else Push(KLParserToken::OPERATOR::SUB, Pos, Pos + 1);
+				break;
+				case '*':
+					Push(KLParserToken::OPERATOR::MUL, Pos, Pos + 1);
+				break;
+				case '/':
+					Push(KLParserToken::OPERATOR::DIV, Pos, Pos + 1);
+				break;
+				case '%':
+					Push(KLParserToken::OPERATOR::MOD, Pos, Pos + 1);
+				break;
+				case '^':
+					Push(KLParserToken::OPERATOR::POW, Pos, Pos + 1);
+				break;
+				case '=':
+					Push(KLParserToken::OPERATOR::EQ, Pos, Pos + 1);
+				break;
+				case '|':
+					Push(KLParserToken::OPERATOR::OR, Pos, Pos + 1);
+				break;
+				case '&':
+					Push(KLParserToken::OPERATOR::AND, Pos, Pos + 1);
+				break;
+				case '?':
+					Push(KLParserToken::OPERATOR::FOR, Pos, Pos + 1);
+				break;
+				case '@':
+					Push(KLParserToken::OPERATOR::FAND, Pos, Pos + 1);
+				break;
+				case '!':
+					Push(KLParserToken::FUNCTION::NOT, Pos, Pos + 1);
+				break;
+				case '$':
+					Nodes.Insert({ Pos, Pos + 1, !Variant("$"), true });
+				break;
+				default:
+				{
+					while (Code[Pos] &&
+						  !isspace(Code[Pos]) &&
+						  !isdigit(Code[Pos]) &&
+						  !isalpha(Code[Pos]) &&
+						  Code[Pos] != '(' &&
+						  Code[Pos] != ')') ++Pos;
+
+					Push(KLParserToken(Code.Part(Start, Pos), KLParserToken::CLASS::OPERATOR), Start, Pos);
+
+					--Pos;
+				}
+			}
+
+			++Pos;
+		}
+	}
+
+	while (Operators.Size() && Valid) Emit(Operators.Pop());
+
+	if (!Valid || Nodes.Size() != 1) return false;
+
+	if (Nodes.Last().Invariant && !Nodes.Last().Trivial) Found.Insert(Nodes.Last());
+
+	for (const auto& Node: Found) Parts.Insert(Code.Part(Node.Begin, Node.End));
+
+	return true;
+}
+
+void KLParser::GetDependencies(const KLStringView& Code, KLList<KLSymbol>& Names) const
+{
+	int Start = 0, Pos = 0;
+
+	while (Pos < Code.Size())
+	{
+		if (isdigit(Code[Pos])) while (isdigit(Code[Pos]) || Code[Pos] == '.') ++Pos;
+		else if (isalpha(Code[Pos]))
+		{
+			Start = Pos; while (isalnum(Code[Pos])) ++Pos;
+
+			const KLStringView Name = Code.Part(Start, Pos);
+
+			if (KLParserToken(Name, KLParserToken::CLASS::FUNCTION).GetFunction() == KLParserToken::FUNCTION::UNKNOWN)
+			{
+				const KLSymbol Symbol(Name); bool Found = false;
+
+				for (const auto& Known: Names) if (Known == Symbol) Found = true;
+
+				if (!Found) Names.Insert(Symbol);
+			}
+		}
+		else ++Pos;
+	}
+}
+
+KLParser::KLSNUMBER KLParser::Round(KLSNUMBER Number, int Digits)
+{
+#if defined(USING_FIXED_POINT)
+	return Number.Round(Digits);
+#else
+	static const double Powers[] =
+	{
+		1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	if (!Digits) return round(Number);
+	else
+	{
+		double Pow = (Digits > 0 && Digits <= 22) ? Powers[Digits - 1] : pow(10, Digits);
+		return round(Number * Pow) / Pow;
+	}
+#endif
+}
+
+KLParser::KLSNUMBER KLParser::Minimum(KLSNUMBER ParamA, KLSNUMBER ParamB)
+{
+	return ParamA < ParamB || ParamB != ParamB ? ParamA : ParamB;
+}
+
+KLParser::KLSNUMBER KLParser::Maximum(KLSNUMBER ParamA, KLSNUMBER ParamB)
+{
+	return ParamA > ParamB || ParamB != ParamB ? ParamA : ParamB;
+}
+
 double KLParser::GetValue(void) const
 {
 	return LastValue;
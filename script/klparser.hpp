@@ -27,9 +27,33 @@
 #include "../containers/kllist.hpp"
 #include "../script/klvariables.hpp"
 
+#include "../containers/klstaticlist.hpp"
+
+#if defined(USING_FIXED_POINT)
+#include "../containers/klfixed.hpp"
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLPARSER_TOKENS)
+#define KLPARSER_TOKENS 32	//!< Maksymalna liczba tokenów wyrażenia (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLPARSER_STACK)
+#define KLPARSER_STACK 16	//!< Maksymalna głębokość stosu wartości (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLPARSER_JUMPS)
+#define KLPARSER_JUMPS 8	//!< Maksymalna liczba skoków warunkowych wyrażenia (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
+#if !defined(USING_STATIC_CONTAINERS) && !defined(KLPARSER_SCRATCH)
+#define KLPARSER_SCRATCH 64	//!< Liczba tokenów wyrażenia obliczanego w buforze na stosie (tryb bez `USING_STATIC_CONTAINERS`).
+#endif
+
 #include <ctype.h>
 #include <math.h>
 
+class KLProgram;
+
 /*! \file		klparser.hpp
  *  \brief	Deklaracje dla klasy KLParser i jej składników.
  *
@@ -48,6 +72,13 @@
 class KLLIBS_EXPORT KLParser
 {
 
+	friend class KLJit;
+	friend class KLProgram;
+	friend class KLScript;
+	friend class KLTranslator;
+
+	template<int Size> friend class KLExpression;
+
 	/*! \brief		Wyliczenie błędu przetwarzania.
 	 *
 	 * Umożliwia sprawdzenie jaki błąd wystąpił podczas przetwarzania wyrażenia.
@@ -65,9 +96,24 @@ class KLLIBS_EXPORT KLParser
 		NOT_ENOUGH_PARAMETERS,	//!< Napotkano zbyt mało parametrów.
 		TOO_MANY_PARAMETERS,	//!< Napotkano zbyt wiele parametrów.
 
-		BRACKETS_NOT_EQUAL		//!< Niepoprawna ilość nawiasów.
+		BRACKETS_NOT_EQUAL,		//!< Niepoprawna ilość nawiasów.
+
+		OUT_OF_CAPACITY		//!< Przekroczono pojemność kontenerów (tryb `USING_STATIC_CONTAINERS`).
 	};
 
+#if defined(USING_FIXED_POINT)
+	public: using KLSNUMBER = KLFixed;
+#else
+	public: using KLSNUMBER = double;
+#endif
+
+#if defined(USING_STATIC_CONTAINERS)
+	public: using KLSVALUES = KLStaticList<KLSNUMBER, KLPARSER_STACK>;
+#else
+	public: using KLSVALUES = KLList<KLSNUMBER>;
+	public: using KLSLOCALVALUES = KLStaticList<KLSNUMBER, KLPARSER_SCRATCH>;
+#endif
+
 	/*! \brief		Klasa bazowa dla tokenu.
 	 *
 	 * Umozliwia jednolitą obsługę wszystkich tokenów - funkcji, liczb i operatorów.
@@ -76,6 +122,8 @@ class KLLIBS_EXPORT KLParser
 	protected: class KLParserToken
 	{
 
+		friend class KLJit;
+
 		/*! \brief		Wyliczenie typu tokenu.
 		 *
 		 * Określa z jaki typ ma bieżący token. Rozwiązanie to pozwala uniknąć stosowania polimorfizmu i operatora dynamic_cast.
@@ -85,7 +133,10 @@ class KLLIBS_EXPORT KLParser
 		{
 			VALUE,	//!< Wartość liczbowa.
 			OPERATOR,	//!< Operator.
-			FUNCTION	//!< Funkcja.
+			FUNCTION,	//!< Funkcja.
+			JUMP,	//!< Skok warunkowy pomijający prawy argument operatora logicznego.
+			VARIABLE,	//!< Odwołanie do zmiennej (wyrażenie skompilowane).
+			RETURN	//!< Odwołanie do ostatniej zwróconej wartości `$` (wyrażenie skompilowane).
 		};
 
 		/*! \brief		Wyliczenie znaczenia operatora.
@@ -181,11 +232,13 @@ class KLLIBS_EXPORT KLParser
 		 */
 		public: union TOKEN
 		{
-			double Value;		//!< Wartość liczbowa (o ile token jest liczbą).
+			KLSNUMBER Value;	//!< Wartość liczbowa (o ile token jest liczbą).
 
 			OPERATOR Operator;	//!< ID operatora (o ile token jest operatorem).
 
 			FUNCTION Function;	//!< ID funkcji (o ile token jest funkcją).
+
+			int Index;		//!< Numer symbolu w tablicy programu (o ile token jest zmienną).
 		};
 
 		protected:
@@ -197,26 +250,46 @@ class KLLIBS_EXPORT KLParser
 
 			TOKEN Data;								//!< Dane tokenu.
 
+			/*! \brief		Obliczenie tokenu.
+			 *  \tparam		List		Typ stosu wartości (`KLList` lub `KLStaticList`).
+			 *  \param [in]	Values	Stos wartości parametrów.
+			 *  \return		Wartość obliczeń lub liczby.
+			 *
+			 * Wspólna implementacja metod `GetValue()` dla stosów wartości na stercie i w buforze o stałej pojemności.
+			 *
+			 */
+			template<typename List> KLSNUMBER Execute(List* Values) const;
+
 		public:
 
 			const CLASS Class;							//!< Klasa tokenu.
 
+			int Target;								//!< Indeks tokenu docelowego skoku lub indeks skoku operatora logicznego (`-1` gdy brak).
+			int Depth;								//!< Głębokość stosu wartości po lewym argumencie operatora logicznego.
+
 			/*! \brief		Konstruktor domyślny.
-			 *  \param [in]	Token		Token w formie łańcucha znaków.
+			 *
+			 * Tworzy token o wartości `0`.
+			 *
+			 */
+			KLParserToken(void);
+
+			/*! \brief		Konstruktor z tekstu.
+			 *  \param [in]	Token		Token w formie fragmentu tekstu.
 			 *  \param [in]	TokenClass	Klasa tokenu.
 			 *
 			 * Na podstawie podanego typu tokena wybiera odpowiednie informacje z tabeli.
 			 *
 			 */
-			KLParserToken(const char* Token, CLASS TokenClass);
+			KLParserToken(const KLStringView& Token, CLASS TokenClass);
 
-			/*! \brief		Konstruktor konwertujący z `double`.
+			/*! \brief		Konstruktor konwertujący z `KLSNUMBER`.
 			 *  \param [in]	Value Wartość liczbowa.
 			 *
 			 *Tworzy token na podstawie wartości liczbowej.
 			 *
 			 */
-			KLParserToken(double Value);
+			KLParserToken(KLSNUMBER Value);
 
 			/*! \brief		Konstruktor konwertujący z `OPERATOR`.
 			 *  \param [in]	Operator ID operatora.
@@ -234,6 +307,60 @@ class KLLIBS_EXPORT KLParser
 			 */
 			KLParserToken(FUNCTION Function);
 
+			/*! \brief		Konstruktor skoku.
+			 *  \param [in]	Condition	Operator logiczny, którego wynik rozstrzyga skok.
+			 *  \param [in]	Jump		Indeks tokenu docelowego (`-1` dla skoku nieaktywnego).
+			 *
+			 * Tworzy token skoku warunkowego dla podanego operatora.
+			 *
+			 */
+			KLParserToken(OPERATOR Condition, int Jump);
+
+			/*! \brief		Konstruktor odwołania.
+			 *  \param [in]	TokenClass	Klasa tokenu (`VARIABLE` lub `RETURN`).
+			 *  \param [in]	Symbol		Numer symbolu zmiennej w tablicy programu.
+			 *
+			 * Tworzy token wyrażenia skompilowanego, którego wartość jest pobierana dopiero podczas obliczeń.
+			 *
+			 */
+			KLParserToken(CLASS TokenClass, int Symbol);
+
+			/*! \brief		Sprawdzenie tokenu programu.
+			 *  \param [in]	Position	Położenie tokenu w wyrażeniu.
+			 *  \param [in]	Count	Liczba tokenów wyrażenia.
+			 *  \param [in]	Symbols	Liczba symboli programu.
+			 *  \return		`true` jeśli token może zostać bezpiecznie obliczony.
+			 *
+			 * Sprawdza klasę, numer operatora lub funkcji, numer symbolu i cel skoku tokenu wczytanego z obrazu programu (`KLProgram`).
+			 *
+			 */
+			bool IsValid(int Position, int Count, int Symbols) const;
+
+			/*! \brief		Sprawdzenie operatora logicznego.
+			 *  \return		`true` jeśli token jest operatorem `&`, `|`, `@` lub `?`.
+			 *
+			 * Operatory logiczne mogą pominąć obliczanie prawego argumentu.
+			 *
+			 */
+			bool IsLogical(void) const;
+
+			/*! \brief		Liczba argumentów.
+			 *  \return		Liczba wartości pobieranych ze stosu.
+			 *
+			 * Zwraca liczbę argumentów operatora lub funkcji (`0` dla wartości i skoków).
+			 *
+			 */
+			int GetArity(void) const;
+
+			/*! \brief		Sprawdzenie warunku skoku.
+			 *  \param [in,out]	Value Lewy argument operatora (szczyt stosu wartości).
+			 *  \return		`true` jeśli lewy argument rozstrzyga wynik operatora.
+			 *
+			 * Gdy wynik operatora nie zależy od prawego argumentu zastępuje lewy argument wynikiem operatora i zwraca `true`. Dla `&` i `|` są to wartości `0` i różne od zera, dla `@` i `?` odpowiednio najmniejsza i największa wartość liczby.
+			 *
+			 */
+			bool Decides(KLSNUMBER& Value) const;
+
 			/*! \brief		Pobranie priorytetu.
 			 *  \return		Priorytet tokenu.
 			 *  \note			Nie wszystkie tokeny mają znaczący priorytet.
@@ -250,7 +377,39 @@ class KLLIBS_EXPORT KLParser
 			 * Zwraca wartość liczbową obliczoną na podstawie tokenu i pobranych ze stosu parametrów.
 			 *
 			 */
-			double GetValue(KLList<double>* Values = nullptr) const;
+			KLSNUMBER GetValue(KLSVALUES* Values = nullptr) const;
+
+#if !defined(USING_STATIC_CONTAINERS)
+			/*! \brief		Pobranie wartości.
+			 *  \param [in]	Values Stos wartości parametrów w buforze na stosie.
+			 *  \return		Wartość obliczeń lub liczby.
+			 *
+			 * Działa tak samo jak `GetValue(KLSVALUES*)` dla stosu wartości o stałej pojemności.
+			 *
+			 */
+			KLSNUMBER GetValue(KLSLOCALVALUES* Values) const;
+#endif
+
+			/*! \brief		Obliczenie operatora.
+			 *  \param [in]	Operator	ID operatora (od `ROUND` do `FAND`).
+			 *  \param [in]	ParamA	Lewy argument.
+			 *  \param [in]	ParamB	Prawy argument.
+			 *  \return		Wynik działania.
+			 *
+			 * Wykonuje działanie operatora na podanych argumentach. Dla nieobsługiwanych operatorów zwraca `0`.
+			 *
+			 */
+			static KLSNUMBER Calculate(OPERATOR Operator, KLSNUMBER ParamA, KLSNUMBER ParamB);
+
+			/*! \brief		Obliczenie funkcji.
+			 *  \param [in]	Function	ID funkcji (od `SIN` do `MINUS`).
+			 *  \param [in]	ParamA	Argument funkcji.
+			 *  \return		Wynik funkcji.
+			 *
+			 * Oblicza wartość funkcji dla podanego argumentu. Dla nieobsługiwanych funkcji zwraca `0`.
+			 *
+			 */
+			static KLSNUMBER Calculate(FUNCTION Function, KLSNUMBER ParamA);
 
 			/*! \brief		Pobranie ID operatora.
 			 *  \return		ID operatora.
@@ -268,6 +427,14 @@ class KLLIBS_EXPORT KLParser
 			 */
 			FUNCTION GetFunction(void) const;
 
+			/*! \brief		Pobranie numeru symbolu.
+			 *  \return		Numer symbolu zmiennej.
+			 *
+			 * Zwraca numer symbolu w tablicy programu jeśli token jest zmienną lub `-1` w pozostałych przypadkach.
+			 *
+			 */
+			int GetIndex(void) const;
+
 			/*! \brief		Pobranie ostatniego błędu.
 			 *  \return		Token w postaci łańcucha.
 			 *
@@ -278,18 +445,81 @@ class KLLIBS_EXPORT KLParser
 
 	};
 
+#if defined(USING_STATIC_CONTAINERS)
+	protected: using KLSTOKENS = KLStaticList<KLParserToken, KLPARSER_TOKENS + KLPARSER_JUMPS>;
+#else
+	protected: using KLSTOKENS = KLList<KLParserToken>;
+	protected: using KLSLOCALTOKENS = KLStaticList<KLParserToken, KLPARSER_SCRATCH>;
+#endif
+
 	protected:
 
 		/*! \brief		Przekształcenie wyrażenia do notacli RPN.
+		 *  \tparam		List		Typ listy tokenów.
 		 *  \param [out]	Tokens	Wyjściowa lista tokenów.
 		 *  \param [in]	Code		Wyrażenie do przetworzenia.
 		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \param [in,out]	Symbols	Tablica symboli programu lub `nullptr`.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Parsuje wyrażenie i zamienia je na postać Odwrotnej Notacji Polskiej. Za lewym argumentem operatorów logicznych umieszcza token skoku pomijający prawy argument, gdy lewy rozstrzyga wynik.
+		 *
+		 * Podczas tworzenia listy śledzona jest głębokość stosu wartości, dzięki czemu błędy, które wystąpiłyby podczas obliczeń (brak argumentów, nieznany operator, nawias bez pary) wykrywane są przed obliczeniami. Skok jest aktywny jedynie gdy prawy argument nie sięga poniżej lewego, więc pominięcie go nie zmienia wyniku.
+		 *
+		 * Gdy podano tablicę `Symbols` wyrażenie jest kompilowane: nazwy zmiennych zamieniane są na tokeny `VARIABLE` (nazwa dopisywana jest do tablicy), a `$` na token `RETURN`, zamiast podstawiania ich wartości.
+		 *
+		 */
+		template<typename List> bool GetTokens(List& Tokens, const KLStringView& Code, const KLVariables* Scoope, const double Return, KLList<KLSymbol>* Symbols = nullptr);
+
+		/*! \brief		Obliczenie wyrażenia.
+		 *  \tparam		TokenList	Typ listy tokenów.
+		 *  \tparam		ValueList	Typ stosu wartości.
+		 *  \param [in]	Code		Wyrażenie do obliczenia.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Przetwarza i oblicza wyrażenie z użyciem podanych kontenerów. Zapełnienie kontenera o stałej pojemności kończy się błędem `OUT_OF_CAPACITY`.
+		 *
+		 */
+		template<typename TokenList, typename ValueList> bool Execute(const KLStringView& Code, const KLVariables* Scoope, const double Return);
+
+		/*! \brief		Obliczenie wyrażenia programu.
+		 *  \tparam		ValueList	Typ stosu wartości.
+		 *  \param [in]	Program	Wczytany program.
+		 *  \param [in]	Expression	Numer wyrażenia w programie.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Oblicza skompilowane wyrażenie z użyciem podanego stosu wartości.
+		 *
+		 */
+		template<typename ValueList> bool Execute(const KLProgram& Program, int Expression, const KLVariables* Scoope, const double Return);
+
+		/*! \brief		Kompilacja wyrażenia do listy tokenów.
+		 *  \param [in]	Code		Wyrażenie do przetworzenia.
+		 *  \param [in,out]	Tokens	Tokeny budowanego programu.
+		 *  \param [in,out]	Symbols	Tablica symboli budowanego programu.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Dopisuje tokeny skompilowanego wyrażenia na koniec listy `Tokens`. Cele skoków liczone są względem pierwszego tokenu wyrażenia.
+		 *
+		 */
+		bool Assemble(const KLStringView& Code, KLList<KLParserToken>& Tokens, KLList<KLSymbol>& Symbols);
+
+		/*! \brief		Obliczenie wyrażenia programu.
+		 *  \param [in]	Program	Wczytany program.
+		 *  \param [in]	Expression	Numer wyrażenia w programie.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
 		 *  \return		Powodzenie operacji.
 		 *
-		 * Parsuje wyrażenie i zamienia je na postać Odwrotnej Notacji Polskiej.
+		 * Oblicza skompilowane wyrażenie bez ponownego parsowania tekstu. Wartości zmiennych pobierane są z zasięgu w chwili użycia. Poza trybem `USING_STATIC_CONTAINERS` wyrażenie o co najwyżej `KLPARSER_SCRATCH` tokenach korzysta ze stosu wartości w buforze na stosie.
 		 *
 		 */
-		bool GetTokens(KLList<KLParserToken*>& Tokens, const KLString& Code, const KLVariables* Scoope, const double Return);
+		bool Calculate(const KLProgram& Program, int Expression, const KLVariables* Scoope, const double Return);
 
 		double LastValue;				//!< Ostatnia poprawnie obliczona wartość wyrażenia.
 
@@ -303,14 +533,88 @@ class KLLIBS_EXPORT KLParser
 		 *  \return 		Powodzenie operacji.
 		 *  \see			GetError(), GetValue().
 		 *
-		 * Przetwarza podane wyrażenie i zwraca powodzenie jego wykonania.
+		 * Przetwarza podane wyrażenie i zwraca powodzenie jego wykonania. Tokeny i wartości pośrednie przechowywane są w kontenerach `KLSTOKENS` i `KLSVALUES`; w trybie `USING_STATIC_CONTAINERS` obliczenie nie korzysta ze sterty, a zbyt długie wyrażenie kończy się błędem `OUT_OF_CAPACITY`. W pozostałych trybach wyrażenie jest najpierw przetwarzane w buforach o pojemności `KLPARSER_SCRATCH` tokenów umieszczonych na stosie wywołania, a dopiero wyrażenie, które się w nich nie mieści, przetwarzane jest ponownie z użyciem list na stercie.
+		 *
+		 */
+		bool Evaluate(const KLStringView& Code, const KLVariables* Scoope = nullptr, const double Return = NAN);
+
+		/*! \brief		Wywołanie skompilowanego wyrażenia.
+		 *  \param [in]	Program	Program utworzony metodą `Compile()`.
+		 *  \param [in]	Scoope	Zasięg zmiennych.
+		 *  \param [in]	Return	Wartość podstawiana za `$`.
+		 *  \return 		Powodzenie operacji.
+		 *  \see			Compile(), GetError(), GetValue().
+		 *
+		 * Oblicza wyrażenie zapisane w programie, dając ten sam wynik i te same błędy co `Evaluate(const KLStringView&, const KLVariables*, const double)` dla tekstu wyrażenia. Program, który nie zawiera pojedynczego wyrażenia, kończy się błędem `UNKNOWN_EXPRESSION`.
+		 *
+		 */
+		bool Evaluate(const KLProgram& Program, const KLVariables* Scoope = nullptr, const double Return = NAN);
+
+		/*! \brief		Kompilacja wyrażenia.
+		 *  \param [in]	Code		Wyrażenie do przetworzenia.
+		 *  \param [out]	Program	Utworzony program.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zamienia wyrażenie na tokeny w postaci RPN zapisane w obrazie programu (`KLProgram`), który można zapisać do pliku i wykonywać bez ponownego parsowania. Nazwy zmiennych nie muszą być znane podczas kompilacji. Błędy składni zgłaszane są tak samo jak w metodzie `Evaluate()`.
+		 *
+		 */
+		bool Compile(const KLStringView& Code, KLProgram& Program);
+
+		/*! \brief		Wyszukanie niezmienników wyrażenia.
+		 *  \param [in]	Code		Wyrażenie do przetworzenia.
+		 *  \param [in]	Variants	Nazwy zmiennych, których wartość może się zmieniać (`$` oznacza ostatnią zwróconą wartość).
+		 *  \param [out]	Parts	Znalezione podwyrażenia.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Analizuje wyrażenie bez jego obliczania i zapisuje w `Parts` największe podwyrażenia (fragmenty `Code`), które nie zależą od zmiennych z listy `Variants` i zawierają co najmniej jeden operator lub funkcję. Zastąpienie takiego fragmentu zmienną o jego wartości nie zmienia wyniku wyrażenia.
+		 *
+		 * Nieznane nazwy traktowane są jak zmienne. Gdy wyrażenie jest niepoprawne, lub jego zapis odbiega od zwykłej postaci wrostkowej, lista pozostaje pusta i zwracane jest `false`.
+		 *
+		 */
+		bool GetInvariants(const KLStringView& Code, const KLList<KLSymbol>& Variants, KLList<KLStringView>& Parts) const;
+
+		/*! \brief		Wyszukanie zależności wyrażenia.
+		 *  \param [in]	Code		Wyrażenie do przetworzenia.
+		 *  \param [out]	Names	Nazwy zmiennych użytych w wyrażeniu.
+		 *
+		 * Dopisuje do listy `Names` nazwy wszystkich zmiennych, do których odwołuje się wyrażenie (każdą nazwę jeden raz). Wyrażenie nie jest obliczane ani sprawdzane.
+		 *
+		 */
+		void GetDependencies(const KLStringView& Code, KLList<KLSymbol>& Names) const;
+
+		/*! \brief		Zaokrąglenie liczby.
+		 *  \param [in]	Number	Liczba do zaokrąglenia.
+		 *  \param [in]	Digits	Liczba miejsc po przecinku.
+		 *  \return		Zaokrąglona liczba.
+		 *
+		 * Zaokrągla liczbę tak samo jak operator `~` w wyrażeniach.
+		 *
+		 */
+		static KLSNUMBER Round(KLSNUMBER Number, int Digits);
+
+		/*! \brief		Iloczyn rozmyty.
+		 *  \param [in]	ParamA	Pierwszy argument.
+		 *  \param [in]	ParamB	Drugi argument.
+		 *  \return		Mniejszy z argumentów.
+		 *
+		 * Oblicza wynik operatora `@` w wyrażeniach. Działa jak `fmin()`, ale wynik nie zależy od kompilatora: dla równych argumentów (np. `-0` i `+0`) zwracany jest `ParamB`, a gdy `ParamB` nie jest liczbą zwracany jest `ParamA`.
+		 *
+		 */
+		static KLSNUMBER Minimum(KLSNUMBER ParamA, KLSNUMBER ParamB);
+
+		/*! \brief		Suma rozmyta.
+		 *  \param [in]	ParamA	Pierwszy argument.
+		 *  \param [in]	ParamB	Drugi argument.
+		 *  \return		Większy z argumentów.
+		 *
+		 * Oblicza wynik operatora `?` w wyrażeniach. Działa jak `fmax()`, ale wynik nie zależy od kompilatora: dla równych argumentów (np. `-0` i `+0`) zwracany jest `ParamB`, a gdy `ParamB` nie jest liczbą zwracany jest `ParamA`.
 		 *
 		 */
-		bool Evaluate(const KLString& Code, const KLVariables* Scoope = nullptr, const double Return = NAN);
+		static KLSNUMBER Maximum(KLSNUMBER ParamA, KLSNUMBER ParamB);
 
 		/*! \brief		Pobranie wartości.
 		 *  \return		Ostatnia poprawnie obliczona wartość.
-		 *  \see			Evaluate(const KLString&).
+		 *  \see			Evaluate(const KLStringView&).
 		 *
 		 * Pobiera ostatnią obliczoną wartość.
 		 *
@@ -319,7 +623,7 @@ class KLLIBS_EXPORT KLParser
 
 		/*! \brief		Pobranie błędu.
 		 *  \return		Ostatni napotkany błąd.
-		 *  \see			Evaluate(const KLString&).
+		 *  \see			Evaluate(const KLStringView&).
 		 *
 		 * Pobiera ostatni błąd znaleziony w wyrażeniu.
 		 *
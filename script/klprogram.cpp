@@ -0,0 +1,411 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Compiled Program interpretation for KLLibs                 *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klprogram.hpp"
+#include "klscript.hpp"
+
+#include <new>
+
+#if !defined(F_CPU)
+#include <stdio.h>
+#endif
+
+#if defined(USING_FIXED_POINT)
+#define FLAGS 1
+#else
+#define FLAGS 0
+#endif
+
+#define ORDER 0x0102
+
+#define ALIGN(size) (((size) + 7) & ~7ull)
+
+KLProgram::KLProgram(void)
+: Buffer(nullptr), Image(nullptr), Length(0), Symbols(nullptr), Header(nullptr) {}
+
+KLProgram::~KLProgram(void)
+{
+	Clean();
+}
+
+bool KLProgram::Bind(void)
+{
+	const HEADER* Info = (const HEADER*) Image;
+
+	if (!Image || Length < int(sizeof(HEADER))) return false;
+
+	if (memcmp(Info->Magic, "KLSP", 4) ||
+	    Info->Version != VERSION ||
+	    Info->Order != ORDER ||
+	    Info->Token != sizeof(KLParser::KLParserToken) ||
+	    Info->Flags != FLAGS ||
+	    Info->Size != uint32_t(Length)) return false;
+
+	if (Info->Checksum != uint32_t(KLString::Hash(Image + 8, Length - 8))) return false;
+
+	const auto Fits = [this] (const SECTION& Section, size_t Item, size_t Extra) -> bool
+	{
+		return Section.Offset >= sizeof(HEADER) && !(Section.Offset % 8) && Section.Count < 0x7FFFFFFF &&
+			  Section.Offset + (unsigned long long) Section.Count * Item + Extra <= (unsigned long long) Length;
+	};
+
+	if (!Fits(Info->Statements, sizeof(STATEMENT), 0) ||
+	    !Fits(Info->Expressions, sizeof(EXPRESSION), 0) ||
+	    !Fits(Info->Tokens, sizeof(KLParser::KLParserToken), 0) ||
+	    !Fits(Info->Names, sizeof(int32_t), 0) ||
+	    !Fits(Info->Functions, sizeof(FUNCTION), 0) ||
+	    !Fits(Info->Symbols, sizeof(SYMBOL), 0) ||
+	    !Fits(Info->Strings, 1, 0) ||
+	    !Fits(Info->Text, 1, 1)) return false;
+
+	const int StatementsCount = Info->Statements.Count;
+	const int ExpressionsCount = Info->Expressions.Count;
+	const int NamesCount = Info->Names.Count;
+	const int FunctionsCount = Info->Functions.Count;
+	const int SymbolsCount = Info->Symbols.Count;
+	const int TextCount = Info->Text.Count;
+
+	const SYMBOL* Table = (const SYMBOL*) (Image + Info->Symbols.Offset);
+	const char* Strings = Image + Info->Strings.Offset;
+
+	Statements = (const STATEMENT*) (Image + Info->Statements.Offset);
+	Expressions = (const EXPRESSION*) (Image + Info->Expressions.Offset);
+	Tokens = (const KLParser::KLParserToken*) (Image + Info->Tokens.Offset);
+	Names = (const int32_t*) (Image + Info->Names.Offset);
+	Functions = (const FUNCTION*) (Image + Info->Functions.Offset);
+	Text = Image + Info->Text.Offset;
+
+	if (Text[TextCount]) return false;
+
+	for (int i = 0; i < SymbolsCount; ++i)
+	{
+		if (Table[i].Offset < 0 || Table[i].Length <= 0 ||
+		    Table[i].Offset >= int(Info->Strings.Count) - Table[i].Length ||
+		    Strings[Table[i].Offset + Table[i].Length]) return false;
+	}
+
+	for (int i = 0; i < ExpressionsCount; ++i)
+	{
+		const EXPRESSION& Code = Expressions[i];
+
+		if (Code.First < 0 || Code.Count <= 0 || Code.First > int(Info->Tokens.Count) - Code.Count) return false;
+
+		for (int j = 0; j < Code.Count; ++j)
+		{
+			if (!Tokens[Code.First + j].IsValid(j, Code.Count, SymbolsCount)) return false;
+		}
+	}
+
+	for (int i = 0; i < NamesCount; ++i)
+	{
+		if (Names[i] < 0 || Names[i] >= SymbolsCount) return false;
+	}
+
+	for (int i = 0; i < FunctionsCount; ++i)
+	{
+		const FUNCTION& Function = Functions[i];
+
+		if (Function.Name < 0 || Function.Name >= SymbolsCount ||
+		    Function.Begin < 0 || Function.Begin >= Function.End || Function.End > StatementsCount ||
+		    Function.Offset < 0 || Function.Length <= 0 || Function.Offset > TextCount - Function.Length) return false;
+	}
+
+	for (int i = 0; i < StatementsCount; ++i)
+	{
+		const STATEMENT& Statement = Statements[i];
+
+		int Items = 0;
+
+		if (Statement.Offset < 0 || Statement.Offset > TextCount ||
+		    Statement.Name < -1 || Statement.Name >= SymbolsCount ||
+		    Statement.Jump < -1 || Statement.Jump > StatementsCount ||
+		    Statement.First < 0 || Statement.Count < 0) return false;
+
+		switch (Statement.Operation)
+		{
+			case KLScript::SET:
+				if (Statement.Name == -1 || Statement.Count != 1) return false;
+				else Items = ExpressionsCount;
+			break;
+
+			case KLScript::CALL:
+			case KLScript::GOTO:
+				if (Statement.Name == -1) return false;
+				else Items = ExpressionsCount;
+			break;
+
+			case KLScript::T_IF:
+			case KLScript::T_WHILE:
+				if (Statement.Jump <= i || Statement.Count != 1) return false;
+				else Items = ExpressionsCount;
+			break;
+
+			case KLScript::T_RETURN:
+				if (Statement.Count != 1) return false;
+				else Items = ExpressionsCount;
+			break;
+
+			case KLScript::VAR:
+			case KLScript::EXP:
+			case KLScript::POP:
+				Items = NamesCount;
+			break;
+
+			case KLScript::T_DEF:
+				if (Statement.Name == -1 || Statement.Jump <= i || Statement.First >= FunctionsCount) return false;
+				else Items = FunctionsCount;
+			break;
+
+			case KLScript::T_ELSE:
+				if (Statement.Jump != -1 && Statement.Jump <= i) return false;
+			break;
+
+			case KLScript::T_DONE:
+				if (Statement.Jump < 0 || Statement.Jump >= i) return false;
+			break;
+
+			case KLScript::T_ENDIF:
+			case KLScript::T_END:
+			case KLScript::EXIT:
+			break;
+
+			default: return false;
+		}
+
+		if (Statement.First > Items - Statement.Count) return false;
+	}
+
+	if (SymbolsCount)
+	{
+		Symbols = new KLSymbol[SymbolsCount];
+
+		for (int i = 0; i < SymbolsCount; ++i)
+		{
+			Symbols[i] = KLSymbol(KLStringView(Strings + Table[i].Offset, Table[i].Length));
+		}
+	}
+
+	Header = Info;
+
+	return true;
+}
+
+bool KLProgram::Create(const BUILD& Build, const KLStringView& Code)
+{
+	HEADER Info;
+	int Strings = 0;
+
+	unsigned long long Total = ALIGN(sizeof(HEADER));
+
+	const auto Place = [&Total] (SECTION& Section, int Count, size_t Item, size_t Extra) -> void
+	{
+		Section.Offset = uint32_t(Total);
+		Section.Count = uint32_t(Count);
+
+		Total = ALIGN(Total + Count * Item + Extra);
+	};
+
+	Clean();
+
+	for (const auto& Symbol: Build.Symbols) Strings += Symbol.Name().Size() + 1;
+
+	Place(Info.Statements, Build.Statements.Size(), sizeof(STATEMENT), 0);
+	Place(Info.Expressions, Build.Expressions.Size(), sizeof(EXPRESSION), 0);
+	Place(Info.Tokens, Build.Tokens.Size(), sizeof(KLParser::KLParserToken), 0);
+	Place(Info.Names, Build.Names.Size(), sizeof(int32_t), 0);
+	Place(Info.Functions, Build.Functions.Size(), sizeof(FUNCTION), 0);
+	Place(Info.Symbols, Build.Symbols.Size(), sizeof(SYMBOL), 0);
+	Place(Info.Strings, Strings, 1, 0);
+	Place(Info.Text, Code.Size(), 1, 1);
+
+	if (Total > 0x7FFFFFFF) return false;
+
+	memcpy(Info.Magic, "KLSP", 4);
+
+	Info.Version = VERSION;
+	Info.Order = ORDER;
+	Info.Token = sizeof(KLParser::KLParserToken);
+	Info.Flags = FLAGS;
+	Info.Size = uint32_t(Total);
+	Info.Hash = uint32_t(KLString::Hash(Code.Data(), Code.Size()));
+
+	Buffer = new char[Total]();
+
+	STATEMENT* StatementsData = (STATEMENT*) (Buffer + Info.Statements.Offset);
+	EXPRESSION* ExpressionsData = (EXPRESSION*) (Buffer + Info.Expressions.Offset);
+	KLParser::KLParserToken* TokensData = (KLParser::KLParserToken*) (Buffer + Info.Tokens.Offset);
+	int32_t* NamesData = (int32_t*) (Buffer + Info.Names.Offset);
+	FUNCTION* FunctionsData = (FUNCTION*) (Buffer + Info.Functions.Offset);
+	SYMBOL* SymbolsData = (SYMBOL*) (Buffer + Info.Symbols.Offset);
+	char* StringsData = Buffer + Info.Strings.Offset;
+
+	int Index = 0;
+
+	for (const auto& Statement: Build.Statements) StatementsData[Index++] = Statement;
+
+	for (const auto& Link: Build.Links)
+	{
+		StatementsData[Link.Statement].Jump = Link.Jump;
+
+		if (Link.First != -1) StatementsData[Link.Statement].First = Link.First;
+	}
+
+	Index = 0; for (const auto& Expression: Build.Expressions) ExpressionsData[Index++] = Expression;
+	Index = 0; for (const auto& Token: Build.Tokens) new (TokensData + Index++) KLParser::KLParserToken(Token);
+	Index = 0; for (const auto& Name: Build.Names) NamesData[Index++] = Name;
+	Index = 0; for (const auto& Function: Build.Functions) FunctionsData[Index++] = Function;
+
+	Index = Strings = 0;
+
+	for (const auto& Symbol: Build.Symbols)
+	{
+		const KLString& Name = Symbol.Name();
+
+		SymbolsData[Index++] = { Strings, Name.Size() };
+
+		memcpy(StringsData + Strings, (const char*) Name, Name.Size());
+
+		Strings += Name.Size() + 1;
+	}
+
+	memcpy(Buffer + Info.Text.Offset, Code.Data(), Code.Size());
+
+	memcpy(Buffer, &Info, sizeof(HEADER));
+
+	((HEADER*) Buffer)->Checksum = uint32_t(KLString::Hash(Buffer + 8, int(Total) - 8));
+
+	Image = Buffer;
+	Length = int(Total);
+
+	if (Bind()) return true;
+	else
+	{
+		Clean(); return false;
+	}
+}
+
+int KLProgram::Intern(KLList<KLSymbol>& List, const KLSymbol& Symbol)
+{
+	int Index = 0;
+
+	for (const auto& Known: List) if (Known == Symbol) return Index; else ++Index;
+
+	return List.Insert(Symbol) - 1;
+}
+
+bool KLProgram::Load(const char* Data, int Size)
+{
+	Clean();
+
+	if (!Data || Size <= 0) return false;
+
+	if (uintptr_t(Data) % alignof(KLParser::KLParserToken) || uintptr_t(Data) % alignof(HEADER))
+	{
+		Buffer = new char[Size];
+
+		memcpy(Buffer, Data, Size);
+
+		Image = Buffer;
+	}
+	else Image = Data;
+
+	Length = Size;
+
+	if (Bind()) return true;
+	else
+	{
+		Clean(); return false;
+	}
+}
+
+#if !defined(F_CPU)
+
+bool KLProgram::LoadFile(const char* Path)
+{
+	Clean();
+
+	if (!File.Open(Path)) return false;
+
+	Image = File.Data();
+	Length = File.Size();
+
+	if (Bind()) return true;
+	else
+	{
+		Clean(); return false;
+	}
+}
+
+bool KLProgram::SaveFile(const char* Path) const
+{
+	if (!Header || !Path) return false;
+
+	FILE* Output = fopen(Path, "wb");
+
+	if (!Output) return false;
+
+	const bool Written = fwrite(Image, 1, Length, Output) == size_t(Length);
+
+	return fclose(Output) == 0 && Written;
+}
+
+#endif
+
+void KLProgram::Clean(void)
+{
+#if !defined(F_CPU)
+	File.Close();
+#endif
+
+	delete [] Symbols;
+	delete [] Buffer;
+
+	Buffer = nullptr;
+	Image = nullptr;
+	Length = 0;
+	Symbols = nullptr;
+	Header = nullptr;
+}
+
+bool KLProgram::IsValid(void) const
+{
+	return Header != nullptr;
+}
+
+bool KLProgram::IsCurrent(const KLStringView& Code) const
+{
+	return Header && Header->Text.Count == uint32_t(Code.Size()) &&
+		  Header->Hash == uint32_t(KLString::Hash(Code.Data(), Code.Size()));
+}
+
+const char* KLProgram::Data(void) const
+{
+	return Header ? Image : nullptr;
+}
+
+int KLProgram::Size(void) const
+{
+	return Header ? Length : 0;
+}
+
+KLString KLProgram::GetSource(void) const
+{
+	return Header ? KLString::Borrow(Text, Header->Text.Count) : KLString();
+}
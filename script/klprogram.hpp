@@ -0,0 +1,351 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Compiled Program interpretation for KLLibs                 *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLPROGRAM_HPP
+#define KLPROGRAM_HPP
+
+#include "../libbuild.hpp"
+
+#include "../containers/kllist.hpp"
+#include "../containers/klstring.hpp"
+#include "../containers/klstringview.hpp"
+#include "../containers/klsymbol.hpp"
+
+#if !defined(F_CPU)
+#include "../containers/klmappedfile.hpp"
+#endif
+
+#include "klparser.hpp"
+
+#include <stdint.h>
+
+/*! \file		klprogram.hpp
+ *  \brief	Deklaracje dla klasy KLProgram i jej składników.
+ *
+ */
+
+/*! \file		klprogram.cpp
+ *  \brief	Implementacja klasy KLProgram i jej składników.
+ *
+ */
+
+/*! \brief	Skompilowany program.
+ *
+ * Obraz binarny skryptu (`KLScript::Compile()`) lub wyrażenia (`KLParser::Compile()`), który można wykonać bez ponownego parsowania i sprawdzania tekstu. Obraz zawiera tablicę instrukcji z rozwiązanymi skokami konstrukcji `if`, `while` i `define`, wyrażenia w postaci tokenów RPN (stałe zapisane są bezpośrednio w tokenach), tablicę symboli oraz kod źródłowy, z którego pobierane są treści funkcji i numery linii błędów.
+ *
+ * Obraz nie zawiera wskaźników (odwołania są numerami lub przesunięciami względem jego początku), więc może zostać zapisany do pliku i wykonany bezpośrednio z odwzorowania pliku w pamięci (`LoadFile()`). Nagłówek opisuje wersję formatu, rozmiar tokenu i typ liczb, dla których program skompilowano, oraz zawiera sumę kontrolną; obraz niezgodny lub uszkodzony nie jest wczytywany. Skrót kodu źródłowego pozwala wykryć nieaktualną kopię (`IsCurrent()`).
+ *
+ * Obraz zależy od platformy (kolejność bajtów, rozmiar typów) i trybu `USING_FIXED_POINT`. Podczas wczytywania nazwy symboli są jednorazowo internowane (`KLSymbol`).
+ *
+ */
+class KLLIBS_EXPORT KLProgram
+{
+
+	friend class KLJit;
+	friend class KLParser;
+	friend class KLScript;
+	friend class KLTranslator;
+
+	public:
+
+		/*! \brief		Wersja formatu.
+		 *
+		 * Zmieniana przy każdej niezgodnej zmianie obrazu, w tym numeracji operacji i tokenów.
+		 *
+		 */
+		static const uint16_t VERSION = 1;
+
+	/*! \brief		Opis sekcji obrazu.
+	 *
+	 * Określa położenie tablicy w obrazie i liczbę jej elementów.
+	 *
+	 */
+	public: struct SECTION
+	{
+		uint32_t Offset;	//!< Przesunięcie względem początku obrazu.
+		uint32_t Count;	//!< Liczba elementów.
+	};
+
+	/*! \brief		Nagłówek obrazu.
+	 *
+	 * Umieszczony na początku obrazu. Suma kontrolna obejmuje wszystkie dane za polem `Checksum`.
+	 *
+	 */
+	public: struct HEADER
+	{
+		char Magic[4];			//!< Sygnatura `KLSP`.
+		uint32_t Checksum;		//!< Suma kontrolna.
+
+		uint16_t Version;		//!< Wersja formatu (`VERSION`).
+		uint16_t Order;		//!< Znacznik kolejności bajtów (`0x0102`).
+		uint16_t Token;		//!< Rozmiar tokenu wyrażenia.
+		uint16_t Flags;		//!< Typ liczb (`1` w trybie `USING_FIXED_POINT`).
+
+		uint32_t Size;			//!< Rozmiar całego obrazu.
+		uint32_t Hash;			//!< Skrót kodu źródłowego.
+
+		SECTION Statements;		//!< Instrukcje skryptu (`STATEMENT`).
+		SECTION Expressions;	//!< Wyrażenia (`EXPRESSION`).
+		SECTION Tokens;		//!< Tokeny wyrażeń.
+		SECTION Names;			//!< Listy nazw instrukcji `var`, `export` i `pop` (numery symboli).
+		SECTION Functions;		//!< Funkcje skryptu (`FUNCTION`).
+		SECTION Symbols;		//!< Tablica symboli (`SYMBOL`).
+		SECTION Strings;		//!< Nazwy symboli zakończone zerem.
+		SECTION Text;			//!< Kod źródłowy zakończony zerem.
+	};
+
+	/*! \brief		Instrukcja skryptu.
+	 *
+	 * Opisuje jedną instrukcję. Znaczenie pól `First` i `Count` zależy od operacji: dla instrukcji z wyrażeniami są to numer pierwszego wyrażenia i ich liczba, dla `var`, `export` i `pop` pozycja w sekcji `Names` i liczba nazw, a dla `define` numer funkcji.
+	 *
+	 */
+	public: struct STATEMENT
+	{
+		int32_t Offset;		//!< Położenie instrukcji w kodzie źródłowym.
+		int32_t Operation;		//!< Numer operacji.
+		int32_t Name;			//!< Numer symbolu zmiennej lub funkcji (`-1` gdy brak).
+		int32_t First;			//!< Pierwszy element instrukcji.
+		int32_t Count;			//!< Liczba elementów instrukcji.
+		int32_t Jump;			//!< Numer instrukcji docelowej skoku (`-1` gdy brak).
+	};
+
+	/*! \brief		Wyrażenie.
+	 *
+	 * Określa zakres tokenów wyrażenia. Cele skoków tokenów liczone są względem pierwszego tokenu.
+	 *
+	 */
+	public: struct EXPRESSION
+	{
+		int32_t First;			//!< Numer pierwszego tokenu.
+		int32_t Count;			//!< Liczba tokenów.
+	};
+
+	/*! \brief		Funkcja skryptu.
+	 *
+	 * Opisuje funkcję zdefiniowaną instrukcją `define`. Treść funkcji to instrukcje od `Begin` do `End` (instrukcja `end`).
+	 *
+	 */
+	public: struct FUNCTION
+	{
+		int32_t Name;			//!< Numer symbolu nazwy.
+		int32_t Begin;			//!< Numer pierwszej instrukcji.
+		int32_t End;			//!< Numer instrukcji `end`.
+		int32_t Offset;		//!< Położenie treści w kodzie źródłowym.
+		int32_t Length;		//!< Długość treści w kodzie źródłowym.
+		int32_t Pure;			//!< Informacja czy funkcja jest czysta.
+	};
+
+	/*! \brief		Symbol.
+	 *
+	 * Wskazuje nazwę symbolu w sekcji `Strings`.
+	 *
+	 */
+	public: struct SYMBOL
+	{
+		int32_t Offset;		//!< Położenie nazwy.
+		int32_t Length;		//!< Długość nazwy.
+	};
+
+	/*! \brief		Poprawka skoku.
+	 *
+	 * Uzupełnia instrukcję, której cel skoku znany jest dopiero po dotarciu do końca bloku.
+	 *
+	 */
+	protected: struct LINK
+	{
+		int Statement;			//!< Numer poprawianej instrukcji.
+		int Jump;				//!< Cel skoku.
+		int First;			//!< Nowa wartość pola `First` (`-1` gdy bez zmian).
+	};
+
+	/*! \brief		Dane budowanego programu.
+	 *
+	 * Zbiera elementy programu podczas kompilacji.
+	 *
+	 */
+	protected: struct BUILD
+	{
+		KLList<STATEMENT> Statements;				//!< Instrukcje.
+		KLList<LINK> Links;						//!< Poprawki skoków.
+		KLList<EXPRESSION> Expressions;			//!< Wyrażenia.
+		KLList<KLParser::KLParserToken> Tokens;		//!< Tokeny.
+		KLList<int32_t> Names;					//!< Listy nazw.
+		KLList<FUNCTION> Functions;				//!< Funkcje.
+		KLList<KLSymbol> Symbols;					//!< Symbole.
+	};
+
+	protected:
+
+		/*! \brief		Sprawdzenie i przypisanie obrazu.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Sprawdza nagłówek, sumę kontrolną i zakresy wszystkich odwołań obrazu, ustala wskaźniki na jego sekcje i internuje symbole.
+		 *
+		 */
+		bool Bind(void);
+
+		/*! \brief		Utworzenie obrazu.
+		 *  \param [in]	Build	Elementy programu.
+		 *  \param [in]	Code		Kod źródłowy.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zapisuje elementy programu w nowym obrazie i przypisuje go do obiektu.
+		 *
+		 */
+		bool Create(const BUILD& Build, const KLStringView& Code);
+
+		/*! \brief		Numer symbolu.
+		 *  \param [in,out]	List		Tablica symboli budowanego programu.
+		 *  \param [in]	Symbol	Wyszukiwany symbol.
+		 *  \return		Numer symbolu w tablicy.
+		 *
+		 * Wyszukuje symbol w tablicy i dopisuje go, jeśli nie był jeszcze używany.
+		 *
+		 */
+		static int Intern(KLList<KLSymbol>& List, const KLSymbol& Symbol);
+
+		char* Buffer;							//!< Własny bufor obrazu (`nullptr` gdy obraz jest pożyczony).
+
+		const char* Image;						//!< Początek obrazu.
+
+		int Length;							//!< Rozmiar obrazu.
+
+#if !defined(F_CPU)
+		KLMappedFile File;						//!< Plik z odwzorowanym obrazem.
+#endif
+
+		KLSymbol* Symbols;						//!< Symbole programu.
+
+		const HEADER* Header;					//!< Nagłówek (`nullptr` gdy program nie jest wczytany).
+
+		const STATEMENT* Statements;				//!< Instrukcje.
+
+		const EXPRESSION* Expressions;			//!< Wyrażenia.
+
+		const KLParser::KLParserToken* Tokens;		//!< Tokeny.
+
+		const int32_t* Names;					//!< Listy nazw.
+
+		const FUNCTION* Functions;				//!< Funkcje.
+
+		const char* Text;						//!< Kod źródłowy.
+
+	public:
+
+		/*! \brief		Konstruktor domyślny.
+		 *
+		 * Tworzy pusty program.
+		 *
+		 */
+		KLProgram(void);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Zwalnia wszystkie użyte zasoby (`Clean()`).
+		 *
+		 */
+		~KLProgram(void);
+
+		KLProgram(const KLProgram&) = delete;
+		KLProgram& operator= (const KLProgram&) = delete;
+
+		/*! \brief		Wczytanie obrazu z pamięci.
+		 *  \param [in]	Data	Dane obrazu.
+		 *  \param [in]	Size	Rozmiar obrazu.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Sprawdza obraz i wykonuje go bezpośrednio z podanego bufora, który musi pozostać niezmieniony do końca życia programu lub wywołania `Clean()`. Bufor bez wymaganego wyrównania jest kopiowany.
+		 *
+		 */
+		bool Load(const char* Data, int Size);
+
+#if !defined(F_CPU)
+
+		/*! \brief		Wczytanie obrazu z pliku.
+		 *  \param [in]	Path Ścieżka do pliku.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Odwzorowuje plik w pamięci (`KLMappedFile`) i wykonuje program bezpośrednio z odwzorowania. Niezgodny lub uszkodzony plik nie jest wczytywany.
+		 *
+		 */
+		bool LoadFile(const char* Path);
+
+		/*! \brief		Zapis obrazu do pliku.
+		 *  \param [in]	Path Ścieżka do pliku.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zapisuje obraz programu do wybranego pliku.
+		 *
+		 */
+		bool SaveFile(const char* Path) const;
+
+#endif
+
+		/*! \brief		Czyszczenie programu.
+		 *
+		 * Zwalnia obraz i zamyka plik. Programu nie można czyścić podczas jego wykonywania.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Sprawdzenie programu.
+		 *  \return		`true` jeśli program jest wczytany.
+		 *
+		 * Sprawdza czy obiekt zawiera poprawny obraz.
+		 *
+		 */
+		bool IsValid(void) const;
+
+		/*! \brief		Sprawdzenie aktualności programu.
+		 *  \param [in]	Code Kod źródłowy.
+		 *  \return		`true` jeśli program został skompilowany z podanego kodu.
+		 *
+		 * Porównuje długość i skrót podanego kodu z danymi zapisanymi w obrazie. Pozwala wykryć nieaktualną kopię programu bez kompilowania kodu.
+		 *
+		 */
+		bool IsCurrent(const KLStringView& Code) const;
+
+		/*! \brief		Dane obrazu.
+		 *  \return		Wskaźnik na początek obrazu lub `nullptr` gdy program nie jest wczytany.
+		 *
+		 * Umożliwia zapisanie obrazu w dowolnym miejscu (np. w pamięci EEPROM) i późniejsze wczytanie metodą `Load()`.
+		 *
+		 */
+		const char* Data(void) const;
+
+		/*! \brief		Rozmiar obrazu.
+		 *  \return		Liczba bajtów obrazu.
+		 *
+		 * Zwraca rozmiar obrazu.
+		 *
+		 */
+		int Size(void) const;
+
+		/*! \brief		Kod źródłowy.
+		 *  \return		Łańcuch wskazujący bezpośrednio na kod zapisany w obrazie.
+		 *
+		 * Zwraca kod, z którego skompilowano program, np. do obliczenia numeru linii błędu (`KLScript::GetLine()`). Łańcuch nie może być używany po wyczyszczeniu programu.
+		 *
+		 */
+		KLString GetSource(void) const;
+
+};
+
+#endif // KLPROGRAM_HPP
@@ -0,0 +1,367 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Reactive Expression Graph for KLLibs                                   *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "klreactive.hpp"
+
+#if !defined(F_CPU)
+#include <atomic>
+#include <thread>
+#endif
+
+#define ReturnError(error) { LastError = error; return false; }
+
+KLReactive::NODE* KLReactive::Create(const KLSymbol& Name)
+{
+	NODE* Node = new NODE;
+
+	Node->Name = Name;
+	Node->Scoope = nullptr;
+	Node->Variable = nullptr;
+	Node->Version = 0;
+	Node->Value = NAN;
+	Node->Error = KLParser::NO_ERROR;
+	Node->Level = 0;
+	Node->Pending = 0;
+	Node->Visited = 0;
+	Node->Derived = false;
+	Node->Dirty = false;
+
+	Nodes.Insert(Node, Name);
+
+	return Node;
+}
+
+KLReactive::NODE* KLReactive::Find(const KLSymbol& Name) const
+{
+	return Nodes.Exists(Name) ? Nodes[Name] : nullptr;
+}
+
+bool KLReactive::Reaches(NODE* From, const NODE* To)
+{
+	KLList<NODE*> Stack; Stack << From;
+
+	From->Visited = ++Visit;
+
+	while (Stack.Size())
+	{
+		NODE* Node = Stack.Pop();
+
+		if (Node == To) return true;
+
+		for (auto Target: Node->Targets) if (Target->Visited != Visit)
+		{
+			Target->Visited = Visit; Stack << Target;
+		}
+	}
+
+	return false;
+}
+
+void KLReactive::Invalidate(NODE* Node)
+{
+	for (auto Target: Node->Targets) if (!Target->Dirty)
+	{
+		Target->Dirty = true; Invalidate(Target);
+	}
+}
+
+void KLReactive::Refresh(void)
+{
+	const KLVariables* Scoope = Values.Parent;
+	const uint64_t Current = Scoope ? Scoope->GetVersion() : 0;
+
+	if (Current == Seen && !Binded) return;
+
+	Seen = Current; Binded = false;
+
+	for (const auto& Item: Nodes) if (!Item.Value->Derived)
+	{
+		NODE* Node = Item.Value; uint64_t Version = 0; bool Changed = false;
+
+		if (Scoope && Scoope->Exists(Node->Name))
+		{
+			const KLVariables::KLVariable& Variable = (*Scoope)[Node->Name];
+
+			if (Variable.IsBinded()) Binded = Changed = true;
+
+			Version = Variable.GetVersion();
+		}
+
+		if (Changed || Version != Node->Version)
+		{
+			Node->Version = Version; Invalidate(Node);
+		}
+	}
+}
+
+void KLReactive::Sort(void)
+{
+	KLList<NODE*> Ready, Sorted; int Depth = 0;
+
+	for (const auto& Item: Nodes)
+	{
+		NODE* Node = Item.Value;
+
+		Node->Level = Node->Pending = 0;
+
+		for (auto Source: Node->Sources) if (Source->Derived) ++Node->Pending;
+
+		if (Node->Derived && !Node->Pending) Ready << Node;
+	}
+
+	while (Ready.Size())
+	{
+		NODE* Node = Ready.Dequeue(); Sorted << Node;
+
+		if (Node->Level > Depth) Depth = Node->Level;
+
+		for (auto Target: Node->Targets)
+		{
+			if (Target->Level <= Node->Level) Target->Level = Node->Level + 1;
+
+			if (!--Target->Pending) Ready << Target;
+		}
+	}
+
+	delete [] Order; Order = new NODE*[Sorted.Size()]; Count = 0;
+
+	for (int i = 0; i <= Depth; ++i) for (auto Node: Sorted)
+	{
+		if (Node->Level == i) Order[Count++] = Node;
+	}
+}
+
+void KLReactive::Compute(NODE* Node)
+{
+	KLParser Parser;
+
+	Parser.Evaluate(Node->Program, Node->Scoope);
+
+	Node->Error = Parser.GetError();
+	Node->Value = Node->Error == KLParser::NO_ERROR ? Parser.GetValue() : NAN;
+
+	*Node->Variable = Node->Value;
+
+	Node->Dirty = false;
+}
+
+void KLReactive::Resolve(NODE* Node)
+{
+	if (!Node->Dirty) return;
+
+	for (auto Source: Node->Sources) Resolve(Source);
+
+	Compute(Node);
+}
+
+KLReactive::KLReactive(KLVariables* Scoope)
+: Values(Scoope), Order(nullptr), Count(0), Seen(0), Visit(0), Binded(false), LastError(NO_ERROR) {}
+
+KLReactive::~KLReactive(void)
+{
+	Clean();
+}
+
+bool KLReactive::Add(const KLSymbol& Name, const KLStringView& Code)
+{
+	KLParser Parser; KLList<KLSymbol> Names;
+
+	NODE* Node = Find(Name);
+
+	if (Node && Node->Derived) ReturnError(ALREADY_DEFINED);
+
+	Parser.GetDependencies(Code, Names);
+
+#if defined(USING_STATIC_CONTAINERS)
+	if (Names.Size() > KLVARIABLES_SIZE) ReturnError(OUT_OF_CAPACITY);
+#endif
+
+	for (const auto& Dependency: Names)
+	{
+		NODE* Source = Find(Dependency);
+
+		if (Dependency == Name || (Node && Source && Reaches(Node, Source))) ReturnError(CYCLIC_DEPENDENCY);
+	}
+
+	if (!Node) Node = Create(Name);
+
+	if (!Parser.Compile(Code, Node->Program) || !Values.Add(Name, KLVariables::NUMBER, KLVariables::KLSCALLBACK(), false))
+	{
+		if (!Node->Targets.Size())
+		{
+			Nodes.Delete(Name); delete Node;
+		}
+
+		ReturnError(Parser.GetError() == KLParser::NO_ERROR ? OUT_OF_CAPACITY : WRONG_EXPRESSION);
+	}
+
+	Node->Scoope = new KLVariables(Values.Parent);
+
+	for (const auto& Dependency: Names)
+	{
+		NODE* Source = Find(Dependency);
+
+		if (!Source) Source = Create(Dependency);
+		else if (Source->Derived) Node->Scoope->Add(Dependency, Source->Value);
+
+		Source->Targets << Node;
+		Node->Sources << Source;
+	}
+
+	for (auto Target: Node->Targets) Target->Scoope->Add(Name, Node->Value);
+
+	Node->Variable = &Values[Name];
+	Node->Derived = Node->Dirty = true;
+
+	Invalidate(Node); Sort();
+
+	LastError = NO_ERROR;
+
+	return true;
+}
+
+int KLReactive::Update(void)
+{
+	int Computed = 0;
+
+	Refresh();
+
+	for (int i = 0; i < Count; ++i) if (Order[i]->Dirty)
+	{
+		Compute(Order[i]); ++Computed;
+	}
+
+	return Computed;
+}
+
+#if !defined(F_CPU)
+
+int KLReactive::Update(KLThreadPool& Pool)
+{
+	std::atomic<int> Computed(0);
+
+	Refresh();
+
+	for (int Begin = 0, End = 0; Begin < Count; Begin = End)
+	{
+		int Dirty = 0;
+
+		while (End < Count && Order[End]->Level == Order[Begin]->Level)
+		{
+			if (Order[End++]->Dirty) ++Dirty;
+		}
+
+		if (Dirty > 1)
+		{
+			std::atomic<int> Next(Begin);
+
+			const int Tasks = Dirty <= Pool.Size() ? Dirty : Pool.Size() + 1;
+
+			std::atomic<int> Pending(Tasks);
+
+			const auto Work = [this, &Next, &Pending, &Computed, End] (void)
+			{
+				for (int i = Next++; i < End; i = Next++) if (Order[i]->Dirty)
+				{
+					Compute(Order[i]); ++Computed;
+				}
+
+				Pending.fetch_sub(1);
+			};
+
+			for (int i = 0; i < Tasks; ++i) Pool.Insert(Work);
+
+			while (Pending.load())
+			{
+				if (!Pool.Process()) std::this_thread::yield();
+			}
+		}
+		else for (int i = Begin; i < End; ++i) if (Order[i]->Dirty)
+		{
+			Compute(Order[i]); ++Computed;
+		}
+	}
+
+	return Computed;
+}
+
+#endif
+
+bool KLReactive::IsDirty(const KLSymbol& Name)
+{
+	NODE* Node = Find(Name);
+
+	Refresh();
+
+	return Node && Node->Derived && Node->Dirty;
+}
+
+bool KLReactive::Exists(const KLSymbol& Name) const
+{
+	NODE* Node = Find(Name);
+
+	return Node && Node->Derived;
+}
+
+void KLReactive::Clean(void)
+{
+	for (const auto& Item: Nodes)
+	{
+		delete Item.Value->Scoope; delete Item.Value;
+	}
+
+	delete [] Order; Order = nullptr; Count = 0;
+
+	Nodes.Clean(); Values.Clean();
+
+	Seen = 0; Binded = false;
+}
+
+double KLReactive::GetValue(const KLSymbol& Name)
+{
+	NODE* Node = Find(Name);
+
+	if (!Node || !Node->Derived) return NAN;
+
+	Refresh(); Resolve(Node);
+
+	return Node->Value;
+}
+
+KLParser::ERROR KLReactive::GetError(const KLSymbol& Name)
+{
+	NODE* Node = Find(Name);
+
+	if (!Node || !Node->Derived) return KLParser::UNKNOWN_EXPRESSION;
+
+	Refresh(); Resolve(Node);
+
+	return Node->Error;
+}
+
+KLReactive::ERROR KLReactive::GetError(void) const
+{
+	return LastError;
+}
+
+KLVariables* KLReactive::GetVariables(void)
+{
+	return &Values;
+}
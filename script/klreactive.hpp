@@ -0,0 +1,300 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Reactive Expression Graph for KLLibs                                   *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLREACTIVE_HPP
+#define KLREACTIVE_HPP
+
+#include "../libbuild.hpp"
+
+#include "../containers/kllist.hpp"
+#include "../containers/klmap.hpp"
+#include "../containers/klstringview.hpp"
+#include "../containers/klsymbol.hpp"
+
+#if !defined(F_CPU)
+#include "../containers/klthreadpool.hpp"
+#endif
+
+#include "klparser.hpp"
+#include "klprogram.hpp"
+#include "klvariables.hpp"
+
+#include <stdint.h>
+
+/*! \file		klreactive.hpp
+ *  \brief	Deklaracje dla klasy KLReactive i jej składników.
+ *
+ */
+
+/*! \file		klreactive.cpp
+ *  \brief	Implementacja klasy KLReactive i jej składników.
+ *
+ */
+
+/*! \brief	Graf zależności wyrażeń.
+ *
+ * Przechowuje nazwane wyrażenia (wielkości pochodne) obliczane na podstawie zmiennych zasięgu `KLVariables` oraz innych wielkości pochodnych. Zależności wyrażenia ustalane są podczas jego dodania (`KLParser::GetDependencies()`), a wyrażenie tworzące cykl zależności jest odrzucane.
+ *
+ * Każda zmienna posiada znacznik zmiany (`KLVariables::KLVariable::GetVersion()`). Gdy znacznik zasięgu (`KLVariables::GetVersion()`) różni się od zapamiętanego, porównywane są znaczniki zmiennych wejściowych, a wielkości zależne (bezpośrednio lub pośrednio) od zmienionych zmiennych oznaczane są jako nieaktualne. Pozostałe wielkości zachowują obliczone wartości. Zmienne zbindowane (których wartość może zmienić się bez przypisania) traktowane są jako zmieniane przed każdym odczytem.
+ *
+ * Nieaktualne wielkości obliczane są leniwie przy odczycie (`GetValue()`, wraz z nieaktualnymi wielkościami, od których zależą) lub wszystkie naraz metodą `Update()` w kolejności topologicznej. Na platformach innych niż AVR wielkości z tego samego poziomu grafu (niezależne od siebie) mogą być obliczane równolegle w puli wątków `KLThreadPool`.
+ *
+ * Każde wyrażenie obliczane jest we własnym, niewielkim zasięgu zawierającym jedynie bindy do wartości wielkości, od których zależy, więc wyszukiwanie zmiennych nie zależy od liczby wielkości w grafie. Obliczone wartości zapisywane są także w zbiorze zmiennych (`GetVariables()`), którego zakresem nadrzędnym jest zasięg zmiennych wejściowych, dzięki czemu zbiór ten można przekazać do `KLParser` lub `KLScript`. Zmienne wielkości pochodnych są tylko do odczytu. W trybie `USING_STATIC_CONTAINERS` liczba wielkości pochodnych i liczba zależności jednego wyrażenia ograniczone są pojemnością zbioru (`KLVARIABLES_SIZE`).
+ *
+ */
+class KLLIBS_EXPORT KLReactive
+{
+
+	/*! \brief		Wyliczenie błędów.
+	 *
+	 * Błędy zgłaszane podczas dodawania wyrażeń.
+	 *
+	 */
+	public: enum ERROR
+	{
+		NO_ERROR,				//!< Brak błędu.
+
+		WRONG_EXPRESSION,		//!< Błąd składni wyrażenia.
+		ALREADY_DEFINED,		//!< Wyrażenie o podanej nazwie już istnieje.
+		CYCLIC_DEPENDENCY,		//!< Wyrażenie tworzy cykl zależności.
+
+		OUT_OF_CAPACITY		//!< Przekroczono pojemność zbioru zmiennych (tryb `USING_STATIC_CONTAINERS`).
+	};
+
+	/*! \brief		Węzeł grafu.
+	 *
+	 * Reprezentuje wielkość pochodną lub zmienną wejściową, od której zależy przynajmniej jedna wielkość.
+	 *
+	 */
+	protected: struct NODE
+	{
+		KLSymbol Name;					//!< Nazwa wielkości lub zmiennej.
+
+		KLProgram Program;				//!< Skompilowane wyrażenie (tylko wielkości pochodne).
+
+		KLList<NODE*> Sources;			//!< Węzły, od których zależy wielkość.
+		KLList<NODE*> Targets;			//!< Węzły zależne od węzła.
+
+		KLVariables* Scoope;				//!< Zasięg wyrażenia (bindy wielkości, od których zależy, i zmienne wejściowe).
+
+		KLVariables::KLVariable* Variable;	//!< Zmienna przechowująca wartość wielkości w zbiorze wartości.
+
+		uint64_t Version;				//!< Ostatni odczytany znacznik zmiennej wejściowej.
+
+		double Value;					//!< Obliczona wartość wielkości.
+
+		KLParser::ERROR Error;			//!< Błąd obliczeń.
+
+		int Level;					//!< Poziom w grafie (najdłuższa ścieżka od zmiennych wejściowych).
+		int Pending;					//!< Liczba nieuporządkowanych poprzedników (podczas sortowania).
+
+		unsigned Visited;				//!< Numer ostatniego przeszukiwania, które odwiedziło węzeł.
+
+		bool Derived;					//!< Węzeł jest wielkością pochodną.
+		bool Dirty;					//!< Wartość wymaga ponownego obliczenia.
+	};
+
+	protected:
+
+		/*! \brief		Utworzenie węzła.
+		 *  \param [in]	Name Nazwa węzła.
+		 *  \return		Nowy węzeł zmiennej wejściowej.
+		 *
+		 */
+		NODE* Create(const KLSymbol& Name);
+
+		/*! \brief		Wyszukanie węzła.
+		 *  \param [in]	Name Nazwa węzła.
+		 *  \return		Węzeł lub `nullptr` gdy nie istnieje.
+		 *
+		 */
+		NODE* Find(const KLSymbol& Name) const;
+
+		/*! \brief		Sprawdzenie osiągalności.
+		 *  \param [in]	From	Węzeł początkowy.
+		 *  \param [in]	To	Węzeł szukany.
+		 *  \return		`true` jeśli `To` zależy (pośrednio lub bezpośrednio) od `From`.
+		 *
+		 */
+		bool Reaches(NODE* From, const NODE* To);
+
+		/*! \brief		Unieważnienie wielkości zależnych.
+		 *  \param [in]	Node Zmieniony węzeł.
+		 *
+		 * Oznacza jako nieaktualne wszystkie wielkości zależne od węzła. Przeszukiwanie zatrzymuje się na wielkościach już nieaktualnych, bo wielkości od nich zależne są również nieaktualne.
+		 *
+		 */
+		void Invalidate(NODE* Node);
+
+		/*! \brief		Sprawdzenie zmiennych wejściowych.
+		 *
+		 * Porównuje znaczniki zmiennych wejściowych z zapamiętanymi i unieważnia wielkości zależne od zmienionych zmiennych. Gdy znacznik zasięgu się nie zmienił, a żadna zmienna nie jest zbindowana, nie wykonuje żadnej pracy.
+		 *
+		 */
+		void Refresh(void);
+
+		/*! \brief		Uporządkowanie grafu.
+		 *
+		 * Wyznacza poziomy wielkości pochodnych i zapisuje je w kolejności topologicznej, uporządkowane według poziomów.
+		 *
+		 */
+		void Sort(void);
+
+		/*! \brief		Obliczenie wielkości.
+		 *  \param [in]	Node Węzeł wielkości pochodnej.
+		 *
+		 * Oblicza wyrażenie w zasięgu węzła i zapisuje wynik w zbiorze wartości. Wyrażenie zakończone błędem otrzymuje wartość `NAN`.
+		 *
+		 */
+		void Compute(NODE* Node);
+
+		/*! \brief		Leniwe obliczenie wielkości.
+		 *  \param [in]	Node Węzeł wielkości pochodnej.
+		 *
+		 * Oblicza nieaktualne wielkości, od których zależy węzeł, a następnie sam węzeł.
+		 *
+		 */
+		void Resolve(NODE* Node);
+
+		KLVariables Values;				//!< Wartości wielkości pochodnych.
+
+		KLMap<NODE*, KLSymbol> Nodes;		//!< Węzły grafu.
+
+		NODE** Order;					//!< Wielkości pochodne w kolejności topologicznej.
+
+		int Count;					//!< Liczba wielkości pochodnych.
+
+		uint64_t Seen;					//!< Ostatni sprawdzony znacznik zasięgu.
+
+		unsigned Visit;				//!< Numer ostatniego przeszukiwania grafu.
+
+		bool Binded;					//!< Przynajmniej jedna zmienna wejściowa jest zbindowana.
+
+		ERROR LastError;				//!< Ostatni odnotowany błąd.
+
+	public:
+
+		/*! \brief		Domyślny konstruktor.
+		 *  \param [in]	Scoope Zasięg zmiennych wejściowych.
+		 *
+		 * Tworzy pusty graf obliczany na podstawie podanego zasięgu zmiennych.
+		 *
+		 */
+		explicit KLReactive(KLVariables* Scoope = nullptr);
+
+		/*! \brief		Destruktor.
+		 *
+		 * Zwalnia wszystkie użyte zasoby (`Clean()`).
+		 *
+		 */
+		~KLReactive(void);
+
+		KLReactive(const KLReactive&) = delete;
+		KLReactive& operator= (const KLReactive&) = delete;
+
+		/*! \brief		Dodanie wielkości.
+		 *  \param [in]	Name	Nazwa wielkości.
+		 *  \param [in]	Code	Wyrażenie obliczające wielkość.
+		 *  \return		Powodzenie operacji.
+		 *  \see			GetError().
+		 *
+		 * Kompiluje wyrażenie, ustala jego zależności i dodaje je do grafu jako nieaktualne. Wyrażenie może korzystać z wielkości jeszcze nie zdefiniowanych; do chwili ich dodania są one traktowane jak zmienne wejściowe. Wyrażenie, którego wielkość byłaby zależna od niej samej, nie jest dodawane (`CYCLIC_DEPENDENCY`).
+		 *
+		 */
+		bool Add(const KLSymbol& Name, const KLStringView& Code);
+
+		/*! \brief		Obliczenie nieaktualnych wielkości.
+		 *  \return		Liczba obliczonych wielkości.
+		 *
+		 * Oblicza wszystkie nieaktualne wielkości w kolejności topologicznej.
+		 *
+		 */
+		int Update(void);
+
+#if !defined(F_CPU)
+
+		/*! \brief		Równoległe obliczenie nieaktualnych wielkości.
+		 *  \param [in]	Pool Pula wątków.
+		 *  \return		Liczba obliczonych wielkości.
+		 *
+		 * Oblicza nieaktualne wielkości kolejnymi poziomami grafu. Wielkości z jednego poziomu nie zależą od siebie, więc obliczane są równolegle przez wątki puli i wątek wywołujący; kolejny poziom obliczany jest po zakończeniu zadań poprzedniego. Do tego czasu wątek wywołujący wykonuje zadania z kolejki puli (`KLThreadPool::Process()`), także niezwiązane z grafem, dlatego metoda może być wywołana we współdzielonej puli i z wnętrza jej zadania.
+		 *
+		 */
+		int Update(KLThreadPool& Pool);
+
+#endif
+
+		/*! \brief		Sprawdzenie aktualności.
+		 *  \param [in]	Name Nazwa wielkości.
+		 *  \return		`true` jeśli wielkość wymaga ponownego obliczenia.
+		 *
+		 */
+		bool IsDirty(const KLSymbol& Name);
+
+		/*! \brief		Sprawdzenie istnienia wielkości.
+		 *  \param [in]	Name Nazwa wielkości.
+		 *  \return		`true` jeśli wielkość została dodana.
+		 *
+		 */
+		bool Exists(const KLSymbol& Name) const;
+
+		/*! \brief		Czyszczenie obiektu.
+		 *
+		 * Usuwa wszystkie wielkości i ich wartości.
+		 *
+		 */
+		void Clean(void);
+
+		/*! \brief		Pobranie wartości.
+		 *  \param [in]	Name Nazwa wielkości.
+		 *  \return		Aktualna wartość wielkości lub `NAN` gdy wielkość nie istnieje.
+		 *
+		 * Gdy wielkość jest nieaktualna, oblicza ją wraz z nieaktualnymi wielkościami, od których zależy.
+		 *
+		 */
+		double GetValue(const KLSymbol& Name);
+
+		/*! \brief		Pobranie błędu obliczeń.
+		 *  \param [in]	Name Nazwa wielkości.
+		 *  \return		Błąd obliczenia wielkości (`KLParser::UNKNOWN_EXPRESSION` gdy wielkość nie istnieje).
+		 *
+		 * Gdy wielkość jest nieaktualna, oblicza ją tak samo jak `GetValue()`.
+		 *
+		 */
+		KLParser::ERROR GetError(const KLSymbol& Name);
+
+		/*! \brief		Pobranie błędu.
+		 *  \return		Ostatni błąd dodawania wyrażenia.
+		 *  \see			Add().
+		 *
+		 */
+		ERROR GetError(void) const;
+
+		/*! \brief		Pobranie zbioru wartości.
+		 *  \return		Zbiór zmiennych z wartościami wielkości pochodnych.
+		 *
+		 * Wartości w zbiorze odpowiadają ostatnim obliczeniom; przed jego użyciem należy wywołać `Update()`.
+		 *
+		 */
+		KLVariables* GetVariables(void);
+
+};
+
+#endif // KLREACTIVE_HPP
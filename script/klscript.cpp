@@ -29,16 +29,74 @@
 #define IS_NoError			(LastError == NO_ERROR)
 #define IS_NextParam		((Separated && IS_NoError) ? LastProcess++ : false)
 
+#define IS_ParamEnd		(Script[LastProcess] == ';' || Script[LastProcess] == '#' || Script[LastProcess] == ',' || Script[LastProcess] == 0)
+
 #define ReturnError(error) 	{ LastError = error; return false; }
 
+KLScript::KLScriptContext::KLScriptContext(KLScript& Owner)
+: Script(Owner), Variables(Owner.Variables), Bindings(Owner.Bindings), Error(Owner.LastError), Return(Owner.LastReturn) {}
+
+void KLScript::KLScriptContext::Enter(void)
+{
+	Error			= NO_ERROR;
+	Return		= NAN;
+	Script.Sigterm	= false;
+}
+
+bool KLScript::KLScriptContext::IsTerminated(void) const
+{
+	return Script.Sigterm;
+}
+
+bool KLScript::KLScriptContext::Exists(const KLSymbol& Proc) const
+{
+	return Script.Functions.Exists(Proc);
+}
+
+bool KLScript::KLScriptContext::Define(const KLSymbol& Name, const char* Code, bool Pure, KLSNATIVE Function)
+{
+	Error = NO_ERROR;
+	Return = NAN;
+
+	if (!Script.Define(Name, KLString::Borrow(Code, strlen(Code)), Pure)) Error = OUT_OF_CAPACITY;
+	else if (Script.Natives.Insert(Function, Name) == -1) Error = OUT_OF_CAPACITY;
+
+	return Error == NO_ERROR;
+}
+
+void KLScript::KLScriptContext::Goto(const KLSymbol& Proc, KLBindings::KLSSTACK& Params)
+{
+	MEMO Key; const int Slot = Script.GetCache(Proc, Params, Key);
+
+	if (Slot != -1 && Script.Cache[Slot] == Key) Script.LastReturn = Script.Cache[Slot].Result;
+	else
+	{
+		const int SavedLastProcess = Script.LastProcess;
+		bool Done = false;
+
+		if (Script.Natives.Exists(Proc)) Done = Script.Natives[Proc](*this, &Params);
+		else Done = Script.Evaluate(Script.Functions[Proc], &Params);
+
+		if (Done && Slot != -1)
+		{
+			Key.Result = Script.LastReturn; Script.Cache[Slot] = Key;
+		}
+
+		Script.LastProcess = SavedLastProcess;
+	}
+}
+
 KLScript::KLScript(KLVariables* Scoope)
-: Sigterm(false), LastReturn(0), LastError(NO_ERROR), Variables(Scoope) {}
+: Sigterm(false), LastReturn(0), LastError(NO_ERROR), Variables(Scoope)
+{
+	CleanCache();
+}
 
 KLScript::OPERATION KLScript::GetToken(const KLString& Script)
 {
-	KLString Token = GetName(Script);
+	const KLStringView Token = GetName(Script);
 
-	if (!Token)				return END;
+	if (!Token.Size())			return END;
 
 	else if (Token == "set")		return SET;
 	else if (Token == "call")	return CALL;
@@ -65,25 +123,40 @@ KLScript::OPERATION KLScript::GetToken(const KLString& Script)
 	else						return UNKNOWN;
 }
 
-KLString KLScript::GetParam(const KLString& Script)
+KLStringView KLScript::GetParam(const KLString& Script)
 {
+	const KLStringView Code(Script);
+
 	int Start = SkipComment(Script);
 
-	while (Script[LastProcess] != ';' &&
-		  Script[LastProcess] != '#' &&
-		  Script[LastProcess] != ',' &&
-		  Script[LastProcess] != 0) ++LastProcess;
+	while (!IS_ParamEnd) ++LastProcess;
+
+	KLStringView Param = Code.Part(Start, LastProcess);
+
+	if (Script[LastProcess] == '#')
+	{
+		Buffer.Delete(0, Buffer.Size());
+
+		while (true)
+		{
+			if (LastProcess > Start) Buffer.Insert(Code.Data() + Start, -1, LastProcess - Start);
 
-	KLString Param = Script.Part(Start, LastProcess);
+			if (Script[LastProcess] != '#') break;
 
-	if (Script[LastProcess] == '#') return Param + GetParam(Script);
+			Start = SkipComment(Script);
+
+			while (!IS_ParamEnd) ++LastProcess;
+		}
+
+		Param = Buffer;
+	}
 
 	while (isspace(Script[LastProcess])) ++LastProcess;
 
 	return Param;
 }
 
-KLString KLScript::GetName(const KLString& Script)
+KLStringView KLScript::GetName(const KLString& Script)
 {
 	int Start = SkipComment(Script);
 
@@ -97,14 +170,17 @@ KLString KLScript::GetName(const KLString& Script)
 		while (isspace(Script[LastProcess])) ++LastProcess;
 	}
 
-	return Script.Part(Start, Stop);
+	return KLStringView(Script).Part(Start, Stop);
 }
 
 bool KLScript::GetValue(const KLString& Script, KLVariables& Scoope)
 {
-	KLString Equation = GetParam(Script);
+	return Parser.Evaluate(GetParam(Script), &Scoope, LastReturn);
+}
 
-	return Parser.Evaluate(Equation, &Scoope, LastReturn);
+bool KLScript::GetValue(const KLProgram& Program, int Expression, KLVariables& Scoope)
+{
+	return Parser.Calculate(Program, Expression, &Scoope, LastReturn);
 }
 
 int KLScript::SkipComment(const KLString& Script)
@@ -121,12 +197,248 @@ int KLScript::SkipComment(const KLString& Script)
 	return LastProcess;
 }
 
-bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
+void KLScript::OptimizeBlock(const KLString& Script, KLStringBuilder& Output, const KLString& Source, int& Names, bool Conservative)
+{
+	int Copied = 0;
+
+	LastProcess = 0;
+
+	while (SkipComment(Script) < Script.Size())
+	{
+		const int Start = LastProcess;
+		const OPERATION ID = GetToken(Script);
+
+		if (ID != T_WHILE && ID != T_DEF)
+		{
+			const int Next = Script.Find(';', LastProcess);
+
+			if (Next == -1) break;
+			else LastProcess = Next + 1;
+
+			continue;
+		}
+
+		KLString Condition;
+
+		if (ID == T_WHILE) Condition = GetParam(Script).ToString();
+		else if (GetName(Script).Size() && !Terminated) GetName(Script);
+
+		if (!Terminated) break;
+
+		const int Body = LastProcess + 1;
+		int Counter = 1;
+		int Stop = 0;
+
+		if (ID == T_DEF)
+		{
+			++LastProcess; SkipComment(Script);
+		}
+
+		while (Counter && LastProcess)
+		{
+			LastProcess = Stop = Script.Find(';', LastProcess) + 1;
+
+			if (LastProcess) switch (GetToken(Script))
+			{
+				case T_WHILE:
+					if (ID == T_WHILE) ++Counter;
+				break;
+				case T_DONE:
+					if (ID == T_WHILE) --Counter;
+				break;
+				case T_DEF:
+					if (ID == T_DEF) ++Counter;
+				break;
+				case T_END:
+					if (ID == T_DEF) --Counter;
+				break;
+				default: break;
+			}
+		}
+
+		if (Counter || !Terminated) break;
+
+		const int End = ++LastProcess;
+
+		KLStringBuilder Inner;
+
+		OptimizeBlock(KLString::Borrow((const char*) Script + Body, Stop - Body), Inner, Source, Names, Conservative);
+
+		const KLString Block = Inner.Release();
+
+		Output.Append((const char*) Script + Copied, Start - Copied);
+
+		if (ID != T_WHILE || !HoistLoop(Block, Condition, Output, Source, Names, Conservative))
+		{
+			Output.Append((const char*) Script + Start, Body - Start) << Block;
+		}
+
+		Output.Append((const char*) Script + Stop, End - Stop);
+
+		LastProcess = Copied = End;
+	}
+
+	Output.Append((const char*) Script + Copied, Script.Size() - Copied);
+}
+
+bool KLScript::HoistLoop(const KLString& Script, const KLString& Condition, KLStringBuilder& Output, const KLString& Source, int& Names, bool Conservative)
 {
-	struct JUMP { int When; int Where; };
+	struct PART
+	{
+		int Begin, End, Name;
+	};
+
+	KLList<KLSymbol> Variants;
+	KLList<KLStringView> Expressions;
+	KLList<KLString> Values, Labels;
+	KLList<PART> Parts;
+
+	bool Calls = false, Impure = false, Jumps = false;
+
+	const auto Expression = [this, &Script, &Expressions] (void) -> void
+	{
+		const KLStringView Param = GetParam(Script);
+
+		if (Param.Data() >= (const char*) Script && Param.Data() + Param.Size() <= (const char*) Script + Script.Size())
+		{
+			Expressions.Insert(Param);
+		}
+	};
+
+	LastProcess = 0;
+
+	while (SkipComment(Script) < Script.Size() && !Jumps)
+	{
+		switch (GetToken(Script))
+		{
+			case SET:
+				Variants.Insert(GetName(Script));
+				Expression();
+			break;
+
+			case CALL:
+			{
+				const KLSymbol Proc = GetName(Script);
+
+				if (!Bindings.Exists(Proc) || !Bindings[Proc].IsPure()) Impure = true;
+
+				if (!Terminated) do Expression(); while (IS_NextParam);
+
+				Calls = true;
+			}
+			break;
+
+			case VAR:
+			case EXP:
+			case POP:
+				do Variants.Insert(GetName(Script)); while (IS_NextParam);
+			break;
+
+			case T_IF:
+			case T_WHILE:
+			case T_RETURN:
+				Expression();
+			break;
+
+			case GOTO:
+			case T_DEF:
+				Jumps = true;
+			break;
+
+			default: break;
+		}
+
+		const int Next = Script.Find(';', LastProcess);
+
+		if (Next == -1) break;
+		else LastProcess = Next + 1;
+	}
+
+	if (Jumps) return false;
+
+	if (Calls) Variants.Insert("$");
+
+	for (KLVariables* Scoope = &Variables; Scoope; Scoope = Scoope->Parent)
+	{
+		for (auto& Var: *Scoope) if (Impure || (Conservative && Var.Value.IsBinded())) Variants.Insert(Var.Index);
+	}
+
+	const auto Collect = [this, &Variants, &Values] (const KLStringView& Code, const char* Base, KLList<PART>& List) -> void
+	{
+		KLList<KLStringView> Found;
+
+		if (Parser.GetInvariants(Code, Variants, Found)) for (const auto& Part: Found)
+		{
+			int Name = 0;
+
+			for (const auto& Value: Values) if (KLStringView(Value) == Part) break; else ++Name;
+
+			if (Name == Values.Size()) Values.Insert(Part.ToString());
+
+			List.Insert({ int(Part.Data() - Base), int(Part.Data() - Base) + Part.Size(), Name });
+		}
+	};
+
+	for (const auto& Code: Expressions) Collect(Code, Script, Parts);
+
+	if (!Values.Size()) return false;
+
+	for (int i = 0; i < Values.Size(); ++i)
+	{
+		KLString Label;
+
+		do Label = KLString("inv") + KLString(Names++);
+		while (Source.Find(Label, 0, 0, true) != -1 || Variables.Exists(Label));
+
+		Labels.Insert(Label);
+	}
+
+	const auto Replace = [&Output, &Labels] (const KLString& Code, KLList<PART>& List) -> void
+	{
+		int Copied = 0;
+
+		while (List.Size())
+		{
+			int First = 0, Index = 0;
+
+			for (const auto& Part: List)
+			{
+				if (Part.Begin < List[First].Begin) First = Index;
+
+				++Index;
+			}
+
+			const PART Part = List[First]; List.Delete(First);
+
+			Output.Append((const char*) Code + Copied, Part.Begin - Copied) << Labels[Part.Name];
+
+			Copied = Part.End;
+		}
+
+		Output.Append((const char*) Code + Copied, Code.Size() - Copied);
+	};
+
+	Output << "if " << Condition << "; var ";
+
+	for (int i = 0; i < Labels.Size(); ++i) Output << (i ? ", " : "") << Labels[i];
+
+	Output << "; ";
+
+	int Index = 0;
+
+	for (const auto& Value: Values) Output << "set " << Labels[Index++] << ' ' << Value << "; ";
 
+	Output << "fi; while " << Condition << ';';
+
+	Replace(Script, Parts);
+
+	return true;
+}
+
+bool KLScript::Evaluate(const KLString& Script, KLBindings::KLSSTACK* Params)
+{
 	KLVariables LocalVars(&Variables);
-	KLList<JUMP> Jumps;
+	KLSJUMPS Jumps;
 
 	LastError		= NO_ERROR;
 	LastProcess	= 0;
@@ -149,7 +461,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 			{
 				IF_Terminated ReturnError(WRONG_PARAMETERS);
 
-				const KLString Var = GetName(Script);
+				const KLSymbol Var = GetName(Script);
 
 				if (!LocalVars.Exists(Var)) ReturnError(UNDEFINED_VARIABLE);
 				if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
@@ -166,7 +478,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 			{
 				IF_Terminated ReturnError(WRONG_PARAMETERS);
 
-				const KLString Proc = GetName(Script); KLList<double> Params;
+				const KLSymbol Proc = GetName(Script); KLBindings::KLSSTACK Params;
 
 				if (!Bindings.Exists(Proc)) ReturnError(UNDEFINED_FUNCTION);
 
@@ -174,7 +486,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 				{
 					if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
 
-					Params.Insert(Parser.GetValue());
+					if (Params.Insert(Parser.GetValue()) == -1) ReturnError(OUT_OF_CAPACITY);
 				}
 				while (IS_NextParam);
 
@@ -186,7 +498,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 			{
 				IF_Terminated ReturnError(WRONG_PARAMETERS);
 
-				const KLString Proc = GetName(Script); KLList<double> Params;
+				const KLSymbol Proc = GetName(Script); KLBindings::KLSSTACK Params;
 
 				if (!Functions.Exists(Proc)) ReturnError(UNDEFINED_FUNCTION);
 
@@ -194,16 +506,23 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 				{
 					if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
 
-					Params.Insert(Parser.GetValue());
+					if (Params.Insert(Parser.GetValue()) == -1) ReturnError(OUT_OF_CAPACITY);
 				}
 				while (IS_NextParam);
 
 				if (!IS_NoError) return false;
+
+				MEMO Key; const int Slot = GetCache(Proc, Params, Key);
+
+				if (Slot != -1 && Cache[Slot] == Key) LastReturn = Cache[Slot].Result;
 				else
 				{
 					int SavedLastProcess = LastProcess;
 
-					Evaluate(Functions[Proc], &Params);
+					if (Evaluate(Functions[Proc], &Params) && Slot != -1)
+					{
+						Key.Result = LastReturn; Cache[Slot] = Key;
+					}
 
 					LastProcess = SavedLastProcess;
 				}
@@ -218,7 +537,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 
 				do
 				{
-					if (KLString Name = GetName(Script))
+					if (const KLSymbol Name = GetName(Script))
 					{
 						const bool Local = LocalVars.Exists(Name, false);
 
@@ -228,18 +547,18 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 
 							if (Local && !Global)
 							{
-								Variables.Add(Name, LocalVars[Name]);
+								if (!Variables.Add(Name, LocalVars[Name])) ReturnError(OUT_OF_CAPACITY);
 							}
 							else if (!Global)
 							{
-								Variables.Add(Name);
+								if (!Variables.Add(Name)) ReturnError(OUT_OF_CAPACITY);
 							}
 
 							if (Local && !Global) LocalVars.Delete(Name);
 						}
 						else if (!Local)
 						{
-							LocalVars.Add(Name);
+							if (!LocalVars.Add(Name)) ReturnError(OUT_OF_CAPACITY);
 						}
 
 						if (ID == POP && Params) LocalVars[Name] = Params->Dequeue();
@@ -283,7 +602,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 
 				if (Parser.GetValue())
 				{
-					if (Else) Jumps.Insert({Else + 1, LastProcess + 1});
+					if (Else && Jumps.Insert({Else + 1, LastProcess + 1}) == -1) ReturnError(OUT_OF_CAPACITY);
 
 					LastProcess = Then;
 				}
@@ -320,7 +639,7 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 
 				if (Parser.GetValue())
 				{
-					Jumps.Insert({LastProcess + 1, Start});
+					if (Jumps.Insert({LastProcess + 1, Start}) == -1) ReturnError(OUT_OF_CAPACITY);
 
 					LastProcess = Then;
 				}
@@ -331,7 +650,8 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 			{
 				IF_Terminated ReturnError(WRONG_PARAMETERS);
 
-				const KLString Name = GetName(Script);
+				const KLSymbol Name = GetName(Script);
+				const bool Declared = !Terminated && GetName(Script) == "pure";
 
 				if (Terminated) ++LastProcess;
 				else ReturnError(WRONG_PARAMETERS);
@@ -358,16 +678,18 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 
 				if (Counter) ReturnError(EXPECTED_DONE_TOK);
 
-				const KLString Code = Script.Part(Start, Stop);
+				const KLString Code = KLString::Borrow((const char*) Script + Start, Stop - Start);
 				int SavedLastProcess = LastProcess;
 
 				if (!Code.Size()) ReturnError(EMPTY_FUNCTION);
 
 				if (!Validate(Code, &LocalVars)) return false;
-				else LastProcess = SavedLastProcess;
 
-				if (Functions.Exists(Name)) Functions[Name] = Code;
-				else Functions.Insert(Code, Name);
+				const bool Memoize = Declared || IsPure(Code);
+
+				LastProcess = SavedLastProcess;
+
+				if (!Define(Name, Code, Memoize)) ReturnError(OUT_OF_CAPACITY);
 			}
 			break;
 
@@ -405,95 +727,493 @@ bool KLScript::Evaluate(const KLString& Script, KLList<double>* Params)
 	return true;
 }
 
-bool KLScript::Validate(const KLString& Script, KLVariables* Scoope)
+bool KLScript::Define(const KLSymbol& Name, const KLString& Code, bool Memoize)
 {
-	KLVariables LocalVars(Scoope ? Scoope : &Variables);
+	if (Functions.Exists(Name)) Functions[Name] = Code;
+	else if (Functions.Insert(Code, Name) == -1) return false;
 
-	LastError 	= NO_ERROR;
-	LastProcess 	= 0;
-	LastReturn	= NAN;
+	Compiled.Delete(Name);
+	Natives.Delete(Name);
 
-	if (SkipComment(Script) == Script.Size()) ReturnError(WRONG_SCRIPTCODE);
+	int Index = 0;
 
-	while (true)
+	for (const auto& Symbol: Pure) if (Symbol == Name) break; else ++Index;
+
+	if (Index < Pure.Size()) Pure.Delete(Index);
+
+	if (Memoize && Pure.Insert(Name) == -1) return false;
+
+	for (auto& Entry: Cache) if (Entry.Function == Name.ToInt()) Entry.Function = 0;
+
+	return true;
+}
+
+bool KLScript::IsPure(const KLString& Script)
+{
+	KLList<KLSymbol> Locals, Names;
+
+	bool Valid = true;
+	int Depth = 0;
+
+	const auto Local = [&Locals] (const KLSymbol& Name) -> bool
 	{
-		SkipComment(Script);
+		for (const auto& Symbol: Locals) if (Symbol == Name) return true;
 
-		switch (GetToken(Script))
-		{
-			case SET:
-			{
-				IF_Terminated ReturnError(WRONG_PARAMETERS);
+		return false;
+	};
 
-				if (!LocalVars.Exists(GetName(Script))) ReturnError(UNDEFINED_VARIABLE);
-				if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
-			}
-			break;
+	const auto Expression = [this, &Script, &Names, &Local] (void) -> bool
+	{
+		Names.Clean(); Parser.GetDependencies(GetParam(Script), Names);
 
-			case CALL:
-			{
-				IF_Terminated ReturnError(WRONG_PARAMETERS);
+		for (const auto& Name: Names) if (!Local(Name)) return false;
 
-				if (!Bindings.Exists(GetName(Script))) ReturnError(UNDEFINED_FUNCTION);
+		return true;
+	};
 
-				if (!Terminated) do
-				{
-					if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
-				}
-				while (IS_NextParam);
-			}
+	LastProcess = 0;
+
+	while (Valid && SkipComment(Script) < Script.Size())
+	{
+		switch (GetToken(Script))
+		{
+			case SET:
+				Valid = Local(GetName(Script)) && Expression();
 			break;
 
-			case GOTO:
+			case CALL:
 			{
-				IF_Terminated ReturnError(WRONG_PARAMETERS);
+				const KLSymbol Proc = GetName(Script);
 
-				GetName(Script);
+				Valid = Bindings.Exists(Proc) && Bindings[Proc].IsPure();
 
-				if (!Terminated) do
-				{
-					if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
-				}
-				while (IS_NextParam);
+				if (!Terminated) do Valid = Valid && Expression(); while (Valid && IS_NextParam);
 			}
 			break;
 
 			case VAR:
-			case EXP:
 			case POP:
-			{
-				IF_Terminated ReturnError(WRONG_PARAMETERS);
-
 				do
 				{
-					if (KLString Name = GetName(Script))
-					{
-						LocalVars.Add(Name);
-					}
-					else ReturnError(EMPTY_EXPRESSION);
+					const KLSymbol Name = GetName(Script);
+
+					if (!Depth) Locals.Insert(Name);
+					else if (!Local(Name)) Valid = false;
 				}
 				while (IS_NextParam);
-			}
 			break;
 
 			case T_IF:
-			{
-				IF_Terminated ReturnError(WRONG_PARAMETERS);
+			case T_WHILE:
+				++Depth; Valid = Expression();
+			break;
 
-				if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
+			case T_ENDIF:
+			case T_DONE:
+				--Depth;
+			break;
 
-				int Counter = 1;
-				int Then = LastProcess;
+			case T_RETURN:
+				Valid = Expression();
+			break;
 
-				while (Counter && LastProcess)
-				{
-					LastProcess = Script.Find(';', LastProcess) + 1;
+			case EXP:
+			case GOTO:
+			case T_DEF:
+				Valid = false;
+			break;
 
-					if (LastProcess) switch (GetToken(Script))
-					{
-						case T_IF:
-							++Counter;
-						break;
+			default: break;
+		}
+
+		const int Next = Script.Find(';', LastProcess);
+
+		if (Next == -1) break;
+		else LastProcess = Next + 1;
+	}
+
+	return Valid;
+}
+
+int KLScript::GetCache(const KLSymbol& Proc, const KLBindings::KLSSTACK& Params, MEMO& Key) const
+{
+	if (Params.Size() > KLSCRIPT_MEMO_PARAMS) return -1;
+
+	bool Found = false;
+
+	for (const auto& Symbol: Pure) if (Symbol == Proc) Found = true;
+
+	if (!Found) return -1;
+
+	Key.Function = Proc.ToInt();
+	Key.Count = 0;
+
+	for (const auto& Param: Params) Key.Params[Key.Count++] = Param;
+
+	const size_t Hash = KLString::Hash((const char*) Key.Params, Key.Count * sizeof(double)) ^ (size_t(Key.Function) * 2654435761u);
+
+	return Hash % KLSCRIPT_MEMO;
+}
+
+KLString KLScript::Optimize(const KLString& Script, bool Conservative)
+{
+	KLStringBuilder Output(Script.Size());
+	int Names = 0;
+
+	if (!Validate(Script)) return Script;
+
+	OptimizeBlock(Script, Output, Script, Names, Conservative);
+
+	LastProcess = 0;
+
+	return Output.Release();
+}
+
+bool KLScript::Compile(const KLString& Script, KLProgram& Program)
+{
+	struct BLOCK
+	{
+		int Statement;			// Numer instrukcji otwierającej blok.
+		OPERATION Operation;	// Operacja otwierająca blok.
+		int Name;				// Numer symbolu funkcji.
+		bool Declared;			// Funkcja zadeklarowana jako czysta.
+		int Begin, Stop;		// Treść funkcji w tekście skryptu.
+		int End, Else;			// Położenie zamknięcia i `else` wyznaczone tak jak w `Evaluate()`.
+		int Last, Branch;		// Położenie i numer ostatniej instrukcji `else` bloku.
+	};
+
+	KLProgram::BUILD Build;
+	KLList<BLOCK> Blocks;
+
+	const auto Expression = [this, &Script, &Build] (void) -> bool
+	{
+		const int First = Build.Tokens.Size();
+
+		if (!Parser.Assemble(GetParam(Script), Build.Tokens, Build.Symbols)) return false;
+
+		Build.Expressions.Insert({ First, Build.Tokens.Size() - First });
+
+		return true;
+	};
+
+	const auto Match = [this, &Script] (BLOCK& Block, OPERATION Close) -> void
+	{
+		const int Saved = LastProcess;
+		int Counter = 1;
+
+		Block.Else = 0;
+
+		while (Counter && LastProcess)
+		{
+			LastProcess = Block.Stop = Script.Find(';', LastProcess) + 1;
+
+			if (LastProcess)
+			{
+				const OPERATION ID = GetToken(Script);
+
+				if (ID == Block.Operation) ++Counter;
+				else if (ID == Close) --Counter;
+				else if (ID == T_ELSE && Block.Operation == T_IF && Counter == 1) Block.Else = LastProcess;
+			}
+		}
+
+		Block.End = Counter ? -1 : LastProcess;
+
+		LastProcess = Saved;
+	};
+
+	Program.Clean();
+
+	if (!Validate(Script)) return false;
+
+	LastProcess = 0;
+
+	while (true)
+	{
+		const int Start = SkipComment(Script);
+		const OPERATION ID = GetToken(Script);
+		const int Index = Build.Statements.Size();
+
+		KLProgram::STATEMENT Statement = { Start, ID, -1, 0, 0, -1 };
+
+		if (ID == END)
+		{
+			if (LastProcess == Script.Size()) break;
+			else ReturnError(EMPTY_EXPRESSION);
+		}
+
+		switch (ID)
+		{
+			case SET:
+			case T_IF:
+			case T_WHILE:
+			case T_RETURN:
+			{
+				if (ID == SET) Statement.Name = KLProgram::Intern(Build.Symbols, GetName(Script));
+
+				Statement.First = Build.Expressions.Size();
+				Statement.Count = 1;
+
+				if (!Expression()) ReturnError(WRONG_EVALUATION);
+
+				if (ID == T_IF || ID == T_WHILE)
+				{
+					BLOCK Block = { Index, ID, -1, false, 0, 0, 0, 0, 0, -1 };
+
+					Match(Block, ID == T_IF ? T_ENDIF : T_DONE);
+
+					Blocks.Insert(Block);
+				}
+			}
+			break;
+
+			case CALL:
+			case GOTO:
+			{
+				Statement.Name = KLProgram::Intern(Build.Symbols, GetName(Script));
+				Statement.First = Build.Expressions.Size();
+
+				if (!Terminated) do
+				{
+					if (!Expression()) ReturnError(WRONG_EVALUATION);
+
+					++Statement.Count;
+				}
+				while (IS_NextParam);
+			}
+			break;
+
+			case VAR:
+			case EXP:
+			case POP:
+			{
+				Statement.First = Build.Names.Size();
+
+				do
+				{
+					Build.Names.Insert(KLProgram::Intern(Build.Symbols, GetName(Script)));
+
+					++Statement.Count;
+				}
+				while (IS_NextParam);
+			}
+			break;
+
+			case T_ELSE:
+			{
+				if (!Blocks.Size() || Blocks.Last().Operation != T_IF) ReturnError(EXPECTED_ENDIF_TOK);
+
+				Blocks.Last().Last = LastProcess;
+				Blocks.Last().Branch = Index;
+			}
+			break;
+
+			case T_ENDIF:
+			{
+				if (!Blocks.Size() || Blocks.Last().Operation != T_IF) ReturnError(EXPECTED_ENDIF_TOK);
+
+				const BLOCK Block = Blocks.Pop();
+
+				if (Block.End != LastProcess || Block.Else != Block.Last) ReturnError(EXPECTED_ENDIF_TOK);
+
+				if (Block.Branch != -1)
+				{
+					Build.Links.Insert({ Block.Statement, Block.Branch + 1, -1 });
+					Build.Links.Insert({ Block.Branch, Index + 1, -1 });
+				}
+				else Build.Links.Insert({ Block.Statement, Index + 1, -1 });
+			}
+			break;
+
+			case T_DONE:
+			{
+				if (!Blocks.Size() || Blocks.Last().Operation != T_WHILE) ReturnError(EXPECTED_DONE_TOK);
+
+				const BLOCK Block = Blocks.Pop();
+
+				if (Block.End != LastProcess) ReturnError(EXPECTED_DONE_TOK);
+
+				Build.Links.Insert({ Block.Statement, Index + 1, -1 });
+
+				Statement.Jump = Block.Statement;
+			}
+			break;
+
+			case T_DEF:
+			{
+				BLOCK Block = { Index, ID, KLProgram::Intern(Build.Symbols, GetName(Script)), false, 0, 0, 0, 0, 0, -1 };
+
+				Block.Declared = !Terminated && GetName(Script) == "pure";
+
+				Statement.Name = Block.Name;
+
+				const int Saved = LastProcess++;
+
+				Block.Begin = SkipComment(Script);
+
+				Match(Block, T_END);
+
+				LastProcess = Saved;
+
+				Blocks.Insert(Block);
+			}
+			break;
+
+			case T_END:
+			{
+				if (!Blocks.Size() || Blocks.Last().Operation != T_DEF) ReturnError(EXPECTED_DONE_TOK);
+
+				const BLOCK Block = Blocks.Pop();
+				const int Saved = LastProcess;
+
+				if (Block.End != LastProcess || Block.Stop <= Block.Begin) ReturnError(EXPECTED_DONE_TOK);
+
+				const bool Memoize = Block.Declared || IsPure(KLString::Borrow((const char*) Script + Block.Begin, Block.Stop - Block.Begin));
+
+				LastProcess = Saved;
+
+				Build.Functions.Insert({ Block.Name, Block.Statement + 1, Index, Block.Begin, Block.Stop - Block.Begin, Memoize });
+				Build.Links.Insert({ Block.Statement, Index + 1, Build.Functions.Size() - 1 });
+			}
+			break;
+
+			case UNKNOWN:
+				ReturnError(UNKNOWN_EXPRESSION);
+			break;
+
+			default: break;
+		}
+
+		Build.Statements.Insert(Statement);
+
+		if (Terminated) ++LastProcess;
+		else ReturnError(EXPECTED_TERMINATOR);
+	}
+
+	if (Blocks.Size()) ReturnError(Blocks.Last().Operation == T_IF ? EXPECTED_ENDIF_TOK : EXPECTED_DONE_TOK);
+
+	LastProcess = 0;
+
+	if (!Program.Create(Build, Script)) ReturnError(OUT_OF_CAPACITY);
+
+	return true;
+}
+
+bool KLScript::Evaluate(const KLProgram& Program, KLBindings::KLSSTACK* Params)
+{
+	LastError		= NO_ERROR;
+	LastProcess	= 0;
+	LastReturn	= NAN;
+	Sigterm		= false;
+
+	if (!Program.IsValid() || !Program.Header->Statements.Count) ReturnError(WRONG_SCRIPTCODE);
+
+	return Execute(Program, 0, Program.Header->Statements.Count, Params);
+}
+
+bool KLScript::Evaluate(KLSNATIVE Function, KLBindings::KLSSTACK* Params)
+{
+	KLScriptContext Context(*this);
+
+	LastError		= NO_ERROR;
+	LastProcess	= 0;
+	LastReturn	= NAN;
+	Sigterm		= false;
+
+	if (!Function) ReturnError(WRONG_SCRIPTCODE);
+
+	return Function(Context, Params);
+}
+
+bool KLScript::Validate(const KLString& Script, KLVariables* Scoope)
+{
+	KLVariables LocalVars(Scoope ? Scoope : &Variables);
+
+	LastError 	= NO_ERROR;
+	LastProcess 	= 0;
+	LastReturn	= NAN;
+
+	if (SkipComment(Script) == Script.Size()) ReturnError(WRONG_SCRIPTCODE);
+
+	while (true)
+	{
+		SkipComment(Script);
+
+		switch (GetToken(Script))
+		{
+			case SET:
+			{
+				IF_Terminated ReturnError(WRONG_PARAMETERS);
+
+				if (!LocalVars.Exists(GetName(Script))) ReturnError(UNDEFINED_VARIABLE);
+				if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
+			}
+			break;
+
+			case CALL:
+			{
+				IF_Terminated ReturnError(WRONG_PARAMETERS);
+
+				if (!Bindings.Exists(GetName(Script))) ReturnError(UNDEFINED_FUNCTION);
+
+				if (!Terminated) do
+				{
+					if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
+				}
+				while (IS_NextParam);
+			}
+			break;
+
+			case GOTO:
+			{
+				IF_Terminated ReturnError(WRONG_PARAMETERS);
+
+				GetName(Script);
+
+				if (!Terminated) do
+				{
+					if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
+				}
+				while (IS_NextParam);
+			}
+			break;
+
+			case VAR:
+			case EXP:
+			case POP:
+			{
+				IF_Terminated ReturnError(WRONG_PARAMETERS);
+
+				do
+				{
+					if (const KLSymbol Name = GetName(Script))
+					{
+						if (!LocalVars.Exists(Name, false) && !LocalVars.Add(Name)) ReturnError(OUT_OF_CAPACITY);
+					}
+					else ReturnError(EMPTY_EXPRESSION);
+				}
+				while (IS_NextParam);
+			}
+			break;
+
+			case T_IF:
+			{
+				IF_Terminated ReturnError(WRONG_PARAMETERS);
+
+				if (!GetValue(Script, LocalVars)) ReturnError(WRONG_EVALUATION);
+
+				int Counter = 1;
+				int Then = LastProcess;
+
+				while (Counter && LastProcess)
+				{
+					LastProcess = Script.Find(';', LastProcess) + 1;
+
+					if (LastProcess) switch (GetToken(Script))
+					{
+						case T_IF:
+							++Counter;
+						break;
 						case T_ENDIF:
 							--Counter;
 						break;
@@ -544,6 +1264,8 @@ bool KLScript::Validate(const KLString& Script, KLVariables* Scoope)
 
 				GetName(Script);
 
+				if (!Terminated && GetName(Script) != "pure") ReturnError(WRONG_PARAMETERS);
+
 				if (Terminated) ++LastProcess;
 				else ReturnError(WRONG_PARAMETERS);
 
@@ -569,7 +1291,7 @@ bool KLScript::Validate(const KLString& Script, KLVariables* Scoope)
 
 				if (Counter) ReturnError(EXPECTED_DONE_TOK);
 
-				const KLString Code = Script.Part(Start, Stop);
+				const KLString Code = KLString::Borrow((const char*) Script + Start, Stop - Start);
 				int SavedLastProcess = LastProcess;
 
 				if (!Code.Size()) ReturnError(EMPTY_FUNCTION);
@@ -607,6 +1329,223 @@ bool KLScript::Validate(const KLString& Script, KLVariables* Scoope)
 	return true;
 }
 
+bool KLScript::Execute(const KLProgram& Program, int Begin, int End, KLBindings::KLSSTACK* Params)
+{
+	KLVariables LocalVars(&Variables);
+
+#if defined(USING_STATIC_CONTAINERS)
+	const int Capacity = KLSCRIPT_JUMPS;
+#else
+	const int Capacity = INT_MAX;
+#endif
+
+	int Jumps = 0;
+
+	LastError		= NO_ERROR;
+	LastProcess	= Program.Statements[Begin].Offset;
+	LastReturn	= NAN;
+	Sigterm		= false;
+
+	for (int Index = Begin; Index < End; ++Index)
+	{
+		const KLProgram::STATEMENT& Statement = Program.Statements[Index];
+		const KLSymbol Name = Statement.Name != -1 ? Program.Symbols[Statement.Name] : KLSymbol();
+
+		if (Sigterm) ReturnError(SCRIPT_TERMINATED);
+
+		LastProcess = Statement.Offset;
+
+		switch (Statement.Operation)
+		{
+			case SET:
+			{
+				if (!LocalVars.Exists(Name)) ReturnError(UNDEFINED_VARIABLE);
+				if (!GetValue(Program, Statement.First, LocalVars)) ReturnError(WRONG_EVALUATION);
+
+				KLVariables::KLVariable& Variable = LocalVars[Name];
+
+				if (Variable.IsReadonly()) ReturnError(VARIABLE_READONLY);
+
+				Variable = Parser.GetValue();
+			}
+			break;
+
+			case CALL:
+			case GOTO:
+			{
+				KLBindings::KLSSTACK Stack;
+
+				if (Statement.Operation == CALL && !Bindings.Exists(Name)) ReturnError(UNDEFINED_FUNCTION);
+				if (Statement.Operation == GOTO && !Functions.Exists(Name)) ReturnError(UNDEFINED_FUNCTION);
+
+				for (int i = 0; i < Statement.Count; ++i)
+				{
+					if (i && !IS_NoError) break;
+
+					if (!GetValue(Program, Statement.First + i, LocalVars)) ReturnError(WRONG_EVALUATION);
+
+					if (Stack.Insert(Parser.GetValue()) == -1) ReturnError(OUT_OF_CAPACITY);
+				}
+
+				if (Statement.Operation == CALL)
+				{
+					if (Stack.Size() < Statement.Count) ReturnError(EXPECTED_TERMINATOR);
+
+					if (IS_NoError) LastReturn = Bindings[Name](Stack);
+				}
+				else
+				{
+					if (!IS_NoError) return false;
+
+					MEMO Key; const int Slot = GetCache(Name, Stack, Key);
+
+					if (Slot != -1 && Cache[Slot] == Key) LastReturn = Cache[Slot].Result;
+					else
+					{
+						bool Done = false;
+
+						if (Compiled.Exists(Name) && Compiled[Name].Program == Program.Header->Checksum)
+						{
+							const KLProgram::FUNCTION& Function = Program.Functions[Compiled[Name].Function];
+
+							Done = Execute(Program, Function.Begin, Function.End, &Stack);
+						}
+						else Done = Evaluate(Functions[Name], &Stack);
+
+						if (Done && Slot != -1)
+						{
+							Key.Result = LastReturn; Cache[Slot] = Key;
+						}
+
+						LastProcess = Statement.Offset;
+					}
+				}
+			}
+			break;
+
+			case VAR:
+			case EXP:
+			case POP:
+			{
+				for (int i = 0; i < Statement.Count; ++i)
+				{
+					if (i && !IS_NoError) ReturnError(EXPECTED_TERMINATOR);
+
+					const KLSymbol Var = Program.Symbols[Program.Names[Statement.First + i]];
+					const bool Local = LocalVars.Exists(Var, false);
+
+					if (Statement.Operation == EXP)
+					{
+						const bool Global = Variables.Exists(Var);
+
+						if (Local && !Global)
+						{
+							if (!Variables.Add(Var, LocalVars[Var])) ReturnError(OUT_OF_CAPACITY);
+						}
+						else if (!Global)
+						{
+							if (!Variables.Add(Var)) ReturnError(OUT_OF_CAPACITY);
+						}
+
+						if (Local && !Global) LocalVars.Delete(Var);
+					}
+					else if (!Local)
+					{
+						if (!LocalVars.Add(Var)) ReturnError(OUT_OF_CAPACITY);
+					}
+
+					if (Statement.Operation == POP && Params) LocalVars[Var] = Params->Dequeue();
+				}
+			}
+			break;
+
+			case T_IF:
+			case T_WHILE:
+			{
+				if (!GetValue(Program, Statement.First, LocalVars)) ReturnError(WRONG_EVALUATION);
+
+				if (!Parser.GetValue()) Index = Statement.Jump - 1;
+				else if (Statement.Operation == T_WHILE || Program.Statements[Statement.Jump - 1].Operation == T_ELSE)
+				{
+					if (Jumps == Capacity) ReturnError(OUT_OF_CAPACITY);
+
+					++Jumps;
+				}
+			}
+			break;
+
+			case T_ELSE:
+			case T_DONE:
+				if (Statement.Jump != -1)
+				{
+					Index = Statement.Jump - 1; --Jumps;
+				}
+			break;
+
+			case T_DEF:
+			{
+				const KLProgram::FUNCTION& Function = Program.Functions[Statement.First];
+				const COMPILED Entry = { Program.Header->Checksum, Statement.First };
+
+				LastError = NO_ERROR;
+				LastReturn = NAN;
+
+				if (!Define(Name, KLString::Borrow(Program.Text + Function.Offset, Function.Length), Function.Pure)) ReturnError(OUT_OF_CAPACITY);
+
+				if (Compiled.Insert(Entry, Name) == -1) ReturnError(OUT_OF_CAPACITY);
+
+				Index = Statement.Jump - 1;
+			}
+			break;
+
+			case T_RETURN:
+			{
+				if (!GetValue(Program, Statement.First, LocalVars)) ReturnError(WRONG_EVALUATION);
+
+				LastReturn = Parser.GetValue();
+
+				return true;
+			}
+			break;
+
+			case EXIT: return IS_NoError;
+
+			default: break;
+		}
+	}
+
+	LastProcess = End < int(Program.Header->Statements.Count) ? Program.Statements[End].Offset : Program.Header->Text.Count;
+
+	return IS_NoError;
+}
+
+#if !defined(F_CPU)
+
+bool KLScript::EvaluateFile(const char* Path, KLBindings::KLSSTACK* Params)
+{
+	const KLMappedFile File(Path);
+
+	if (!File.IsOpen()) ReturnError(WRONG_SCRIPTCODE);
+
+	return Evaluate(File.String(), Params);
+}
+
+bool KLScript::ValidateFile(const char* Path, KLVariables* Scoope)
+{
+	const KLMappedFile File(Path);
+
+	if (!File.IsOpen()) ReturnError(WRONG_SCRIPTCODE);
+
+	return Validate(File.String(), Scoope);
+}
+
+#endif
+
+void KLScript::CleanCache(void)
+{
+	for (auto& Entry: Cache) Entry.Function = 0;
+}
+
 void KLScript::Terminate(void)
 {
 	Sigterm = true;
@@ -26,12 +26,45 @@
 #include "../libbuild.hpp"
 
 #include "../containers/klstring.hpp"
+#include "../containers/klstringbuilder.hpp"
+
+#if !defined(F_CPU)
+#include "../containers/klmappedfile.hpp"
+#endif
 
 #include "klvariables.hpp"
 #include "klbindings.hpp"
 #include "klparser.hpp"
+#include "klprogram.hpp"
+
+#if defined(USING_STATIC_CONTAINERS)
+#include "../containers/klstaticlist.hpp"
+#include "../containers/klstaticmap.hpp"
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLSCRIPT_JUMPS)
+#define KLSCRIPT_JUMPS 8	//!< Maksymalne zagnieżdżenie pętli i konstrukcji `if else` (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLSCRIPT_FUNCTIONS)
+#define KLSCRIPT_FUNCTIONS 8	//!< Maksymalna liczba funkcji zdefiniowanych w skrypcie (tryb `USING_STATIC_CONTAINERS`).
+#endif
+
+#if !defined(KLSCRIPT_MEMO) && defined(F_CPU)
+#define KLSCRIPT_MEMO 4		//!< Liczba miejsc w pamięci podręcznej wyników funkcji czystych.
+#elif !defined(KLSCRIPT_MEMO)
+#define KLSCRIPT_MEMO 64	//!< Liczba miejsc w pamięci podręcznej wyników funkcji czystych.
+#endif
+
+#if !defined(KLSCRIPT_MEMO_PARAMS) && defined(F_CPU)
+#define KLSCRIPT_MEMO_PARAMS 2	//!< Maksymalna liczba parametrów zapamiętywanego wywołania funkcji czystej.
+#elif !defined(KLSCRIPT_MEMO_PARAMS)
+#define KLSCRIPT_MEMO_PARAMS 4	//!< Maksymalna liczba parametrów zapamiętywanego wywołania funkcji czystej.
+#endif
 
 #include <ctype.h>
+#include <limits.h>
+#include <string.h>
 
 /*! \file		klscript.hpp
  *  \brief	Deklaracje dla klasy KLScript i jej składników.
@@ -50,12 +83,17 @@
  *
  * Utworzone zmienne są niszczone po zakończeniu skryptu. Do funkcji przekazywane są zmienne ze stosu w osobnym zakresie, wraz z dołączeniem zasięgu całego skryptu.
  *
+ * Funkcje czyste (zadeklarowane jako `define funkcja pure;` lub rozpoznane automatycznie, zobacz `IsPure()`) wywoływane przez `goto` zapamiętują swoje wyniki w pamięci podręcznej o stałym rozmiarze `KLSCRIPT_MEMO`, więc ponowne wywołanie z tymi samymi parametrami nie wykonuje funkcji. Zapamiętywane są jedynie wywołania zakończone powodzeniem.
+ *
  * Po każdym wyrażeniu (instrukcji) musi zostać umieszczony terminator `;`. Dotyczy to także konstrukcji `if`, `else`, `endif`, `while`, `done` itd. Taka restrykcja upraszcza parser do minimalnego stopnia skomplikowania.
  *
  */
 class KLLIBS_EXPORT KLScript
 {
 
+	friend class KLProgram;
+	friend class KLTranslator;
+
 	/*! \brief		Wyliczenie operacji.
 	 *
 	 * Umożliwia sprawdzenie jaką operację należy przetworzyć.
@@ -82,7 +120,7 @@ class KLLIBS_EXPORT KLScript
 		T_WHILE,	//!< Konstrukcja warunkowa: `while`.
 		T_DONE,	//!< Konstrukcja warunkowa: `done`.
 
-		T_DEF,	//!< Definicja funkcji: `define funkcja`.
+		T_DEF,	//!< Definicja funkcji: `define funkcja` lub `define funkcja pure`.
 		T_END,	//!< Zakończenie funkcji: `end`.
 
 		T_RETURN,	//!< Zakończenie skryptu i zwrócenie wartości: `return wyrażenie`.
@@ -116,9 +154,148 @@ class KLLIBS_EXPORT KLScript
 
 		VARIABLE_READONLY,		//!< Zmienna tylko do odczytu.
 
-		SCRIPT_TERMINATED		//!< Użytkownik przerwał skrypt.
+		SCRIPT_TERMINATED,		//!< Użytkownik przerwał skrypt.
+
+		OUT_OF_CAPACITY		//!< Przekroczono pojemność kontenerów (tryb `USING_STATIC_CONTAINERS`).
+	};
+
+	/*! \brief		Struktura skoku.
+	 *
+	 * Opisuje miejsce w skrypcie, po osiągnięciu którego należy przejść do innego punktu (np. na początek pętli).
+	 *
+	 */
+	protected: struct JUMP
+	{
+		int When;		//!< Pozycja wyzwalająca skok.
+		int Where;	//!< Pozycja docelowa.
 	};
 
+	/*! \brief		Wpis pamięci podręcznej funkcji.
+	 *
+	 * Przechowuje wynik wywołania funkcji czystej dla jednego zestawu parametrów.
+	 *
+	 */
+	protected: struct MEMO
+	{
+		int Function;						//!< Numer symbolu funkcji (`0` dla pustego wpisu).
+		int Count;						//!< Liczba parametrów.
+
+		double Params[KLSCRIPT_MEMO_PARAMS];	//!< Parametry wywołania.
+		double Result;						//!< Zwrócona wartość.
+
+		bool operator== (const MEMO& Memo) const
+		{
+			return Function == Memo.Function && Count == Memo.Count &&
+				  !memcmp(Params, Memo.Params, Count * sizeof(double));
+		}
+	};
+
+	/*! \brief		Funkcja skompilowana.
+	 *
+	 * Wskazuje treść funkcji zdefiniowanej przez program (`KLProgram`), dzięki czemu wywołanie `goto` z tego samego programu nie wymaga parsowania tekstu funkcji.
+	 *
+	 */
+	protected: struct COMPILED
+	{
+		uint32_t Program;	//!< Suma kontrolna programu.
+		int Function;		//!< Numer funkcji w programie.
+	};
+
+	public: class KLScriptContext;
+
+	public: using KLSNATIVE = bool (*)(KLScriptContext& Context, KLBindings::KLSSTACK* Params);	//!< Funkcja natywna (zobacz `KLTranslator`).
+
+	/*! \brief		Kontekst funkcji natywnej.
+	 *
+	 * Udostępnia funkcjom natywnym (utworzonym przez `KLTranslator`) stan interpretera: zmienne, bindy, ostatni błąd i zwróconą wartość, a także wywołania `goto` i definicje funkcji `define`, dzięki czemu funkcja natywna zachowuje się tak samo jak wykonywany przez interpreter skrypt.
+	 *
+	 */
+	public: class KLLIBS_EXPORT KLScriptContext
+	{
+
+		protected:
+
+			KLScript& Script;	//!< Interpreter wykonujący funkcję.
+
+		public:
+
+			KLVariables& Variables;	//!< Zmienne interpretera.
+
+			KLBindings& Bindings;	//!< Bindy funkcji interpretera.
+
+			ERROR& Error;			//!< Ostatni błąd interpretera.
+
+			double& Return;		//!< Ostatnia zwrócona wartość.
+
+			/*! \brief		Domyślny konstruktor.
+			 *  \param [in]	Owner Interpreter wykonujący funkcję.
+			 *
+			 * Tworzy kontekst odwołujący się do stanu podanego interpretera.
+			 *
+			 */
+			KLScriptContext(KLScript& Owner);
+
+			/*! \brief		Rozpoczęcie wykonania.
+			 *
+			 * Zeruje ostatni błąd, zwróconą wartość i sygnał zakończenia, tak jak rozpoczęcie wykonania skryptu lub funkcji.
+			 *
+			 */
+			void Enter(void);
+
+			/*! \brief		Sprawdzenie sygnału zakończenia.
+			 *  \return		`true` jeśli skrypt należy przerwać.
+			 *
+			 * Sprawdza czy wywołano metodę `KLScript::Terminate()`.
+			 *
+			 */
+			bool IsTerminated(void) const;
+
+			/*! \brief		Sprawdzenie istnienia funkcji.
+			 *  \param [in]	Proc Nazwa funkcji.
+			 *  \return		`true` jeśli funkcja jest zdefiniowana.
+			 *
+			 * Sprawdza czy funkcję zdefiniowano za pomocą `define`.
+			 *
+			 */
+			bool Exists(const KLSymbol& Proc) const;
+
+			/*! \brief		Definicja funkcji.
+			 *  \param [in]	Name		Nazwa funkcji.
+			 *  \param [in]	Code		Treść funkcji.
+			 *  \param [in]	Pure		Informacja czy funkcja jest czysta.
+			 *  \param [in]	Function	Natywna postać funkcji.
+			 *  \return		Powodzenie operacji.
+			 *
+			 * Wykonuje instrukcję `define`: zapisuje treść funkcji w `KLScript::Functions` i zapamiętuje jej natywną postać, która jest używana przez kolejne wywołania `Goto()`. Gdy przekroczono pojemność kontenerów ustawia błąd `OUT_OF_CAPACITY` i zwraca `false`.
+			 *
+			 */
+			bool Define(const KLSymbol& Name, const char* Code, bool Pure, KLSNATIVE Function);
+
+			/*! \brief		Wywołanie funkcji.
+			 *  \param [in]	Proc		Nazwa funkcji.
+			 *  \param [in]	Params	Parametry wywołania.
+			 *
+			 * Wykonuje instrukcję `goto` dla obliczonych już parametrów. Korzysta z pamięci podręcznej funkcji czystych, a funkcję zdefiniowaną przez `Define()` wykonuje w postaci natywnej. Pozostałe funkcje wykonywane są przez interpreter.
+			 *
+			 */
+			void Goto(const KLSymbol& Proc, KLBindings::KLSSTACK& Params);
+
+	};
+
+#if defined(USING_STATIC_CONTAINERS)
+	protected: using KLSJUMPS = KLStaticList<JUMP, KLSCRIPT_JUMPS>;
+	protected: using KLSPURE = KLStaticList<KLSymbol, KLSCRIPT_FUNCTIONS>;
+	protected: using KLSCOMPILED = KLStaticMap<COMPILED, KLSymbol, KLSCRIPT_FUNCTIONS>;
+	protected: using KLSNATIVES = KLStaticMap<KLSNATIVE, KLSymbol, KLSCRIPT_FUNCTIONS>;
+	public: using KLSFUNCTIONS = KLStaticMap<KLString, KLSymbol, KLSCRIPT_FUNCTIONS>;
+#else
+	protected: using KLSJUMPS = KLList<JUMP>;
+	protected: using KLSPURE = KLList<KLSymbol>;
+	protected: using KLSCOMPILED = KLMap<COMPILED, KLSymbol>;
+	protected: using KLSNATIVES = KLMap<KLSNATIVE, KLSymbol>;
+	public: using KLSFUNCTIONS = KLMap<KLString, KLSymbol>;
+#endif
+
 	protected:
 
 		/*! \brief		Pobranie numeru operacji.
@@ -134,10 +311,10 @@ class KLLIBS_EXPORT KLScript
 		 *  \param [in]	Script Przetwarzany kod.
 		 *  \return		Parametr wyrażenia.
 		 *
-		 * Pobiera parametr przetwarzanego wyrażenia.
+		 * Pobiera parametr przetwarzanego wyrażenia. Zwracany fragment wskazuje na treść skryptu; jedynie parametr przerwany komentarzem jest składany w buforze `Buffer` i pozostaje ważny do następnego wywołania.
 		 *
 		 */
-		KLString GetParam(const KLString& Script);
+		KLStringView GetParam(const KLString& Script);
 
 		/*! \brief		Pobranie nazwy obiektu.
 		 *  \param [in]	Script Przetwarzany kod.
@@ -146,7 +323,7 @@ class KLLIBS_EXPORT KLScript
 		 * Pobiera nazwę zmiennej lub innego obiektu.
 		 *
 		 */
-		KLString GetName(const KLString& Script);
+		KLStringView GetName(const KLString& Script);
 
 		/*! \brief		Pobranie wartości liczbowej.
 		 *  \param [in]	Script	Przetwarzany kod.
@@ -158,6 +335,29 @@ class KLLIBS_EXPORT KLScript
 		 */
 		bool GetValue(const KLString& Script, KLVariables& Scoope);
 
+		/*! \brief		Pobranie wartości liczbowej.
+		 *  \param [in]	Program	Wykonywany program.
+		 *  \param [in]	Expression	Numer wyrażenia w programie.
+		 *  \param [in]	Scoope	Zakres zmiennych.
+		 *  \return		Wartośc wyrażenia.
+		 *
+		 * Oblicza wartość skompilowanego wyrażenia.
+		 *
+		 */
+		bool GetValue(const KLProgram& Program, int Expression, KLVariables& Scoope);
+
+		/*! \brief		Wykonanie fragmentu programu.
+		 *  \param [in]	Program	Wykonywany program.
+		 *  \param [in]	Begin	Numer pierwszej instrukcji.
+		 *  \param [in]	End		Numer instrukcji kończącej fragment.
+		 *  \param [in]	Params	Stos ze zmiennymi do pobrania.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Wykonuje instrukcje programu w nowym zakresie zmiennych, tak samo jak `Evaluate(const KLString&, KLBindings::KLSSTACK*)` wykonuje tekst skryptu lub funkcji.
+		 *
+		 */
+		bool Execute(const KLProgram& Program, int Begin, int End, KLBindings::KLSSTACK* Params);
+
 		/*! \brief		Pominięcie komentarza.
 		 *  \param [in]	Script Przetwarzany kod.
 		 *  \return		Bierzący punkt w skrypcie.
@@ -167,6 +367,63 @@ class KLLIBS_EXPORT KLScript
 		 */
 		int SkipComment(const KLString& Script);
 
+		/*! \brief		Optymalizacja fragmentu skryptu.
+		 *  \param [in]	Script		Przetwarzany kod.
+		 *  \param [out]	Output		Zoptymalizowany kod.
+		 *  \param [in]	Source		Cały optymalizowany skrypt.
+		 *  \param [in,out]	Names		Licznik nazw zmiennych pomocniczych.
+		 *  \param [in]	Conservative	Traktowanie zbindowanych zmiennych jako zmiennych.
+		 *
+		 * Przepisuje kod do bufora wyjściowego, optymalizując napotkane pętle `while` oraz treść funkcji `define`. Zagnieżdżone pętle optymalizowane są przed pętlami zewnętrznymi.
+		 *
+		 */
+		void OptimizeBlock(const KLString& Script, KLStringBuilder& Output, const KLString& Source, int& Names, bool Conservative);
+
+		/*! \brief		Wyciągnięcie niezmienników z pętli.
+		 *  \param [in]	Script		Treść pętli.
+		 *  \param [in]	Condition		Warunek pętli.
+		 *  \param [out]	Output		Zoptymalizowany kod.
+		 *  \param [in]	Source		Cały optymalizowany skrypt.
+		 *  \param [in,out]	Names		Licznik nazw zmiennych pomocniczych.
+		 *  \param [in]	Conservative	Traktowanie zbindowanych zmiennych jako zmiennych.
+		 *  \return		`true` jeśli pętla została zapisana w buforze.
+		 *
+		 * Wyszukuje w treści pętli podwyrażenia niezależne od zmiennych modyfikowanych w pętli, oblicza je przed pętlą i zastępuje zmiennymi pomocniczymi. Gdy nie ma czego wyciągnąć, lub pętla zawiera `goto` albo `define`, nic nie zapisuje i zwraca `false`.
+		 *
+		 */
+		bool HoistLoop(const KLString& Script, const KLString& Condition, KLStringBuilder& Output, const KLString& Source, int& Names, bool Conservative);
+
+		/*! \brief		Sprawdzenie czystości funkcji.
+		 *  \param [in]	Script Treść funkcji.
+		 *  \return		`true` jeśli funkcja jest czysta.
+		 *
+		 * Funkcja jest czysta gdy odwołuje się wyłącznie do własnych zmiennych (utworzonych przez `var` lub `pop` poza konstrukcjami `if` i `while` przed ich użyciem), nie używa `export`, `goto` ani `define` i wywołuje jedynie funkcje oznaczone jako czyste (`KLBindings::Add()`).
+		 *
+		 */
+		bool IsPure(const KLString& Script);
+
+		/*! \brief		Zapisanie definicji funkcji.
+		 *  \param [in]	Name		Nazwa funkcji.
+		 *  \param [in]	Code		Treść funkcji.
+		 *  \param [in]	Memoize	Informacja czy funkcja jest czysta.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Zapisuje treść funkcji, aktualizuje listę funkcji czystych i usuwa z pamięci podręcznej wyniki poprzedniej definicji. Zwraca `false` gdy przekroczono pojemność kontenerów.
+		 *
+		 */
+		bool Define(const KLSymbol& Name, const KLString& Code, bool Memoize);
+
+		/*! \brief		Wyszukanie miejsca w pamięci podręcznej.
+		 *  \param [in]	Proc		Nazwa funkcji.
+		 *  \param [in]	Params	Parametry wywołania.
+		 *  \param [out]	Key		Klucz wywołania.
+		 *  \return		Numer miejsca w pamięci podręcznej lub `-1` gdy wywołanie nie może być zapamiętane.
+		 *
+		 * Wypełnia klucz wywołania i wyznacza jego miejsce w pamięci podręcznej `Cache`. Zapamiętywane są jedynie wywołania funkcji czystych o co najwyżej `KLSCRIPT_MEMO_PARAMS` parametrach.
+		 *
+		 */
+		int GetCache(const KLSymbol& Proc, const KLBindings::KLSSTACK& Params, MEMO& Key) const;
+
 		volatile bool Sigterm;				//!< Sygnał zakończenia skryptu.
 
 		double LastReturn;					//!< Ostatnia zwrócona wartość.
@@ -175,9 +432,19 @@ class KLLIBS_EXPORT KLScript
 
 		ERROR LastError;					//!< Wyliczenie ostatniego błędu.
 
+		KLString Buffer;					//!< Bufor parametru przerwanego komentarzem.
+
+		KLSPURE Pure;						//!< Funkcje czyste zdefiniowane za pomocą skryptu.
+
+		MEMO Cache[KLSCRIPT_MEMO];			//!< Pamięć podręczna wyników funkcji czystych.
+
+		KLSCOMPILED Compiled;				//!< Funkcje zdefiniowane przez programy skompilowane.
+
+		KLSNATIVES Natives;					//!< Funkcje zdefiniowane przez funkcje natywne.
+
 	public:
 
-		KLMap<KLString, KLString> Functions;	//!< Funkcje zdefiniowane za pomocą skryptu.
+		KLSFUNCTIONS Functions;				//!< Funkcje zdefiniowane za pomocą skryptu.
 
 		KLVariables	Variables;			//!< Zmienne i ich bindy.
 
@@ -198,10 +465,10 @@ class KLLIBS_EXPORT KLScript
 		 *  \param [in]	Params	Stos ze zmiennymi do pobrania.
 		 *  \return		Powodzenie operacji.
 		 *
-		 * Przetwarza wybrany kod i zwraca powodzenie operacji.
+		 * Przetwarza wybrany kod i zwraca powodzenie operacji. W trybie `USING_STATIC_CONTAINERS` wykonanie skryptu nie korzysta ze sterty (poza zapisem definicji funkcji i pierwszym użyciem nowej nazwy symbolu), a przekroczenie pojemności kontenerów kończy się błędem `OUT_OF_CAPACITY`.
 		 *
 		 */
-		bool Evaluate(const KLString& Script, KLList<double>* Params = nullptr);
+		bool Evaluate(const KLString& Script, KLBindings::KLSSTACK* Params = nullptr);
 
 		/*! \brief		Sprawdzenie kodu.
 		 *  \param [in]	Script	Skrypt do przetworzenia.
@@ -213,6 +480,83 @@ class KLLIBS_EXPORT KLScript
 		 */
 		bool Validate(const KLString& Script, KLVariables* Scoope = nullptr);
 
+		/*! \brief		Optymalizacja kodu.
+		 *  \param [in]	Script		Skrypt do przetworzenia.
+		 *  \param [in]	Conservative	Traktowanie zbindowanych zmiennych jako zmiennych.
+		 *  \return		Zoptymalizowany skrypt.
+		 *
+		 * Wyciąga z pętli `while` obliczenia niezależne od przebiegu pętli. Podwyrażenia treści pętli, które nie odwołują się do zmiennych zapisywanych w pętli (`set`, `pop`, `var`, `export`), obliczane są raz przed pętlą w zmiennych pomocniczych `invN`, np. `while i < n; set y x * (k1 + k2 / k3); ...` staje się `if i < n; var inv0; set inv0 k1 + k2 / k3; fi; while i < n; set y x * (inv0); ...`. Wyciągnięte wyrażenia obliczane są przy każdym wejściu do pętli, o ile jej warunek jest spełniony, więc pętla, która nie wykona się ani razu, nie oblicza ich wcale. Warunek pętli nie jest przepisywany, bo jest obliczany także wtedy, gdy pętla się nie wykonuje.
+		 *
+		 * Wywołanie w pętli funkcji `call` nieoznaczonej jako czysta (`KLBindings::Add()`) sprawia, że wszystkie zmienne zakresu `Variables` traktowane są jako zmienne, a każde `call` zmienia wartość `$`. Pętle zawierające `goto` lub `define` nie są optymalizowane. W trybie zachowawczym (`Conservative`) zmienne zbindowane ze wskaźnikami, które program może zmienić w trakcie wykonania skryptu, nigdy nie są uznawane za niezmienne.
+		 *
+		 * Gdy skrypt nie przechodzi walidacji zwracana jest jego niezmieniona kopia, a błąd dostępny jest przez `GetError()`. Numery linii błędów zoptymalizowanego skryptu mogą różnić się od oryginału, a każda zmienna pomocnicza zajmuje miejsce w zakresie zmiennych (tryb `USING_STATIC_CONTAINERS`).
+		 *
+		 */
+		KLString Optimize(const KLString& Script, bool Conservative = true);
+
+		/*! \brief		Kompilacja kodu.
+		 *  \param [in]	Script	Skrypt do przetworzenia.
+		 *  \param [out]	Program	Utworzony program.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Sprawdza skrypt (`Validate()`) i zamienia go na obraz binarny (`KLProgram`), w którym wyrażenia zapisane są jako tokeny RPN, a skoki konstrukcji `if`, `else`, `while` i `define` są już rozwiązane. Program można zapisać do pliku (`KLProgram::SaveFile()`) i przy kolejnym uruchomieniu wykonać bez parsowania tekstu.
+		 *
+		 * Skrypt, w którym bloki nie są poprawnie zagnieżdżone (np. `fi` wewnątrz pętli otwartej w bloku `if`, lub `;` w komentarzu przesuwające koniec bloku), nie jest kompilowany i kończy się błędem `EXPECTED_ENDIF_TOK` lub `EXPECTED_DONE_TOK`.
+		 *
+		 */
+		bool Compile(const KLString& Script, KLProgram& Program);
+
+		/*! \brief		Wykonanie programu.
+		 *  \param [in]	Program	Program utworzony metodą `Compile()`.
+		 *  \param [in]	Params	Stos ze zmiennymi do pobrania.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Wykonuje skompilowany skrypt z tymi samymi wynikami i błędami co `Evaluate(const KLString&, KLBindings::KLSSTACK*)`. Różnice: treść funkcji sprawdzana jest podczas kompilacji, a nie w chwili wykonania `define`, czystość funkcji ustalana jest podczas kompilacji, a numer linii błędu (`GetLine()` dla `KLProgram::GetSource()`) wskazuje początek instrukcji. Funkcje zdefiniowane przez program wywoływane przez `goto` z tego samego programu wykonywane są w postaci skompilowanej.
+		 *
+		 */
+		bool Evaluate(const KLProgram& Program, KLBindings::KLSSTACK* Params = nullptr);
+
+		/*! \brief		Wykonanie funkcji natywnej.
+		 *  \param [in]	Function	Funkcja utworzona przez `KLTranslator`.
+		 *  \param [in]	Params	Stos ze zmiennymi do pobrania.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Wykonuje skrypt przetłumaczony na kod C++ z tymi samymi wynikami i błędami co `Evaluate(const KLProgram&, KLBindings::KLSSTACK*)`. Numer linii błędu nie jest dostępny.
+		 *
+		 */
+		bool Evaluate(KLSNATIVE Function, KLBindings::KLSSTACK* Params = nullptr);
+
+#if !defined(F_CPU)
+
+		/*! \brief		Wykonanie kodu z pliku.
+		 *  \param [in]	Path		Ścieżka do pliku ze skryptem.
+		 *  \param [in]	Params	Stos ze zmiennymi do pobrania.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Odwzorowuje plik w pamięci (`KLMappedFile`) i wykonuje skrypt bezpośrednio z odwzorowania, bez kopiowania jego treści. Gdy pliku nie można otworzyć ustawiany jest błąd `WRONG_SCRIPTCODE`.
+		 *
+		 */
+		bool EvaluateFile(const char* Path, KLBindings::KLSSTACK* Params = nullptr);
+
+		/*! \brief		Sprawdzenie kodu z pliku.
+		 *  \param [in]	Path		Ścieżka do pliku ze skryptem.
+		 *  \param [in]	Scoope	Globalny zakres zmiennych.
+		 *  \return		Powodzenie operacji.
+		 *
+		 * Odwzorowuje plik w pamięci (`KLMappedFile`) i sprawdza skrypt bezpośrednio z odwzorowania, bez kopiowania jego treści. Gdy pliku nie można otworzyć ustawiany jest błąd `WRONG_SCRIPTCODE`.
+		 *
+		 */
+		bool ValidateFile(const char* Path, KLVariables* Scoope = nullptr);
+
+#endif
+
+		/*! \brief		Czyszczenie pamięci podręcznej.
+		 *
+		 * Usuwa zapamiętane wyniki funkcji czystych. Metodę należy wywołać po zmianie funkcji zbindowanych oznaczonych jako czyste.
+		 *
+		 */
+		void CleanCache(void);
+
 		/*! \brief		Przerwanie skryptu.
 		 *
 		 * Ustala zmienną odpowiedzialną za zakończenie skryptu przy następnej iteracji. Metode należy wywołać za pośrednictwem innego wątku lub w kodzie przerwanai watchdoga.
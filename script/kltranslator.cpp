@@ -0,0 +1,647 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Script Translator for KLLibs                               *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "kltranslator.hpp"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+
+#define FAIL(error)		"{ Error = KLScript::" error "; return false; }\n"
+
+KLTranslator::KLTranslator(KLScript& Engine)
+: Script(Engine) {}
+
+void KLTranslator::Classify(const KLProgram& Program, int Begin, int End, NAME* Names) const
+{
+	const auto Touch = [Names] (int Symbol, KIND Kind) -> void
+	{
+		if (!Names[Symbol].Variable)
+		{
+			Names[Symbol].Kind = Kind;
+			Names[Symbol].Variable = true;
+		}
+		else if (Kind != GLOBAL && Names[Symbol].Kind == GLOBAL) Names[Symbol].Kind = MIXED;
+	};
+
+	const auto Use = [&Program, &Touch, Names] (int Expression) -> void
+	{
+		const KLProgram::EXPRESSION& Code = Program.Expressions[Expression];
+
+		for (int i = 0; i < Code.Count; ++i)
+		{
+			const KLParser::KLParserToken& Token = Program.Tokens[Code.First + i];
+
+			if (Token.Class == KLParser::KLParserToken::CLASS::VARIABLE)
+			{
+				Touch(Token.GetIndex(), GLOBAL); Names[Token.GetIndex()].Read = true;
+			}
+		}
+	};
+
+	int Depth = 0;
+
+	for (int i = 0; i < int(Program.Header->Symbols.Count); ++i) Names[i] = { GLOBAL, false, false, false };
+
+	for (int Index = Begin; Index < End; ++Index)
+	{
+		const KLProgram::STATEMENT& Statement = Program.Statements[Index];
+
+		switch (KLScript::OPERATION(Statement.Operation))
+		{
+			case KLScript::SET:
+				Touch(Statement.Name, GLOBAL); Use(Statement.First);
+			break;
+
+			case KLScript::CALL:
+			case KLScript::GOTO:
+				if (Statement.Operation == KLScript::CALL) Names[Statement.Name].Binding = true;
+
+				for (int i = 0; i < Statement.Count; ++i) Use(Statement.First + i);
+			break;
+
+			case KLScript::VAR:
+			case KLScript::EXP:
+			case KLScript::POP:
+				for (int i = 0; i < Statement.Count; ++i)
+				{
+					const int Symbol = Program.Names[Statement.First + i];
+
+					if (Statement.Operation == KLScript::EXP)
+					{
+						Names[Symbol].Kind = MIXED;
+						Names[Symbol].Variable = true;
+						Names[Symbol].Read = true;
+					}
+					else Touch(Symbol, Depth ? MIXED : LOCAL);
+				}
+			break;
+
+			case KLScript::T_IF:
+			case KLScript::T_WHILE:
+				Use(Statement.First); ++Depth;
+			break;
+
+			case KLScript::T_ENDIF:
+			case KLScript::T_DONE:
+				--Depth;
+			break;
+
+			case KLScript::T_DEF:
+				Index = Statement.Jump - 1;
+			break;
+
+			case KLScript::T_RETURN:
+				Use(Statement.First);
+			break;
+
+			default: break;
+		}
+	}
+}
+
+bool KLTranslator::Expression(const KLProgram& Program, int Expression, const NAME* Names, KLStringBuilder& Output, KLString& Value) const
+{
+	using TOKEN = KLParser::KLParserToken;
+
+	const auto Unary = [] (const char* Head, const KLString& A, const char* Tail) -> KLString
+	{
+		return KLString(Head) + A + Tail;
+	};
+
+	const auto Binary = [] (const char* Head, const KLString& A, const char* Middle, const KLString& B, const char* Tail) -> KLString
+	{
+		return KLString(Head) + A + Middle + B + Tail;
+	};
+
+	const KLProgram::EXPRESSION& Code = Program.Expressions[Expression];
+
+	KLList<KLString> Values;
+	KLList<int> Checked;
+	KLString Check;
+
+	bool Returns = false;
+	int Depth = 0;
+
+	for (int i = 0; i < Code.Count; ++i)
+	{
+		const TOKEN& Token = Program.Tokens[Code.First + i];
+
+		switch (Token.Class)
+		{
+			case TOKEN::CLASS::JUMP: continue;
+
+			case TOKEN::CLASS::VALUE:
+			{
+				const KLParser::KLSNUMBER Number = Token.GetValue();
+				char Buffer[64];
+#if defined(USING_FIXED_POINT)
+				snprintf(Buffer, sizeof(Buffer), "KLSNUMBER::FromRaw(%lldLL)", (long long) Number.ToRaw());
+#else
+				if (isnan(Number)) snprintf(Buffer, sizeof(Buffer), "KLSNUMBER(NAN)");
+				else if (isinf(Number)) snprintf(Buffer, sizeof(Buffer), "KLSNUMBER(%sINFINITY)", Number < 0 ? "-" : "");
+				else snprintf(Buffer, sizeof(Buffer), "KLSNUMBER(%.17g)", Number);
+#endif
+				Values.Insert(Buffer);
+			}
+			break;
+
+			case TOKEN::CLASS::VARIABLE:
+			{
+				const int Symbol = Token.GetIndex();
+				const KLString ID(Symbol);
+
+				bool Found = false;
+
+				for (const auto& Index: Checked) if (Index == Symbol) Found = true;
+
+				if (!Found && Names[Symbol].Kind != LOCAL)
+				{
+					if (Check.Size()) Check += " && ";
+
+					if (Names[Symbol].Kind == MIXED) Check += KLString("(d") + ID + " || ";
+					Check += KLString("Find(Context.Variables, g") + ID + ", S[" + ID + "])";
+					if (Names[Symbol].Kind == MIXED) Check += ")";
+
+					Checked.Insert(Symbol);
+				}
+
+				switch (Names[Symbol].Kind)
+				{
+					case LOCAL:	Values.Insert(KLString("KLSNUMBER(l") + ID + ")"); break;
+					case GLOBAL:	Values.Insert(KLString("KLSNUMBER(g") + ID + "->ToNumber())"); break;
+					case MIXED:	Values.Insert(KLString("KLSNUMBER(d") + ID + " ? l" + ID + " : g" + ID + "->ToNumber())"); break;
+				}
+			}
+			break;
+
+			case TOKEN::CLASS::RETURN:
+				Values.Insert("KLSNUMBER(Return)"); Returns = true;
+			break;
+
+			case TOKEN::CLASS::OPERATOR:
+			{
+				const KLString B = Values.Pop();
+				const KLString A = Values.Pop();
+
+				switch (Token.GetOperator())
+				{
+					case TOKEN::OPERATOR::ROUND:	Values.Insert(Binary("KLParser::Round(", A, ", int(", B, "))")); break;
+					case TOKEN::OPERATOR::ADD:	Values.Insert(Binary("(", A, " + ", B, ")")); break;
+					case TOKEN::OPERATOR::SUB:	Values.Insert(Binary("(", A, " - ", B, ")")); break;
+					case TOKEN::OPERATOR::MUL:	Values.Insert(Binary("(", A, " * ", B, ")")); break;
+					case TOKEN::OPERATOR::DIV:	Values.Insert(Binary("(", A, " / ", B, ")")); break;
+					case TOKEN::OPERATOR::MOD:	Values.Insert(Binary("KLSNUMBER(int(", A, ") % int(", B, "))")); break;
+					case TOKEN::OPERATOR::POW:	Values.Insert(Binary("pow(", A, ", ", B, ")")); break;
+
+					case TOKEN::OPERATOR::EQ:	Values.Insert(Binary("KLSNUMBER(", A, " == ", B, ")")); break;
+					case TOKEN::OPERATOR::NEQ:	Values.Insert(Binary("KLSNUMBER(", A, " != ", B, ")")); break;
+					case TOKEN::OPERATOR::GT:	Values.Insert(Binary("KLSNUMBER(", A, " > ", B, ")")); break;
+					case TOKEN::OPERATOR::LT:	Values.Insert(Binary("KLSNUMBER(", A, " < ", B, ")")); break;
+					case TOKEN::OPERATOR::GE:	Values.Insert(Binary("KLSNUMBER(", A, " >= ", B, ")")); break;
+					case TOKEN::OPERATOR::LE:	Values.Insert(Binary("KLSNUMBER(", A, " <= ", B, ")")); break;
+
+					case TOKEN::OPERATOR::AND:	Values.Insert(Binary("KLSNUMBER(", A, " && ", B, ")")); break;
+					case TOKEN::OPERATOR::OR:	Values.Insert(Binary("KLSNUMBER(", A, " || ", B, ")")); break;
+
+					case TOKEN::OPERATOR::FAND:	Values.Insert(Binary("KLParser::Minimum(", A, ", ", B, ")")); break;
+					case TOKEN::OPERATOR::FOR:	Values.Insert(Binary("KLParser::Maximum(", A, ", ", B, ")")); break;
+
+					default: break;
+				}
+			}
+			break;
+
+			case TOKEN::CLASS::FUNCTION:
+			{
+				const KLString A = Values.Pop();
+
+				switch (Token.GetFunction())
+				{
+					case TOKEN::FUNCTION::SIN:	Values.Insert(Unary("sin(", A, ")")); break;
+					case TOKEN::FUNCTION::COS:	Values.Insert(Unary("cos(", A, ")")); break;
+					case TOKEN::FUNCTION::TAN:	Values.Insert(Unary("tan(", A, ")")); break;
+
+					case TOKEN::FUNCTION::ABS:	Values.Insert(Unary("fabs(", A, ")")); break;
+
+					case TOKEN::FUNCTION::EXP:	Values.Insert(Unary("exp(", A, ")")); break;
+					case TOKEN::FUNCTION::SQRT:	Values.Insert(Unary("sqrt(", A, ")")); break;
+					case TOKEN::FUNCTION::LOG:	Values.Insert(Unary("log10(", A, ")")); break;
+					case TOKEN::FUNCTION::LN:	Values.Insert(Unary("log(", A, ")")); break;
+
+					case TOKEN::FUNCTION::NOT:	Values.Insert(Unary("KLSNUMBER(!", A, ")")); break;
+
+					case TOKEN::FUNCTION::MINUS:	Values.Insert(Unary("(-", A, ")")); break;
+
+					default: break;
+				}
+			}
+			break;
+		}
+
+		if (Values.Size() > Depth) Depth = Values.Size();
+	}
+
+	if (Check.Size()) Output.Append("\t\tif (!(").Append(Check).Append(")) " FAIL("WRONG_EVALUATION"));
+
+#if defined(USING_STATIC_CONTAINERS)
+	if (Depth > KLPARSER_STACK) Output.Append("\t\t" FAIL("WRONG_EVALUATION"));
+#endif
+
+	Value = KLString("double(") + Values.Pop() + ")";
+
+	return Returns;
+}
+
+void KLTranslator::Body(const KLProgram& Program, int Begin, int End, const KLString& Name, const KLString& Prefix, KLStringBuilder& Output) const
+{
+	const int Count = Program.Header->Symbols.Count;
+
+	NAME* Names = new NAME[Count + 1];
+	bool* Targets = new bool[End - Begin + 1]();
+
+	KLStringBuilder Code;
+
+	bool Returns = false;
+	bool Pops = false;
+	bool Symbols = false;
+	bool Jumps = false;
+
+	Classify(Program, Begin, End, Names);
+
+	for (int Index = Begin; Index < End; ++Index)
+	{
+		const KLProgram::STATEMENT& Statement = Program.Statements[Index];
+
+		switch (KLScript::OPERATION(Statement.Operation))
+		{
+			case KLScript::T_IF:
+			case KLScript::T_WHILE:
+			case KLScript::T_ELSE:
+			case KLScript::T_DONE:
+				if (Statement.Jump != -1) Targets[Statement.Jump - Begin] = true;
+			break;
+
+			case KLScript::T_DEF:
+				Index = Statement.Jump - 1;
+			break;
+
+			default: break;
+		}
+	}
+
+	for (int Index = Begin; Index < End; ++Index)
+	{
+		const KLProgram::STATEMENT& Statement = Program.Statements[Index];
+		const KLString ID(Statement.Name);
+		KLString Value;
+
+		if (Targets[Index - Begin]) Code.Append("\nL").Append(Index).Append(":\n");
+		else Code.Append('\n');
+
+		Code.Append("\tif (Context.IsTerminated()) " FAIL("SCRIPT_TERMINATED"));
+
+		switch (KLScript::OPERATION(Statement.Operation))
+		{
+			case KLScript::SET:
+			{
+				const NAME& Var = Names[Statement.Name];
+
+				Code.Append("\t{\n");
+
+				const int Mark = Code.Size();
+
+				if (Var.Kind == GLOBAL) Code.Append("\t\tif (!Find(Context.Variables, g").Append(ID).Append(", S[").Append(ID).Append("])) " FAIL("UNDEFINED_VARIABLE"));
+				if (Var.Kind == MIXED) Code.Append("\t\tif (!d").Append(ID).Append(" && !Find(Context.Variables, g").Append(ID).Append(", S[").Append(ID).Append("])) " FAIL("UNDEFINED_VARIABLE"));
+
+				const bool Uses = Expression(Program, Statement.First, Names, Code, Value);
+
+				if (Var.Kind != LOCAL || Var.Read)
+				{
+					if (Code.Size() != Mark) Code.Append('\n');
+
+					Code.Append("\t\tconst double Value = ").Append(Value).Append(";\n\n");
+
+					Returns = Returns || Uses;
+				}
+
+				switch (Var.Kind)
+				{
+					case LOCAL:
+						if (Var.Read) Code.Append("\t\tl").Append(ID).Append(" = Value;\n");
+					break;
+					case GLOBAL:
+						Code.Append("\t\tif (g").Append(ID).Append("->IsReadonly()) " FAIL("VARIABLE_READONLY"));
+						Code.Append("\t\telse *g").Append(ID).Append(" = Value;\n");
+					break;
+					case MIXED:
+						if (Var.Read)
+						{
+							Code.Append("\t\tif (d").Append(ID).Append(") l").Append(ID).Append(" = Value;\n");
+							Code.Append("\t\telse if (g").Append(ID).Append("->IsReadonly()) " FAIL("VARIABLE_READONLY"));
+							Code.Append("\t\telse *g").Append(ID).Append(" = Value;\n");
+						}
+						else
+						{
+							Code.Append("\t\tif (!d").Append(ID).Append(" && g").Append(ID).Append("->IsReadonly()) " FAIL("VARIABLE_READONLY"));
+							Code.Append("\t\telse if (!d").Append(ID).Append(") *g").Append(ID).Append(" = Value;\n");
+						}
+					break;
+				}
+
+				Code.Append("\t}\n");
+
+				Symbols = Symbols || Var.Kind != LOCAL;
+			}
+			break;
+
+			case KLScript::CALL:
+			case KLScript::GOTO:
+			{
+				const bool Call = Statement.Operation == KLScript::CALL;
+
+				Code.Append("\t{\n\t\tKLBindings::KLSSTACK Stack;\n\n");
+
+				if (Call)
+				{
+					Code.Append("\t\tif (!b").Append(ID).Append(")\n\t\t{\n");
+					Code.Append("\t\t\tif (!Context.Bindings.Exists(S[").Append(ID).Append("])) " FAIL("UNDEFINED_FUNCTION"));
+					Code.Append("\t\t\telse b").Append(ID).Append(" = &Context.Bindings[S[").Append(ID).Append("]];\n\t\t}\n");
+				}
+				else Code.Append("\t\tif (!Context.Exists(S[").Append(ID).Append("])) " FAIL("UNDEFINED_FUNCTION"));
+
+				for (int i = 0; i < Statement.Count; ++i)
+				{
+					if (Expression(Program, Statement.First + i, Names, Code, Value)) Returns = true;
+
+					Code.Append("\t\tif (Stack.Insert(").Append(Value).Append(") == -1) " FAIL("OUT_OF_CAPACITY"));
+				}
+
+				if (Call) Code.Append("\n\t\tif (Error == KLScript::NO_ERROR) Return = (*b").Append(ID).Append(")(Stack);\n");
+				else Code.Append("\n\t\tif (Error != KLScript::NO_ERROR) return false;\n\n\t\tContext.Goto(S[").Append(ID).Append("], Stack);\n");
+
+				Code.Append("\t}\n");
+
+				Returns = Returns || Call;
+				Symbols = true;
+			}
+			break;
+
+			case KLScript::VAR:
+			case KLScript::EXP:
+			case KLScript::POP:
+			{
+				KLStringBuilder Block;
+
+				for (int i = 0; i < Statement.Count; ++i)
+				{
+					const int Symbol = Program.Names[Statement.First + i];
+					const KLString Var(Symbol);
+
+					if (Statement.Operation == KLScript::EXP)
+					{
+						Block.Append("\t\tif (!Find(Context.Variables, g").Append(Var).Append(", S[").Append(Var).Append("]))\n\t\t{\n");
+						Block.Append("\t\t\tif (d").Append(Var).Append(" && !Context.Variables.Add(S[").Append(Var).Append("], KLVariables::KLVariable(l").Append(Var).Append("))) " FAIL("OUT_OF_CAPACITY"));
+						Block.Append("\t\t\tif (!d").Append(Var).Append(" && !Context.Variables.Add(S[").Append(Var).Append("])) " FAIL("OUT_OF_CAPACITY"));
+						Block.Append("\n\t\t\td").Append(Var).Append(" = false;\n\t\t}\n");
+
+						Symbols = true;
+					}
+					else if (Names[Symbol].Kind == MIXED && Names[Symbol].Read)
+					{
+						Block.Append("\t\tif (!d").Append(Var).Append(") { d").Append(Var).Append(" = true; l").Append(Var).Append(" = 0; }\n");
+					}
+					else if (Names[Symbol].Kind == MIXED) Block.Append("\t\td").Append(Var).Append(" = true;\n");
+
+					if (Statement.Operation == KLScript::POP)
+					{
+						if (Names[Symbol].Read) Block.Append("\t\tif (Params) l").Append(Var).Append(" = Params->Dequeue();\n");
+						else Block.Append("\t\tif (Params) Params->Dequeue();\n");
+
+						Pops = true;
+					}
+				}
+
+				if (Block.Size()) Code.Append("\t{\n").Append(Block.Release()).Append("\t}\n");
+			}
+			break;
+
+			case KLScript::T_IF:
+			case KLScript::T_WHILE:
+			{
+				const bool Push = Statement.Operation == KLScript::T_WHILE ||
+							   Program.Statements[Statement.Jump - 1].Operation == KLScript::T_ELSE;
+
+				Code.Append("\t{\n");
+
+				if (Expression(Program, Statement.First, Names, Code, Value)) Returns = true;
+
+				Code.Append("\t\tif (!").Append(Value).Append(") goto L").Append(Statement.Jump).Append(";\n");
+
+#if defined(USING_STATIC_CONTAINERS)
+				if (Push) Code.Append("\t\telse if (Jumps == KLSCRIPT_JUMPS) " FAIL("OUT_OF_CAPACITY")).Append("\t\telse ++Jumps;\n");
+
+				Jumps = Jumps || Push;
+#else
+				(void) Push;
+#endif
+
+				Code.Append("\t}\n");
+			}
+			break;
+
+			case KLScript::T_ELSE:
+			case KLScript::T_DONE:
+				if (Statement.Jump != -1)
+				{
+#if defined(USING_STATIC_CONTAINERS)
+					Code.Append("\t--Jumps;\n");
+#endif
+					Code.Append("\tgoto L").Append(Statement.Jump).Append(";\n");
+				}
+			break;
+
+			case KLScript::T_DEF:
+			{
+				const KLProgram::FUNCTION& Function = Program.Functions[Statement.First];
+
+				Code.Append("\tif (!Context.Define(S[").Append(ID).Append("], \"");
+
+				for (int i = 0; i < Function.Length; ++i)
+				{
+					const unsigned char Char = Program.Text[Function.Offset + i];
+
+					if (Char == '\n') Code.Append("\\n\"\n\t\t\"");
+					else if (Char == '\\' || Char == '"' || Char == '?') Code.Append('\\').Append(char(Char));
+					else if (Char >= 32 && Char < 127) Code.Append(char(Char));
+					else
+					{
+						char Buffer[8];
+
+						snprintf(Buffer, sizeof(Buffer), "\\%03o", Char);
+
+						Code.Append(Buffer);
+					}
+				}
+
+				Code.Append("\", ").Append(bool(Function.Pure)).Append(", ").Append(Prefix).Append('_').Append(Statement.First).Append(")) return false;\n");
+
+				Index = Statement.Jump - 1;
+				Symbols = true;
+			}
+			break;
+
+			case KLScript::T_RETURN:
+				Code.Append("\t{\n");
+
+				Expression(Program, Statement.First, Names, Code, Value);
+
+				Code.Append("\t\tReturn = ").Append(Value).Append(";\n\n\t\treturn true;\n\t}\n");
+
+				Returns = true;
+			break;
+
+			case KLScript::EXIT:
+				Code.Append("\treturn Error == KLScript::NO_ERROR;\n");
+			break;
+
+			default: break;
+		}
+	}
+
+	if (Targets[End - Begin]) Code.Append("\nL").Append(End).Append(":");
+
+	Code.Append("\n\treturn Error == KLScript::NO_ERROR;\n}\n");
+
+	for (int i = 0; i < Count; ++i) if (Names[i].Variable && Names[i].Kind != LOCAL) Symbols = true;
+
+	Output.Append("\nbool ").Append(Name).Append("(KLScript::KLScriptContext& Context, KLBindings::KLSSTACK* Params)\n{\n");
+
+	if (Symbols) Output.Append("\tconst KLSymbol* S = ").Append(Prefix).Append("_Symbols();\n\n");
+
+	Output.Append("\tKLScript::ERROR& Error = Context.Error;\n");
+
+	if (Returns) Output.Append("\tdouble& Return = Context.Return;\n");
+
+	Output.Append('\n');
+
+	for (int i = 0; i < Count; ++i)
+	{
+		const KLString ID(i);
+
+		if (Names[i].Read && Names[i].Kind != GLOBAL) Output.Append("\tdouble l").Append(ID).Append(" = 0;\t// ").Append(Program.Symbols[i].Name()).Append('\n');
+		if (Names[i].Variable && Names[i].Kind == MIXED) Output.Append("\tbool d").Append(ID).Append(" = false;\n");
+		if (Names[i].Variable && Names[i].Kind != LOCAL) Output.Append("\tKLVariables::KLVariable* g").Append(ID).Append(" = nullptr;\t// ").Append(Program.Symbols[i].Name()).Append('\n');
+		if (Names[i].Binding) Output.Append("\tKLBindings::KLBinding* b").Append(ID).Append(" = nullptr;\t// ").Append(Program.Symbols[i].Name()).Append('\n');
+	}
+
+	if (Jumps) Output.Append("\tint Jumps = 0;\n");
+
+	Output.Append("\n\tContext.Enter();\n");
+
+	if (!Pops) Output.Append("\n\t(void) Params;\n");
+
+	Output.Append(Code.Release());
+
+	delete [] Names;
+	delete [] Targets;
+}
+
+KLString KLTranslator::Translate(const KLString& Code, const KLString& Name)
+{
+	KLProgram Program;
+	KLStringBuilder Output(Code.Size() * 8);
+
+	bool Valid = Name.Size() && !isdigit(Name[0]);
+
+	for (int i = 0; i < Name.Size(); ++i) if (!isalnum(Name[i]) && Name[i] != '_') Valid = false;
+
+	if (!Valid)
+	{
+		Script.LastError = KLScript::WRONG_PARAMETERS;
+		Script.LastProcess = 0;
+
+		return KLString();
+	}
+
+	if (!Script.Compile(Code, Program)) return KLString();
+
+	Output.Append("/* Kod wygenerowany przez KLTranslator. Nie należy go modyfikować ręcznie. */\n\n");
+	Output.Append("#include \"KLLibs.hpp\"\n\n");
+
+#if defined(USING_FIXED_POINT)
+	Output.Append("#if !defined(USING_FIXED_POINT)");
+#else
+	Output.Append("#if defined(USING_FIXED_POINT)");
+#endif
+
+#if defined(USING_STATIC_CONTAINERS)
+	Output.Append(" || !defined(USING_STATIC_CONTAINERS)\n");
+#else
+	Output.Append(" || defined(USING_STATIC_CONTAINERS)\n");
+#endif
+
+	Output.Append("#error \"Kod wygenerowano dla innego trybu biblioteki\"\n#endif\n\n");
+
+	Output.Append("namespace\n{\n\nusing KLSNUMBER = KLParser::KLSNUMBER;\n\n");
+
+	Output.Append("inline const KLSymbol* ").Append(Name).Append("_Symbols(void)\n{\n\tstatic const KLSymbol Table[] =\n\t{\n\t\t");
+
+	for (unsigned i = 0; i < Program.Header->Symbols.Count; ++i)
+	{
+		Output.Append('"').Append(Program.Symbols[i].Name()).Append("\", ");
+	}
+
+	Output.Append("KLSymbol()\n\t};\n\n\treturn Table;\n}\n\n");
+
+	Output.Append("inline KLVariables::KLVariable* Find(KLVariables& Variables, KLVariables::KLVariable*& Cache, const KLSymbol& Name)\n{\n");
+	Output.Append("\tif (!Cache && Variables.Exists(Name)) Cache = &Variables[Name];\n\n\treturn Cache;\n}\n\n");
+
+	for (unsigned i = 0; i < Program.Header->Functions.Count; ++i)
+	{
+		Output.Append("bool ").Append(Name).Append('_').Append(int(i)).Append("(KLScript::KLScriptContext& Context, KLBindings::KLSSTACK* Params);\n");
+	}
+
+	for (unsigned i = 0; i < Program.Header->Functions.Count; ++i)
+	{
+		const KLProgram::FUNCTION& Function = Program.Functions[i];
+
+		Output.Append("\n// define ").Append(Program.Symbols[Function.Name].Name()).Append('\n');
+
+		Body(Program, Function.Begin, Function.End, Name + "_" + KLString(int(i)), Name, Output);
+	}
+
+	Output.Append("\n}\n");
+
+	Body(Program, 0, Program.Header->Statements.Count, Name, Name, Output);
+
+	return Output.Release();
+}
+
+KLScript::ERROR KLTranslator::GetError(void) const
+{
+	return Script.GetError();
+}
+
+int KLTranslator::GetLine(const KLString& Code) const
+{
+	return Script.GetLine(Code);
+}
@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Script Translator for KLLibs                               *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef KLTRANSLATOR_HPP
+#define KLTRANSLATOR_HPP
+
+#include "../libbuild.hpp"
+
+#include "../containers/klstring.hpp"
+#include "../containers/klstringbuilder.hpp"
+
+#include "klscript.hpp"
+#include "klprogram.hpp"
+
+/*! \file		kltranslator.hpp
+ *  \brief	Deklaracje dla klasy KLTranslator i jej składników.
+ *
+ */
+
+/*! \file		kltranslator.cpp
+ *  \brief	Implementacja klasy KLTranslator i jej składników.
+ *
+ */
+
+/*! \brief	Tłumaczenie skryptów na kod C++.
+ *
+ * Zamienia sprawdzony skrypt i zdefiniowane w nim funkcje na samodzielny plik źródłowy C++ z funkcją natywną (`KLScript::KLSNATIVE`), którą wykonuje się metodą `KLScript::Evaluate(KLSNATIVE, KLBindings::KLSSTACK*)` z tymi samymi wynikami i błędami co skompilowany program (`KLScript::Evaluate(const KLProgram&, KLBindings::KLSSTACK*)`).
+ *
+ * Zmienne, które przez cały czas wykonania funkcji są lokalne, stają się zmiennymi C++. Pozostałe zmienne odczytywane są przez wskaźnik do obiektu `KLVariables::KLVariable`, wyszukiwany raz przy pierwszym użyciu, a wywołania `call` trafiają bezpośrednio do zapamiętanego obiektu `KLBindings::KLBinding`. Wywołania `goto` korzystają z pamięci podręcznej funkcji czystych, a funkcje zdefiniowane przez przetłumaczony kod wykonywane są w postaci natywnej.
+ *
+ * Ograniczenia:
+ * - skrypt jest sprawdzany w zakresie zmiennych i bindów interpretera podanego w konstruktorze, więc muszą one odpowiadać tym, z którymi kod będzie wykonywany;
+ * - w trakcie wykonania nie wolno usuwać zmiennych ani bindów interpretera;
+ * - kod należy skompilować w tym samym trybie biblioteki (`USING_STATIC_CONTAINERS`, `USING_FIXED_POINT`), w którym został wygenerowany;
+ * - liczba zmiennych lokalnych nie jest ograniczona pojemnością `KLVARIABLES_SIZE`;
+ * - wyniki zmiennoprzecinkowe są identyczne z interpreterem gdy kompilator nie łączy operacji (np. `-ffp-contract=off`).
+ *
+ */
+class KLLIBS_EXPORT KLTranslator
+{
+
+	/*! \brief		Rodzaj zmiennej.
+	 *
+	 * Określa sposób przechowywania zmiennej w wygenerowanej funkcji.
+	 *
+	 */
+	protected: enum KIND
+	{
+		GLOBAL,	//!< Zmienna interpretera.
+		LOCAL,	//!< Zmienna lokalna przez cały czas wykonania funkcji.
+		MIXED		//!< Zmienna, która w zależności od przebiegu funkcji jest lokalna lub należy do interpretera.
+	};
+
+	/*! \brief		Opis symbolu.
+	 *
+	 * Opisuje użycie symbolu programu w treści tłumaczonej funkcji.
+	 *
+	 */
+	protected: struct NAME
+	{
+		KIND Kind;		//!< Rodzaj zmiennej.
+		bool Variable;		//!< Symbol jest używany jako zmienna.
+		bool Read;		//!< Wartość zmiennej jest odczytywana.
+		bool Binding;		//!< Symbol jest używany jako nazwa funkcji `call`.
+	};
+
+	protected:
+
+		/*! \brief		Analiza zmiennych.
+		 *  \param [in]	Program	Tłumaczony program.
+		 *  \param [in]	Begin	Numer pierwszej instrukcji.
+		 *  \param [in]	End		Numer instrukcji kończącej fragment.
+		 *  \param [out]	Names	Opisy symboli programu.
+		 *
+		 * Ustala rodzaj każdej zmiennej fragmentu. Zmienna jest lokalna gdy po raz pierwszy pojawia się w instrukcji `var` lub `pop` poza konstrukcjami `if` i `while` i nie jest eksportowana.
+		 *
+		 */
+		void Classify(const KLProgram& Program, int Begin, int End, NAME* Names) const;
+
+		/*! \brief		Tłumaczenie wyrażenia.
+		 *  \param [in]	Program	Tłumaczony program.
+		 *  \param [in]	Expression	Numer wyrażenia.
+		 *  \param [in]	Names	Opisy symboli programu.
+		 *  \param [out]	Output	Bufor wyjściowy.
+		 *  \param [out]	Value	Kod obliczający wartość wyrażenia.
+		 *  \return		`true` jeśli wyrażenie odczytuje wartość `$`.
+		 *
+		 * Zapisuje do bufora kod sprawdzający istnienie zmiennych wyrażenia, a kod obliczający wyrażenie zwraca w parametrze `Value`.
+		 *
+		 */
+		bool Expression(const KLProgram& Program, int Expression, const NAME* Names, KLStringBuilder& Output, KLString& Value) const;
+
+		/*! \brief		Tłumaczenie fragmentu programu.
+		 *  \param [in]	Program	Tłumaczony program.
+		 *  \param [in]	Begin	Numer pierwszej instrukcji.
+		 *  \param [in]	End		Numer instrukcji kończącej fragment.
+		 *  \param [in]	Name		Nazwa funkcji C++.
+		 *  \param [in]	Prefix	Przedrostek nazw pomocniczych.
+		 *  \param [out]	Output	Bufor wyjściowy.
+		 *
+		 * Zapisuje funkcję C++ wykonującą instrukcje fragmentu (treści skryptu lub funkcji `define`).
+		 *
+		 */
+		void Body(const KLProgram& Program, int Begin, int End, const KLString& Name, const KLString& Prefix, KLStringBuilder& Output) const;
+
+		KLScript& Script;		//!< Interpreter sprawdzający i kompilujący skrypt.
+
+	public:
+
+		/*! \brief		Domyślny konstruktor.
+		 *  \param [in]	Engine Interpreter, w którego zakresie sprawdzany jest skrypt.
+		 *
+		 * Tworzy obiekt korzystający ze zmiennych i bindów podanego interpretera.
+		 *
+		 */
+		KLTranslator(KLScript& Engine);
+
+		/*! \brief		Tłumaczenie skryptu.
+		 *  \param [in]	Code		Skrypt do przetłumaczenia.
+		 *  \param [in]	Name		Nazwa tworzonej funkcji C++.
+		 *  \return		Kod źródłowy C++ lub pusty łańcuch w przypadku błędu.
+		 *
+		 * Kompiluje skrypt (`KLScript::Compile()`) i zapisuje go jako plik źródłowy z funkcją `bool Name(KLScript::KLScriptContext&, KLBindings::KLSSTACK*)`. Gdy nazwa nie jest poprawnym identyfikatorem C++ ustawiany jest błąd `KLScript::WRONG_PARAMETERS`.
+		 *
+		 */
+		KLString Translate(const KLString& Code, const KLString& Name);
+
+		/*! \brief		Pobranie ostatniego błędu.
+		 *  \return		Ostatni błąd interpretera.
+		 *
+		 * Zwraca błąd, który przerwał ostatnie tłumaczenie.
+		 *
+		 */
+		KLScript::ERROR GetError(void) const;
+
+		/*! \brief		Obliczenie numeru linii ostatniego błędu.
+		 *  \param [in]	Code Ostatnio tłumaczony skrypt.
+		 *  \return		Numer linii ostatniego błędu.
+		 *
+		 * Oblicza i zwraca numer linii, w której wystąpił błąd przerywający tłumaczenie.
+		 *
+		 */
+		int GetLine(const KLString& Code) const;
+
+};
+
+#endif // KLTRANSLATOR_HPP
@@ -20,11 +20,17 @@
 
 #include "klvariables.hpp"
 
+#if defined(F_CPU)
+static uint64_t Stamps = 0;				//!< Ostatni nadany znacznik zmiany.
+#else
+static std::atomic<uint64_t> Stamps(0);	//!< Ostatni nadany znacznik zmiany.
+#endif
+
 KLVariables::KLVariable::KLVariable(const KLVariable& Object)
-: Pointer(Object.Pointer), Variable(Object.Variable), Readonly(Object.Readonly), Callback(Object.Callback), Type(Object.Type) {}
+: Owner(nullptr), Version(++Stamps), Pointer(Object.Pointer), Variable(Object.Variable), Readonly(Object.Readonly), Callback(Object.Callback), Type(Object.Type) {}
 
 KLVariables::KLVariable::KLVariable(TYPE VarType, void* Bind, KLSCALLBACK Handler, bool Writeable)
-: Pointer(Bind), Variable(0.0), Readonly(!Writeable), Callback(Handler), Type(VarType) {}
+: Owner(nullptr), Version(++Stamps), Pointer(Bind), Variable(0.0), Readonly(!Writeable), Callback(Handler), Type(VarType) {}
 
 KLVariables::KLVariable::KLVariable(bool Boolean, KLSCALLBACK Handler, bool Writeable)
 : KLVariable(BOOLEAN, nullptr, Handler, Writeable)
@@ -93,6 +99,11 @@ bool KLVariables::KLVariable::IsBinded(void) const
 	return Pointer;
 }
 
+uint64_t KLVariables::KLVariable::GetVersion(void) const
+{
+	return Version;
+}
+
 void KLVariables::KLVariable::SetCallback(KLSCALLBACK Handler)
 {
 	Callback = Handler;
@@ -141,53 +152,86 @@ KLVariables::KLVariable& KLVariables::KLVariable::operator= (const Data& Value)
 		break;
 	}
 
+	Version = ++Stamps;
+
+	if (KLVariables* Scoope = Owner) Scoope->Touch();
+
 	if (Callback) Callback(ToNumber());
 
 	return *this;
 }
 
+void KLVariables::Touch(void)
+{
+	Version = ++Stamps;
+}
+
+void KLVariables::Adopt(void)
+{
+	for (auto& Var: Variables) Var.Value.Owner = this;
+}
+
 KLVariables::KLVariables(KLVariables* Scoope)
-: Parent(Scoope) {}
+: Version(++Stamps), Parent(Scoope) {}
 
 KLVariables::KLVariables(const KLVariables& Objects)
-: Variables(Objects.Variables), Parent(Objects.Parent) {}
+: Variables(Objects.Variables), Version(++Stamps), Parent(Objects.Parent)
+{
+	Adopt();
+}
 
-bool KLVariables::Add(const KLString& Name, const KLVariable& Object)
+bool KLVariables::Add(const KLSymbol& Name, const KLVariable& Object)
 {
-	return Variables.Insert(Object, Name) != -1;
+	if (Variables.Insert(Object, Name) == -1) return false;
+
+	Variables[Name].Owner = this; Touch();
+
+	return true;
 }
 
-bool KLVariables::Add(const KLString& Name, TYPE Type, KLSCALLBACK Handler, bool Writeable)
+bool KLVariables::Add(const KLSymbol& Name, TYPE Type, KLSCALLBACK Handler, bool Writeable)
 {
-	return Variables.Insert(KLVariable(Type, nullptr, Handler, Writeable), Name) != -1;
+	return Add(Name, KLVariable(Type, nullptr, Handler, Writeable));
 }
 
-bool KLVariables::Add(const KLString& Name, bool& Boolean, KLSCALLBACK Handler, bool Writeable)
+bool KLVariables::Add(const KLSymbol& Name, bool& Boolean, KLSCALLBACK Handler, bool Writeable)
 {
-	return Variables.Insert(KLVariable(BOOLEAN, &Boolean, Handler, Writeable), Name) != -1;
+	return Add(Name, KLVariable(BOOLEAN, &Boolean, Handler, Writeable));
 }
 
-bool KLVariables::Add(const KLString& Name, double& Number, KLSCALLBACK Handler, bool Writeable)
+bool KLVariables::Add(const KLSymbol& Name, double& Number, KLSCALLBACK Handler, bool Writeable)
 {
-	return Variables.Insert(KLVariable(NUMBER, &Number, Handler, Writeable), Name) != -1;
+	return Add(Name, KLVariable(NUMBER, &Number, Handler, Writeable));
 }
 
-bool KLVariables::Add(const KLString& Name, int& Integer, KLSCALLBACK Handler, bool Writeable)
+bool KLVariables::Add(const KLSymbol& Name, int& Integer, KLSCALLBACK Handler, bool Writeable)
 {
-	return Variables.Insert(KLVariable(INTEGER, &Integer, Handler, Writeable), Name) != -1;
+	return Add(Name, KLVariable(INTEGER, &Integer, Handler, Writeable));
 }
 
-bool KLVariables::Delete(const KLString& Name)
+bool KLVariables::Delete(const KLSymbol& Name)
 {
-	return Variables.Delete(Name) != -1;
+	if (Variables.Delete(Name) == -1) return false;
+
+#if defined(USING_STATIC_CONTAINERS)
+	Adopt();
+#endif
+
+	Touch();
+
+	return true;
 }
 
-bool KLVariables::Rename(const KLString& OldName, const KLString& NewName)
+bool KLVariables::Rename(const KLSymbol& OldName, const KLSymbol& NewName)
 {
-	return Variables.Update(OldName, NewName);
+	if (!Variables.Update(OldName, NewName)) return false;
+
+	Variables[NewName].Owner = this; Touch();
+
+	return true;
 }
 
-bool KLVariables::Exists(const KLString& Name, bool Recursive) const
+bool KLVariables::Exists(const KLSymbol& Name, bool Recursive) const
 {
 	if (Parent && Recursive)
 		return Variables.Exists(Name) || Parent->Exists(Name);
@@ -195,6 +239,19 @@ bool KLVariables::Exists(const KLString& Name, bool Recursive) const
 		return Variables.Exists(Name);
 }
 
+uint64_t KLVariables::GetVersion(void) const
+{
+	const uint64_t Current = Version;
+
+	if (Parent)
+	{
+		const uint64_t Inherited = Parent->GetVersion();
+
+		return Inherited > Current ? Inherited : Current;
+	}
+	else return Current;
+}
+
 int KLVariables::Size(void) const
 {
 	return Variables.Size();
@@ -202,10 +259,17 @@ int KLVariables::Size(void) const
 
 void KLVariables::Clean(void)
 {
-	Variables.Clean();
+	Variables.Clean(); Touch();
+}
+
+void KLVariables::Reclaim(void)
+{
+#if defined(USING_CONCURRENT) && !defined(USING_STATIC_CONTAINERS)
+	Variables.Reclaim();
+#endif
 }
 
-KLVariables::KLVariable& KLVariables::operator[] (const KLString& Name)
+KLVariables::KLVariable& KLVariables::operator[] (const KLSymbol& Name)
 {
 	if (!Variables.Exists(Name))
 		return (*Parent)[Name];
@@ -213,7 +277,7 @@ KLVariables::KLVariable& KLVariables::operator[] (const KLString& Name)
 		return Variables[Name];
 }
 
-const KLVariables::KLVariable& KLVariables::operator[] (const KLString& Name) const
+const KLVariables::KLVariable& KLVariables::operator[] (const KLSymbol& Name) const
 {
 	if (!Variables.Exists(Name))
 		return (*Parent)[Name];
@@ -232,22 +296,22 @@ KLVariables& KLVariables::operator = (const KLVariables& Objects)
 	return *this;
 }
 
-KLMap<KLVariables::KLVariable, KLString>::KLMapVarIterator KLVariables::begin(void)
+KLVariables::KLSVARITERATOR KLVariables::begin(void)
 {
 	return Variables.begin();
 }
 
-KLMap<KLVariables::KLVariable, KLString>::KLMapVarIterator KLVariables::end(void)
+KLVariables::KLSVARITERATOR KLVariables::end(void)
 {
 	return Variables.end();
 }
 
-KLMap<KLVariables::KLVariable, KLString>::KLMapConstIterator KLVariables::begin(void) const
+KLVariables::KLSCONSTITERATOR KLVariables::begin(void) const
 {
 	return Variables.begin();
 }
 
-KLMap<KLVariables::KLVariable, KLString>::KLMapConstIterator KLVariables::end(void) const
+KLVariables::KLSCONSTITERATOR KLVariables::end(void) const
 {
 	return Variables.end();
 }
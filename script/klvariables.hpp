@@ -25,12 +25,29 @@
 
 #include "../containers/klmap.hpp"
 #include "../containers/klstring.hpp"
+#include "../containers/klsymbol.hpp"
+
+#if defined(USING_STATIC_CONTAINERS)
+#include "../containers/klstaticmap.hpp"
+#elif defined(USING_CONCURRENT)
+#include "../containers/klconcurrentmap.hpp"
+#endif
+
+#if defined(USING_STATIC_CONTAINERS) && !defined(KLVARIABLES_SIZE)
+#define KLVARIABLES_SIZE 16	//!< Maksymalna liczba zmiennych w jednym zakresie (tryb `USING_STATIC_CONTAINERS`).
+#endif
 
 #if defined(USING_BOOST)
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
 #endif
 
+#if !defined(F_CPU)
+#include <atomic>
+#endif
+
+#include <stdint.h>
+
 /*! \file		klvariables.hpp
  *  \brief	Deklaracje dla klasy KLVariables i jej składników.
  *
@@ -49,6 +66,10 @@
  *
  * Organizacja obsługuje możliwość iteracji po zakresie jedynie po bierzącym poziomie, zgodnie z `KLMap`.
  *
+ * Nazwy zmiennych są przechowywane jako symbole `KLSymbol`, więc wyszukiwanie zmiennej porównuje jedynie numery symboli. Metody przyjmujące nazwę akceptują także `KLString` i `const char*`.
+ *
+ * Przy zdefiniowanym makrze `USING_CONCURRENT` zmienne przechowywane są w `KLConcurrentMap`, dzięki czemu jeden system zmiennych może być współdzielony przez wiele wątków wykonujących skrypty. Wyszukiwanie zmiennych nie wymaga wtedy blokad, natomiast równoczesny zapis tej samej zmiennej z wielu wątków wymaga synchronizacji po stronie użytkownika.
+ *
  */
 class KLLIBS_EXPORT KLVariables
 {
@@ -71,6 +92,14 @@ class KLLIBS_EXPORT KLVariables
 		INTEGER	//!< Typ całkowity.
 	};
 
+#if defined(F_CPU)
+	protected: using KLSVERSION = uint64_t;
+	protected: using KLSOWNER = KLVariables*;
+#else
+	protected: using KLSVERSION = std::atomic<uint64_t>;
+	protected: using KLSOWNER = std::atomic<KLVariables*>;
+#endif
+
 	/*! \brief		Reprezentacja pojedynczej zmiennej.
 	 *
 	 * Definiuje typ zmiennej przechowywanej w organizacji.
@@ -79,8 +108,14 @@ class KLLIBS_EXPORT KLVariables
 	public: class KLLIBS_EXPORT KLVariable
 	{
 
+		friend class KLVariables;
+
 		protected:
 
+			KLSOWNER Owner;		//!< Zbiór, do którego należy zmienna (`nullptr` dla zmiennej spoza zbioru).
+
+			KLSVERSION Version;		//!< Znacznik ostatniej zmiany zmiennej.
+
 			void* const Pointer;	//!< Adres bindu.
 
 			double Variable;		//!< Przechowywane dane.
@@ -96,7 +131,7 @@ class KLLIBS_EXPORT KLVariables
 			/*! \brief		Konstruktor kopiujący.
 			 *  \param [in]	Object Obiekt do sklonowania.
 			 *
-			 * Kopiuje dane zmiennej i tworzy nową na jej wzór. Gdy zmienna jest bindem konstruktor ten klonuje bind.
+			 * Kopiuje dane zmiennej i tworzy nową na jej wzór. Gdy zmienna jest bindem konstruktor ten klonuje bind. Kopia nie należy do żadnego zbioru - zbiór przypisuje sobie zmienną po umieszczeniu jej w kontenerze.
 			 *
 			 */
 			KLVariable(const KLVariable& Object);
@@ -183,6 +218,14 @@ class KLLIBS_EXPORT KLVariables
 			 */
 			bool IsBinded(void) const;
 
+			/*! \brief		Pobranie znacznika zmiany.
+			 *  \return		Znacznik ostatniego przypisania zmiennej.
+			 *
+			 * Znacznik nadawany jest przy utworzeniu zmiennej i przy każdym przypisaniu, z tej samej puli co znaczniki zbiorów (`KLVariables::GetVersion()`). Zmiana wartości zbindowanej zmiennej poza skryptem nie zmienia znacznika.
+			 *
+			 */
+			uint64_t GetVersion(void) const;
+
 			/*! \brief		Ustalenie funkcji zwrotnej.
 			 *  \param [in]	Handler Funkcja zwrotna.
 			 *
@@ -219,16 +262,46 @@ class KLLIBS_EXPORT KLVariables
 			 *  \tparam		Data		Typ nowej wartości.
 			 *  \param [in]	Value	Nowa wartość.
 			 *
-			 * Przypisuje do obiektu odpowiednią reprezentacje podanego obiektu po dokonaniu konwersji.
+			 * Przypisuje do obiektu odpowiednią reprezentacje podanego obiektu po dokonaniu konwersji. Zmiana nadaje zmiennej nowy znacznik zmiany (`GetVersion()`), a zmiennej należącej do zbioru także zbiorowi (`KLVariables::GetVersion()`).
 			 *
 			 */
 			template<typename Data> KLVariable& operator= (const Data& Value);
 
 	};
 
+#if defined(USING_STATIC_CONTAINERS)
+	public: using KLSCONTAINER = KLStaticMap<KLVariable, KLSymbol, KLVARIABLES_SIZE>;
+	public: using KLSVARITERATOR = KLSCONTAINER::KLStaticMapVarIterator;
+	public: using KLSCONSTITERATOR = KLSCONTAINER::KLStaticMapConstIterator;
+#elif defined(USING_CONCURRENT)
+	public: using KLSCONTAINER = KLConcurrentMap<KLVariable, KLSymbol>;
+	public: using KLSVARITERATOR = KLSCONTAINER::KLConcurrentMapVarIterator;
+	public: using KLSCONSTITERATOR = KLSCONTAINER::KLConcurrentMapConstIterator;
+#else
+	public: using KLSCONTAINER = KLMap<KLVariable, KLSymbol>;
+	public: using KLSVARITERATOR = KLSCONTAINER::KLMapVarIterator;
+	public: using KLSCONSTITERATOR = KLSCONTAINER::KLMapConstIterator;
+#endif
+
 	protected:
 
-		KLMap<KLVariable, KLString> Variables;	//!< Mapa zmiennych.
+		KLSCONTAINER Variables;	//!< Mapa zmiennych.
+
+		KLSVERSION Version;		//!< Znacznik ostatniej zmiany zbioru.
+
+		/*! \brief		Odnotowanie zmiany.
+		 *
+		 * Nadaje zbiorowi nowy, większy od wszystkich dotychczas nadanych, znacznik zmiany.
+		 *
+		 */
+		void Touch(void);
+
+		/*! \brief		Przypisanie zmiennych do zbioru.
+		 *
+		 * Ustawia zbiór jako właściciela wszystkich zmiennych (po skopiowaniu lub przesunięciu elementów kontenera).
+		 *
+		 */
+		void Adopt(void);
 
 	public:
 
@@ -258,7 +331,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Tworzy nową zmienną w systemie zgodnie z regułami konstruktora `KLVariable::KLVariable(const KLVariable&)`.
 		 *
 		 */
-		bool Add(const KLString& Name, const KLVariable& Object);
+		bool Add(const KLSymbol& Name, const KLVariable& Object);
 
 		/*! \brief		Tworzenie zmiennej w systemie.
 		 *  \param [in]	Name		Nazwa zmiennej.
@@ -270,7 +343,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Tworzy nową zmienną w systemie zgodnie z regułami konstruktora `KLVariable::KLVariable(TYPE, void*)`.
 		 *
 		 */
-		bool Add(const KLString& Name, TYPE Type = NUMBER, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
+		bool Add(const KLSymbol& Name, TYPE Type = NUMBER, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
 
 		/*! \brief		Tworzenie zmiennej w systemie.
 		 *  \param [in]	Name		Nazwa zmiennej.
@@ -282,7 +355,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Tworzy nową zmienną w systemie bindując do niej podany obiekt.
 		 *
 		 */
-		bool Add(const KLString& Name, bool& Boolean, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
+		bool Add(const KLSymbol& Name, bool& Boolean, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
 
 		/*! \brief		Tworzenie zmiennej w systemie.
 		 *  \param [in]	Name		Nazwa zmiennej.
@@ -294,7 +367,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Tworzy nową zmienną w systemie bindując do niej podany obiekt.
 		 *
 		 */
-		bool Add(const KLString& Name, double& Number, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
+		bool Add(const KLSymbol& Name, double& Number, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
 
 		/*! \brief		Tworzenie zmiennej w systemie.
 		 *  \param [in]	Name		Nazwa zmiennej.
@@ -306,7 +379,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Tworzy nową zmienną w systemie bindując do niej podany obiekt.
 		 *
 		 */
-		bool Add(const KLString& Name, int& Integer, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
+		bool Add(const KLSymbol& Name, int& Integer, KLSCALLBACK Handler = KLSCALLBACK(), bool Writeable = true);
 
 		/*! \brief		Usuwanie zmiennej z systemu.
 		 *  \param [in]	Name Nazwa zmiennej.
@@ -315,7 +388,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Usuwa wybraną zmienną z systemu zgodnie z regułami `KLVariable::~KLVariable()`.
 		 *
 		 */
-		bool Delete(const KLString& Name);
+		bool Delete(const KLSymbol& Name);
 
 		/*! \brief		Zmiana nazwy zmiennej.
 		 *  \param [in]	OldName	Stara nazwa zmiennej.
@@ -325,7 +398,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Usuwa wybraną zmienną z systemu zgodnie z regułami `KLVariable::~KLVariable()`.
 		 *
 		 */
-		bool Rename(const KLString& OldName, const KLString& NewName);
+		bool Rename(const KLSymbol& OldName, const KLSymbol& NewName);
 
 		/*! \brief		Test obecności zmiennej.
 		 *  \param [in]	Name		Nazwa zmiennej.
@@ -335,7 +408,15 @@ class KLLIBS_EXPORT KLVariables
 		 * Sprawdza czy podana zmienna istnieje w systemie.
 		 *
 		 */
-		bool Exists(const KLString& Name, bool Recursive = true) const;
+		bool Exists(const KLSymbol& Name, bool Recursive = true) const;
+
+		/*! \brief		Pobranie znacznika zmiany.
+		 *  \return		Największy znacznik zmiany zbioru i jego zakresów nadrzędnych.
+		 *
+		 * Znacznik zmienia się przy każdym przypisaniu zmiennej, dodaniu, usunięciu i zmianie nazwy zmiennej w zbiorze lub w którymkolwiek zakresie nadrzędnym, a także przy utworzeniu zbioru. Znaczniki są unikatowe w całym programie, dzięki czemu ta sama wartość oznacza brak zmian od chwili jej pobrania. Zmiana wartości zbindowanej zmiennej poza skryptem nie zmienia znacznika.
+		 *
+		 */
+		uint64_t GetVersion(void) const;
 
 		/*! \brief		Pobranie ilości zmiennych.
 		 *  \return		Ilośc zmiennych w obecnym zakresie.
@@ -352,6 +433,14 @@ class KLLIBS_EXPORT KLVariables
 		 */
 		void Clean(void);
 
+		/*! \brief		Odzyskanie pamięci usuniętych zmiennych.
+		 *  \warning		Wywołujący gwarantuje, że żaden wątek nie przechowuje referencji do zmiennych zbioru.
+		 *
+		 * W trybie `USING_CONCURRENT` usunięte zmienne pozostają w pamięci, aby referencje pobrane przez inne wątki nie traciły ważności, i są zwalniane dopiero przez tę metodę (`KLConcurrentMap::Reclaim()`). W pozostałych trybach metoda nic nie robi.
+		 *
+		 */
+		void Reclaim(void);
+
 		/*! \brief		Operator wyboru.
 		 *  \param [in]	Name Nazwa zmiennej.
 		 *  \return		Referencja do obiektu zmiennej.
@@ -360,7 +449,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Wybiera z systemu zmienną o podanej nazwie.
 		 *
 		 */
-		KLVariable& operator[] (const KLString& Name);
+		KLVariable& operator[] (const KLSymbol& Name);
 
 		/*! \brief		Operator wyboru.
 		 *  \param [in]	Name Nazwa zmiennej.
@@ -370,7 +459,7 @@ class KLLIBS_EXPORT KLVariables
 		 * Wybiera z systemu zmienną o podanej nazwie.
 		 *
 		 */
-		const KLVariable& operator[] (const KLString& Name) const;
+		const KLVariable& operator[] (const KLSymbol& Name) const;
 
 		/*! \brief		Operator przypisania.
 		 *  \param [in]	Objects Zmienne do skopiowania.
@@ -381,11 +470,11 @@ class KLLIBS_EXPORT KLVariables
 		 */
 		KLVariables& operator = (const KLVariables& Objects);
 
-		KLMap<KLVariable, KLString>::KLMapVarIterator begin(void);
-		KLMap<KLVariable, KLString>::KLMapVarIterator end(void);
+		KLSVARITERATOR begin(void);
+		KLSVARITERATOR end(void);
 
-		KLMap<KLVariable, KLString>::KLMapConstIterator begin(void) const;
-		KLMap<KLVariable, KLString>::KLMapConstIterator end(void) const;
+		KLSCONSTITERATOR begin(void) const;
+		KLSCONSTITERATOR end(void) const;
 
 };
 
@@ -0,0 +1,252 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Fixed-point accuracy test and benchmark for KLLibs                     *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "../../containers/klfixed.hpp"
+#include "../../script/klparser.hpp"
+#include "../../script/klprogram.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+enum FUNCTION
+{
+	ADD, MUL, DIV, SQRT, SIN, COS, EXP, LN, LOG10, POW, ROUND, PARSE, COUNT
+};
+
+static const char* Names[] =
+{
+	"add", "mul", "div", "sqrt", "sin", "cos", "exp", "ln", "log10", "pow", "round", "parse"
+};
+
+// dopuszczalny błąd w jednostkach `2^-Fraction` (działania) lub `2^-16` (funkcje tablicowe, `exp` i `pow` względem wartości większych od 1)
+static const double Limits[] =
+{
+	1.0, 1.0, 1.0, 1.0, 1.5, 1.5, 1.5, 1.5, 1.5, 4.5, 1.0, 1.0
+};
+
+static const bool Tables[] =
+{
+	false, false, false, false, true, true, true, true, true, true, false, false
+};
+
+static unsigned Seed = 12345;
+
+static double Random(double Range)
+{
+	Seed = Seed * 1103515245u + 12345u; return ((Seed >> 8) & 0xFFFFFF) / double(0xFFFFFF) * 2.0 * Range - Range;
+}
+
+static double Elapsed(clock_t Start, int Count)
+{
+	return double(clock() - Start) / CLOCKS_PER_SEC * 1e9 / Count;
+}
+
+static bool Accuracy(int Count)
+{
+	const double Lsb = double(KLFixed::ONE);
+	const double Range = KLFixed::FromRaw(KLFixed::MAX).ToNumber() * 0.9;
+
+	double Worst[COUNT] = { 0.0 };
+	bool Passed = true;
+
+	auto Check = [&] (FUNCTION Function, double Result, double Expected, double Scale)
+	{
+		if (fabs(Expected) > Range) return;
+
+		const double Error = fabs(Result - Expected) * (Tables[Function] ? 65536.0 : Lsb) / Scale;
+
+		if (Error > Worst[Function]) Worst[Function] = Error;
+	};
+
+	for (int i = 0; i < Count; ++i)
+	{
+		const KLFixed A(Random(100.0)), B(Random(10.0));
+		const KLFixed H = B * KLFixed(0.5);
+
+		const double a = A.ToNumber(), b = B.ToNumber(), h = H.ToNumber();
+
+		Check(ADD, (A + B).ToNumber(), a + b, 1.0);
+		Check(MUL, (A * B).ToNumber(), a * b, 1.0);
+		Check(SQRT, sqrt(fabs(A)).ToNumber(), sqrt(fabs(a)), 1.0);
+		Check(SIN, sin(A).ToNumber(), sin(a), 1.0);
+		Check(COS, cos(A).ToNumber(), cos(a), 1.0);
+		Check(ROUND, A.Round(2).ToNumber(), round(a * 100.0) / 100.0, 1.0);
+
+		if (fabs(b) > 0.01) Check(DIV, (A / B).ToNumber(), a / b, 1.0);
+
+		if (b < 10.0) Check(EXP, exp(B).ToNumber(), exp(b), fmax(1.0, exp(b)));
+
+		if (a > 0.01)
+		{
+			Check(LN, log(A).ToNumber(), log(a), 1.0);
+			Check(LOG10, log10(A).ToNumber(), log10(a), 1.0);
+		}
+
+		if (a > 0.0 && a < 10.0) Check(POW, pow(A, H).ToNumber(), pow(a, h), fmax(1.0, pow(a, h)));
+
+		char Text[32]; KLFixed Parsed(0.0);
+
+		snprintf(Text, sizeof(Text), "%.9f", fabs(a));
+		KLFixed::Parse(Text, Text + strlen(Text), Parsed);
+
+		Check(PARSE, Parsed.ToNumber(), atof(Text), 1.0);
+	}
+
+	printf("accuracy (Q%d.%d, %d operands):\n", int(sizeof(KLFixed) * 8) - int(log2(Lsb)), int(log2(Lsb)), Count);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		const bool Within = Worst[i] <= Limits[i];
+
+		printf("  %-6s %6.2f %s (limit %.1f)%s\n", Names[i], Worst[i], Tables[i] ? "x 2^-16" : "LSB", Limits[i], Within ? "" : " FAILED");
+
+		Passed = Passed && Within;
+	}
+
+	return Passed;
+}
+
+template<typename Type> static void Kernels(const char* Name, const double* Operands, int Count, int Repeat)
+{
+	Type* Values = new Type[Count];
+	volatile double Sink = 0.0;
+
+	for (int i = 0; i < Count; ++i) Values[i] = Type(Operands[i]);
+
+	printf("  %-7s", Name);
+
+	{
+		const clock_t Start = clock(); Type Sum(0.0);
+		for (int r = 0; r < Repeat; ++r) for (int i = 1; i < Count; ++i) Sum = Sum + Values[i] * Values[i - 1];
+		Sink = Sink + double(Sum); printf(" mul+add %6.2f ns", Elapsed(Start, Repeat * Count));
+	}
+
+	{
+		const clock_t Start = clock(); Type Sum(0.0);
+		for (int r = 0; r < Repeat; ++r) for (int i = 1; i < Count; ++i) Sum = Sum + Values[i] / Values[i - 1];
+		Sink = Sink + double(Sum); printf(" | div %6.2f ns", Elapsed(Start, Repeat * Count));
+	}
+
+	{
+		const clock_t Start = clock(); Type Sum(0.0);
+		for (int r = 0; r < Repeat; ++r) for (int i = 0; i < Count; ++i) Sum = Sum + sqrt(fabs(Values[i]));
+		Sink = Sink + double(Sum); printf(" | sqrt %6.2f ns", Elapsed(Start, Repeat * Count));
+	}
+
+	{
+		const clock_t Start = clock(); Type Sum(0.0);
+		for (int r = 0; r < Repeat; ++r) for (int i = 0; i < Count; ++i) Sum = Sum + sin(Values[i]);
+		Sink = Sink + double(Sum); printf(" | sin %6.2f ns", Elapsed(Start, Repeat * Count));
+	}
+
+	{
+		const clock_t Start = clock(); Type Sum(0.0);
+		for (int r = 0; r < Repeat; ++r) for (int i = 0; i < Count; ++i) Sum = Sum + exp(Values[i] * Type(0.1));
+		Sink = Sink + double(Sum); printf(" | exp %6.2f ns", Elapsed(Start, Repeat * Count));
+	}
+
+	{
+		const clock_t Start = clock(); Type Sum(0.0);
+		for (int r = 0; r < Repeat; ++r) for (int i = 0; i < Count; ++i) Sum = Sum + log(fabs(Values[i]) + Type(1.0));
+		Sink = Sink + double(Sum); printf(" | ln %6.2f ns\n", Elapsed(Start, Repeat * Count));
+	}
+
+	delete [] Values;
+}
+
+static void Benchmark(int Repeat)
+{
+	const int Count = 1024;
+
+	double Operands[Count];
+
+	for (int i = 0; i < Count; ++i)
+	{
+		do Operands[i] = Random(10.0); while (fabs(Operands[i]) < 0.1);
+	}
+
+	printf("benchmark (per operation):\n");
+
+	Kernels<double>("double", Operands, Count, Repeat);
+	Kernels<KLFixed>("KLFixed", Operands, Count, Repeat);
+
+	const char* Code = "a * b + c / (a + 1) - sqrt(abs(b)) + sin(c) + (a > b & c < 3)";
+
+	KLParser Parser; KLProgram Program; KLVariables Scoope;
+	double a = 1.5, b = 2.5, Sum = 0.0;
+
+	Scoope.Add("a", a);
+	Scoope.Add("b", b);
+	Scoope.Add("c");
+	Scoope["c"] = 0.25;
+
+	Parser.Compile(Code, Program);
+
+	const clock_t Start = clock();
+
+	for (int i = 0; i < Repeat * 100; ++i)
+	{
+		a = Operands[i % Count]; Parser.Evaluate(Program, &Scoope); Sum += Parser.GetValue();
+	}
+
+#if defined(USING_FIXED_POINT)
+	const char* Mode = "USING_FIXED_POINT";
+#else
+	const char* Mode = "double";
+#endif
+
+	printf("  KLParser (%s) %.1f ns per evaluation (sum %g)\n", Mode, Elapsed(Start, Repeat * 100), Sum);
+}
+
+static int Usage(void)
+{
+	fprintf(stderr, "Usage: klfixedbench [-n operands] [-b repeats] [-s seed]\n\n"
+				 "  -n operands  number of random operands of the accuracy test (default: 200000)\n"
+				 "  -b repeats   number of benchmark repeats, 0 disables the benchmark (default: 1000)\n"
+				 "  -s seed      seed of the operand generator (default: 12345)\n");
+
+	return 1;
+}
+
+int main(int argc, char* argv[])
+{
+	int Operands = 200000;
+	int Repeats = 1000;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool Param = argv[i][0] == '-' && i + 1 < argc;
+
+		if (Param && !strcmp(argv[i], "-n")) Operands = atoi(argv[++i]);
+		else if (Param && !strcmp(argv[i], "-b")) Repeats = atoi(argv[++i]);
+		else if (Param && !strcmp(argv[i], "-s")) Seed = unsigned(atol(argv[++i]));
+		else return Usage();
+	}
+
+	const bool Passed = Accuracy(Operands);
+
+	if (Repeats > 0) Benchmark(Repeats);
+
+	return Passed ? 0 : 2;
+}
@@ -0,0 +1,179 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  JIT and interpreter comparison test for KLLibs                         *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "../../script/kljit.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* Fixed[] =
+{
+	"a+b*c", "a & b | c", "a @ b ? c", "-a", "!a", "sqrt(a)", "abs(a)", "a ~ b", "a % b", "a ^ b",
+	"a & (b | c) & $", "(a | b) & (c @ $)", "a ? b ? c", "a @ b @ c", "a > b & b > c | c = a",
+	"sin(a) + cos(b) * tan(c)", "x + 1", "1", "$", "a < b", "a = b", "a <> b", "a >= b", "a <= b",
+	"a / b", "a - b", "exp(a) + log(b) + ln(c)", "((a))", "a & b & c & $", "a | b | c | $",
+	"!(a & b) | !c", "-(a @ b)", "(a + b) & (c + $) | (a - b)", "2 * 3 + a", "a ? (b & c)",
+	"a & (b ? c)", "(a @ b) & c", "a + (b & c) * $", "abs(a) ~ 3", "1 / 0"
+};
+
+static const char* Operators[] = { "+", "-", "*", "/", "^", "=", "<>", ">", "<", ">=", "<=", "|", "&", "?", "@", "~", "%" };
+static const char* Functions[] = { "sin", "cos", "tan", "abs", "exp", "sqrt", "log", "ln", "!", "-" };
+static const char* Operands[] = { "a", "b", "c", "$", "1", "0", "2.5", "0.0", "3" };
+
+static const double Values[] =
+{
+	0.0, -0.0, 1.0, -1.0, NAN, -NAN, INFINITY, -INFINITY,
+	0.5, 3.7, 1e300, -2.5, 1e-310, 7.0, 2.0
+};
+
+static unsigned Seed = 12345;
+
+static unsigned Random(unsigned Range)
+{
+	Seed = Seed * 1103515245u + 12345u; return ((Seed >> 8) & 0xFFFFFF) % Range;
+}
+
+static void Append(char* Buffer, const char* String)
+{
+	strncat(Buffer, String, 1023 - strlen(Buffer));
+}
+
+static void Generate(char* Buffer, int Depth)
+{
+	const unsigned Kind = Random(10);
+
+	if (Depth <= 0 || Kind < 3)
+	{
+		Append(Buffer, Operands[Random(9)]);
+	}
+	else if (Kind < 5)
+	{
+		Append(Buffer, Functions[Random(10)]);
+		Append(Buffer, "(");
+		Generate(Buffer, Depth - 1);
+		Append(Buffer, ")");
+	}
+	else
+	{
+		const char* Operator = Operators[Random(17)];
+
+		Append(Buffer, "(");
+		Generate(Buffer, Depth - 1);
+		Append(Buffer, " ");
+		Append(Buffer, Operator);
+		Append(Buffer, " ");
+
+		// prawy argument `%` i `~` rzutowany jest na `int`, więc generowana jest dla niego stała
+		if (!strcmp(Operator, "%")) Append(Buffer, "3");
+		else if (!strcmp(Operator, "~")) Append(Buffer, "2");
+		else Generate(Buffer, Depth - 1);
+
+		Append(Buffer, ")");
+	}
+}
+
+static int Usage(void)
+{
+	fprintf(stderr, "Usage: kljittest [-n expressions] [-s seed]\n\n"
+				 "  -n expressions  number of tested expressions (default: 3000)\n"
+				 "  -s seed         seed of the expression generator (default: 12345)\n");
+
+	return 1;
+}
+
+int main(int argc, char* argv[])
+{
+	const int Count = sizeof(Values) / sizeof(Values[0]);
+	const int Fixeds = sizeof(Fixed) / sizeof(Fixed[0]);
+
+	int Expressions = 3000;
+	int Total = 0, Native = 0, Cases = 0, Diffs = 0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool Param = argv[i][0] == '-' && i + 1 < argc;
+
+		if (Param && !strcmp(argv[i], "-n")) Expressions = atoi(argv[++i]);
+		else if (Param && !strcmp(argv[i], "-s")) Seed = unsigned(atol(argv[++i]));
+		else return Usage();
+	}
+
+	for (int k = 0; k < Expressions; ++k)
+	{
+		char Code[1024] = "";
+
+		if (k < Fixeds) Append(Code, Fixed[k]);
+		else Generate(Code, 1 + Random(5));
+
+		KLJit Jit; KLParser Parser; KLProgram Program;
+
+		const bool Compiled = Parser.Compile(Code, Program);
+
+		if (Jit.Compile(Code) != Compiled)
+		{
+			printf("COMPILE %s: %d | %d\n", Code, Compiled, !Compiled); ++Diffs; continue;
+		}
+		else if (!Compiled) continue;
+
+		++Total; if (Jit.IsNative()) ++Native;
+
+		// `%` dzieli liczby całkowite, a dzielenie przez zero jest niezdefiniowane
+		const bool Integral = strchr(Code, '%') != nullptr;
+
+		for (int t = 0; t < 40; ++t)
+		{
+			KLVariables Scoope;
+
+			double a = Values[Random(Count)];
+			double b = Values[Random(Count)];
+			double c = Values[Random(Count)];
+			double r = Values[Random(Count)];
+
+			if (Integral && !(b == 2.0 || b == 3.7 || b == 7.0)) b = 2.0;
+
+			Scoope.Add("a", a);
+			Scoope.Add("b", b);
+
+			// co siódmy przypadek sprawdza błąd niezdefiniowanej zmiennej
+			if (t % 7) { Scoope.Add("c"); Scoope["c"] = c; }
+
+			const bool Interpreted = Parser.Evaluate(Program, &Scoope, r);
+			const bool Executed = Jit.Evaluate(&Scoope, r);
+
+			const double Expected = Parser.GetValue();
+			const double Result = Jit.GetValue();
+
+			++Cases;
+
+			if (Interpreted != Executed || Parser.GetError() != Jit.GetError() || memcmp(&Expected, &Result, sizeof(double)))
+			{
+				if (++Diffs <= 20) printf("DIFF %s a=%g b=%g c=%g $=%g: %d %d %a | %d %d %a\n", Code, a, b, c, r,
+									 Interpreted, Parser.GetError(), Expected,
+									 Executed, Jit.GetError(), Result);
+			}
+		}
+	}
+
+	printf("expressions=%d native=%d cases=%d diffs=%d\n", Total, Native, Cases, Diffs);
+
+	return Diffs ? 2 : 0;
+}
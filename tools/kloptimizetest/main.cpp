@@ -0,0 +1,107 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Script optimizer regression test for KLLibs                            *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "../../script/klscript.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* Scripts[] =
+{
+	// treść pętli z niezmiennikiem
+	"var i, s, a, b; set a 3; set b 4; while i < 5; set s s + i * (a * b + 1); set i i + 1; done; call print s;",
+
+	// pętla zagnieżdżona z niezmiennikiem pętli zewnętrznej
+	"var i, j, s, k; set k 2; while i < 3; set j 0; while j < 3; set s s + k * 10 + i; set j j + 1; done; set i i + 1; done; call print s;",
+
+	// pętla niewykonana ani razu, z niezmiennym podwyrażeniem warunku
+	"var i, n, k; set n 0; set k 2; while i < n * k; set i i + 1; done; call print i;",
+
+	// cały warunek pętli niezmienny
+	"var i, n; set n 0; while n > 0; set i i + 1; done; call print i;",
+
+	// warunek pętli wewnętrznej zmienia się w kolejnych przebiegach pętli zewnętrznej
+	"var i, j, k; set k 1; while i < 2; set j 0; while j < k * 2; call print i, j; set j j + 1; done; set k 0; set i i + 1; done;"
+};
+
+static char Buffer[4096];
+
+static double Print(KLBindings::KLSSTACK& Params)
+{
+	size_t Length = strlen(Buffer);
+
+	Length += snprintf(Buffer + Length, sizeof(Buffer) - Length, "P");
+
+	for (int i = 0; i < Params.Size() && Length < sizeof(Buffer); ++i)
+	{
+		Length += snprintf(Buffer + Length, sizeof(Buffer) - Length, " %g", Params[i]);
+	}
+
+	if (Length < sizeof(Buffer)) snprintf(Buffer + Length, sizeof(Buffer) - Length, "\n");
+
+	return 0.0;
+}
+
+static KLScript::ERROR Run(const KLString& Code, KLString& Source, bool Optimize, char* Output, size_t Size)
+{
+	KLScript Script;
+
+	Script.Bindings.Add("print", Print);
+
+	Buffer[0] = 0;
+
+	Source = Optimize ? Script.Optimize(Code) : Code;
+
+	Script.Evaluate(Source);
+
+	snprintf(Output, Size, "%s", Buffer);
+
+	return Script.GetError();
+}
+
+int main(void)
+{
+	const int Count = sizeof(Scripts) / sizeof(Scripts[0]);
+
+	int Diffs = 0;
+
+	for (int i = 0; i < Count; ++i)
+	{
+		static char Expected[4096], Result[4096];
+
+		KLString Source, Rewritten;
+
+		const KLScript::ERROR Original = Run(Scripts[i], Source, false, Expected, sizeof(Expected));
+		const KLScript::ERROR Optimized = Run(Scripts[i], Rewritten, true, Result, sizeof(Result));
+
+		if (Original != Optimized || strcmp(Expected, Result))
+		{
+			printf("DIFF %s\n  optimized: %s\n  error %d | %d\n%s--\n%s", (const char*) Source,
+				  (const char*) Rewritten, Original, Optimized, Expected, Result);
+
+			++Diffs;
+		}
+	}
+
+	printf("scripts=%d diffs=%d\n", Count, Diffs);
+
+	return Diffs ? 2 : 0;
+}
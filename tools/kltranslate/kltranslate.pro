@@ -0,0 +1,61 @@
+# * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#                                                                         *
+#  Script Translator tool for KLLibs                                      *
+#  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+#                                                                         *
+#  This program is free software: you can redistribute it and/or modify   *
+#  it under the terms of the GNU General Public License as published by   *
+#  the  Free Software Foundation, either  version 3 of the  License, or   *
+#  (at your option) any later version.                                    *
+#                                                                         *
+#  This  program  is  distributed  in the hope  that it will be useful,   *
+#  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+#  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+#  GNU General Public License for more details.                           *
+#                                                                         *
+#  You should have  received a copy  of the  GNU General Public License   *
+#  along with this program. If not, see http://www.gnu.org/licenses/.     *
+#                                                                         *
+# * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+TARGET	=	kltranslate
+TEMPLATE	=	app
+
+CONFIG	+=	c++14 console
+CONFIG	-=	app_bundle qt
+
+SOURCES	+=	main.cpp \
+			../../script/kltranslator.cpp \
+			../../script/klscript.cpp \
+			../../script/klvariables.cpp \
+			../../script/klbindings.cpp \
+			../../script/klparser.cpp \
+			../../script/klprogram.cpp \
+			../../containers/klnumber.cpp \
+			../../containers/klstring.cpp \
+			../../containers/klstringbuilder.cpp \
+			../../containers/klstringview.cpp \
+			../../containers/klsymbol.cpp \
+			../../containers/klmappedfile.cpp
+
+HEADERS	+=	../../script/kltranslator.hpp
+
+QMAKE_CXXFLAGS	+=	-std=c++14
+
+unix {
+
+	LIBS		+=	-lpthread
+
+}
+
+static {
+
+	DEFINES	+=	USING_STATIC_CONTAINERS
+
+}
+
+fixed {
+
+	DEFINES	+=	USING_FIXED_POINT
+
+}
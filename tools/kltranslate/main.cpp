@@ -0,0 +1,114 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                         *
+ *  Lightweight Script Translator tool for KLLibs                          *
+ *  Copyright (C) 2015  Łukasz "Kuszki" Dróżdż  l.drozdz@openmailbox.org   *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the  Free Software Foundation, either  version 3 of the  License, or   *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This  program  is  distributed  in the hope  that it will be useful,   *
+ *  but WITHOUT ANY  WARRANTY;  without  even  the  implied  warranty of   *
+ *  MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the   *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have  received a copy  of the  GNU General Public License   *
+ *  along with this program. If not, see http://www.gnu.org/licenses/.     *
+ *                                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "../../script/kltranslator.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* Errors[] =
+{
+	"NO_ERROR",
+	"UNDEFINED_VARIABLE",
+	"UNDEFINED_FUNCTION",
+	"EXPECTED_ENDIF_TOK",
+	"EXPECTED_DONE_TOK",
+	"EXPECTED_TERMINATOR",
+	"EMPTY_FUNCTION",
+	"EMPTY_EXPRESSION",
+	"UNKNOWN_EXPRESSION",
+	"WRONG_SCRIPTCODE",
+	"WRONG_PARAMETERS",
+	"WRONG_EVALUATION",
+	"VARIABLE_READONLY",
+	"SCRIPT_TERMINATED",
+	"OUT_OF_CAPACITY"
+};
+
+static double Declared(KLBindings::KLSSTACK&)
+{
+	return 0.0;
+}
+
+static int Usage(void)
+{
+	fprintf(stderr, "Usage: kltranslate [-n name] [-o output] [-v variable]... [-c function]... [-p function]... script\n\n"
+				 "  -n name      name of the generated C++ function (default: Script)\n"
+				 "  -o output    output file (default: standard output)\n"
+				 "  -v variable  declare a variable bound by the program\n"
+				 "  -c function  declare a function bound by the program\n"
+				 "  -p function  declare a pure function bound by the program\n");
+
+	return 1;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* Input = nullptr;
+	const char* Output = nullptr;
+	const char* Name = "Script";
+
+	KLScript Script;
+	KLTranslator Translator(Script);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool Param = argv[i][0] == '-' && i + 1 < argc;
+
+		if (Param && !strcmp(argv[i], "-n")) Name = argv[++i];
+		else if (Param && !strcmp(argv[i], "-o")) Output = argv[++i];
+		else if (Param && !strcmp(argv[i], "-v")) Script.Variables.Add(argv[++i]);
+		else if (Param && !strcmp(argv[i], "-c")) Script.Bindings.Add(argv[++i], Declared);
+		else if (Param && !strcmp(argv[i], "-p")) Script.Bindings.Add(argv[++i], Declared, true);
+		else if (argv[i][0] != '-' && !Input) Input = argv[i];
+		else return Usage();
+	}
+
+	if (!Input) return Usage();
+
+	const KLMappedFile File(Input);
+
+	if (!File.IsOpen())
+	{
+		fprintf(stderr, "kltranslate: cannot open '%s'\n", Input); return 2;
+	}
+
+	const KLString Code = File.String();
+	const KLString Source = Translator.Translate(Code, Name);
+
+	if (!Source.Size())
+	{
+		fprintf(stderr, "%s:%d: error: %s\n", Input, Translator.GetLine(Code), Errors[Translator.GetError()]); return 2;
+	}
+
+	FILE* Stream = Output ? fopen(Output, "wb") : stdout;
+
+	if (!Stream)
+	{
+		fprintf(stderr, "kltranslate: cannot write '%s'\n", Output); return 2;
+	}
+
+	const bool Written = fwrite((const char*) Source, 1, Source.Size(), Stream) == size_t(Source.Size());
+
+	if (Output) fclose(Stream);
+
+	return Written ? 0 : 2;
+}